@@ -22,8 +22,11 @@
  *  Buffer for handling actionscript byte code.
  */
 
+#include <algorithm>
+
+#include "src/common/error.h"
+#include "src/common/readstream.h"
 #include "src/common/bitstream.h"
-#include "src/common/memreadstream.h"
 #include "src/common/debug.h"
 
 #include "src/aurora/actionscript/variable.h"
@@ -81,37 +84,327 @@ enum Opcodes {
 	kActionIf              = 0x9D
 };
 
-ASBuffer::ASBuffer(Common::SeekableReadStream *as) :
-		_currentLength(0), _seeked(0), _script(as) {
+ASBuffer::PushValue::PushValue() : type(0), index(0) {
+}
+
+ASBuffer::MemberCache::MemberCache() : member(0) {
+}
+
+ASBuffer::Action::Action(byte op) : opcode(op), argument(0), target(0),
+		preloadThisFlag(false), preloadSuperFlag(false) {
+
+}
 
+ASBuffer::ASBuffer(Common::SeekableReadStream *as) {
 	assert(as);
+
+	as->seek(0);
+	_actions = decode(*as);
+}
+
+ASBuffer::ASBuffer(const ActionList &actions, const ConstantPool &constants) :
+		_actions(actions), _constants(constants) {
+
+	assert(_actions);
 }
 
 void ASBuffer::run(AVM &avm) {
-	_script->seek(0);
 	execute(avm);
 }
 
-void ASBuffer::setConstantPool(std::vector<Common::UString> constantPool) {
-	_constants = constantPool;
-}
+ASBuffer::ActionList ASBuffer::decode(Common::SeekableReadStream &script) {
+	ActionList actions(new std::vector<Action>);
+
+	// Byte offsets of all actions, to resolve the branches
+	std::vector<size_t> offsets;
+	std::vector<size_t> branches;
+	std::vector<size_t> branchTargets;
+
+	// Everything branching to the end action, or past the last action, ends the execution
+	size_t endOffset = 0;
 
-void ASBuffer::execute(AVM &avm) {
 	byte opcode;
-	debugC(kDebugActionScript, 1, "--- Start Actionscript ---");
 	do {
-		_seeked = 0;
-		opcode = _script->readByte();
+		const size_t offset = script.pos();
+
+		opcode = script.readByte();
 
 		uint16 length = 0;
 		if (opcode >= 0x80)
-			length = _script->readUint16LE();
+			length = script.readUint16LE();
 
-		_currentLength = length;
+		const size_t startPos = script.pos();
 
-		size_t startPos = _script->pos();
+		Action action(opcode);
+		size_t seeked = 0;
 
 		switch (opcode) {
+			case kActionStop:
+			case kActionToggleQuality:
+			case kActionSubtract:
+			case kActionMultiply:
+			case kActionDivide:
+			case kActionAnd:
+			case kActionOr:
+			case kActionNot:
+			case kActionPop:
+			case kActionGetVariable:
+			case kActionSetVariable:
+			case kActionTrace:
+			case kActionDefineLocal:
+			case kActionCallFunction:
+			case kActionReturn:
+			case kActionNewObject:
+			case kActionInitArray:
+			case kActionAdd2:
+			case kActionLess2:
+			case kActionEquals2:
+			case kActionPushDuplicate:
+			case kActionToNumber2:
+			case kActionGetMember:
+			case kActionSetMember:
+			case kActionIncrement:
+			case kActionCallMethod:
+			case kActionEnumerate2:
+			case kActionExtends:
+				break;
+
+			case kActionStoreRegister:
+				action.argument = script.readByte();
+				break;
+
+			case kActionConstantPool:
+				decodeConstantPool(script, action);
+				break;
+
+			case kActionDefineFunction2:
+				seeked = decodeDefineFunction2(script, action);
+				break;
+
+			case kActionPush:
+				decodePush(script, action, length);
+				break;
+
+			case kActionJump:
+			case kActionIf: {
+				const int16 branchOffset = script.readSint16LE();
+
+				branches.push_back(actions->size());
+				branchTargets.push_back(script.pos() + branchOffset);
+				break;
+			}
+
+			case kActionGetURL2:
+				decodeGetURL2(script, action);
+				break;
+
+			case kActionDefineFunction:
+				seeked = decodeDefineFunction(script, action);
+				break;
+
+			default:
+				script.seek(length, Common::SeekableReadStream::kOriginCurrent);
+				if (opcode != 0)
+					warning("Unknown opcode");
+		}
+
+		if (script.pos() - startPos != length + seeked)
+			throw Common::Exception("Invalid tag");
+
+		if (opcode != 0) {
+			offsets.push_back(offset);
+			actions->push_back(action);
+		}
+
+		endOffset = (opcode != 0) ? script.pos() : offset;
+
+	} while (opcode != 0 && script.pos() != script.size());
+
+	for (size_t i = 0; i < branches.size(); i++) {
+		const size_t target = branchTargets[i];
+
+		std::vector<size_t>::const_iterator found = std::lower_bound(offsets.begin(), offsets.end(), target);
+		if (found != offsets.end() && *found == target)
+			(*actions)[branches[i]].target = found - offsets.begin();
+		else if (target >= endOffset)
+			(*actions)[branches[i]].target = actions->size();
+		else
+			throw Common::Exception("Invalid branch target %u", (uint)target);
+	}
+
+	return actions;
+}
+
+void ASBuffer::decodeConstantPool(Common::SeekableReadStream &script, Action &action) {
+	const uint16 count = script.readUint16LE();
+
+	std::vector<Variable> *constants = new std::vector<Variable>;
+	action.constants.reset(constants);
+
+	constants->reserve(count);
+	for (uint16 i = 0; i < count; ++i)
+		constants->push_back(readString(script));
+}
+
+uint16 ASBuffer::decodeDefineFunction2(Common::SeekableReadStream &script, Action &action) {
+	action.functionName = readString(script);
+
+	int numParams = script.readUint16LE();
+	int registerCount = script.readByte();
+
+	Common::BitStream8MSB bitstream(script);
+
+	bool preloadParentFlag = bitstream.getBit() != 0;
+	bool preloadRootFlag = bitstream.getBit() != 0;
+	bool suppressSuperFlag = bitstream.getBit() != 0;
+	bool preloadSuperFlag = bitstream.getBit() != 0;
+	bool suppressArgumentsFlag = bitstream.getBit() != 0;
+	bool preloadArgumentsFlag = bitstream.getBit() != 0;
+	bool suppressThisFlag = bitstream.getBit() != 0;
+	bool preloadThisFlag = bitstream.getBit() != 0;
+
+	unsigned int reserved = bitstream.getBits(7);
+	assert(reserved == 0);
+
+	bool preloadGlobalFlag = bitstream.getBit() != 0;
+
+	for (int i = 0; i < numParams; ++i) {
+		script.readByte();
+		readString(script);
+	}
+
+	unsigned short codeSize = script.readUint16LE();
+
+	action.preloadThisFlag  = preloadThisFlag;
+	action.preloadSuperFlag = preloadSuperFlag;
+	action.function         = decodeFunctionBody(script, codeSize);
+
+	debugC(
+			kDebugActionScript,
+			2,
+			"decodeDefineFunction2 \"%s\" %d %d %s %s %s %s %s %s %s %s %s",
+			action.functionName.c_str(),
+			numParams,
+			registerCount,
+			preloadParentFlag ? "true" : "false",
+			preloadRootFlag ? "true" : "false",
+			suppressSuperFlag ? "true" : "false",
+			preloadSuperFlag ? "true" : "false",
+			suppressArgumentsFlag ? "true" : "false",
+			preloadArgumentsFlag ? "true" : "false",
+			suppressThisFlag ? "true" : "false",
+			preloadThisFlag ? "true" : "false",
+			preloadGlobalFlag ? "true" : "false"
+	);
+
+	return codeSize;
+}
+
+uint16 ASBuffer::decodeDefineFunction(Common::SeekableReadStream &script, Action &action) {
+	action.functionName = readString(script);
+
+	uint16 numParams = script.readUint16LE();
+	for (int i = 0; i < numParams; ++i)
+		readString(script);
+
+	uint16 codeSize = script.readUint16LE();
+
+	action.function = decodeFunctionBody(script, codeSize);
+
+	return codeSize;
+}
+
+ASBuffer::ActionList ASBuffer::decodeFunctionBody(Common::SeekableReadStream &script, uint16 codeSize) {
+	const size_t codeStart = script.pos();
+
+	Common::SeekableSubReadStream body(&script, codeStart, codeStart + codeSize);
+	ActionList actions = decode(body);
+
+	script.seek(codeStart + codeSize);
+
+	return actions;
+}
+
+void ASBuffer::decodePush(Common::SeekableReadStream &script, Action &action, uint16 length) {
+	while (length != 0) {
+		PushValue value;
+
+		value.type = script.readByte();
+		length -= 1;
+
+		switch (value.type) {
+			case 0: {
+				Common::UString string = readString(script);
+				value.literal = string;
+				length -= string.size() + 1;
+				break;
+			}
+			case 1:
+				value.literal = static_cast<double>(script.readIEEEFloatLE());
+				length -= 4;
+				break;
+			case 2:
+				// null
+			case 3:
+				// undefined
+				break;
+			case 4:
+				value.index = script.readByte();
+				length -= 1;
+				break;
+			case 5:
+				value.literal = (script.readByte() != 0);
+				length -= 1;
+				break;
+			case 6:
+				value.literal = script.readIEEEDoubleLE();
+				length -= 8;
+				break;
+			case 7:
+				value.literal = static_cast<unsigned int>(script.readUint32LE());
+				length -= 4;
+				break;
+			case 8:
+				// constant pool index 8bit
+				value.index = script.readByte();
+				length -= 1;
+				break;
+			case 9:
+				// constant pool index 16bit
+				value.index = script.readUint16LE();
+				length -= 2;
+				break;
+			default:
+				throw Common::Exception("invalid type byte in actionscript");
+		}
+
+		action.values.push_back(value);
+	}
+}
+
+void ASBuffer::decodeGetURL2(Common::SeekableReadStream &script, Action &action) {
+	Common::BitStream8MSB bitstream(script);
+
+	action.argument = bitstream.getBits(2);
+
+	byte reserved = bitstream.getBits(4);
+	assert(reserved == 0);
+
+	// Load target and load variables flags
+	bitstream.getBit();
+	bitstream.getBit();
+}
+
+void ASBuffer::execute(AVM &avm) {
+	std::vector<Action> &actions = *_actions;
+
+	debugC(kDebugActionScript, 1, "--- Start Actionscript ---");
+
+	size_t next = 0;
+	while (next < actions.size()) {
+		Action &action = actions[next++];
+
+		switch (action.opcode) {
 			case kActionStop:            actionStop(avm); break;
 			case kActionToggleQuality:   actionToggleQuality(); break;
 			case kActionSubtract:        actionSubtract(); break;
@@ -134,29 +427,24 @@ void ASBuffer::execute(AVM &avm) {
 			case kActionEquals2:         actionEquals2(); break;
 			case kActionPushDuplicate:   actionPushDuplicate(); break;
 			case kActionToNumber2:       actionToNumber2(); break;
-			case kActionGetMember:       actionGetMember(); break;
-			case kActionSetMember:       actionSetMember(); break;
+			case kActionGetMember:       actionGetMember(action); break;
+			case kActionSetMember:       actionSetMember(action); break;
 			case kActionIncrement:       actionIncrement(); break;
-			case kActionCallMethod:      actionCallMethod(avm); break;
+			case kActionCallMethod:      actionCallMethod(avm, action); break;
 			case kActionEnumerate2:      actionEnumerate2(); break;
 			case kActionExtends:         actionExtends(); break;
-			case kActionStoreRegister:   actionStoreRegister(avm); break;
-			case kActionDefineFunction2: actionDefineFunction2(); break;
-			case kActionConstantPool:    actionConstantPool(); break;
-			case kActionPush:            actionPush(avm); break;
-			case kActionJump:            actionJump(); break;
-			case kActionGetURL2:         actionGetURL2(avm); break;
-			case kActionDefineFunction:  actionDefineFunction(); break;
-			case kActionIf:              actionIf(); break;
+			case kActionStoreRegister:   actionStoreRegister(avm, action); break;
+			case kActionDefineFunction2: actionDefineFunction2(action); break;
+			case kActionConstantPool:    actionConstantPool(action); break;
+			case kActionPush:            actionPush(avm, action); break;
+			case kActionJump:            actionJump(action, next); break;
+			case kActionGetURL2:         actionGetURL2(avm, action); break;
+			case kActionDefineFunction:  actionDefineFunction(action); break;
+			case kActionIf:              actionIf(action, next); break;
 			default:
-				_script->seek(length, Common::SeekableReadStream::kOriginCurrent);
-				if (opcode != 0)
-					warning("Unknown opcode");
+				break;
 		}
-
-		if (_script->pos() - startPos != length + _seeked)
-			throw Common::Exception("Invalid tag");
-	} while (opcode != 0 && _script->pos() != _script->size());
+	}
 
 	debugC(kDebugActionScript, 1, "--- End Actionscript ---");
 }
@@ -357,7 +645,7 @@ void ASBuffer::actionPushDuplicate() {
 	debugC(kDebugActionScript, 1, "actionPushDuplicate");
 }
 
-void ASBuffer::actionGetMember() {
+void ASBuffer::actionGetMember(Action &action) {
 	if (!_stack.top().isString())
 		throw Common::Exception("value is not a string");
 	Common::UString name = _stack.top().asString();
@@ -367,18 +655,18 @@ void ASBuffer::actionGetMember() {
 	ObjectPtr object = _stack.top().asObject();
 	_stack.pop();
 
-	_stack.push(object->getMember(name));
+	_stack.push(getMember(action.cache, object, name, false));
 
 	debugC(kDebugActionScript, 1, "actionGetMember");
 }
 
-void ASBuffer::actionSetMember() {
+void ASBuffer::actionSetMember(Action &action) {
 	Variable value = _stack.top();
 	_stack.pop();
 	Common::UString name = _stack.top().asString();
 	_stack.pop();
 	ObjectPtr object = _stack.top().asObject();
-	object->setMember(name, value);
+	getMember(action.cache, object, name, true) = value;
 	_stack.pop();
 
 	debugC(kDebugActionScript, 1, "actionSetMember");
@@ -393,7 +681,7 @@ void ASBuffer::actionIncrement() {
 	debugC(kDebugActionScript, 1, "actionIncrement");
 }
 
-void ASBuffer::actionCallMethod(AVM &avm) {
+void ASBuffer::actionCallMethod(AVM &avm, Action &action) {
 	Common::UString name;
 	if (_stack.top().isString())
 		name = _stack.top().asString();
@@ -415,7 +703,7 @@ void ASBuffer::actionCallMethod(AVM &avm) {
 	if (name.empty()) {
 		function = dynamic_cast<Function *>(object.get());
 	} else {
-		function = dynamic_cast<Function *>(object->getMember(name).asObject().get());
+		function = dynamic_cast<Function *>(getMember(action.cache, object, name, false).asObject().get());
 	}
 
 	if (!function)
@@ -457,192 +745,69 @@ void ASBuffer::actionExtends() {
 	debugC(kDebugActionScript, 1, "actionExtends");
 }
 
-void ASBuffer::actionStoreRegister(AVM &avm) {
-	byte registerNumber = _script->readByte();
-	avm.storeRegister(_stack.top(), registerNumber);
+void ASBuffer::actionStoreRegister(AVM &avm, const Action &action) {
+	avm.storeRegister(_stack.top(), action.argument);
 
-	debugC(kDebugActionScript, 1, "actionStoreRegister %i", registerNumber);
+	debugC(kDebugActionScript, 1, "actionStoreRegister %i", action.argument);
 }
 
-void ASBuffer::actionConstantPool() {
-	uint16 count = _script->readUint16LE();
-	_constants.resize(count);
-	for (int i = 0; i < count; ++i) {
-		Common::UString constant = readString();
-		_constants[i] = constant;
-	}
+void ASBuffer::actionConstantPool(const Action &action) {
+	_constants = action.constants;
 
 	debugC(kDebugActionScript, 1, "actionConstantPool");
 }
 
-void ASBuffer::actionDefineFunction2() {
-	Common::UString functionName = readString();
-	int numParams = _script->readUint16LE();
-	int registerCount = _script->readByte();
-
-	Common::BitStream8MSB bitstream(_script);
-
-	bool preloadParentFlag = bitstream.getBit() != 0;
-	bool preloadRootFlag = bitstream.getBit() != 0;
-	bool suppressSuperFlag = bitstream.getBit() != 0;
-	bool preloadSuperFlag = bitstream.getBit() != 0;
-	bool suppressArgumentsFlag = bitstream.getBit() != 0;
-	bool preloadArgumentsFlag = bitstream.getBit() != 0;
-	bool suppressThisFlag = bitstream.getBit() != 0;
-	bool preloadThisFlag = bitstream.getBit() != 0;
-
-	unsigned int reserved = bitstream.getBits(7);
-	assert(reserved == 0);
-
-	bool preloadGlobalFlag = bitstream.getBit() != 0;
-
-	for (int i = 0; i < numParams; ++i) {
-		_script->readByte();
-		readString();
-	}
+void ASBuffer::actionDefineFunction2(const Action &action) {
+	_stack.push(ObjectPtr(new ScriptedFunction(action.function, _constants,
+	                                           action.preloadThisFlag, action.preloadSuperFlag)));
 
-	unsigned short codeSize = _script->readUint16LE();
-	_seeked = codeSize;
-
-	_stack.push(
-			ObjectPtr(
-					new ScriptedFunction(
-							new Common::SeekableSubReadStream(_script, _script->pos(), _script->pos() + codeSize),
-							_constants,
-							preloadThisFlag,
-							preloadSuperFlag
-					)
-			)
-	);
-
-	_script->seek(codeSize, Common::SeekableReadStream::kOriginCurrent);
-
-
-	debugC(
-			kDebugActionScript,
-			1,
-			"actionDefineFunction2 \"%s\" %d %d %s %s %s %s %s %s %s %s %s",
-			functionName.c_str(),
-			numParams,
-			registerCount,
-			preloadParentFlag ? "true" : "false",
-			preloadRootFlag ? "true" : "false",
-			suppressSuperFlag ? "true" : "false",
-			preloadSuperFlag ? "true" : "false",
-			suppressArgumentsFlag ? "true" : "false",
-			preloadArgumentsFlag ? "true" : "false",
-			suppressThisFlag ? "true" : "false",
-			preloadThisFlag ? "true" : "false",
-			preloadGlobalFlag ? "true" : "false"
-	);
+	debugC(kDebugActionScript, 1, "actionDefineFunction2 \"%s\"", action.functionName.c_str());
 }
 
-void ASBuffer::actionPush(AVM &avm) {
-	unsigned short length = _currentLength;
+void ASBuffer::actionPush(AVM &avm, const Action &action) {
+	for (std::vector<PushValue>::const_iterator v = action.values.begin(); v != action.values.end(); ++v) {
+		switch (v->type) {
+			case 4:
+				debugC(kDebugActionScript, 1, "actionPush register%d", v->index);
+				_stack.push(avm.getRegister(v->index));
+				break;
 
-	while (length != 0) {
-		byte type = _script->readByte();
-		length -= 1;
+			case 8:
+			case 9:
+				// constant pool index
+				if (!_constants || v->index >= _constants->size())
+					throw Common::Exception("Invalid constant pool index %u", v->index);
 
-		switch (type) {
-			case 0: {
-				Common::UString string = readString();
-				_stack.push(string);
-				debugC(kDebugActionScript, 1, "actionPush \"%s\"", string.c_str());
-				length -= string.size() + 1;
+				_stack.push((*_constants)[v->index]);
+				debugC(kDebugActionScript, 1, "actionPush constant%d", v->index);
 				break;
-			}
-			case 1: {
-				float floatValue = _script->readIEEEFloatLE();
-				_stack.push(floatValue);
-				debugC(kDebugActionScript, 1, "actionPush %f", floatValue);
-				length -= 4;
-				break;
-			}
-			case 2: {
-				// null
+
+			case 2:
 				debugC(kDebugActionScript, 1, "actionPush null");
-				_stack.push(Variable());
+				_stack.push(v->literal);
 				break;
-			}
-			case 3: {
-				// undefined
+
+			case 3:
 				debugC(kDebugActionScript, 1, "actionPush undefined");
-				_stack.push(Variable());
-				break;
-			}
-			case 4: {
-				byte registerNumber = _script->readByte();
-				debugC(kDebugActionScript, 1, "actionPush register%d", registerNumber);
-				_stack.push(avm.getRegister(registerNumber));
-				length -= 1;
-				break;
-			}
-			case 5: {
-				bool boolValue = (_script->readByte() != 0);
-				debugC(kDebugActionScript, 1, "actionPush %s", boolValue ? "true" : "false");
-				_stack.push(boolValue);
-				length -= 1;
-				break;
-			}
-			case 6: {
-				double doubleValue = _script->readIEEEDoubleLE();
-				_stack.push(doubleValue);
-				debugC(kDebugActionScript, 1, "actionPush %f", doubleValue);
-				length -= 8;
-				break;
-			}
-			case 7: {
-				unsigned int uintValue = _script->readUint32LE();
-				_stack.push(uintValue);
-				debugC(kDebugActionScript, 1, "actionPush %u", uintValue);
-				length -= 4;
-				break;
-			}
-				// constant pool index 8bit
-			case 8: {
-				byte byteValue = _script->readByte();
-				_stack.push(_constants[byteValue]);
-				debugC(kDebugActionScript, 1, "actionPush \"%s\"", _constants[byteValue].c_str());
-				length -= 1;
-				break;
-			}
-				// constant pool index 16bit
-			case 9: {
-				unsigned short shortValue = _script->readUint16LE();
-				_stack.push(_constants[shortValue]);
-				debugC(kDebugActionScript, 1, "actionPush \"%s\"", _constants[shortValue].c_str());
-				length -= 2;
+				_stack.push(v->literal);
 				break;
-			}
+
 			default:
-				throw Common::Exception("invalid type byte in actionscript");
+				_stack.push(v->literal);
+				break;
 		}
 	}
 }
 
-void ASBuffer::actionJump() {
-	unsigned short offset = _script->readUint16LE();
-
-	_script->seek(offset, Common::SeekableReadStream::kOriginCurrent);
-	_seeked = offset;
+void ASBuffer::actionJump(const Action &action, size_t &next) {
+	next = action.target;
 
-	debugC(kDebugActionScript, 1, "actionJump %d", offset);
+	debugC(kDebugActionScript, 1, "actionJump %u", (uint)action.target);
 }
 
-void ASBuffer::actionGetURL2(AVM &avm) {
-	Common::BitStream8MSB bitstream(_script);
-
-	byte sendVarsMethodId = bitstream.getBits(2);
-
-	byte reserved = bitstream.getBits(4);
-	assert(reserved == 0);
-
-	byte loadTargetFlag = bitstream.getBit();
-	byte loadVariablesFlag = bitstream.getBit();
-
+void ASBuffer::actionGetURL2(AVM &avm, const Action &action) {
 	Common::UString sendVarsMethod;
-	switch (sendVarsMethodId) {
+	switch (action.argument) {
 		case 1:
 			sendVarsMethod = "GET";
 			break;
@@ -663,66 +828,55 @@ void ASBuffer::actionGetURL2(AVM &avm) {
 	debugC(
 			kDebugActionScript,
 			1,
-			"actionGetURL2 %s %i %i",
-			sendVarsMethod.c_str(),
-			loadTargetFlag,
-			loadVariablesFlag
+			"actionGetURL2 %s",
+			sendVarsMethod.c_str()
 	);
 }
 
-void ASBuffer::actionDefineFunction() {
-	Common::UString functionName = readString();
+void ASBuffer::actionDefineFunction(const Action &action) {
+	_stack.push(ObjectPtr(new ScriptedFunction(action.function, _constants, false, false)));
 
-	uint16 numParams = _script->readUint16LE();
-	for (int i = 0; i < numParams; ++i) {
-		Common::UString param = readString();
-	}
-
-	uint16 codeSize = _script->readUint16LE();
-	_script->seek(codeSize, Common::SeekableReadStream::kOriginCurrent);
-
-	ASBuffer buffer(new Common::SeekableSubReadStream(_script, _script->pos(), _script->pos() + codeSize));
+	debugC(kDebugActionScript, 1, "actionDefineFunction %s", action.functionName.c_str());
+}
 
-	_stack.push(
-			ObjectPtr(
-					new ScriptedFunction(
-							new Common::SeekableSubReadStream(_script, _script->pos(), _script->pos() + codeSize),
-							_constants, false, false
-					)
-			)
-	);
+void ASBuffer::actionIf(const Action &action, size_t &next) {
+	Variable variable = _stack.top();
+	_stack.pop();
 
-	_seeked = codeSize;
+	if (variable.asBoolean())
+		next = action.target;
 
-	debugC(
-			kDebugActionScript,
-			1,
-			"actionDefineFunction %s",
-			functionName.c_str()
-	);
+	debugC(kDebugActionScript, 1, "actionIf %u", (uint)action.target);
 }
 
-void ASBuffer::actionIf() {
-	short branchOffset = _script->readSint16LE();
+Variable &ASBuffer::getMember(MemberCache &cache, const ObjectPtr &object, const Common::UString &name,
+                              bool write) {
+	/* The owner comparison is true for the very same object only. An expired
+	 * object keeps its weak count, so no new object can ever compare equal. */
+	if (cache.member && !cache.object.owner_before(object) && !object.owner_before(cache.object) &&
+	    cache.name == name)
+		return *cache.member;
 
-	Variable variable = _stack.top();
-	_stack.pop();
+	// Reading a member that doesn't exist yet creates it as an object
+	if (!write && !object->hasMember(name))
+		object->setMember(name, ObjectPtr(new Object));
 
-	if (variable.asBoolean()) {
-		_script->seek(branchOffset, Common::SeekableReadStream::kOriginCurrent);
-		_seeked = branchOffset;
-	}
+	Variable &member = object->getMemberStorage(name);
+
+	cache.object = object;
+	cache.name   = name;
+	cache.member = &member;
 
-	debugC(kDebugActionScript, 1, "actionIf %i", branchOffset);
+	return member;
 }
 
-Common::UString ASBuffer::readString() {
+Common::UString ASBuffer::readString(Common::SeekableReadStream &script) {
 	Common::UString string;
 
-	uint32 character = _script->readChar();
+	uint32 character = script.readChar();
 	while (character != 0) {
 		string += character;
-		character = _script->readChar();
+		character = script.readChar();
 	}
 	return string;
 }
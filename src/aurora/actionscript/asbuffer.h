@@ -25,30 +25,95 @@
 #ifndef AURORA_ACTIONSCRIPT_ASBUFFER_H
 #define AURORA_ACTIONSCRIPT_ASBUFFER_H
 
+#include <vector>
 #include <stack>
 
-#include <boost/any.hpp>
-#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
 
-#include "src/common/readstream.h"
-#include "src/common/scopedptr.h"
+#include "src/common/types.h"
+#include "src/common/ustring.h"
 
 #include "src/aurora/actionscript/avm.h"
 #include "src/aurora/actionscript/object.h"
 
+namespace Common {
+	class SeekableReadStream;
+}
+
 namespace Aurora {
 
 namespace ActionScript {
 
 class Variable;
 
+/** A buffer of ActionScript actions.
+ *
+ *  The byte code is decoded once, into a list of actions with all their
+ *  arguments already read, branch offsets resolved to action indices and
+ *  strings turned into variables. Running the buffer only walks that list.
+ */
 class ASBuffer {
 public:
+	struct Action;
+
+	/** A list of decoded actions, shared by all functions defined at the same place. */
+	typedef boost::shared_ptr<std::vector<Action> > ActionList;
+	/** A constant pool, shared by all functions defined with it. */
+	typedef boost::shared_ptr<const std::vector<Variable> > ConstantPool;
+
+	/** Decode the actions found in this stream. The stream is not taken over. */
 	ASBuffer(Common::SeekableReadStream *as);
+	/** Run already decoded actions, with this constant pool. */
+	ASBuffer(const ActionList &actions, const ConstantPool &constants);
 
 	void run(AVM &avm);
 
-	void setConstantPool(std::vector<Common::UString> constantPool);
+private:
+	/** A value pushed by an ActionPush. */
+	struct PushValue {
+		byte type;        ///< The original value type in the byte code.
+		uint16 index;     ///< The register or constant pool index.
+		Variable literal; ///< The value itself, for all other types.
+
+		PushValue();
+	};
+
+	/** An inline cache of the last member looked up by an action. */
+	struct MemberCache {
+		boost::weak_ptr<Object> object;
+		Common::UString name;
+		Variable *member;
+
+		MemberCache();
+	};
+
+public:
+	/** A decoded action. */
+	struct Action {
+		byte opcode;
+
+		/** The register for StoreRegister, or the method for GetURL2. */
+		byte argument;
+		/** The index of the branch target for Jump and If. */
+		size_t target;
+
+		/** The values to push for Push. */
+		std::vector<PushValue> values;
+		/** The new pool for ConstantPool. */
+		ConstantPool constants;
+
+		/** The function body for DefineFunction and DefineFunction2. */
+		ActionList function;
+		Common::UString functionName;
+		bool preloadThisFlag;
+		bool preloadSuperFlag;
+
+		/** The member cache for GetMember, SetMember and CallMethod. */
+		MemberCache cache;
+
+		Action(byte op);
+	};
 
 private:
 	void execute(AVM &avm);
@@ -75,35 +140,45 @@ private:
 	void actionEquals2();
 	void actionToNumber2();
 	void actionPushDuplicate();
-	void actionGetMember();
-	void actionSetMember();
+	void actionGetMember(Action &action);
+	void actionSetMember(Action &action);
 	void actionIncrement();
-	void actionCallMethod(AVM &avm);
+	void actionCallMethod(AVM &avm, Action &action);
 	void actionEnumerate2();
 	void actionExtends();
-	void actionStoreRegister(AVM &avm);
-	void actionConstantPool();
-	void actionDefineFunction2();
-	void actionPush(AVM &avm);
-	void actionJump();
-	void actionGetURL2(AVM &avm);
-	void actionDefineFunction();
-	void actionIf();
-
-	// Utility methods and variables.
-	Common::UString readString();
-
-	unsigned int _currentLength;
-	unsigned int _seeked;
+	void actionStoreRegister(AVM &avm, const Action &action);
+	void actionConstantPool(const Action &action);
+	void actionDefineFunction2(const Action &action);
+	void actionPush(AVM &avm, const Action &action);
+	void actionJump(const Action &action, size_t &next);
+	void actionGetURL2(AVM &avm, const Action &action);
+	void actionDefineFunction(const Action &action);
+	void actionIf(const Action &action, size_t &next);
+
+	/** Look up a member of an object, going through the action's inline cache. */
+	static Variable &getMember(MemberCache &cache, const ObjectPtr &object, const Common::UString &name,
+	                           bool write);
+
+	// Decoding methods.
+	static ActionList decode(Common::SeekableReadStream &script);
+
+	static void decodeConstantPool(Common::SeekableReadStream &script, Action &action);
+	static uint16 decodeDefineFunction2(Common::SeekableReadStream &script, Action &action);
+	static uint16 decodeDefineFunction(Common::SeekableReadStream &script, Action &action);
+	static void decodePush(Common::SeekableReadStream &script, Action &action, uint16 length);
+	static void decodeGetURL2(Common::SeekableReadStream &script, Action &action);
+	static ActionList decodeFunctionBody(Common::SeekableReadStream &script, uint16 codeSize);
+
+	static Common::UString readString(Common::SeekableReadStream &script);
+
+	// The decoded actions.
+	ActionList _actions;
 
 	// Constant pool.
-	std::vector<Common::UString> _constants;
+	ConstantPool _constants;
 
 	// Execution stack.
 	std::stack<Variable> _stack;
-
-	// The script data.
-	Common::SeekableReadStream *_script;
 };
 
 } // End of namespace ActionScript
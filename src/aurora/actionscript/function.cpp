@@ -39,14 +39,12 @@ bool Function::getPreloadSuperFlag() {
 	return _preloadSuperFlag;
 }
 
-ScriptedFunction::ScriptedFunction(Common::SeekableReadStream *as, std::vector<Common::UString> constants,
+ScriptedFunction::ScriptedFunction(const ASBuffer::ActionList &actions, const ASBuffer::ConstantPool &constants,
                                    bool preloadThisFlag, bool preloadSuperFlag) :
-	Function(preloadThisFlag, preloadSuperFlag), _stream(as), _buffer(as) {
-	_buffer.setConstantPool(constants);
+	Function(preloadThisFlag, preloadSuperFlag), _buffer(actions, constants) {
 }
 
 ScriptedFunction::~ScriptedFunction() {
-	delete _stream;
 }
 
 Variable ScriptedFunction::operator()(AVM &avm) {
@@ -55,8 +55,8 @@ private:
 class ScriptedFunction : public Function {
 public:
 	ScriptedFunction(
-			Common::SeekableReadStream *as,
-			std::vector<Common::UString> constantPool,
+			const ASBuffer::ActionList &actions,
+			const ASBuffer::ConstantPool &constantPool,
 			bool preloadThisFlag,
 			bool preloadSuperFlag
 	);
@@ -65,7 +65,6 @@ public:
 	Variable operator()(AVM &avm);
 
 private:
-	Common::SeekableReadStream *_stream;
 	ASBuffer _buffer;
 };
 
@@ -44,24 +44,27 @@ Object::Object(Object *object) {
 Object::~Object() {
 }
 
-bool Object::hasMember(Common::UString id) {
+bool Object::hasMember(const Common::UString &id) {
 	return _members.find(id) != _members.end();
 }
 
-Variable Object::getMember(Common::UString id) {
-	if (_members.find(id) != _members.end())
-		return _members[id];
-	else {
-		_members.insert(std::make_pair(id, ObjectPtr(new Object)));
-		return _members[id];
-	}
+Variable Object::getMember(const Common::UString &id) {
+	std::map<Common::UString, Variable>::iterator member = _members.find(id);
+	if (member == _members.end())
+		member = _members.insert(std::make_pair(id, Variable(ObjectPtr(new Object)))).first;
+
+	return member->second;
 }
 
-void Object::setMember(Common::UString id, Variable member) {
+void Object::setMember(const Common::UString &id, const Variable &member) {
 	_members[id] = member;
 }
 
-Variable Object::call(Common::UString function, AVM &avm) {
+Variable &Object::getMemberStorage(const Common::UString &id) {
+	return _members[id];
+}
+
+Variable Object::call(const Common::UString &function, AVM &avm) {
 	if (!hasMember(function))
 		throw Common::Exception("object has no member %s", function.c_str());
 
@@ -50,12 +50,17 @@ public:
 	Object(Object *object);
 	virtual ~Object();
 
-	bool hasMember(Common::UString);
+	bool hasMember(const Common::UString &id);
 
-	Variable getMember(Common::UString);
-	void setMember(Common::UString, Variable);
+	Variable getMember(const Common::UString &id);
+	void setMember(const Common::UString &id, const Variable &member);
 
-	Variable call(Common::UString, AVM &avm);
+	/** Return the storage of a member, adding it as undefined if it doesn't exist yet.
+	 *  The reference stays valid for as long as this object exists.
+	 */
+	Variable &getMemberStorage(const Common::UString &id);
+
+	Variable call(const Common::UString &function, AVM &avm);
 
 private:
 	std::map<Common::UString, Variable> _members;
@@ -64,9 +64,11 @@ void GFF3File::Header::read(Common::SeekableReadStream &gff3) {
 
 
 GFF3File::GFF3File(Common::SeekableReadStream *gff3, uint32 id, bool repairNWNPremium) :
-	_stream(gff3), _repairNWNPremium(repairNWNPremium), _offsetCorrection(0) {
+	_repairNWNPremium(repairNWNPremium), _offsetCorrection(0) {
+
+	assert(gff3);
 
-	assert(_stream);
+	_stream.reset(Common::makeMemoryBacked(gff3));
 
 	load(id);
 }
@@ -74,10 +76,12 @@ GFF3File::GFF3File(Common::SeekableReadStream *gff3, uint32 id, bool repairNWNPr
 GFF3File::GFF3File(const Common::UString &gff3, FileType type, uint32 id, bool repairNWNPremium) :
 	_repairNWNPremium(repairNWNPremium), _offsetCorrection(0) {
 
-	_stream.reset(ResMan.getResource(gff3, type));
-	if (!_stream)
+	Common::SeekableReadStream *stream = ResMan.getResource(gff3, type);
+	if (!stream)
 		throw Common::Exception("No such GFF3 \"%s\"", TypeMan.setFileType(gff3, type).c_str());
 
+	_stream.reset(Common::makeMemoryBacked(stream));
+
 	load(id);
 }
 
@@ -204,13 +208,13 @@ void GFF3File::loadLists() {
 	 * list of lists into a list index.
 	 */
 
-	_stream->seek(_header.listIndicesOffset);
+	Common::MemoryReadCursor data = getCursor(_header.listIndicesOffset);
 
 	// Read list array
 	std::vector<uint32> rawLists;
 	rawLists.resize(_header.listIndicesCount / 4);
 	for (std::vector<uint32>::iterator it = rawLists.begin(); it != rawLists.end(); ++it)
-		*it = _stream->readUint32LE();
+		*it = data.readUint32LE();
 
 	// Counting the actual amount of lists
 	uint32 listCount = 0;
@@ -282,6 +286,13 @@ Common::SeekableReadStream &GFF3File::getFieldData() const {
 	return getStream(_header.fieldDataOffset);
 }
 
+Common::MemoryReadCursor GFF3File::getCursor(uint32 offset) const {
+	Common::MemoryReadCursor cursor = _stream->getCursor();
+	cursor.seek(offset);
+
+	return cursor;
+}
+
 
 GFF3Struct::Field::Field() : type(kFieldTypeNone), data(0), extended(false) {
 }
@@ -315,7 +326,7 @@ uint32 GFF3Struct::getID() const {
 // --- Loader ---
 
 void GFF3Struct::load(uint32 offset) {
-	Common::SeekableReadStream &data = _parent->getStream(offset);
+	Common::MemoryReadCursor data = _parent->getCursor(offset);
 
 	_id         = data.readUint32LE();
 	_fieldIndex = data.readUint32LE();
@@ -328,7 +339,7 @@ void GFF3Struct::load(uint32 offset) {
 		readFields(data, _fieldIndex, _fieldCount);
 }
 
-void GFF3Struct::readField(Common::SeekableReadStream &data, uint32 index) {
+void GFF3Struct::readField(Common::MemoryReadCursor &data, uint32 index) {
 	// Sanity check
 	if (index > _parent->_header.fieldCount)
 		throw Common::Exception("GFF3: Field index out of range (%d/%d)",
@@ -351,7 +362,7 @@ void GFF3Struct::readField(Common::SeekableReadStream &data, uint32 index) {
 	_fieldNames.push_back(fieldName);
 }
 
-void GFF3Struct::readFields(Common::SeekableReadStream &data, uint32 index, uint32 count) {
+void GFF3Struct::readFields(Common::MemoryReadCursor &data, uint32 index, uint32 count) {
 	// Sanity check
 	if (index > _parent->_header.fieldIndicesCount)
 		throw Common::Exception("GFF3: Field indices index out of range (%d/%d)",
@@ -369,17 +380,19 @@ void GFF3Struct::readFields(Common::SeekableReadStream &data, uint32 index, uint
 		readField(data, *i);
 }
 
-void GFF3Struct::readIndices(Common::SeekableReadStream &data,
+void GFF3Struct::readIndices(Common::MemoryReadCursor &data,
                              std::vector<uint32> &indices, uint32 count) const {
 	indices.reserve(count);
 	while (count-- > 0)
 		indices.push_back(data.readUint32LE());
 }
 
-Common::UString GFF3Struct::readLabel(Common::SeekableReadStream &data, uint32 index) const {
+Common::UString GFF3Struct::readLabel(Common::MemoryReadCursor &data, uint32 index) const {
 	data.seek(_parent->_header.labelOffset + index * 16);
 
-	return Common::readStringFixed(data, Common::kEncodingASCII, 16);
+	const size_t length = MIN<size_t>(data.remaining(), 16);
+
+	return Common::readString(data.getData() + data.pos(), length, Common::kEncodingASCII);
 }
 
 Common::SeekableReadStream &GFF3Struct::getData(const Field &field) const {
@@ -40,6 +40,8 @@
 
 namespace Common {
 	class SeekableReadStream;
+	class MemoryReadStream;
+	class MemoryReadCursor;
 }
 
 namespace Aurora {
@@ -122,7 +124,7 @@ private:
 	typedef std::vector<GFF3List> ListArray;
 
 
-	Common::ScopedPtr<Common::SeekableReadStream> _stream;
+	Common::ScopedPtr<Common::MemoryReadStream> _stream;
 
 	Header _header; ///< The GFF3's header.
 
@@ -150,6 +152,8 @@ private:
 	Common::SeekableReadStream &getStream(uint32 offset) const;
 	/** Return the GFF3 stream seeked to the start of the field data. */
 	Common::SeekableReadStream &getFieldData() const;
+	/** Return a cursor over the GFF3 data, positioned at this offset. */
+	Common::MemoryReadCursor getCursor(uint32 offset) const;
 
 	/** Return a struct within the GFF3. */
 	const GFF3Struct &getStruct(uint32 i) const;
@@ -273,12 +277,12 @@ private:
 
 	void load(uint32 offset);
 
-	void readField  (Common::SeekableReadStream &data, uint32 index);
-	void readFields (Common::SeekableReadStream &data, uint32 index, uint32 count);
-	void readIndices(Common::SeekableReadStream &data,
+	void readField  (Common::MemoryReadCursor &data, uint32 index);
+	void readFields (Common::MemoryReadCursor &data, uint32 index, uint32 count);
+	void readIndices(Common::MemoryReadCursor &data,
 	                 std::vector<uint32> &indices, uint32 count) const;
 
-	Common::UString readLabel(Common::SeekableReadStream &data, uint32 index) const;
+	Common::UString readLabel(Common::MemoryReadCursor &data, uint32 index) const;
 	// '---
 
 	// .--- Field and field data accessors
@@ -46,6 +46,11 @@ namespace Aurora {
 
 namespace Lua {
 
+ScriptManager::CachedFunction::CachedFunction(const std::vector<Common::UString> &p, const FunctionRef &f) :
+	path(p), function(f) {
+
+}
+
 ScriptManager::ScriptManager() : _luaState(0), _regNestingLevel(0) {
 
 }
@@ -116,25 +121,9 @@ Variables ScriptManager::callFunction(const Common::UString &name, const Variabl
 	assert(!name.empty());
 	assert(_luaState && _regNestingLevel == 0);
 
-	std::vector<Common::UString> parts;
-	Common::UString::split(name, '.', parts);
-	if (parts.empty()) {
-		error("Lua call \"%s\" failed: bad name", name.c_str());
-		return Variables();
-	}
-
-	const Common::UString funcName = parts.back();
-	parts.pop_back();
-
-	if (parts.empty()) {
-		return getGlobalFunction(funcName).call(params);
-	}
-
-	TableRef table = getGlobalTable(parts[0]);
-	for (uint32 i = 1; i < parts.size(); ++i) {
-		table = table.getTableAt(parts[i]);
-	}
-	return table.getFunctionAt(funcName).call(params);
+	// Take a copy, since the called function might execute more code and drop the cache
+	const FunctionRef function = findFunction(name);
+	return function.call(params);
 }
 
 Variables ScriptManager::callFunction(const Common::UString &name) {
@@ -313,6 +302,8 @@ void ScriptManager::openLuaState() {
 }
 
 void ScriptManager::closeLuaState() {
+	_functionCache.clear();
+
 	if (_luaState) {
 		lua_close(_luaState);
 		_luaState = 0;
@@ -320,6 +311,63 @@ void ScriptManager::closeLuaState() {
 	_regNestingLevel = 0;
 }
 
+const FunctionRef &ScriptManager::findFunction(const Common::UString &name) {
+	FunctionCache::iterator cached = _functionCache.find(name);
+	if (cached != _functionCache.end()) {
+		// Lua code might have assigned something else to this name in the meantime
+		if (isCurrentFunction(cached->second)) {
+			return cached->second.function;
+		}
+
+		_functionCache.erase(cached);
+	}
+
+	std::vector<Common::UString> path;
+	Common::UString::split(name, '.', path);
+	if (path.empty()) {
+		throw Common::Exception("Lua call \"%s\" failed: bad name", name.c_str());
+	}
+
+	const FunctionRef function = resolveFunction(path);
+
+	cached = _functionCache.insert(std::make_pair(name, CachedFunction(path, function))).first;
+	return cached->second.function;
+}
+
+FunctionRef ScriptManager::resolveFunction(const std::vector<Common::UString> &path) const {
+	assert(!path.empty());
+
+	if (path.size() == 1) {
+		return getGlobalFunction(path[0]);
+	}
+
+	TableRef table = getGlobalTable(path[0]);
+	for (size_t i = 1; i < path.size() - 1; ++i) {
+		table = table.getTableAt(path[i]);
+	}
+
+	return table.getFunctionAt(path.back());
+}
+
+bool ScriptManager::isCurrentFunction(const CachedFunction &cached) const {
+	StackGuard guard(*_luaState);
+
+	// Look up the name again, without creating any references along the way
+	lua_getglobal(_luaState, cached.path[0].c_str());
+	for (size_t i = 1; i < cached.path.size(); ++i) {
+		if (!lua_istable(_luaState, -1)) {
+			return false;
+		}
+
+		lua_pushstring(_luaState, cached.path[i].c_str());
+		lua_gettable(_luaState, -2);
+		lua_remove(_luaState, -2);
+	}
+
+	lua_getref(_luaState, cached.function.getRef());
+	return lua_rawequal(_luaState, -1, -2) != 0;
+}
+
 void ScriptManager::requireDeclaredClass(const Common::UString &name) const {
 	assert(_luaState);
 
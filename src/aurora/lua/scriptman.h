@@ -29,11 +29,13 @@
 
 #include <set>
 #include <map>
+#include <vector>
 
 #include "src/common/singleton.h"
 #include "src/common/ustring.h"
 
 #include "src/aurora/lua/types.h"
+#include "src/aurora/lua/function.h"
 
 namespace Aurora {
 
@@ -61,6 +63,10 @@ public:
 	/** Call a Lua function.
 	 *  A "dot" syntax is used to call class methods or table functions.
 	 *  For example, callFunction("module.Class.method", params).
+	 *
+	 *  The resolved function is cached by name. Since any Lua code might
+	 *  assign something else to that name, the cached function is only
+	 *  used if it's still what the name currently refers to.
 	 */
 	Variables callFunction(const Common::UString &name, const Variables &params);
 	Variables callFunction(const Common::UString &name);
@@ -113,7 +119,16 @@ public:
 	void injectNewIndexMetaEventIntoTable(const TableRef& table);
 
 private:
+	/** A function resolved by callFunction(). */
+	struct CachedFunction {
+		std::vector<Common::UString> path; ///< The function's full name, split at the dots.
+		FunctionRef function;
+
+		CachedFunction(const std::vector<Common::UString> &p, const FunctionRef &f);
+	};
+
 	typedef std::map<void *, TableRef> ObjectLuaInstanceMap;
+	typedef std::map<Common::UString, CachedFunction> FunctionCache;
 
 	/** The Lua state. */
 	lua_State *_luaState;
@@ -124,11 +139,21 @@ private:
 
 	ObjectLuaInstanceMap _objectLuaInstances;
 
+	/** Functions already resolved by callFunction(), indexed by their full name. */
+	FunctionCache _functionCache;
+
 	/** Open and setup a new Lua state. */
 	void openLuaState();
 	/** Close the current Lua state. */
 	void closeLuaState();
 
+	/** Resolve a function name in "dot" syntax, using the function cache. */
+	const FunctionRef &findFunction(const Common::UString &name);
+	/** Resolve a function name, split at the dots. */
+	FunctionRef resolveFunction(const std::vector<Common::UString> &path) const;
+	/** Does the name of this cached function still refer to the same function? */
+	bool isCurrentFunction(const CachedFunction &cached) const;
+
 	/** Check whether a class with the given name was declared.
 	 *  Throw an exception if the check failed.
 	 */
@@ -91,6 +91,10 @@ void Stack::pushFunction(const FunctionRef &value) {
 	}
 }
 
+void Stack::pushRawUserType(void *value, const char *type) {
+	tolua_pushusertype(&_luaState, value, type);
+}
+
 void Stack::pushRawUserType(void *value, const Common::UString &type) {
 	tolua_pushusertype(&_luaState, value, type.c_str());
 }
@@ -159,6 +163,13 @@ Common::UString Stack::getStringAt(int index) const {
 	return lua_tostring(&_luaState, index);
 }
 
+const char *Stack::getRawStringAt(int index) const {
+	if (!isStringAt(index)) {
+		throw Common::Exception("Failed to get a string from the Lua stack (index: %d)", index);
+	}
+	return lua_tostring(&_luaState, index);
+}
+
 TableRef Stack::getTableAt(int index) const {
 	if (!isTableAt(index)) {
 		throw Common::Exception("Failed to get a table from the Lua stack (index: %d)", index);
@@ -173,15 +184,27 @@ FunctionRef Stack::getFunctionAt(int index) const {
 	return FunctionRef(_luaState, index);
 }
 
-void *Stack::getRawUserTypeAt(int index, const Common::UString &type) const {
+void *Stack::getRawUserTypeAt(int index) const {
+	if (!isUserTypeAt(index)) {
+		throw Common::Exception("Failed to get a usertype value from the Lua stack (index: %d)", index);
+	}
+
+	return tolua_tousertype(&_luaState, index, 0);
+}
+
+void *Stack::getRawUserTypeAt(int index, const char *type) const {
 	if (!isUserTypeAt(index, type)) {
 		const char *msg = "Failed to get a usertype value from the Lua stack (type: %s, index: %d)";
-		throw Common::Exception(msg, type.c_str(), index);
+		throw Common::Exception(msg, type, index);
 	}
 
 	return tolua_tousertype(&_luaState, index, 0);
 }
 
+void *Stack::getRawUserTypeAt(int index, const Common::UString &type) const {
+	return getRawUserTypeAt(index, type.c_str());
+}
+
 Variable Stack::getVariableAt(int index) const {
 	switch (getTypeAt(index)) {
 		case kTypeNil:
@@ -284,13 +307,21 @@ bool Stack::isFunctionAt(int index) const {
 	return checkIndex(index) && lua_isfunction(&_luaState, index);
 }
 
-bool Stack::isUserTypeAt(int index, const Common::UString &type) const {
-	if (type.empty()) {
-		return getTypeAt(index) == kTypeUserType;
+bool Stack::isUserTypeAt(int index) const {
+	return checkIndex(index) && lua_type(&_luaState, index) == LUA_TUSERDATA;
+}
+
+bool Stack::isUserTypeAt(int index, const char *type) const {
+	if (!type || !*type) {
+		return isUserTypeAt(index);
 	}
 
 	tolua_Error error;
-	return checkIndex(index) && tolua_isusertype(&_luaState, index, type.c_str(), 0, &error) != 0;
+	return checkIndex(index) && tolua_isusertype(&_luaState, index, type, 0, &error) != 0;
+}
+
+bool Stack::isUserTypeAt(int index, const Common::UString &type) const {
+	return isUserTypeAt(index, type.c_str());
 }
 
 void Stack::registerGCForTopObject() {
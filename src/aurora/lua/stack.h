@@ -63,6 +63,8 @@ public:
 	/** Push a function onto the stack. */
 	void pushFunction(const FunctionRef &value);
 	/** Push a raw usertype value onto the stack. */
+	void pushRawUserType(void *value, const char *type);
+	/** Push a raw usertype value onto the stack. */
 	void pushRawUserType(void *value, const Common::UString &type);
 
 	void pushVariable(const Variable &var);
@@ -72,6 +74,8 @@ public:
 	 *  Expect that @a type is a name of the registered type in the script subsystem.
 	 */
 	template<typename T>
+	void pushUserType(T &value, const char *type);
+	template<typename T>
 	void pushUserType(T &value, const Common::UString &type);
 
 	/** Return a boolean value at the given @a index in the stack. */
@@ -82,18 +86,31 @@ public:
 	int getIntAt(int index) const;
 	/** Return a string at the given @a index in the stack. */
 	Common::UString getStringAt(int index) const;
+	/** Return a raw C string at the given @a index in the stack.
+	 *  The string is owned by Lua and only valid while the value stays on the stack.
+	 */
+	const char *getRawStringAt(int index) const;
 	/** Return a table at the given @a index in the stack. */
 	TableRef getTableAt(int index) const;
 	/** Return a function at the given @a index in the stack. */
 	FunctionRef getFunctionAt(int index) const;
 	/** Return a raw usertype value at the given @a index in the stack. */
-	void *getRawUserTypeAt(int index, const Common::UString &type = "") const;
+	void *getRawUserTypeAt(int index) const;
+	/** Return a raw usertype value of the given @a type at the given @a index in the stack. */
+	void *getRawUserTypeAt(int index, const char *type) const;
+	/** Return a raw usertype value of the given @a type at the given @a index in the stack. */
+	void *getRawUserTypeAt(int index, const Common::UString &type) const;
 
+	/** Return a usertype value at the given @a index in the stack. */
+	template<typename T>
+	T *getUserTypeAt(int index) const;
 	/** Return a usertype value at the given @a index in the stack.
 	 *  If @a type is not empty, perform a type check.
 	 */
 	template<typename T>
-	T *getUserTypeAt(int index, const Common::UString &type = "") const;
+	T *getUserTypeAt(int index, const char *type) const;
+	template<typename T>
+	T *getUserTypeAt(int index, const Common::UString &type) const;
 
 	Variable getVariableAt(int index) const;
 
@@ -116,10 +133,13 @@ public:
 	bool isTableAt(int index) const;
 	/** Check whether the value at the given @a index is a function. */
 	bool isFunctionAt(int index) const;
+	/** Check whether the value at the given @a index is a usertype value. */
+	bool isUserTypeAt(int index) const;
 	/** Check whether the value at the given @a index is a usertype value.
 	 *  If @a type is not empty, perform a type check.
 	 */
-	bool isUserTypeAt(int index, const Common::UString &type = "") const;
+	bool isUserTypeAt(int index, const char *type) const;
+	bool isUserTypeAt(int index, const Common::UString &type) const;
 
 	void registerGCForTopObject();
 
@@ -135,15 +155,30 @@ private:
 };
 
 template<typename T>
-void Stack::pushUserType(T &value, const Common::UString &type) {
+void Stack::pushUserType(T &value, const char *type) {
 	return pushRawUserType(&value, type);
 }
 
 template<typename T>
-T *Stack::getUserTypeAt(int index, const Common::UString &type) const {
+void Stack::pushUserType(T &value, const Common::UString &type) {
+	return pushRawUserType(&value, type.c_str());
+}
+
+template<typename T>
+T *Stack::getUserTypeAt(int index) const {
+	return reinterpret_cast<T *>(getRawUserTypeAt(index));
+}
+
+template<typename T>
+T *Stack::getUserTypeAt(int index, const char *type) const {
 	return reinterpret_cast<T *>(getRawUserTypeAt(index, type));
 }
 
+template<typename T>
+T *Stack::getUserTypeAt(int index, const Common::UString &type) const {
+	return reinterpret_cast<T *>(getRawUserTypeAt(index, type.c_str()));
+}
+
 } // End of namespace Lua
 
 } // End of namespace Aurora
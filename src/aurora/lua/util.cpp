@@ -22,8 +22,11 @@
  *  Lua helpers.
  */
 
+#include "toluapp/tolua++.h"
+
 #include "src/aurora/lua/util.h"
 #include "src/aurora/lua/stack.h"
+#include "src/aurora/lua/stackguard.h"
 #include "src/aurora/lua/variable.h"
 #include "src/aurora/lua/table.h"
 
@@ -34,10 +37,16 @@ namespace Lua {
 void *getRawCppObjectFromStack(const Stack &stack, int index) {
 	switch (stack.getTypeAt(index)) {
 		case Aurora::Lua::kTypeTable: {
-			TableRef instance = stack.getTableAt(index);
-			instance.setMetaAccessEnabled(false);
-			if (instance.isUserTypeAt("CPP_instance")) {
-				return instance.getRawUserTypeAt("CPP_instance");
+			// Look up the instance directly, without taking a table reference
+			lua_State &state = stack.getLuaState();
+			StackGuard guard(state);
+
+			const int tableIndex = index < 0 ? lua_gettop(&state) + index + 1 : index;
+
+			lua_pushstring(&state, "CPP_instance");
+			lua_rawget(&state, tableIndex);
+			if (lua_type(&state, -1) == LUA_TUSERDATA) {
+				return tolua_tousertype(&state, -1, 0);
 			}
 		}
 		XOREOS_FALLTHROUGH;
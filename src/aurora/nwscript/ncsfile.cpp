@@ -274,13 +274,15 @@ void NCSFile::setupOpcodes() {
 
 #undef OPCODE
 
-NCSFile::NCSFile(Common::SeekableReadStream *ncs) : _script(ncs), _owner(0), _triggerer(0) {
+NCSFile::NCSFile(Common::SeekableReadStream *ncs) : _script(ncs), _owner(0), _triggerer(0),
+	_running(false), _instructionCount(0) {
 	assert(_script);
 
 	load();
 }
 
-NCSFile::NCSFile(const Common::UString &ncs) : _name(ncs), _owner(0), _triggerer(0) {
+NCSFile::NCSFile(const Common::UString &ncs) : _name(ncs), _owner(0), _triggerer(0),
+	_running(false), _instructionCount(0) {
 	_script.reset(ResMan.getResource(ncs, kFileTypeNCS));
 	if (!_script)
 		throw Common::Exception("No such NCS \"%s\"", ncs.c_str());
@@ -344,6 +346,9 @@ void NCSFile::reset() {
 	_storedState.setType(kTypeVoid);
 	_return.setType(kTypeVoid);
 
+	_running          = false;
+	_instructionCount = 0;
+
 	_script->seek(13); // 8 byte header + 5 byte program size dummy op
 }
 
@@ -352,6 +357,15 @@ const Variable &NCSFile::run(Object *owner, Object *triggerer) {
 }
 
 const Variable &NCSFile::run(const ScriptState &state, Object *owner, Object *triggerer) {
+	start(state, owner, triggerer);
+
+	while (executeStep())
+		;
+
+	return finish();
+}
+
+void NCSFile::start(const ScriptState &state, Object *owner, Object *triggerer) {
 	debugC(kDebugScripts, 1, "=== Running script \"%s\" (%d) ===",
 	       _name.c_str(), state.offset);
 
@@ -370,16 +384,49 @@ const Variable &NCSFile::run(const ScriptState &state, Object *owner, Object *tr
 	for (var = state.locals.rbegin(); var != state.locals.rend(); ++var)
 		_stack.push(*var);
 
-	return execute(owner, triggerer);
-}
-
-const Variable &NCSFile::execute(Object *owner, Object *triggerer) {
 	_owner     = owner;
 	_triggerer = triggerer;
 
-	while (executeStep())
-		;
+	_running = true;
+}
+
+bool NCSFile::resume(size_t &budget) {
+	if (!_running)
+		return true;
+
+	try {
+		while (budget > 0) {
+			budget--;
+
+			if (!executeStep()) {
+				finish();
+				return true;
+			}
+		}
+	} catch (...) {
+		_running   = false;
+		_owner     = 0;
+		_triggerer = 0;
+
+		throw;
+	}
+
+	return false;
+}
+
+bool NCSFile::isRunning() const {
+	return _running;
+}
 
+const Variable &NCSFile::getReturn() const {
+	return _return;
+}
+
+size_t NCSFile::getInstructionCount() const {
+	return _instructionCount;
+}
+
+const Variable &NCSFile::finish() {
 	if (!_stack.empty())
 		_return = _stack.top();
 
@@ -387,9 +434,14 @@ const Variable &NCSFile::execute(Object *owner, Object *triggerer) {
 		debugC(kDebugScripts, 1, "=> Script\"%s\" returns: %d",
 		       _name.c_str(), _stack.top().getInt());
 
+	debugC(kDebugScripts, 2, "=> Script \"%s\" executed %u instructions",
+	       _name.c_str(), (uint)_instructionCount);
+
 	_owner     = 0;
 	_triggerer = 0;
 
+	_running = false;
+
 	return _return;
 }
 
@@ -408,6 +460,8 @@ bool NCSFile::executeStep() {
 
 	debugC(kDebugScripts, 1, "NWScript opcode %s [0x%02X]", _opcodes[opcode].desc, opcode);
 
+	_instructionCount++;
+
 	(this->*(_opcodes[opcode].proc))((InstructionType)type);
 
 	_stack.print();
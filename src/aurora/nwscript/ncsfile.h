@@ -107,6 +107,27 @@ public:
 	/** Run the current script, from this state to finish. */
 	const Variable &run(const ScriptState &state, Object *owner = 0, Object *triggerer = 0);
 
+	/** Prepare a time-sliced run of the script, from this state.
+	 *
+	 *  The script is then executed piecewise by calling resume().
+	 */
+	void start(const ScriptState &state, Object *owner = 0, Object *triggerer = 0);
+	/** Continue a time-sliced run of the script.
+	 *
+	 *  @param  budget The maximum number of instructions to execute. Will be
+	 *                 decreased by the number of instructions actually executed.
+	 *  @return true if the script has finished, false if it ran out of budget.
+	 */
+	bool resume(size_t &budget);
+
+	/** Is the script in the middle of a time-sliced run? */
+	bool isRunning() const;
+
+	/** Return the value the last finished run of the script returned. */
+	const Variable &getReturn() const;
+	/** Return the number of instructions executed in the current or last run. */
+	size_t getInstructionCount() const;
+
 	static ScriptState getEmptyState();
 
 private:
@@ -168,6 +189,9 @@ private:
 	Object *_owner;
 	Object *_triggerer;
 
+	bool _running;
+	size_t _instructionCount;
+
 	VariableContainer _env;
 
 	std::stack<uint32> _returnOffsets;
@@ -188,7 +212,8 @@ private:
 	/** Reset the script for another execution. */
 	void reset();
 
-	const Variable &execute(Object *owner = 0, Object *triggerer = 0);
+	/** Finish a run, collecting the return value. */
+	const Variable &finish();
 
 	/** Execute one script step. */
 	bool executeStep();
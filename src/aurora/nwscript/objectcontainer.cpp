@@ -46,33 +46,46 @@ void ObjectContainer::clearObjects() {
 	_objects.clear();
 	_objectsByID.clear();
 	_objectsByTag.clear();
+	_objectsByType.clear();
 }
 
-void ObjectContainer::addObject(Object &object) {
+void ObjectContainer::addObject(Object &object, uint32 type) {
 	Common::StackLock stackLock(_mutex);
 
 	assert(std::find(_objects.begin(), _objects.end(), &object) == _objects.end());
 
 	_objects.push_back(&object);
 	_objectsByID.insert(std::make_pair(object.getID(), &object));
-	_objectsByTag.insert(std::make_pair(object.getTag(), &object));
+	_objectsByTag[Common::InternedString(object.getTag())].push_back(&object);
+	_objectsByType[type].push_back(&object);
 }
 
-void ObjectContainer::removeObject(Object &object) {
+void ObjectContainer::removeObject(Object &object, uint32 type) {
 	Common::StackLock stackLock(_mutex);
 
-	_objects.remove(&object);
+	removeFromList(_objects, object);
 	_objectsByID.erase(object.getID());
 
-	std::pair<ObjectTagMap::iterator, ObjectTagMap::iterator> tag =
-		_objectsByTag.equal_range(object.getTag());
+	Common::InternedString tagString;
+	if (Common::InternedString::lookup(object.getTag(), tagString)) {
+		ObjectTagMap::iterator tag = _objectsByTag.find(tagString);
+		if (tag != _objectsByTag.end()) {
+			removeFromList(tag->second, object);
 
-	for (ObjectTagMap::iterator o = tag.first; o != tag.second; ++o) {
-		if (o->second == &object) {
-			_objectsByTag.erase(o);
-			break;
+			if (tag->second.empty())
+				_objectsByTag.erase(tag);
 		}
 	}
+
+	ObjectTypeMap::iterator objectType = _objectsByType.find(type);
+	if (objectType != _objectsByType.end())
+		removeFromList(objectType->second, object);
+}
+
+void ObjectContainer::removeFromList(ObjectList &list, Object &object) {
+	ObjectList::iterator o = std::find(list.begin(), list.end(), &object);
+	if (o != list.end())
+		list.erase(o);
 }
 
 Object *ObjectContainer::getObjectByID(uint32 id) const {
@@ -84,23 +97,40 @@ Object *ObjectContainer::getObjectByID(uint32 id) const {
 }
 
 Object *ObjectContainer::getFirstObject() const {
-	SearchList ctx(_objects);
-
-	return ctx.get();
+	return findObjects().get();
 }
 
 Object *ObjectContainer::getFirstObjectByTag(const Common::UString &tag) const {
-	SearchTagMap ctx(_objectsByTag, tag);
+	return findObjectsByTag(tag).get();
+}
 
-	return ctx.get();
+Object *ObjectContainer::getFirstObjectByType(uint32 type) const {
+	return findObjectsByType(type).get();
 }
 
-ObjectSearch *ObjectContainer::findObjects() const {
-	return new SearchList(_objects);
+ObjectSearch ObjectContainer::findObjects() const {
+	return ObjectSearch(_objects);
 }
 
-ObjectSearch *ObjectContainer::findObjectsByTag(const Common::UString &tag) const {
-	return new SearchTagMap(_objectsByTag, tag);
+ObjectSearch ObjectContainer::findObjectsByTag(const Common::UString &tag) const {
+	// A tag that was never interned can't have any objects
+	Common::InternedString tagString;
+	if (!Common::InternedString::lookup(tag, tagString))
+		return ObjectSearch();
+
+	ObjectTagMap::const_iterator objects = _objectsByTag.find(tagString);
+	if (objects == _objectsByTag.end())
+		return ObjectSearch();
+
+	return ObjectSearch(objects->second);
+}
+
+ObjectSearch ObjectContainer::findObjectsByType(uint32 type) const {
+	ObjectTypeMap::const_iterator objects = _objectsByType.find(type);
+	if (objects == _objectsByType.end())
+		return ObjectSearch();
+
+	return ObjectSearch(objects->second);
 }
 
 void ObjectContainer::lock() {
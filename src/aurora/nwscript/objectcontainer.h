@@ -25,10 +25,13 @@
 #ifndef AURORA_NWSCRIPT_OBJECTCONTAINER_H
 #define AURORA_NWSCRIPT_OBJECTCONTAINER_H
 
-#include <list>
+#include <vector>
 #include <map>
 
+#include <boost/unordered/unordered_map.hpp>
+
 #include "src/common/mutex.h"
+#include "src/common/internedstring.h"
 
 #include "src/aurora/nwscript/object.h"
 
@@ -36,67 +39,48 @@ namespace Aurora {
 
 namespace NWScript {
 
+/** A search context iterating over a range of objects.
+ *
+ *  An ObjectSearch is cheap to copy and meant to live on the stack. It
+ *  points directly into the container it came from, so it's only valid
+ *  as long as no objects are added to or removed from that container.
+ */
 class ObjectSearch {
 public:
-	ObjectSearch() { }
-	virtual ~ObjectSearch() { }
+	ObjectSearch() : _current(0), _end(0) { }
+	ObjectSearch(const std::vector<Object *> &objects) : _current(0), _end(0) {
+		if (!objects.empty()) {
+			_current = &objects[0];
+			_end     = _current + objects.size();
+		}
+	}
 
 	/** Return the current object in the search context. */
-	virtual Object *get()  = 0;
-	/** Move to the next object in the search context and return the previous one. */
-	virtual Object *next() = 0;
-};
-
-template<typename T> class SearchRange : public ObjectSearch {
-public:
-	typedef T type;
-	typedef typename T::const_iterator iterator;
-	typedef std::pair<iterator, iterator> range;
-
-	SearchRange(const range &r) : _range(r) { }
-	~SearchRange() { }
-
-	Object *get() {
-		if (_range.first == _range.second)
-			return 0;
-
-		return getObject(_range.first);
+	Object *get() const {
+		return (_current != _end) ? *_current : 0;
 	}
 
+	/** Move to the next object in the search context and return the previous one. */
 	Object *next() {
-		if (_range.first == _range.second)
-			return 0;
-
-		Object *object = getObject(_range.first);
-
-		++_range.first;
+		return (_current != _end) ? *_current++ : 0;
+	}
 
-		return object;
+	/** Return the number of objects left in the search context. */
+	size_t size() const {
+		return _end - _current;
 	}
 
-protected:
-	virtual Object *getObject(const iterator &t) = 0;
+	/** Are there no objects left in the search context? */
+	bool empty() const {
+		return _current == _end;
+	}
 
 private:
-	range _range;
-};
-
-class SearchList : public SearchRange< std::list<Object *> > {
-public:
-	SearchList(const type &l) : SearchRange<type>(std::make_pair(l.begin(), l.end())) { }
-	~SearchList() { }
-
-	Object *getObject(const iterator &t) { return *t; }
-};
-
-class SearchTagMap : public SearchRange< std::multimap<Common::UString, Object *> > {
-public:
-	SearchTagMap(const type &m, const Common::UString &tag) : SearchRange<type>(m.equal_range(tag)) { }
-	~SearchTagMap() { }
-
-	Object *getObject(const iterator &t) { return t->second; };
+	Object * const *_current;
+	Object * const *_end;
 };
 
+/** A container of NWScript objects, indexed by ID, tag and type. */
 class ObjectContainer {
 public:
 	ObjectContainer();
@@ -104,10 +88,10 @@ public:
 
 	void clearObjects();
 
-	/** Add an object to this container. */
-	void addObject(Object &object);
-	/** Remove an object from this container. */
-	void removeObject(Object &object);
+	/** Add an object of this engine-specific type to this container. */
+	void addObject(Object &object, uint32 type = 0);
+	/** Remove an object of this engine-specific type from this container. */
+	void removeObject(Object &object, uint32 type = 0);
 
 	/** Find a specific object by ID. */
 	Object *getObjectByID(uint32 id) const;
@@ -116,11 +100,15 @@ public:
 	Object *getFirstObject() const;
 	/** Return the first object with this tag. */
 	Object *getFirstObjectByTag(const Common::UString &tag) const;
+	/** Return the first object of this engine-specific type. */
+	Object *getFirstObjectByType(uint32 type) const;
 
 	/** Return a search context to iterate over all objects. */
-	ObjectSearch *findObjects() const;
+	ObjectSearch findObjects() const;
 	/** Return a search context to iterate over all objects with this tag. */
-	ObjectSearch *findObjectsByTag(const Common::UString &tag) const;
+	ObjectSearch findObjectsByTag(const Common::UString &tag) const;
+	/** Return a search context to iterate over all objects of this engine-specific type. */
+	ObjectSearch findObjectsByType(uint32 type) const;
 
 
 protected:
@@ -129,15 +117,22 @@ protected:
 
 
 private:
+	typedef std::vector<Object *> ObjectList;
+
 	typedef std::map<uint32, Object *> ObjectIDMap;
-	typedef SearchList::type ObjectList;
-	typedef SearchTagMap::type ObjectTagMap;
+	typedef std::map<uint32, ObjectList> ObjectTypeMap;
+
+	/** All objects sharing a tag. The tags are interned, so they're only stored once globally. */
+	typedef boost::unordered_map<Common::InternedString, ObjectList, Common::hashInternedString> ObjectTagMap;
 
 	Common::Mutex _mutex;
 
-	ObjectList   _objects;
-	ObjectIDMap  _objectsByID;
-	ObjectTagMap _objectsByTag;
+	ObjectList    _objects;
+	ObjectIDMap   _objectsByID;
+	ObjectTagMap  _objectsByTag;
+	ObjectTypeMap _objectsByType;
+
+	static void removeFromList(ObjectList &list, Object &object);
 };
 
 } // End of namespace NWScript
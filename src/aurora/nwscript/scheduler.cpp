@@ -0,0 +1,279 @@
+/* xoreos - A reimplementation of BioWare's Aurora engine
+ *
+ * xoreos is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * xoreos is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * xoreos is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with xoreos. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  A cooperative, time-sliced scheduler for NWScript executions.
+ */
+
+#include <limits>
+
+#include "src/common/util.h"
+#include "src/common/error.h"
+#include "src/common/debug.h"
+#include "src/common/configman.h"
+#include "src/common/frametimes.h"
+
+#include "src/aurora/types.h"
+
+#include "src/aurora/nwscript/scheduler.h"
+#include "src/aurora/nwscript/ncsfile.h"
+#include "src/aurora/nwscript/object.h"
+#include "src/aurora/nwscript/objectcontainer.h"
+
+using Common::kDebugScripts;
+
+namespace Aurora {
+
+namespace NWScript {
+
+const size_t ScriptScheduler::kDefaultBudget;
+
+ScriptScheduler::ScriptScheduler(ObjectContainer &objects, Object *module) :
+	_objects(&objects), _module(module), _jobCount(0) {
+
+	_budget = MAX(ConfigMan.getInt("scriptbudget", (int) kDefaultBudget), 1);
+
+	_owner     = createReference(0);
+	_triggerer = createReference(0);
+}
+
+ScriptScheduler::ScriptScheduler(ObjectContainer &objects, Object *module, size_t budget) :
+	_objects(&objects), _module(module), _budget(budget), _jobCount(0) {
+
+	_owner     = createReference(0);
+	_triggerer = createReference(0);
+}
+
+ScriptScheduler::~ScriptScheduler() {
+}
+
+size_t ScriptScheduler::getBudget() const {
+	return _budget;
+}
+
+void ScriptScheduler::setBudget(size_t budget) {
+	_budget = budget;
+}
+
+void ScriptScheduler::schedule(const Common::UString &script, Object *owner, Object *triggerer,
+                               uint32 timestamp) {
+
+	schedule(script, NCSFile::getEmptyState(), owner, triggerer, timestamp);
+}
+
+void ScriptScheduler::schedule(const Common::UString &script, const ScriptState &state,
+                               Object *owner, Object *triggerer, uint32 timestamp) {
+
+	if (script.empty())
+		return;
+
+	Batch &batch = _batches[timestamp];
+
+	batch.push_back(Job());
+
+	Job &job = batch.back();
+
+	job.script    = script;
+	job.state     = state;
+	job.owner     = createReference(owner);
+	job.triggerer = createReference(triggerer);
+
+	_jobCount++;
+}
+
+size_t ScriptScheduler::run(uint32 now) {
+	const size_t executed = execute(now, _budget);
+
+	if (executed >= _budget) {
+		const size_t backlog = getBacklog(now);
+		if (backlog > 0)
+			debugC(kDebugScripts, 1, "ScriptScheduler: Budget of %u instructions exhausted, "
+			       "%u scripts backlogged", (uint)_budget, (uint)backlog);
+	}
+
+	return executed;
+}
+
+size_t ScriptScheduler::runAll(uint32 now) {
+	return execute(now, std::numeric_limits<size_t>::max());
+}
+
+void ScriptScheduler::clear() {
+	_batches.clear();
+	_jobCount = 0;
+
+	unloadScript();
+}
+
+bool ScriptScheduler::empty() const {
+	return (_jobCount == 0) && (!_ncs || !_ncs->isRunning());
+}
+
+size_t ScriptScheduler::getBacklog(uint32 now) const {
+	size_t backlog = (_ncs && _ncs->isRunning()) ? 1 : 0;
+
+	for (BatchMap::const_iterator b = _batches.begin(); b != _batches.end(); ++b) {
+		if (b->first > now)
+			break;
+
+		backlog += b->second.size();
+	}
+
+	return backlog;
+}
+
+size_t ScriptScheduler::execute(uint32 now, size_t budget) {
+	Common::FrameTimer timer(FrameTimesMan, Common::kFramePhaseScripts);
+
+	const size_t startBudget = budget;
+
+	// Continue the script we had to suspend last time
+	if (!resumeJob(budget))
+		return startBudget - budget;
+
+	while (budget > 0) {
+		/* Scripts we run can schedule new jobs, so don't keep any
+		 * iterators into the batch map around while executing. */
+
+		if (_batches.empty() || (_batches.begin()->first > now))
+			break;
+
+		Batch &batch = _batches.begin()->second;
+		if (batch.empty()) {
+			_batches.erase(_batches.begin());
+			continue;
+		}
+
+		Job job = batch.front();
+
+		batch.pop_front();
+		if (batch.empty())
+			_batches.erase(_batches.begin());
+
+		_jobCount--;
+
+		if (!startJob(job))
+			continue;
+
+		if (!resumeJob(budget))
+			break;
+	}
+
+	return startBudget - budget;
+}
+
+bool ScriptScheduler::startJob(const Job &job) {
+	Object *owner = 0, *triggerer = 0;
+	if (!findObject(job.owner, owner) || !findObject(job.triggerer, triggerer)) {
+		debugC(kDebugScripts, 1, "ScriptScheduler: Dropping script \"%s\", its objects are gone",
+		       job.script.c_str());
+		return false;
+	}
+
+	try {
+		// Consecutive jobs of the same script can reuse the loaded NCS
+		if (!_ncs || (_ncsName != job.script)) {
+			unloadScript();
+
+			_ncs.reset(loadScript(job.script));
+			_ncsName = job.script;
+		} else
+			_ncs->getEnvironment().clearVariables();
+
+		_ncs->start(job.state, owner, triggerer);
+
+		_owner     = job.owner;
+		_triggerer = job.triggerer;
+
+	} catch (...) {
+		Common::exceptionDispatcherWarning("Failed running script \"%s\"", job.script.c_str());
+
+		unloadScript();
+		return false;
+	}
+
+	return true;
+}
+
+bool ScriptScheduler::resumeJob(size_t &budget) {
+	if (!_ncs || !_ncs->isRunning())
+		return true;
+
+	// The objects might have been destroyed while the script was suspended
+	Object *owner = 0, *triggerer = 0;
+	if (!findObject(_owner, owner) || !findObject(_triggerer, triggerer)) {
+		debugC(kDebugScripts, 1, "ScriptScheduler: Aborting script \"%s\", its objects are gone",
+		       _ncsName.c_str());
+
+		unloadScript();
+		return true;
+	}
+
+	try {
+		return _ncs->resume(budget);
+	} catch (...) {
+		Common::exceptionDispatcherWarning("Failed running script \"%s\"", _ncsName.c_str());
+
+		unloadScript();
+	}
+
+	return true;
+}
+
+NCSFile *ScriptScheduler::loadScript(const Common::UString &script) {
+	return new NCSFile(script);
+}
+
+void ScriptScheduler::unloadScript() {
+	_ncs.reset();
+	_ncsName.clear();
+
+	_owner     = createReference(0);
+	_triggerer = createReference(0);
+}
+
+bool ScriptScheduler::findObject(const ObjectReference &reference, Object *&object) const {
+	object = reference.object;
+
+	// No object at all, or one we can't look up
+	if (!object || (reference.id == kObjectIDInvalid))
+		return true;
+
+	// The module isn't part of its own container, but it outlives us anyway
+	if (object == _module)
+		return true;
+
+	object = _objects->getObjectByID(reference.id);
+
+	return object != 0;
+}
+
+ScriptScheduler::ObjectReference ScriptScheduler::createReference(Object *object) {
+	ObjectReference reference;
+
+	reference.object = object;
+	reference.id     = object ? object->getID() : kObjectIDInvalid;
+
+	return reference;
+}
+
+} // End of namespace NWScript
+
+} // End of namespace Aurora
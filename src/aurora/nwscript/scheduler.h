@@ -0,0 +1,170 @@
+/* xoreos - A reimplementation of BioWare's Aurora engine
+ *
+ * xoreos is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * xoreos is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * xoreos is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with xoreos. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  A cooperative, time-sliced scheduler for NWScript executions.
+ */
+
+#ifndef AURORA_NWSCRIPT_SCHEDULER_H
+#define AURORA_NWSCRIPT_SCHEDULER_H
+
+#include <list>
+#include <map>
+
+#include <boost/noncopyable.hpp>
+
+#include "src/common/types.h"
+#include "src/common/scopedptr.h"
+#include "src/common/ustring.h"
+
+#include "src/aurora/nwscript/variable.h"
+
+namespace Aurora {
+
+namespace NWScript {
+
+class Object;
+class ObjectContainer;
+class NCSFile;
+
+/** A scheduler running pending scripts under a per-update instruction budget.
+ *
+ *  Scripts, most notably the stored script states of DelayCommand() and
+ *  AssignCommand(), are queued with the timestamp they're due at. Scripts
+ *  due at the same timestamp are collected into one batch, and consecutive
+ *  scripts in a batch sharing the same NCS reuse the already loaded file.
+ *
+ *  Each call to run() executes at most the budgeted number of NCS
+ *  instructions. A script that runs out of budget is suspended and resumed
+ *  on the next call, so that a long-running script can't stall a frame.
+ *
+ *  The owner and triggerer of a queued or suspended script might be
+ *  destroyed before it runs. So the scheduler remembers their IDs and
+ *  looks them up in an object container again before starting or
+ *  resuming the script. If one of them is gone, the script is dropped.
+ *  Objects without an ID can't be looked up, and are used as they are.
+ */
+class ScriptScheduler : boost::noncopyable {
+public:
+	/** The number of instructions to execute per run() call, unless configured otherwise. */
+	static const size_t kDefaultBudget = 50000;
+
+	/** Create a scheduler with the budget set by the "scriptbudget" config option.
+	 *
+	 *  @param objects The container all objects scripts run on are part of.
+	 *  @param module  An object owning the container that outlives the scheduler,
+	 *                 like the module, which isn't in the container itself.
+	 */
+	ScriptScheduler(ObjectContainer &objects, Object *module = 0);
+	/** Create a scheduler with this budget. */
+	ScriptScheduler(ObjectContainer &objects, Object *module, size_t budget);
+	virtual ~ScriptScheduler();
+
+	/** Return the number of instructions executed per run() call. */
+	size_t getBudget() const;
+	/** Set the number of instructions executed per run() call. */
+	void setBudget(size_t budget);
+
+	/** Queue a script to be run from the beginning once the timestamp is reached. */
+	void schedule(const Common::UString &script, Object *owner, Object *triggerer,
+	              uint32 timestamp);
+	/** Queue a stored script state to be run once the timestamp is reached. */
+	void schedule(const Common::UString &script, const ScriptState &state,
+	              Object *owner, Object *triggerer, uint32 timestamp);
+
+	/** Run the scripts that are due, within the instruction budget.
+	 *
+	 *  @param  now The current timestamp.
+	 *  @return The number of instructions executed.
+	 */
+	size_t run(uint32 now);
+	/** Run all scripts that are due, ignoring the instruction budget. */
+	size_t runAll(uint32 now);
+
+	/** Drop all queued scripts, including a suspended one. */
+	void clear();
+
+	/** Are there no scripts queued at all? */
+	bool empty() const;
+
+	/** Return the number of scripts that are due, but haven't finished running yet. */
+	size_t getBacklog(uint32 now) const;
+
+protected:
+	/** Load a script by name. */
+	virtual NCSFile *loadScript(const Common::UString &script);
+
+private:
+	/** An object a script runs on, which might be destroyed while the script waits. */
+	struct ObjectReference {
+		Object *object; ///< The object. Only used directly if it has no ID.
+		uint32 id;      ///< The ID of the object.
+	};
+
+	/** A queued script execution. */
+	struct Job {
+		Common::UString script;
+
+		ScriptState state;
+
+		ObjectReference owner;
+		ObjectReference triggerer;
+	};
+
+	/** All jobs due at the same timestamp, in the order they were scheduled. */
+	typedef std::list<Job> Batch;
+	typedef std::map<uint32, Batch> BatchMap;
+
+	ObjectContainer *_objects;
+	Object *_module;
+
+	size_t _budget;
+
+	BatchMap _batches;
+	size_t _jobCount;
+
+	Common::UString _ncsName;           ///< The name of the currently loaded script.
+	Common::ScopedPtr<NCSFile> _ncs;    ///< The currently loaded script.
+
+	ObjectReference _owner;     ///< The owner of the currently running script.
+	ObjectReference _triggerer; ///< The triggerer of the currently running script.
+
+	/** Run due scripts until they're done or the budget is spent. */
+	size_t execute(uint32 now, size_t budget);
+
+	/** Load and start a job's script. */
+	bool startJob(const Job &job);
+	/** Continue executing the current script. */
+	bool resumeJob(size_t &budget);
+
+	/** Unload the current script. */
+	void unloadScript();
+
+	/** Look up a referenced object. Return false if it doesn't exist anymore. */
+	bool findObject(const ObjectReference &reference, Object *&object) const;
+
+	static ObjectReference createReference(Object *object);
+};
+
+} // End of namespace NWScript
+
+} // End of namespace Aurora
+
+#endif // AURORA_NWSCRIPT_SCHEDULER_H
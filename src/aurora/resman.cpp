@@ -172,6 +172,8 @@ ResourceManager::~ResourceManager() {
 }
 
 void ResourceManager::clear() {
+	Common::StackLock lock(_mutex);
+
 	_typeAliases.clear();
 
 	_hasSmall = false;
@@ -293,6 +295,7 @@ Common::SeekableReadStream *ResourceManager::openArchiveStream(const KnownArchiv
 
 void ResourceManager::indexArchive(const Common::UString &file, uint32 priority,
                                    const std::vector<byte> &password, Common::ChangeID *changeID) {
+	Common::StackLock lock(_mutex);
 
 	KnownArchive *knownArchive = findArchive(file);
 	if (!knownArchive)
@@ -466,6 +469,7 @@ bool ResourceManager::hasResourceDir(const Common::UString &dir) {
 
 void ResourceManager::indexResourceFile(const Common::UString &file, uint32 priority,
                                         Common::ChangeID *changeID) {
+	Common::StackLock lock(_mutex);
 
 	Common::UString path;
 	path = _baseDir.empty() ? file : (_baseDir + "/" + file);
@@ -483,6 +487,8 @@ void ResourceManager::indexResourceFile(const Common::UString &file, uint32 prio
 
 void ResourceManager::indexResourceDir(const Common::UString &dir, const char *glob, int depth,
                                        uint32 priority, Common::ChangeID *changeID) {
+	Common::StackLock lock(_mutex);
+
 	if (_baseDir.empty())
 		throw Common::Exception("No base data directory set");
 
@@ -514,6 +520,8 @@ void ResourceManager::indexResourceDir(const Common::UString &dir, const char *g
 }
 
 void ResourceManager::undo(Common::ChangeID &changeID) {
+	Common::StackLock lock(_mutex);
+
 	Change *change = dynamic_cast<Change *>(changeID.getContent());
 	if (!change || (change->_change == _changes.end()))
 		return;
@@ -593,10 +601,14 @@ void ResourceManager::undo(Common::ChangeID &changeID) {
 }
 
 void ResourceManager::addTypeAlias(FileType alias, FileType realType) {
+	Common::StackLock lock(_mutex);
+
 	_typeAliases[alias] = realType;
 }
 
 void ResourceManager::blacklist(const Common::UString &name, FileType type) {
+	Common::StackLock lock(_mutex);
+
 	ResourceMap::iterator resList = _resources.find(getHash(name, type));
 	if (resList == _resources.end())
 		return;
@@ -606,6 +618,8 @@ void ResourceManager::blacklist(const Common::UString &name, FileType type) {
 }
 
 void ResourceManager::declareResource(const Common::UString &name, FileType type) {
+	Common::StackLock lock(_mutex);
+
 	bool isSmall = false;
 
 	ResourceMap::iterator resList = _resources.find(getHash(name, type));
@@ -653,10 +667,14 @@ bool ResourceManager::hasResource(const Common::UString &name) const {
 }
 
 bool ResourceManager::hasResource(const Common::UString &name, const std::vector<FileType> &types) const {
+	Common::StackLock lock(_mutex);
+
 	return getRes(name, types) != 0;
 }
 
 bool ResourceManager::hasResource(uint64 hash) const {
+	Common::StackLock lock(_mutex);
+
 	return getRes(hash) != 0;
 }
 
@@ -680,6 +698,8 @@ Common::UString ResourceManager::findResourceFile(const Common::UString &name) c
 
 Common::UString ResourceManager::findResourceFile(const Common::UString &name,
                                                   const std::vector<FileType> &types) const {
+	Common::StackLock lock(_mutex);
+
 	const Resource *res = getRes(name, types);
 	if (res && (res->source == kSourceFile))
 		return res->path;
@@ -722,6 +742,7 @@ Common::SeekableReadStream *ResourceManager::getResource(const Common::UString &
 
 Common::SeekableReadStream *ResourceManager::getResource(const Common::UString &name,
 		const std::vector<FileType> &types, FileType *foundType) const {
+	Common::StackLock lock(_mutex);
 
 	const Resource *res = getRes(name, types);
 	if (!res)
@@ -735,6 +756,8 @@ Common::SeekableReadStream *ResourceManager::getResource(const Common::UString &
 }
 
 Common::SeekableReadStream *ResourceManager::getResource(uint64 hash, FileType *type) const {
+	Common::StackLock lock(_mutex);
+
 	const Resource *res = getRes(hash);
 	if (!res)
 		return 0;
@@ -750,9 +773,16 @@ Common::SeekableReadStream *ResourceManager::getResource(const Resource &res, bo
 	Common::SeekableReadStream *stream = 0;
 
 	switch (res.source) {
-		case kSourceFile:
-			stream = new Common::ReadFile(res.path);
+		case kSourceFile: {
+			Common::ReadFile *file = new Common::ReadFile(res.path);
+
+			// Archives are read in small chunks from all over the file
+			if (tryNoCopy)
+				file->setAccessHint(Common::ReadFile::kAccessRandom);
+
+			stream = file;
 			break;
+		}
 
 		case kSourceArchive:
 			stream = getArchiveResource(res, tryNoCopy);
@@ -786,6 +816,7 @@ Common::SeekableReadStream *ResourceManager::getResource(ResourceType resType,
 
 void ResourceManager::getAvailableResources(FileType type,
 		std::list<ResourceID> &list) const {
+	Common::StackLock lock(_mutex);
 
 	for (ResourceMap::const_iterator r = _resources.begin(); r != _resources.end(); ++r) {
 		if (!r->second.empty() && (r->second.front().type == type)) {
@@ -800,6 +831,7 @@ void ResourceManager::getAvailableResources(FileType type,
 
 void ResourceManager::getAvailableResources(const std::vector<FileType> &types,
 		std::list<ResourceID> &list) const {
+	Common::StackLock lock(_mutex);
 
 	for (ResourceMap::const_iterator r = _resources.begin(); r != _resources.end(); ++r) {
 		for (std::vector<FileType>::const_iterator t = types.begin(); t != types.end(); ++t) {
@@ -1037,6 +1069,8 @@ const ResourceManager::Resource *ResourceManager::getRes(const Common::UString &
 }
 
 void ResourceManager::dumpResourcesList(const Common::UString &fileName) const {
+	Common::StackLock lock(_mutex);
+
 	Common::WriteFile file;
 
 	if (!file.open(fileName))
@@ -36,6 +36,7 @@
 #include "src/common/filelist.h"
 #include "src/common/hash.h"
 #include "src/common/changeid.h"
+#include "src/common/mutex.h"
 
 #include "src/aurora/types.h"
 
@@ -51,6 +52,9 @@ class BIFFile;
 
 /** A resource manager holding information about and handling all request for all
  *  resources usable by the game.
+ *
+ *  Indexing and looking up resources is serialized by a mutex, so that the
+ *  texture streaming thread can read resources while the game is running.
  */
 class ResourceManager : public Common::Singleton<ResourceManager> {
 public:
@@ -490,6 +494,8 @@ private:
 	ResourceMap   _resources; ///< All currently known resources.
 	ChangeSetList _changes;   ///< Changes produced by indexing the currently known resources.
 
+	mutable Common::Mutex _mutex; ///< Protects the resources and the opened archives.
+
 	FileTypeSet  _archiveTypeTypes [kArchiveMAX];  ///< All valid archive types file types.
 	FileTypeList _resourceTypeTypes[kResourceMAX]; ///< All valid resource type file types.
 
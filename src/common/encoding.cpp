@@ -56,13 +56,161 @@ static const size_t kTerminatorLength  [kEncodingMAX] = {
 	1, 1, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1
 };
 
-/** A manager handling string encoding conversions. */
+/** Mask of the high bit in each byte of a 64-bit word. */
+static const uint64 kHighBits = UINT64_C(0x8080808080808080);
+
+/** Byte masks of the non-ASCII bits of four UTF-16 code units, little- and big-endian. */
+static const byte kUTF16HighBits[2][8] = {
+	{ 0x80, 0xFF, 0x80, 0xFF, 0x80, 0xFF, 0x80, 0xFF },
+	{ 0xFF, 0x80, 0xFF, 0x80, 0xFF, 0x80, 0xFF, 0x80 }
+};
+
+static bool isSingleByteEncoding(Encoding encoding) {
+	return (encoding == kEncodingLatin9) || (encoding == kEncodingCP1250) ||
+	       (encoding == kEncodingCP1251) || (encoding == kEncodingCP1252);
+}
+
+/** Return the number of bytes at the start of the buffer that are 7-bit ASCII.
+ *
+ *  The bulk of the buffer is checked a 64-bit word at a time.
+ */
+static size_t scanASCII(const byte *data, size_t n) {
+	size_t i = 0;
+
+	for (; (i + 8) <= n; i += 8) {
+		uint64 word;
+		std::memcpy(&word, data + i, 8);
+
+		if (word & kHighBits)
+			break;
+	}
+
+	while ((i < n) && (data[i] < 0x80))
+		i++;
+
+	return i;
+}
+
+/** Return the length of the data up to the first (aligned) terminator. */
+static size_t findTerminator(const byte *data, size_t n, size_t termSize) {
+	if (termSize == 1) {
+		const byte *end = static_cast<const byte *>(std::memchr(data, 0, n));
+
+		return end ? (end - data) : n;
+	}
+
+	n -= n % termSize;
+
+	for (size_t i = 0; i < n; i += termSize) {
+		bool zero = true;
+		for (size_t j = 0; zero && (j < termSize); j++)
+			zero = data[i + j] == 0;
+
+		if (zero)
+			return i;
+	}
+
+	return n;
+}
+
+/** Write a Unicode codepoint as UTF-8, returning the pointer past it. */
+static char *writeUTF8(char *out, uint32 c) {
+	if        (c < 0x80) {
+		*out++ = c;
+	} else if (c < 0x800) {
+		*out++ = 0xC0 | (c >> 6);
+		*out++ = 0x80 | (c & 0x3F);
+	} else if (c < 0x10000) {
+		*out++ = 0xE0 | (c >> 12);
+		*out++ = 0x80 | ((c >> 6) & 0x3F);
+		*out++ = 0x80 | (c & 0x3F);
+	} else {
+		*out++ = 0xF0 | (c >> 18);
+		*out++ = 0x80 | ((c >> 12) & 0x3F);
+		*out++ = 0x80 | ((c >>  6) & 0x3F);
+		*out++ = 0x80 | (c & 0x3F);
+	}
+
+	return out;
+}
+
+/** Decode UTF-16 into UTF-8 without going through iconv.
+ *
+ *  Runs of ASCII characters are detected and narrowed four code units at
+ *  a time. Returns false on unpaired surrogates, leaving those to iconv.
+ */
+static bool decodeUTF16(std::string &str, const byte *data, size_t n, bool bigEndian) {
+	const size_t lowByte  = bigEndian ? 1 : 0;
+	const size_t highByte = bigEndian ? 0 : 1;
+
+	uint64 highBits;
+	std::memcpy(&highBits, kUTF16HighBits[bigEndian ? 1 : 0], 8);
+
+	n &= ~((size_t) 1);
+
+	// Each code unit grows to at most 3 bytes, surrogate pairs to 4
+	std::vector<char> output(((n / 2) * 3) + 1);
+
+	char *out = &output[0];
+	for (size_t i = 0; i < n; ) {
+		if ((i + 8) <= n) {
+			uint64 word;
+			std::memcpy(&word, data + i, 8);
+
+			if (!(word & highBits)) {
+				out[0] = data[i + 0 + lowByte];
+				out[1] = data[i + 2 + lowByte];
+				out[2] = data[i + 4 + lowByte];
+				out[3] = data[i + 6 + lowByte];
+
+				out += 4;
+				i   += 8;
+				continue;
+			}
+		}
+
+		uint32 c = (data[i + highByte] << 8) | data[i + lowByte];
+		i += 2;
+
+		if ((c >= 0xDC00) && (c <= 0xDFFF))
+			return false;
+
+		if ((c >= 0xD800) && (c <= 0xDBFF)) {
+			if (i >= n)
+				return false;
+
+			const uint32 c2 = (data[i + highByte] << 8) | data[i + lowByte];
+			if ((c2 < 0xDC00) || (c2 > 0xDFFF))
+				return false;
+
+			c  = 0x10000 + ((c - 0xD800) << 10) + (c2 - 0xDC00);
+			i += 2;
+		}
+
+		out = writeUTF8(out, c);
+	}
+
+	str.assign(&output[0], out - &output[0]);
+	return true;
+}
+
+/** A manager handling string encoding conversions.
+ *
+ *  Conversions are done by iconv, with a few fast paths for the common cases:
+ *  pure ASCII strings in ASCII-compatible encodings are copied verbatim,
+ *  UTF-16 is decoded directly and the single-byte code pages are decoded
+ *  through a lookup table of their upper half. The tables are filled by
+ *  iconv itself, so the results are the same either way.
+ */
 class ConversionManager : public Singleton<ConversionManager> {
 public:
 	ConversionManager() {
 		for (size_t i = 0; i < kEncodingMAX; i++) {
 			_contextFrom[i] = (iconv_t) -1;
 			_contextTo  [i] = (iconv_t) -1;
+
+			_asciiCompatible[i] = false;
+			_hasUpperHalf   [i] = false;
 		}
 
 		for (size_t i = 0; i < kEncodingMAX; i++)
@@ -72,6 +220,9 @@ public:
 		for (size_t i = 0; i < kEncodingMAX; i++)
 			if ((_contextTo  [i] = iconv_open(kEncodingName[i], "UTF-8")) == ((iconv_t) -1))
 				warning("Failed to initialize UTF-8 -> %s conversion: %s", kEncodingName[i], strerror(errno));
+
+		for (size_t i = 0; i < kEncodingMAX; i++)
+			buildTables((Encoding) i);
 	}
 
 	~ConversionManager() {
@@ -101,6 +252,10 @@ public:
 		if (((size_t) encoding) >= kEncodingMAX)
 			throw Exception("Invalid encoding %d", encoding);
 
+		std::string str;
+		if (convertFast(encoding, data, n, str))
+			return str;
+
 		return convert(_contextFrom[encoding], data, n, kEncodingGrowthFrom[encoding], 1);
 	}
 
@@ -108,15 +263,141 @@ public:
 		if (((size_t) encoding) >= kEncodingMAX)
 			throw Exception("Invalid encoding %d", encoding);
 
+		if (str.isASCII()) {
+			MemoryReadStream *stream = convertASCII(encoding, str, terminate ? kTerminatorLength[encoding] : 0);
+			if (stream)
+				return stream;
+		}
+
 		return convert(_contextTo[encoding], str, kEncodingGrowthTo[encoding],
 		               terminate ? kTerminatorLength[encoding] : 0);
 	}
 
 private:
+	/** The UTF-8 representation of a single-byte encoding character. */
+	struct UpperHalfChar {
+		byte length; ///< Length of the UTF-8 sequence, 0 if iconv can't convert it.
+		byte data[3];
+	};
+
 	iconv_t _contextFrom[kEncodingMAX];
 	iconv_t _contextTo  [kEncodingMAX];
 
-	byte *doConvert(iconv_t &ctx, byte *data, size_t nIn, size_t nOut, size_t &size) {
+	/** Do the bytes 0x01-0x7F map to ASCII in this encoding? */
+	bool _asciiCompatible[kEncodingMAX];
+
+	bool _hasUpperHalf[kEncodingMAX];
+	/** Bytes 0x80-0xFF of single-byte encodings, as UTF-8. */
+	UpperHalfChar _upperHalf[kEncodingMAX][128];
+
+	void buildTables(Encoding encoding) {
+		if ((_contextFrom[encoding] == ((iconv_t) -1)) || (encoding == kEncodingUTF16LE) ||
+		    (encoding == kEncodingUTF16BE))
+			return;
+
+		byte ascii[127];
+		for (size_t i = 0; i < sizeof(ascii); i++)
+			ascii[i] = i + 1;
+
+		size_t size;
+		ScopedArray<byte> converted(doConvert(_contextFrom[encoding], ascii, sizeof(ascii), sizeof(ascii), size, true));
+
+		_asciiCompatible[encoding] = converted && (size == sizeof(ascii)) &&
+		                             !std::memcmp(converted.get(), ascii, sizeof(ascii));
+
+		if (!_asciiCompatible[encoding] || !isSingleByteEncoding(encoding))
+			return;
+
+		for (size_t i = 0; i < 128; i++) {
+			byte c = 0x80 + i;
+
+			converted.reset(doConvert(_contextFrom[encoding], &c, 1, sizeof(_upperHalf[encoding][i].data), size, true));
+
+			_upperHalf[encoding][i].length = converted ? size : 0;
+			if (converted)
+				std::memcpy(_upperHalf[encoding][i].data, converted.get(), size);
+		}
+
+		_hasUpperHalf[encoding] = true;
+	}
+
+	/** Convert to UTF-8 without iconv, if possible.
+	 *
+	 *  Like the iconv path, the result ends at the first terminator.
+	 */
+	bool convertFast(Encoding encoding, const byte *data, size_t n, std::string &str) {
+		n = findTerminator(data, n, kTerminatorLength[encoding]);
+
+		if ((encoding == kEncodingUTF16LE) || (encoding == kEncodingUTF16BE))
+			return decodeUTF16(str, data, n, encoding == kEncodingUTF16BE);
+
+		if (!_asciiCompatible[encoding])
+			return false;
+
+		const size_t ascii = scanASCII(data, n);
+		if (ascii == n) {
+			str.assign(reinterpret_cast<const char *>(data), n);
+			return true;
+		}
+
+		if (!_hasUpperHalf[encoding])
+			return false;
+
+		// Every byte grows to at most 3 bytes
+		std::vector<char> output((n * 3) + 1);
+
+		std::memcpy(&output[0], data, ascii);
+		char *out = &output[ascii];
+
+		for (size_t i = ascii; i < n; i++) {
+			if (data[i] < 0x80) {
+				*out++ = data[i];
+				continue;
+			}
+
+			const UpperHalfChar &c = _upperHalf[encoding][data[i] - 0x80];
+			if (c.length == 0)
+				return false;
+
+			for (size_t j = 0; j < c.length; j++)
+				*out++ = c.data[j];
+		}
+
+		str.assign(&output[0], out - &output[0]);
+		return true;
+	}
+
+	/** Convert a pure ASCII string without iconv, if possible. */
+	MemoryReadStream *convertASCII(Encoding encoding, const UString &str, size_t termSize) {
+		const size_t n = str.size();
+
+		if ((encoding == kEncodingUTF16LE) || (encoding == kEncodingUTF16BE)) {
+			const size_t lowByte = (encoding == kEncodingUTF16BE) ? 1 : 0;
+
+			const size_t size = n * 2 + termSize;
+			ScopedArray<byte> data(new byte[size]);
+			std::memset(data.get(), 0, size);
+
+			const char *in = str.c_str();
+			for (size_t i = 0; i < n; i++)
+				data[i * 2 + lowByte] = in[i];
+
+			return new MemoryReadStream(data.release(), size, true);
+		}
+
+		if (!_asciiCompatible[encoding] || (_contextTo[encoding] == ((iconv_t) -1)))
+			return 0;
+
+		const size_t size = n + termSize;
+		ScopedArray<byte> data(new byte[size]);
+
+		std::memcpy(data.get(), str.c_str(), n);
+		std::memset(data.get() + n, 0, termSize);
+
+		return new MemoryReadStream(data.release(), size, true);
+	}
+
+	byte *doConvert(iconv_t &ctx, byte *data, size_t nIn, size_t nOut, size_t &size, bool quiet = false) {
 		size_t inBytes  = nIn;
 		size_t outBytes = nOut;
 
@@ -131,7 +412,9 @@ private:
 		if (iconv(ctx, const_cast<ICONV_CONST char **>(reinterpret_cast<char **>(&data)), &inBytes,
 		          reinterpret_cast<char **>(&outBuf), &outBytes) == ((size_t) -1)) {
 
-			warning("iconv() failed: %s", strerror(errno));
+			if (!quiet)
+				warning("iconv() failed: %s", strerror(errno));
+
 			return 0;
 		}
 
@@ -268,6 +551,9 @@ static void writeFakeChar(std::vector<byte> &output, uint32 c, Encoding encoding
 }
 
 static UString createString(std::vector<byte> &output, Encoding encoding) {
+	if (output.empty())
+		return "";
+
 	switch (encoding) {
 		case kEncodingASCII:
 		case kEncodingUTF8:
@@ -282,11 +568,35 @@ static UString createString(std::vector<byte> &output, Encoding encoding) {
 }
 
 UString readString(SeekableReadStream &stream, Encoding encoding) {
+	if (((size_t) encoding) >= kEncodingMAX)
+		throw Exception("Invalid encoding %d", encoding);
+
+	const size_t termSize = kTerminatorLength[encoding];
+
 	std::vector<byte> output;
 
-	uint32 c;
-	while (((c = readFakeChar(stream, encoding)) != '\0') && !stream.eos())
-		writeFakeChar(output, c, encoding);
+	/* Read the string in blocks and look for the terminator in there, instead
+	 * of reading it character by character. Afterwards, seek back to just
+	 * after the terminator. */
+
+	static const size_t kBlockSize = 256;
+	byte buffer[kBlockSize];
+
+	while (true) {
+		const size_t start = stream.pos();
+		const size_t n     = stream.read(buffer, kBlockSize);
+
+		const size_t length = findTerminator(buffer, n, termSize);
+		output.insert(output.end(), buffer, buffer + length);
+
+		if ((length + termSize) <= n) {
+			stream.seek(start + length + termSize);
+			break;
+		}
+
+		if (n < kBlockSize)
+			break;
+	}
 
 	return createString(output, encoding);
 }
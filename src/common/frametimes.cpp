@@ -0,0 +1,280 @@
+/* xoreos - A reimplementation of BioWare's Aurora engine
+ *
+ * xoreos is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * xoreos is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * xoreos is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with xoreos. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  Recording per-frame timings, for finding stutters.
+ */
+
+#include <cassert>
+
+#include <algorithm>
+
+#include <SDL_timer.h>
+#include <SDL_thread.h>
+
+#include "src/common/util.h"
+#include "src/common/frametimes.h"
+#include "src/common/ustring.h"
+#include "src/common/writestream.h"
+
+DECLARE_SINGLETON(Common::FrameTimesManager)
+
+namespace Common {
+
+static const char * const kPhaseNames[kFramePhaseMAX] = {
+	"events", "scripts", "animation", "world", "gui", "video", "gpu"
+};
+
+/** Upper ends of the histogram buckets, in microseconds. */
+static const uint32 kHistogramLimits[FrameTimes::kHistogramSize] = {
+	4000, 8000, 12000, 17000, 20000, 25000, 34000, 50000, 100000, 0xFFFFFFFF
+};
+
+FrameTimes::FrameTimes(size_t historySize) : _history(historySize), _frameNumber(0) {
+	assert(historySize > 0);
+
+	for (size_t i = 0; i < kFramePhaseMAX; i++) {
+		_thread[i].store(0);
+		_depth[i] = 0;
+	}
+
+	reset();
+}
+
+FrameTimes::~FrameTimes() {
+}
+
+void FrameTimes::reset() {
+	StackLock lock(_mutex);
+
+	_historyStart = 0;
+	_historyCount = 0;
+
+	_lastFrame = 0;
+
+	for (size_t i = 0; i < kFramePhaseMAX; i++)
+		_current[i].store(0);
+}
+
+void FrameTimes::addTime(FramePhase phase, uint32 time) {
+	assert((phase >= 0) && (phase < kFramePhaseMAX));
+
+	_current[phase].fetch_add(time, boost::memory_order_relaxed);
+}
+
+void FrameTimes::addTime(uint64 frame, FramePhase phase, uint32 time) {
+	assert((phase >= 0) && (phase < kFramePhaseMAX));
+
+	StackLock lock(_mutex);
+
+	if (frame >= _frameNumber) {
+		_current[phase].fetch_add(time, boost::memory_order_relaxed);
+		return;
+	}
+
+	// The newest frame in the history is the one before the current frame
+	const uint64 age = _frameNumber - frame;
+	if (age > _historyCount)
+		return;
+
+	_history[(_historyStart + _historyCount - age) % _history.size()].phases[phase] += time;
+}
+
+uint64 FrameTimes::getCurrentFrame() const {
+	StackLock lock(_mutex);
+
+	return _frameNumber;
+}
+
+void FrameTimes::finishedFrame() {
+	const uint64 now = getMicroseconds();
+
+	// The first frame only starts the measurement
+	if (_lastFrame == 0) {
+		_lastFrame = now;
+
+		for (size_t i = 0; i < kFramePhaseMAX; i++)
+			_current[i].store(0, boost::memory_order_relaxed);
+
+		return;
+	}
+
+	const uint64 time = now - _lastFrame;
+	_lastFrame = now;
+
+	finishedFrame(MIN<uint64>(time, 0xFFFFFFFF));
+}
+
+void FrameTimes::finishedFrame(uint32 time) {
+	Frame frame;
+
+	frame.time = time;
+	for (size_t i = 0; i < kFramePhaseMAX; i++)
+		frame.phases[i] = _current[i].exchange(0, boost::memory_order_relaxed);
+
+	StackLock lock(_mutex);
+
+	if (_historyCount < _history.size()) {
+		_history[(_historyStart + _historyCount) % _history.size()] = frame;
+		_historyCount++;
+	} else {
+		_history[_historyStart] = frame;
+		_historyStart = (_historyStart + 1) % _history.size();
+	}
+
+	_frameNumber++;
+}
+
+size_t FrameTimes::getFrameCount() const {
+	StackLock lock(_mutex);
+
+	return _historyCount;
+}
+
+uint32 FrameTimes::getPercentile(uint32 percent) const {
+	std::vector<uint32> times;
+
+	{
+		StackLock lock(_mutex);
+
+		times.reserve(_historyCount);
+		for (size_t i = 0; i < _historyCount; i++)
+			times.push_back(_history[(_historyStart + i) % _history.size()].time);
+	}
+
+	if (times.empty())
+		return 0;
+
+	// Nearest rank
+	const size_t rank  = (MIN<uint32>(percent, 100) * times.size() + 99) / 100;
+	const size_t index = (rank > 0) ? (rank - 1) : 0;
+
+	std::nth_element(times.begin(), times.begin() + index, times.end());
+
+	return times[index];
+}
+
+uint32 FrameTimes::getPhaseAverage(FramePhase phase) const {
+	assert((phase >= 0) && (phase < kFramePhaseMAX));
+
+	StackLock lock(_mutex);
+
+	if (_historyCount == 0)
+		return 0;
+
+	uint64 total = 0;
+	for (size_t i = 0; i < _historyCount; i++)
+		total += _history[(_historyStart + i) % _history.size()].phases[phase];
+
+	return total / _historyCount;
+}
+
+void FrameTimes::getHistogram(Histogram &histogram) const {
+	std::fill(histogram.buckets, histogram.buckets + kHistogramSize, 0);
+
+	StackLock lock(_mutex);
+
+	for (size_t i = 0; i < _historyCount; i++) {
+		const uint32 time = _history[(_historyStart + i) % _history.size()].time;
+
+		size_t bucket = 0;
+		while ((bucket < (kHistogramSize - 1)) && (time > kHistogramLimits[bucket]))
+			bucket++;
+
+		histogram.buckets[bucket]++;
+	}
+}
+
+void FrameTimes::write(WriteStream &stream) const {
+	UString header = "frame,time";
+	for (size_t i = 0; i < kFramePhaseMAX; i++)
+		header += UString(",") + kPhaseNames[i];
+
+	stream.writeString(header + "\n");
+
+	StackLock lock(_mutex);
+
+	for (size_t i = 0; i < _historyCount; i++) {
+		const Frame &frame = _history[(_historyStart + i) % _history.size()];
+
+		UString line = UString::format("%u,%u", (uint) i, (uint) frame.time);
+		for (size_t j = 0; j < kFramePhaseMAX; j++)
+			line += UString::format(",%u", (uint) frame.phases[j]);
+
+		stream.writeString(line + "\n");
+	}
+}
+
+const char *FrameTimes::getPhaseName(FramePhase phase) {
+	if ((phase < 0) || (phase >= kFramePhaseMAX))
+		return "";
+
+	return kPhaseNames[phase];
+}
+
+uint32 FrameTimes::getHistogramLimit(size_t bucket) {
+	if (bucket >= kHistogramSize)
+		return 0xFFFFFFFF;
+
+	return kHistogramLimits[bucket];
+}
+
+uint64 FrameTimes::getMicroseconds() {
+	static const uint64 frequency = SDL_GetPerformanceFrequency();
+
+	const uint64 counter = SDL_GetPerformanceCounter();
+
+	// Split, to avoid overflowing when multiplying
+	return (counter / frequency) * 1000000 + ((counter % frequency) * 1000000) / frequency;
+}
+
+
+FrameTimer::FrameTimer(FrameTimes &times, FramePhase phase) : _times(&times), _phase(phase) {
+	assert((_phase >= 0) && (_phase < kFramePhaseMAX));
+
+	const uint64 thread = SDL_ThreadID();
+
+	// Claim the phase for this thread, unless we're already running timers of it
+	uint64 owner = 0;
+	if (!_times->_thread[_phase].compare_exchange_strong(owner, thread, boost::memory_order_acquire))
+		assert(owner == thread);
+
+	_nesting   = (owner == 0) || (owner == thread);
+	_outermost = !_nesting || (_times->_depth[_phase]++ == 0);
+	_start     = _outermost ? FrameTimes::getMicroseconds() : 0;
+}
+
+FrameTimer::~FrameTimer() {
+	if (_outermost)
+		_times->addTime(_phase, MIN<uint64>(FrameTimes::getMicroseconds() - _start, 0xFFFFFFFF));
+
+	// Release the phase again once the outermost timer is done
+	if (_nesting && (--_times->_depth[_phase] == 0))
+		_times->_thread[_phase].store(0, boost::memory_order_release);
+}
+
+
+FrameTimesManager::FrameTimesManager() {
+}
+
+FrameTimesManager::~FrameTimesManager() {
+}
+
+} // End of namespace Common
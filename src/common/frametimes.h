@@ -0,0 +1,187 @@
+/* xoreos - A reimplementation of BioWare's Aurora engine
+ *
+ * xoreos is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * xoreos is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * xoreos is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with xoreos. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  Recording per-frame timings, for finding stutters.
+ */
+
+#ifndef COMMON_FRAMETIMES_H
+#define COMMON_FRAMETIMES_H
+
+#include "src/common/atomic.h"
+
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+#include "src/common/types.h"
+#include "src/common/singleton.h"
+#include "src/common/mutex.h"
+
+namespace Common {
+
+class WriteStream;
+
+/** A phase of work done during a frame. */
+enum FramePhase {
+	kFramePhaseEvents = 0, ///< Processing input and window events.
+	kFramePhaseScripts,    ///< Running scheduled game scripts.
+	kFramePhaseAnimation,  ///< Updating model animations.
+	kFramePhaseWorld,      ///< Rendering the world.
+	kFramePhaseGUI,        ///< Rendering the front GUI.
+	kFramePhaseVideo,      ///< Playing videos.
+	kFramePhaseGPU,        ///< GPU time of the whole frame.
+	kFramePhaseMAX
+};
+
+/** Records how long each frame, and each phase within it, took.
+ *
+ *  Time spent in a phase can be added with addTime() from any thread, at
+ *  any time, without locking. It's collected into the current frame whenever
+ *  the render thread finishes a frame. The last frames are kept in a
+ *  history, from which percentiles and a histogram are calculated.
+ *
+ *  Times only measured a few frames later, like the GPU time, are added to
+ *  the frame they were measured in, identified by its frame number.
+ *
+ *  All times are in microseconds.
+ */
+class FrameTimes : boost::noncopyable {
+public:
+	/** Number of buckets in the frame time histogram. */
+	static const size_t kHistogramSize = 10;
+
+	/** A frame time histogram. */
+	struct Histogram {
+		uint32 buckets[kHistogramSize]; ///< Number of frames within each bucket.
+	};
+
+	FrameTimes(size_t historySize = 1024);
+	~FrameTimes();
+
+	/** Forget all recorded frames. */
+	void reset();
+
+	/** Add time spent in this phase to the current frame. */
+	void addTime(FramePhase phase, uint32 time);
+	/** Add time spent in this phase to an earlier frame, or to the current frame.
+	 *
+	 *  If that frame isn't in the history anymore, the time is dropped.
+	 */
+	void addTime(uint64 frame, FramePhase phase, uint32 time);
+
+	/** Return the number of the current frame.
+	 *
+	 *  Frames are numbered in the order they're finished. The numbering
+	 *  continues across reset().
+	 */
+	uint64 getCurrentFrame() const;
+
+	/** Finish the current frame, measuring the time since the last finished frame. */
+	void finishedFrame();
+	/** Finish the current frame, which took that long. */
+	void finishedFrame(uint32 time);
+
+	/** Return the number of frames in the history. */
+	size_t getFrameCount() const;
+
+	/** Return the frame time the given percentage of frames in the history are at or below. */
+	uint32 getPercentile(uint32 percent) const;
+	/** Return the average time spent in this phase per frame in the history. */
+	uint32 getPhaseAverage(FramePhase phase) const;
+	/** Sort the frames in the history into a histogram. */
+	void getHistogram(Histogram &histogram) const;
+
+	/** Write the history as comma-separated values, one frame per line. */
+	void write(WriteStream &stream) const;
+
+	/** Return the name of a frame phase. */
+	static const char *getPhaseName(FramePhase phase);
+	/** Return the upper end of a histogram bucket, or 0xFFFFFFFF for the last bucket. */
+	static uint32 getHistogramLimit(size_t bucket);
+
+	/** Return a high-resolution timestamp, in microseconds. */
+	static uint64 getMicroseconds();
+
+private:
+	/** The timings of one frame. */
+	struct Frame {
+		uint32 time;                   ///< Time the whole frame took.
+		uint32 phases[kFramePhaseMAX]; ///< Time spent in each phase.
+	};
+
+	std::vector<Frame> _history; ///< The last frames, as a ring buffer.
+
+	size_t _historyStart; ///< Index of the oldest frame in the history.
+	size_t _historyCount; ///< Number of frames in the history.
+
+	uint64 _frameNumber; ///< Number of the current frame.
+
+	uint64 _lastFrame; ///< Timestamp of the last finished frame.
+
+	/** Time spent in each phase since the last finished frame. */
+	boost::atomic<uint32> _current[kFramePhaseMAX];
+	/** The thread running timers of each phase, or 0 if none is running. */
+	boost::atomic<uint64> _thread[kFramePhaseMAX];
+	/** Number of nested timers running for each phase. Only used by that thread. */
+	uint32 _depth[kFramePhaseMAX];
+
+	mutable Mutex _mutex; ///< Mutex protecting the history.
+
+	friend class FrameTimer;
+};
+
+/** Measures the time from its creation until its destruction as a frame phase.
+ *
+ *  Nested timers of the same phase only count once, so a script running
+ *  another script doesn't get counted twice.
+ *
+ *  Nesting is tracked per phase, not per thread. So while a timer of a
+ *  phase is running, timers of the same phase may only be created on that
+ *  same thread. This is asserted; in release builds, a timer on another
+ *  thread is counted on its own, without regard to nesting.
+ */
+class FrameTimer : boost::noncopyable {
+public:
+	FrameTimer(FrameTimes &times, FramePhase phase);
+	~FrameTimer();
+
+private:
+	FrameTimes *_times;
+	FramePhase _phase;
+
+	uint64 _start;
+	bool _outermost; ///< Is this the outermost timer of its phase?
+	bool _nesting;   ///< Does this timer take part in nesting?
+};
+
+/** The global frame times, shared by all subsystems. */
+class FrameTimesManager : public Singleton<FrameTimesManager>, public FrameTimes {
+public:
+	FrameTimesManager();
+	~FrameTimesManager();
+};
+
+} // End of namespace Common
+
+/** Shortcut for accessing the global frame times. */
+#define FrameTimesMan Common::FrameTimesManager::instance()
+
+#endif // COMMON_FRAMETIMES_H
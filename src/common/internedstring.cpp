@@ -0,0 +1,170 @@
+/* xoreos - A reimplementation of BioWare's Aurora engine
+ *
+ * xoreos is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * xoreos is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * xoreos is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with xoreos. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  A global pool of unique, immutable strings.
+ */
+
+#include <cassert>
+
+#include <boost/functional/hash.hpp>
+
+#include "src/common/internedstring.h"
+#include "src/common/util.h"
+#include "src/common/scopedptr.h"
+
+DECLARE_SINGLETON(Common::StringInterner)
+
+namespace Common {
+
+StringInterner::Entry::Entry() : string(0), refCount(0) {
+}
+
+
+StringInterner::StringInterner() {
+}
+
+StringInterner::~StringInterner() {
+	for (EntryMap::iterator e = _entries.begin(); e != _entries.end(); ++e)
+		delete e->second;
+}
+
+size_t StringInterner::size() const {
+	StackLock lock(_mutex);
+
+	return _entries.size();
+}
+
+StringInterner::Entry *StringInterner::intern(const UString &str) {
+	StackLock lock(_mutex);
+
+	EntryMap::iterator e = _entries.find(str);
+	if (e == _entries.end()) {
+		ScopedPtr<Entry> entry(new Entry);
+
+		e = _entries.insert(std::make_pair(str, entry.get())).first;
+		entry->string = &e->first;
+
+		entry.release();
+	}
+
+	e->second->refCount++;
+	return e->second;
+}
+
+StringInterner::Entry *StringInterner::find(const UString &str) {
+	StackLock lock(_mutex);
+
+	EntryMap::iterator e = _entries.find(str);
+	if (e == _entries.end())
+		return 0;
+
+	e->second->refCount++;
+	return e->second;
+}
+
+void StringInterner::reference(Entry *entry) {
+	// The caller already holds a reference, so this can't race with a release to 0
+	entry->refCount.fetch_add(1, boost::memory_order_relaxed);
+}
+
+void StringInterner::release(Entry *entry) {
+	/* If we're not holding the last reference, just drop ours. The count
+	 * only ever goes from 1 to 0 (and from 0 to 1, in intern()) with the
+	 * mutex held, so an entry can't be removed while another thread
+	 * is looking it up. */
+
+	uint32 count = entry->refCount.load(boost::memory_order_relaxed);
+	while (count > 1)
+		if (entry->refCount.compare_exchange_weak(count, count - 1, boost::memory_order_release,
+		                                          boost::memory_order_relaxed))
+			return;
+
+	StackLock lock(_mutex);
+
+	if (--entry->refCount > 0)
+		return;
+
+	_entries.erase(_entries.find(*entry->string));
+	delete entry;
+}
+
+
+InternedString::InternedString() : _entry(0) {
+}
+
+InternedString::InternedString(const UString &str) : _entry(0) {
+	if (!str.empty())
+		_entry = StringInternMan.intern(str);
+}
+
+InternedString::InternedString(const InternedString &str) : _entry(str._entry) {
+	if (_entry)
+		StringInternMan.reference(_entry);
+}
+
+InternedString::~InternedString() {
+	if (_entry)
+		StringInternMan.release(_entry);
+}
+
+InternedString &InternedString::operator=(const InternedString &str) {
+	InternedString tmp(str);
+	swap(tmp);
+
+	return *this;
+}
+
+const UString &InternedString::str() const {
+	static const UString kEmptyString;
+
+	return _entry ? *_entry->string : kEmptyString;
+}
+
+const char *InternedString::c_str() const {
+	return str().c_str();
+}
+
+bool InternedString::empty() const {
+	return _entry == 0;
+}
+
+size_t InternedString::hash() const {
+	return boost::hash<const void *>()(_entry);
+}
+
+void InternedString::swap(InternedString &str) {
+	SWAP(_entry, str._entry);
+}
+
+bool InternedString::lookup(const UString &str, InternedString &interned) {
+	InternedString found;
+
+	if (!str.empty()) {
+		found._entry = StringInternMan.find(str);
+		if (!found._entry)
+			return false;
+	}
+
+	interned.swap(found);
+	return true;
+}
+
+} // End of namespace Common
@@ -0,0 +1,157 @@
+/* xoreos - A reimplementation of BioWare's Aurora engine
+ *
+ * xoreos is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * xoreos is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * xoreos is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with xoreos. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  A global pool of unique, immutable strings.
+ */
+
+#ifndef COMMON_INTERNEDSTRING_H
+#define COMMON_INTERNEDSTRING_H
+
+#include "src/common/atomic.h"
+
+#include <functional>
+
+#include <boost/unordered_map.hpp>
+
+#include "src/common/types.h"
+#include "src/common/ustring.h"
+#include "src/common/singleton.h"
+#include "src/common/mutex.h"
+
+namespace Common {
+
+class InternedString;
+
+/** The global string interner.
+ *
+ *  Every distinct string is only stored once, no matter how many
+ *  InternedString handles refer to it. A string is removed from the
+ *  pool again when the last handle referring to it goes away.
+ *
+ *  Creating the interner is not thread-safe, like with every singleton.
+ *  It's therefore explicitly created at startup, before any other thread
+ *  runs. After that, all methods are thread-safe.
+ *
+ *  The interner is deliberately never destroyed, since handles might
+ *  outlive every other manager. Destroying it anyway, for example in
+ *  unit tests, frees all entries and invalidates all existing handles.
+ */
+class StringInterner : public Singleton<StringInterner> {
+public:
+	StringInterner();
+	~StringInterner();
+
+	/** Return the number of distinct strings currently interned. */
+	size_t size() const;
+
+private:
+	/** A string in the pool. */
+	struct Entry {
+		const UString *string;           ///< The string, owned by the pool's map.
+		boost::atomic<uint32> refCount; ///< Number of handles referring to this entry.
+
+		Entry();
+	};
+
+	/** All interned strings. We hash case-insensitively because UString caches that hash. */
+	typedef boost::unordered_map<UString, Entry *, hashUStringCaseInsensitive> EntryMap;
+
+	EntryMap _entries;
+
+	mutable Mutex _mutex;
+
+	/** Return the entry for this string, adding it if necessary. */
+	Entry *intern(const UString &str);
+	/** Return the entry for this string, if it is already interned. */
+	Entry *find(const UString &str);
+
+	void reference(Entry *entry);
+	void release(Entry *entry);
+
+	friend class InternedString;
+};
+
+/** A handle to a string in the global StringInterner.
+ *
+ *  Since every distinct string only exists once in the pool, comparing
+ *  and hashing InternedStrings only looks at the handles, never at the
+ *  string data. Note that the ordering of operator< is arbitrary; it does
+ *  not follow the ordering of the strings.
+ */
+class InternedString {
+public:
+	/** Create a handle to the empty string. */
+	InternedString();
+	/** Intern this string. */
+	explicit InternedString(const UString &str);
+	InternedString(const InternedString &str);
+	~InternedString();
+
+	InternedString &operator=(const InternedString &str);
+
+	bool operator==(const InternedString &str) const {
+		return _entry == str._entry;
+	}
+
+	bool operator!=(const InternedString &str) const {
+		return _entry != str._entry;
+	}
+
+	bool operator<(const InternedString &str) const {
+		return std::less<const StringInterner::Entry *>()(_entry, str._entry);
+	}
+
+	/** Return the interned string. */
+	const UString &str() const;
+	/** Return the (utf8 encoded) string data. */
+	const char *c_str() const;
+
+	bool empty() const;
+
+	size_t hash() const;
+
+	void swap(InternedString &str);
+
+	/** Find the handle for this string without interning it.
+	 *
+	 *  Since a string that was never interned can't be found in any
+	 *  container keyed by InternedStrings, this is useful for lookups.
+	 *
+	 *  @return true if the string was already interned, false otherwise.
+	 */
+	static bool lookup(const UString &str, InternedString &interned);
+
+private:
+	StringInterner::Entry *_entry; ///< Our entry in the pool, or 0 for the empty string.
+};
+
+struct hashInternedString {
+	size_t operator()(const InternedString &str) const {
+		return str.hash();
+	}
+};
+
+} // End of namespace Common
+
+/** Shortcut for accessing the string interner. */
+#define StringInternMan Common::StringInterner::instance()
+
+#endif // COMMON_INTERNEDSTRING_H
@@ -53,6 +53,7 @@
 #include "src/common/memreadstream.h"
 #include "src/common/error.h"
 #include "src/common/util.h"
+#include "src/common/scopedptr.h"
 
 namespace Common {
 
@@ -115,4 +116,23 @@ MemoryReadStreamEndian::MemoryReadStreamEndian(const byte *dataPtr, size_t dataS
 MemoryReadStreamEndian::~MemoryReadStreamEndian() {
 }
 
+
+MemoryReadStream *makeMemoryBacked(SeekableReadStream *stream) {
+	assert(stream);
+
+	MemoryReadStream *memStream = dynamic_cast<MemoryReadStream *>(stream);
+	if (memStream)
+		return memStream;
+
+	ScopedPtr<SeekableReadStream> original(stream);
+
+	const size_t pos = original->pos();
+
+	original->seek(0);
+	memStream = original->readStream(original->size());
+
+	memStream->seek(pos);
+	return memStream;
+}
+
 } // End of namespace Common
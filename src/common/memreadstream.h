@@ -55,11 +55,165 @@
 #include <boost/noncopyable.hpp>
 
 #include "src/common/types.h"
+#include "src/common/endianness.h"
+#include "src/common/util.h"
+#include "src/common/error.h"
 #include "src/common/disposableptr.h"
 #include "src/common/readstream.h"
 
 namespace Common {
 
+/** A light-weight cursor over a contiguous block of memory.
+ *
+ *  Unlike the ReadStream interface, all reading methods are non-virtual
+ *  and can be inlined, which makes this considerably faster for format
+ *  parsers that read lots of small values. The cursor does not own the
+ *  memory it reads from, and it is cheap to copy.
+ *
+ *  Reading past the end throws a kReadError exception, seeking past the
+ *  end a kSeekError exception.
+ */
+class MemoryReadCursor {
+public:
+	MemoryReadCursor() : _data(0), _size(0), _pos(0) {
+	}
+
+	MemoryReadCursor(const byte *data, size_t size, size_t pos = 0) : _data(data), _size(size), _pos(pos) {
+		if (_pos > _size)
+			throw Exception(kSeekError);
+	}
+
+	/** Return the start of the memory block. */
+	const byte *getData() const {
+		return _data;
+	}
+
+	size_t pos() const {
+		return _pos;
+	}
+
+	size_t size() const {
+		return _size;
+	}
+
+	/** Return the number of bytes left to read. */
+	size_t remaining() const {
+		return _size - _pos;
+	}
+
+	/** Seek to an absolute position within the memory block. */
+	void seek(size_t offset) {
+		if (offset > _size)
+			throw Exception(kSeekError);
+
+		_pos = offset;
+	}
+
+	/** Skip forward (or backward) by a number of bytes. */
+	void skip(ptrdiff_t offset) {
+		if (((offset < 0) && ((size_t) -offset > _pos)) || ((offset > 0) && ((size_t) offset > remaining())))
+			throw Exception(kSeekError);
+
+		_pos += offset;
+	}
+
+	/** Copy dataSize bytes into dataPtr. */
+	void read(void *dataPtr, size_t dataSize) {
+		std::memcpy(dataPtr, advance(dataSize), dataSize);
+	}
+
+	byte readByte() {
+		return *advance(1);
+	}
+
+	int8 readSByte() {
+		return (int8)readByte();
+	}
+
+	uint16 readUint16LE() {
+		return READ_LE_UINT16(advance(2));
+	}
+
+	uint32 readUint32LE() {
+		return READ_LE_UINT32(advance(4));
+	}
+
+	uint64 readUint64LE() {
+		return READ_LE_UINT64(advance(8));
+	}
+
+	uint16 readUint16BE() {
+		return READ_BE_UINT16(advance(2));
+	}
+
+	uint32 readUint32BE() {
+		return READ_BE_UINT32(advance(4));
+	}
+
+	uint64 readUint64BE() {
+		const byte *data = advance(8);
+
+		return (((uint64) READ_BE_UINT32(data)) << 32) | READ_BE_UINT32(data + 4);
+	}
+
+	int16 readSint16LE() {
+		return (int16)readUint16LE();
+	}
+
+	int32 readSint32LE() {
+		return (int32)readUint32LE();
+	}
+
+	int64 readSint64LE() {
+		return (int64)readUint64LE();
+	}
+
+	int16 readSint16BE() {
+		return (int16)readUint16BE();
+	}
+
+	int32 readSint32BE() {
+		return (int32)readUint32BE();
+	}
+
+	int64 readSint64BE() {
+		return (int64)readUint64BE();
+	}
+
+	float readIEEEFloatLE() {
+		return convertIEEEFloat(readUint32LE());
+	}
+
+	float readIEEEFloatBE() {
+		return convertIEEEFloat(readUint32BE());
+	}
+
+	double readIEEEDoubleLE() {
+		return convertIEEEDouble(readUint64LE());
+	}
+
+	double readIEEEDoubleBE() {
+		return convertIEEEDouble(readUint64BE());
+	}
+
+private:
+	const byte *_data;
+
+	size_t _size;
+	size_t _pos;
+
+	/** Return a pointer to the current position and move n bytes forward. */
+	const byte *advance(size_t n) {
+		if (n > remaining())
+			throw Exception(kReadError);
+
+		const byte *data = _data + _pos;
+		_pos += n;
+
+		return data;
+	}
+};
+
 /** Simple memory based 'stream', which implements the ReadStream interface for
  *  a plain memory block.
  */
@@ -102,6 +256,12 @@ public:
 
 	const byte *getData() const;
 
+	/** Return a cursor over the whole memory block, positioned at
+	 *  the current position of this stream. */
+	MemoryReadCursor getCursor() const {
+		return MemoryReadCursor(_ptrOrig.get(), _size, _pos);
+	}
+
 private:
 	DisposableArray<const byte> _ptrOrig;
 	const byte *_ptr;
@@ -159,6 +319,15 @@ public:
 	}
 };
 
+/** Make sure a stream is backed by a contiguous block of memory, so that
+ *  it can be read with a MemoryReadCursor.
+ *
+ *  If the stream already is a MemoryReadStream, it is returned unchanged.
+ *  Otherwise, the whole stream is read into a new MemoryReadStream, seeked
+ *  to the same position, and the original stream is deleted.
+ */
+MemoryReadStream *makeMemoryBacked(SeekableReadStream *stream);
+
 } // End of namespace Common
 
 #endif // COMMON_MEMREADSTREAM_H
@@ -44,6 +44,10 @@ void Mutex::lock() {
 	assert(res == 0);
 }
 
+bool Mutex::lockTry() {
+	return SDL_TryLockMutex(_mutex) == 0;
+}
+
 void Mutex::unlock() {
 	SDL_UnlockMutex(_mutex);
 }
@@ -139,4 +143,8 @@ void Condition::signal() {
 	SDL_CondSignal(_condition);
 }
 
+void Condition::broadcast() {
+	SDL_CondBroadcast(_condition);
+}
+
 } // End of namespace Common
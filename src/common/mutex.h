@@ -43,6 +43,7 @@ public:
 	~Mutex();
 
 	void lock();
+	bool lockTry();
 	void unlock();
 
 private:
@@ -87,7 +88,10 @@ public:
 	~Condition();
 
 	bool wait(uint32 timeout = 0);
+	/** Wake up one waiting thread. */
 	void signal();
+	/** Wake up all waiting threads. */
+	void broadcast();
 
 private:
 	bool _ownMutex;
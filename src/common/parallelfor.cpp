@@ -0,0 +1,85 @@
+/* xoreos - A reimplementation of BioWare's Aurora engine
+ *
+ * xoreos is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * xoreos is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * xoreos is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with xoreos. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  Running the iterations of a loop on a thread pool.
+ */
+
+#include <vector>
+
+#include "src/common/util.h"
+#include "src/common/ptrvector.h"
+#include "src/common/threadpool.h"
+#include "src/common/parallelfor.h"
+
+namespace Common {
+
+/** Chunks of iterations for each worker thread, to balance out uneven work. */
+static const size_t kChunksPerThread = 4;
+
+ParallelForBody::~ParallelForBody() {
+}
+
+/** A chunk of consecutive iterations, run by a thread pool worker. */
+class ParallelForJob : public ThreadPoolJob {
+public:
+	ParallelForJob(ParallelForBody &body, size_t begin, size_t end) : _body(&body), _begin(begin), _end(end) {
+	}
+
+	void run() {
+		for (size_t i = _begin; i < _end; i++)
+			_body->run(i);
+	}
+
+private:
+	ParallelForBody *_body;
+
+	size_t _begin;
+	size_t _end;
+};
+
+void parallelFor(ThreadPool *pool, size_t begin, size_t end, ParallelForBody &body, size_t grain) {
+	if (begin >= end)
+		return;
+
+	const size_t count       = end - begin;
+	const size_t threadCount = pool ? pool->getThreadCount() : 0;
+
+	grain = MAX<size_t>(grain, 1);
+
+	// The calling thread works along, so it counts as a thread as well
+	const size_t maxChunks = kChunksPerThread * (threadCount + 1);
+	const size_t chunkSize = MAX<size_t>(grain, (count + maxChunks - 1) / maxChunks);
+
+	if ((threadCount == 0) || (chunkSize >= count)) {
+		for (size_t i = begin; i < end; i++)
+			body.run(i);
+
+		return;
+	}
+
+	PtrVector<ParallelForJob> jobs;
+	for (size_t i = begin; i < end; i += chunkSize)
+		jobs.push_back(new ParallelForJob(body, i, MIN(i + chunkSize, end)));
+
+	pool->run(std::vector<ThreadPoolJob *>(jobs.begin(), jobs.end()));
+}
+
+} // End of namespace Common
@@ -0,0 +1,61 @@
+/* xoreos - A reimplementation of BioWare's Aurora engine
+ *
+ * xoreos is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * xoreos is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * xoreos is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with xoreos. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  Running the iterations of a loop on a thread pool.
+ */
+
+#ifndef COMMON_PARALLELFOR_H
+#define COMMON_PARALLELFOR_H
+
+#include <cstddef>
+
+namespace Common {
+
+class ThreadPool;
+
+/** The body of a loop run by parallelFor(). */
+class ParallelForBody {
+public:
+	virtual ~ParallelForBody();
+
+	/** Run the iteration with this index. */
+	virtual void run(size_t index) = 0;
+};
+
+/** Run body.run(i) for all i in [begin, end), spread over the workers of the pool.
+ *
+ *  The range is cut into consecutive chunks of at least grain iterations,
+ *  and a few chunks for each worker, so that they can balance out uneven
+ *  amounts of work. The iterations must not depend on each other.
+ *
+ *  Without a pool, with a pool without any worker threads, or when the range
+ *  doesn't make up more than one chunk, all iterations run in the calling thread.
+ *
+ *  The loop may be nested: the body itself may call parallelFor() on the same pool.
+ *
+ *  If any of the iterations throws an exception, the first one is rethrown
+ *  here after all the chunks have finished.
+ */
+void parallelFor(ThreadPool *pool, size_t begin, size_t end, ParallelForBody &body, size_t grain = 1);
+
+} // End of namespace Common
+
+#endif // COMMON_PARALLELFOR_H
@@ -23,18 +23,36 @@
  */
 
 #include <cassert>
+#include <cstring>
+
+#include "src/common/system.h"
+
+#if defined(HAVE_PREAD) || defined(HAVE_POSIX_FADVISE)
+	#include <unistd.h>
+	#include <fcntl.h>
+	#include <cerrno>
+#endif
 
 #include "src/common/readfile.h"
 #include "src/common/error.h"
 #include "src/common/ustring.h"
+#include "src/common/util.h"
 #include "src/common/platform.h"
+#include "src/common/mutex.h"
 
 namespace Common {
 
-ReadFile::ReadFile() : _handle(0), _size(kSizeInvalid) {
+ReadFile::ReadFile() : _handle(0), _size(kSizeInvalid), _pos(0), _eos(false),
+	_bufferSize(0), _bufferStart(0), _bufferFill(0) {
+
+	setBufferSize(kDefaultBufferSize);
 }
 
-ReadFile::ReadFile(const UString &fileName) : _handle(0), _size(kSizeInvalid) {
+ReadFile::ReadFile(const UString &fileName) : _handle(0), _size(kSizeInvalid), _pos(0), _eos(false),
+	_bufferSize(0), _bufferStart(0), _bufferFill(0) {
+
+	setBufferSize(kDefaultBufferSize);
+
 	if (!open(fileName))
 		throw Exception("Can't open file \"%s\"", fileName.c_str());
 }
@@ -78,6 +96,13 @@ bool ReadFile::open(const UString &fileName) {
 
 	_size = (size_t)fileSize;
 
+	// We do our own buffering, stdio's would only get in the way
+	std::setvbuf(_handle, 0, _IONBF, 0);
+
+#ifndef HAVE_PREAD
+	_mutex.reset(new Mutex);
+#endif
+
 	return true;
 }
 
@@ -87,24 +112,109 @@ void ReadFile::close() {
 
 	_handle = 0;
 	_size   = kSizeInvalid;
+
+	_pos = 0;
+	_eos = false;
+
+	_bufferStart = 0;
+	_bufferFill  = 0;
+
+	_mutex.reset();
 }
 
 bool ReadFile::isOpen() const {
 	return _handle != 0;
 }
 
+void ReadFile::setBufferSize(size_t size) {
+	size = ((size + kBlockSize - 1) / kBlockSize) * kBlockSize;
+	if (size == _bufferSize)
+		return;
+
+	_buffer.reset(size ? new byte[size] : 0);
+
+	_bufferSize  = size;
+	_bufferStart = 0;
+	_bufferFill  = 0;
+}
+
+void ReadFile::setAccessHint(AccessHint hint) {
+	if (!_handle)
+		return;
+
+#ifdef HAVE_POSIX_FADVISE
+	static const int kHintToAdvice[] = {
+		POSIX_FADV_NORMAL, POSIX_FADV_SEQUENTIAL, POSIX_FADV_RANDOM
+	};
+
+	if (((size_t) hint) >= ARRAYSIZE(kHintToAdvice))
+		return;
+
+	posix_fadvise(fileno(_handle), 0, 0, kHintToAdvice[hint]);
+#else
+	(void) hint;
+#endif
+}
+
+size_t ReadFile::readAt(size_t offset, void *dataPtr, size_t dataSize) const {
+	if (!_handle || (offset >= _size))
+		return 0;
+
+	assert(dataPtr);
+
+	dataSize = MIN(dataSize, _size - offset);
+
+#ifdef HAVE_PREAD
+	const int fd = fileno(_handle);
+
+	byte  *data = reinterpret_cast<byte *>(dataPtr);
+	size_t done = 0;
+
+	while (done < dataSize) {
+		const ssize_t n = pread(fd, data + done, dataSize - done, (off_t) (offset + done));
+		if (n < 0) {
+			if (errno == EINTR)
+				continue;
+
+			break;
+		}
+
+		if (n == 0)
+			break;
+
+		done += (size_t) n;
+	}
+
+	return done;
+#else
+	StackLock lock(*_mutex);
+
+	if (std::fseek(_handle, (long) offset, SEEK_SET) != 0)
+		return 0;
+
+	return std::fread(dataPtr, 1, dataSize, _handle);
+#endif
+}
+
+bool ReadFile::fillBuffer(size_t offset) {
+	_bufferStart = offset - (offset % kBlockSize);
+	_bufferFill  = readAt(_bufferStart, _buffer.get(), _bufferSize);
+
+	return (_bufferStart + _bufferFill) > offset;
+}
+
 bool ReadFile::eos() const {
 	if (!_handle)
 		return true;
 
-	return std::feof(_handle) != 0;
+	return _eos;
 }
 
 size_t ReadFile::pos() const {
 	if (!_handle)
 		return kPositionInvalid;
 
-	return (size_t)std::ftell(_handle);
+	return _pos;
 }
 
 size_t ReadFile::size() const {
@@ -112,21 +222,16 @@ size_t ReadFile::size() const {
 }
 
 size_t ReadFile::seek(ptrdiff_t offset, Origin whence) {
-	static const int kSeekToWhence[kOriginMAX] = { SEEK_SET, SEEK_CUR, SEEK_END };
-	if (((size_t) whence) >= kOriginMAX)
-		throw Exception(kSeekError);
-
 	if (!_handle)
 		throw Exception(kSeekError);
 
-	size_t oldPos = pos();
-
-	if (std::fseek(_handle, offset, kSeekToWhence[whence]) != 0)
+	const size_t oldPos = _pos;
+	const size_t newPos = evalSeek(offset, whence, _pos, 0, _size);
+	if (newPos > _size)
 		throw Exception(kSeekError);
 
-	long p = std::ftell(_handle);
-	if ((p < 0) || ((size_t)p > _size))
-		throw Exception(kSeekError);
+	_pos = newPos;
+	_eos = false;
 
 	return oldPos;
 }
@@ -136,7 +241,48 @@ size_t ReadFile::read(void *dataPtr, size_t dataSize) {
 		return 0;
 
 	assert(dataPtr);
-	return std::fread(dataPtr, 1, dataSize, _handle);
+
+	// Read at most as many bytes as are still available...
+	if (dataSize > (_size - _pos)) {
+		dataSize = _size - _pos;
+		_eos = true;
+	}
+
+	byte  *data = reinterpret_cast<byte *>(dataPtr);
+	size_t done = 0;
+
+	while (done < dataSize) {
+		// Copy what we can from the read-ahead buffer
+		if ((_pos >= _bufferStart) && (_pos < (_bufferStart + _bufferFill))) {
+			const size_t n = MIN(dataSize - done, _bufferStart + _bufferFill - _pos);
+
+			std::memcpy(data + done, _buffer.get() + (_pos - _bufferStart), n);
+
+			_pos += n;
+			done += n;
+			continue;
+		}
+
+		// Big reads go straight into the caller's memory
+		if ((dataSize - done) >= _bufferSize) {
+			const size_t n = readAt(_pos, data + done, dataSize - done);
+
+			_pos += n;
+			done += n;
+
+			if (done < dataSize)
+				_eos = true;
+
+			break;
+		}
+
+		if (!fillBuffer(_pos)) {
+			_eos = true;
+			break;
+		}
+	}
+
+	return done;
 }
 
 } // End of namespace Common
@@ -30,15 +30,36 @@
 #include <boost/noncopyable.hpp>
 
 #include "src/common/types.h"
+#include "src/common/scopedptr.h"
 #include "src/common/readstream.h"
 
 namespace Common {
 
 class UString;
+class Mutex;
 
-/** A simple streaming file reading class. */
+/** A stream reading from a file on disk.
+ *
+ *  Reads go through a read-ahead buffer whose file offsets are aligned
+ *  to kBlockSize, so many small reads and seeks within a region of the
+ *  file only cost a single system call. Reads larger than the buffer
+ *  bypass it. Where the platform supports it, the file is read with
+ *  positional reads (pread()), so seeking never touches the OS.
+ */
 class ReadFile : boost::noncopyable, public SeekableReadStream {
 public:
+	/** How the file is expected to be accessed. */
+	enum AccessHint {
+		kAccessNormal,     ///< No special access pattern.
+		kAccessSequential, ///< The file is mostly read from start to end.
+		kAccessRandom      ///< The file is read in small chunks at random offsets.
+	};
+
+	/** File offsets and sizes of buffered reads are aligned to this. */
+	static const size_t kBlockSize = 4096;
+	/** The default size of the read-ahead buffer. */
+	static const size_t kDefaultBufferSize = 4 * kBlockSize;
+
 	ReadFile();
 	ReadFile(const UString &fileName);
 	~ReadFile();
@@ -59,6 +80,29 @@ public:
 	 */
 	bool isOpen() const;
 
+	/** Set the size of the read-ahead buffer.
+	 *
+	 *  The size is rounded up to a multiple of kBlockSize. A size
+	 *  of 0 disables buffering, and every read goes to the OS.
+	 */
+	void setBufferSize(size_t size);
+
+	/** Tell the OS how we expect to access the file.
+	 *
+	 *  This is only a hint, and is ignored on platforms that don't
+	 *  support posix_fadvise().
+	 */
+	void setAccessHint(AccessHint hint);
+
+	/** Read data from a specific offset in the file, without using or
+	 *  changing the stream position or the read-ahead buffer.
+	 *
+	 *  This can safely be called from several threads at once.
+	 *
+	 *  @return the number of bytes which were actually read.
+	 */
+	size_t readAt(size_t offset, void *dataPtr, size_t dataSize) const;
+
 	bool eos() const;
 
 	size_t pos() const;
@@ -70,6 +114,20 @@ public:
 protected:
 	std::FILE *_handle; ///< The actual file handle.
 	size_t _size;       ///< The file's size.
+
+	size_t _pos; ///< The current stream position.
+	bool   _eos; ///< Did the last read hit the end of the file?
+
+	ScopedArray<byte> _buffer; ///< The read-ahead buffer.
+	size_t _bufferSize;        ///< The capacity of the read-ahead buffer.
+	size_t _bufferStart;       ///< The file offset the buffer content starts at.
+	size_t _bufferFill;        ///< The number of valid bytes in the buffer.
+
+	/** Serializes seek+read pairs on platforms without pread(). */
+	ScopedPtr<Mutex> _mutex;
+
+	/** Refill the read-ahead buffer with the block containing this offset. */
+	bool fillBuffer(size_t offset);
 };
 
 } // End of namespace Common
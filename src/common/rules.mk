@@ -45,8 +45,13 @@ src_common_libcommon_la_SOURCES += \
     src/common/mdct.h \
     src/common/threads.h \
     src/common/thread.h \
+    src/common/threadpool.h \
+    src/common/parallelfor.h \
+    src/common/triplebuffer.h \
+    src/common/frametimes.h \
     src/common/mutex.h \
     src/common/ustring.h \
+    src/common/internedstring.h \
     src/common/hash.h \
     src/common/md5.h \
     src/common/blowfish.h \
@@ -98,8 +103,12 @@ src_common_libcommon_la_SOURCES += \
     src/common/mdct.cpp \
     src/common/threads.cpp \
     src/common/thread.cpp \
+    src/common/threadpool.cpp \
+    src/common/parallelfor.cpp \
+    src/common/frametimes.cpp \
     src/common/mutex.cpp \
     src/common/ustring.cpp \
+    src/common/internedstring.cpp \
     src/common/md5.cpp \
     src/common/blowfish.cpp \
     src/common/deflate.cpp \
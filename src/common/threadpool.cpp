@@ -0,0 +1,275 @@
+/* xoreos - A reimplementation of BioWare's Aurora engine
+ *
+ * xoreos is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * xoreos is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * xoreos is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with xoreos. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  A pool of worker threads.
+ */
+
+#include <cassert>
+
+#include "src/common/fallthrough.h"
+START_IGNORE_IMPLICIT_FALLTHROUGH
+#include <SDL_cpuinfo.h>
+#include <SDL_timer.h>
+STOP_IGNORE_IMPLICIT_FALLTHROUGH
+
+#include "src/common/threadpool.h"
+#include "src/common/error.h"
+
+namespace Common {
+
+ThreadPoolJob::~ThreadPoolJob() {
+}
+
+
+/** The bookkeeping of one batch of jobs. */
+struct ThreadPool::Batch {
+	boost::atomic<size_t> remaining; ///< Number of jobs not yet finished.
+
+	Semaphore done; ///< Unlocked when the last job has finished.
+
+	Mutex errorMutex;
+	bool failed;
+	Exception error; ///< The first exception thrown by a job.
+
+	Batch(size_t count) : remaining(count), done(0), failed(false) {
+	}
+};
+
+
+ThreadPool::Worker::Worker(ThreadPool &pool, size_t index) : _pool(&pool), _index(index) {
+}
+
+ThreadPool::Worker::~Worker() {
+	destroyThread();
+}
+
+void ThreadPool::Worker::threadMethod() {
+	_pool->_runningWorkers.fetch_add(1);
+
+	while (true) {
+		_pool->_jobsAvailable.lock();
+
+		if (_pool->_shutdown.load(boost::memory_order_acquire))
+			break;
+
+		/* Each wake-up stands for one queued job. If another thread already
+		 * took it, we simply go back to sleep. */
+
+		Entry entry;
+		if (_pool->takeJob(_index, entry))
+			_pool->runJob(entry);
+	}
+}
+
+
+ThreadPool::ThreadPool(size_t threadCount) : _jobsAvailable(0), _nextQueue(0), _runningWorkers(0), _shutdown(false) {
+	// One queue for each worker, plus one for pools without workers
+	const size_t queueCount = MAX<size_t>(threadCount, 1);
+
+	for (size_t i = 0; i < queueCount; i++)
+		_queues.push_back(new Queue);
+
+	for (size_t i = 0; i < threadCount; i++) {
+		_workers.push_back(new Worker(*this, i));
+
+		if (!_workers.back()->createThread(UString::format("ThreadPool%u", (uint)i))) {
+			_workers.pop_back();
+			break;
+		}
+	}
+
+	// Wait for all workers to start, so that they can be destroyed cleanly
+	while (_runningWorkers.load() < _workers.size())
+		SDL_Delay(1);
+}
+
+ThreadPool::~ThreadPool() {
+	_shutdown.store(true, boost::memory_order_release);
+
+	for (size_t i = 0; i < _workers.size(); i++)
+		_jobsAvailable.unlock();
+
+	_workers.clear();
+
+	// Nobody might be waiting for background jobs, but their owners expect them to run
+	Entry entry;
+	while (takeJob(0, entry))
+		runJob(entry);
+}
+
+size_t ThreadPool::getThreadCount() const {
+	return _workers.size();
+}
+
+size_t ThreadPool::getDefaultThreadCount() {
+	const int cpuCount = SDL_GetCPUCount();
+
+	return (cpuCount > 1) ? (cpuCount - 1) : 0;
+}
+
+void ThreadPool::run(const std::vector<ThreadPoolJob *> &jobs) {
+	if (jobs.empty())
+		return;
+
+	Batch batch(jobs.size());
+
+	// Spread the jobs evenly over the queues, in consecutive runs
+
+	const size_t queueCount = _queues.size();
+	const size_t first      = _nextQueue.fetch_add(1) % queueCount;
+	const size_t perQueue   = (jobs.size() + queueCount - 1) / queueCount;
+
+	for (size_t i = 0, j = 0; i < queueCount; i++) {
+		Queue &queue = *_queues[(first + i) % queueCount];
+
+		StackLock lock(queue.mutex);
+		for (size_t n = 0; (n < perQueue) && (j < jobs.size()); n++, j++) {
+			Entry entry;
+			entry.job   = jobs[j];
+			entry.batch = &batch;
+
+			queue.entries.push_back(entry);
+		}
+	}
+
+	for (size_t i = 0; i < jobs.size(); i++)
+		_jobsAvailable.unlock();
+
+	/* Help out until there's nothing left to take, then wait for the rest.
+	 * We only take our own jobs: a background job or another thread's batch
+	 * could take a long time, holding up our caller for no good reason. */
+
+	Entry entry;
+	while ((batch.remaining.load() > 0) && takeJob(first, entry, &batch))
+		runJob(entry);
+
+	batch.done.lock();
+
+	if (batch.failed)
+		throw batch.error;
+}
+
+void ThreadPool::queue(ThreadPoolJob *job) {
+	assert(job);
+
+	Entry entry;
+	entry.job   = job;
+	entry.batch = 0;
+
+	if (_workers.empty()) {
+		runJob(entry);
+		return;
+	}
+
+	{
+		Queue &queue = *_queues[_nextQueue.fetch_add(1) % _queues.size()];
+
+		StackLock lock(queue.mutex);
+		queue.entries.push_back(entry);
+	}
+
+	_jobsAvailable.unlock();
+}
+
+bool ThreadPool::takeJob(size_t preferred, Entry &entry, const Batch *batch) {
+	const size_t queueCount = _queues.size();
+
+	// Our own queue, from the front
+	if (takeJob(*_queues[preferred % queueCount], true, entry, batch))
+		return true;
+
+	// Steal from the other queues, from the back
+	for (size_t i = 1; i < queueCount; i++)
+		if (takeJob(*_queues[(preferred + i) % queueCount], false, entry, batch))
+			return true;
+
+	return false;
+}
+
+bool ThreadPool::takeJob(Queue &queue, bool front, Entry &entry, const Batch *batch) {
+	StackLock lock(queue.mutex);
+
+	if (front) {
+		for (std::deque<Entry>::iterator e = queue.entries.begin(); e != queue.entries.end(); ++e) {
+			if (batch && (e->batch != batch))
+				continue;
+
+			entry = *e;
+			queue.entries.erase(e);
+			return true;
+		}
+
+		return false;
+	}
+
+	for (std::deque<Entry>::reverse_iterator e = queue.entries.rbegin(); e != queue.entries.rend(); ++e) {
+		if (batch && (e->batch != batch))
+			continue;
+
+		entry = *e;
+		queue.entries.erase(--e.base());
+		return true;
+	}
+
+	return false;
+}
+
+void ThreadPool::runJob(const Entry &entry) {
+	if (!entry.batch) {
+		try {
+			entry.job->run();
+		} catch (...) {
+			Common::exceptionDispatcherWarning("Background thread pool job failed");
+		}
+
+		return;
+	}
+
+	Batch &batch = *entry.batch;
+
+	try {
+		entry.job->run();
+	} catch (...) {
+		Exception e;
+
+		try {
+			throw;
+		} catch (Exception &se) {
+			e = se;
+		} catch (std::exception &se) {
+			e = Exception(se);
+		} catch (...) {
+			e = Exception("Unknown exception in thread pool job");
+		}
+
+		StackLock lock(batch.errorMutex);
+		if (!batch.failed) {
+			batch.failed = true;
+			batch.error  = e;
+		}
+	}
+
+	// The last job to finish wakes up the thread waiting for the batch
+	if (batch.remaining.fetch_sub(1) == 1)
+		batch.done.unlock();
+}
+
+} // End of namespace Common
@@ -0,0 +1,150 @@
+/* xoreos - A reimplementation of BioWare's Aurora engine
+ *
+ * xoreos is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * xoreos is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * xoreos is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with xoreos. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  A pool of worker threads.
+ */
+
+#ifndef COMMON_THREADPOOL_H
+#define COMMON_THREADPOOL_H
+
+#include "src/common/atomic.h"
+
+#include <vector>
+#include <deque>
+
+#include <boost/noncopyable.hpp>
+
+#include "src/common/types.h"
+#include "src/common/scopedptr.h"
+#include "src/common/ptrvector.h"
+#include "src/common/mutex.h"
+#include "src/common/thread.h"
+
+namespace Common {
+
+/** A unit of work that can be run by a ThreadPool. */
+class ThreadPoolJob {
+public:
+	virtual ~ThreadPoolJob();
+
+	virtual void run() = 0;
+};
+
+/** A pool of worker threads, running batches of jobs.
+ *
+ *  Each worker has its own queue of jobs. A batch is spread evenly over
+ *  these queues; each worker takes jobs from the front of its own queue,
+ *  and when that runs dry, steals jobs from the back of the others. The
+ *  thread that submitted the batch works along on the jobs of its own
+ *  batch, never on those of other batches, until the batch is done.
+ *
+ *  Several threads may submit batches at the same time.
+ *
+ *  Single jobs can also be queued to run in the background, without
+ *  waiting for them to finish.
+ */
+class ThreadPool : boost::noncopyable {
+public:
+	/** Create a pool with that many worker threads.
+	 *
+	 *  A pool without any worker threads runs all jobs in the submitting thread.
+	 */
+	ThreadPool(size_t threadCount);
+	~ThreadPool();
+
+	/** Return the number of worker threads in this pool. */
+	size_t getThreadCount() const;
+
+	/** Run all these jobs and wait for them to finish.
+	 *
+	 *  If any of the jobs throws an exception, the first one is rethrown
+	 *  here after all the other jobs have finished.
+	 */
+	void run(const std::vector<ThreadPoolJob *> &jobs);
+
+	/** Queue this job to be run in the background, and return immediately.
+	 *
+	 *  The job has to stay valid until it has run; it is not deleted by the
+	 *  pool. Exceptions thrown by the job are printed as warnings. Jobs still
+	 *  queued when the pool is destroyed are run by the destructor.
+	 *
+	 *  A pool without any worker threads runs the job right away.
+	 */
+	void queue(ThreadPoolJob *job);
+
+	/** Return a good number of worker threads: one fewer than the number of CPU cores. */
+	static size_t getDefaultThreadCount();
+
+private:
+	struct Batch;
+
+	/** A job in one of the queues, together with the batch it belongs to. */
+	struct Entry {
+		ThreadPoolJob *job;
+		Batch *batch; ///< 0 for jobs queued in the background.
+	};
+
+	/** A worker's queue of jobs. */
+	struct Queue {
+		Mutex mutex;
+		std::deque<Entry> entries;
+	};
+
+	class Worker : public Thread {
+	public:
+		Worker(ThreadPool &pool, size_t index);
+		~Worker();
+
+	private:
+		ThreadPool *_pool;
+		size_t _index;
+
+		void threadMethod();
+	};
+
+	PtrVector<Queue>  _queues;
+	PtrVector<Worker> _workers;
+
+	/** Counts the queued jobs, to wake up sleeping workers. */
+	Semaphore _jobsAvailable;
+
+	/** The queue the next batch starts filling. */
+	boost::atomic<size_t> _nextQueue;
+
+	boost::atomic<size_t> _runningWorkers;
+	boost::atomic<bool>   _shutdown;
+
+	/** Take a job, from the preferred queue first, then from all the others.
+	 *
+	 *  If a batch is given, only take jobs belonging to that batch.
+	 */
+	bool takeJob(size_t preferred, Entry &entry, const Batch *batch = 0);
+	/** Take a job from this queue, from the front or the back. */
+	static bool takeJob(Queue &queue, bool front, Entry &entry, const Batch *batch);
+	/** Run a job and mark it as finished in its batch. */
+	void runJob(const Entry &entry);
+
+	friend class Worker;
+};
+
+} // End of namespace Common
+
+#endif // COMMON_THREADPOOL_H
@@ -0,0 +1,107 @@
+/* xoreos - A reimplementation of BioWare's Aurora engine
+ *
+ * xoreos is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * xoreos is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * xoreos is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with xoreos. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  A lock-free triple buffer, handing data from one thread to another.
+ */
+
+#ifndef COMMON_TRIPLEBUFFER_H
+#define COMMON_TRIPLEBUFFER_H
+
+#include "src/common/atomic.h"
+
+#include <boost/noncopyable.hpp>
+
+#include "src/common/types.h"
+
+namespace Common {
+
+/** A lock-free triple buffer.
+ *
+ *  A single producer thread writes into the back buffer and publishes it
+ *  when complete. A single consumer thread picks up the most recently
+ *  published buffer and reads it at its leisure. Neither side ever waits
+ *  for the other: the third buffer sits in the middle and is atomically
+ *  swapped with the back buffer on publish and with the front buffer on
+ *  update.
+ *
+ *  If the producer publishes several times before the consumer updates,
+ *  only the newest buffer reaches the consumer. The contents of the back
+ *  buffer after a publish are whatever an older buffer held, so the producer
+ *  needs to fully rewrite it every time.
+ */
+template<typename T>
+class TripleBuffer : boost::noncopyable {
+public:
+	TripleBuffer() : _state(1), _back(0), _front(2) {
+	}
+
+	/** Return the buffer the producer is writing into. */
+	T &getBack() {
+		return _buffers[_back];
+	}
+
+	/** Publish the back buffer, making it available to the consumer.
+	 *
+	 *  Must only be called from the producer thread.
+	 */
+	void publish() {
+		const uint8 old = _state.exchange(_back | kFresh, boost::memory_order_acq_rel);
+
+		_back = old & kIndexMask;
+	}
+
+	/** Make the most recently published buffer the front buffer.
+	 *
+	 *  Must only be called from the consumer thread.
+	 *
+	 *  @return true if a new buffer was published since the last update.
+	 */
+	bool update() {
+		if (!(_state.load(boost::memory_order_relaxed) & kFresh))
+			return false;
+
+		const uint8 old = _state.exchange(_front, boost::memory_order_acq_rel);
+
+		_front = old & kIndexMask;
+		return true;
+	}
+
+	/** Return the buffer the consumer is reading from. */
+	T &getFront() {
+		return _buffers[_front];
+	}
+
+private:
+	static const uint8 kIndexMask = 0x03;
+	static const uint8 kFresh     = 0x04;
+
+	T _buffers[3];
+
+	/** Index of the middle buffer, and whether it holds unread data. */
+	boost::atomic<uint8> _state;
+
+	uint8 _back;  ///< Index of the buffer owned by the producer.
+	uint8 _front; ///< Index of the buffer owned by the consumer.
+};
+
+} // End of namespace Common
+
+#endif // COMMON_TRIPLEBUFFER_H
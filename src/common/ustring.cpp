@@ -34,7 +34,7 @@
 
 namespace Common {
 
-UString::UString() : _size(0) {
+UString::UString() : _size(0), _hashIgnoreCase(0), _ascii(true) {
 }
 
 UString::UString(const UString &str) {
@@ -53,12 +53,12 @@ UString::UString(const char *str, size_t n) {
 	*this = std::string(str, n);
 }
 
-UString::UString(uint32 c, size_t n) : _size(0) {
+UString::UString(uint32 c, size_t n) : _size(0), _hashIgnoreCase(0), _ascii(true) {
 	while (n-- > 0)
 		*this += c;
 }
 
-UString::UString(iterator sBegin, iterator sEnd) : _size(0) {
+UString::UString(iterator sBegin, iterator sEnd) : _size(0), _hashIgnoreCase(0), _ascii(true) {
 	for (; (sBegin != sEnd) && *sBegin; ++sBegin)
 		*this += *sBegin;
 }
@@ -70,13 +70,16 @@ UString &UString::operator=(const UString &str) {
 	_string = str._string;
 	_size   = str._size;
 
+	_hashIgnoreCase = str._hashIgnoreCase;
+	_ascii          = str._ascii;
+
 	return *this;
 }
 
 UString &UString::operator=(const std::string &str) {
 	_string = str;
 
-	recalculateSize();
+	recalculate();
 
 	return *this;
 }
@@ -88,11 +91,11 @@ UString &UString::operator=(const char *str) {
 }
 
 bool UString::operator==(const UString &str) const {
-	return strcmp(str) == 0;
+	return equals(str);
 }
 
 bool UString::operator!=(const UString &str) const {
-	return strcmp(str) != 0;
+	return !equals(str);
 }
 
 bool UString::operator<(const UString &str) const {
@@ -139,6 +142,9 @@ UString &UString::operator+=(const UString &str) {
 	_string += str._string;
 	_size   += str._size;
 
+	hashLower(_hashIgnoreCase, str._string, str._ascii);
+	_ascii = _ascii && str._ascii;
+
 	return *this;
 }
 
@@ -164,10 +170,19 @@ UString &UString::operator+=(uint32 c) {
 
 	_size++;
 
+	boost::hash_combine<uint32>(_hashIgnoreCase, toLower(c));
+	_ascii = _ascii && isASCII(c);
+
 	return *this;
 }
 
 int UString::strcmp(const UString &str) const {
+	if (_ascii && str._ascii) {
+		const int cmp = _string.compare(str._string);
+
+		return (cmp < 0) ? -1 : ((cmp > 0) ? 1 : 0);
+	}
+
 	UString::iterator it1 = begin();
 	UString::iterator it2 = str.begin();
 	for (; (it1 != end()) && (it2 != str.end()); ++it1, ++it2) {
@@ -190,6 +205,25 @@ int UString::strcmp(const UString &str) const {
 }
 
 int UString::stricmp(const UString &str) const {
+	if (_ascii && str._ascii) {
+		const size_t length = MIN(_string.size(), str._string.size());
+
+		for (size_t i = 0; i < length; i++) {
+			const uint32 c1 = toLower((byte) _string[i]);
+			const uint32 c2 = toLower((byte) str._string[i]);
+
+			if (c1 < c2)
+				return -1;
+			if (c1 > c2)
+				return  1;
+		}
+
+		if (_string.size() == str._string.size())
+			return 0;
+
+		return (_string.size() < str._string.size()) ? -1 : 1;
+	}
+
 	UString::iterator it1 = begin();
 	UString::iterator it2 = str.begin();
 	for (; (it1 != end()) && (it2 != str.end()); ++it1, ++it2) {
@@ -212,10 +246,14 @@ int UString::stricmp(const UString &str) const {
 }
 
 bool UString::equals(const UString &str) const {
-	return strcmp(str) == 0;
+	// The same characters always have the same UTF-8 encoding
+	return (_size == str._size) && (_string == str._string);
 }
 
 bool UString::equalsIgnoreCase(const UString &str) const {
+	if ((_size != str._size) || (_hashIgnoreCase != str._hashIgnoreCase))
+		return false;
+
 	return stricmp(str) == 0;
 }
 
@@ -230,18 +268,31 @@ bool UString::lessIgnoreCase(const UString &str) const {
 void UString::swap(UString &str) {
 	_string.swap(str._string);
 
-	SWAP(_size, str._size);
+	SWAP(_size          , str._size);
+	SWAP(_hashIgnoreCase, str._hashIgnoreCase);
+	SWAP(_ascii         , str._ascii);
 }
 
 void UString::clear() {
 	_string.clear();
-	_size = 0;
+
+	_size           = 0;
+	_hashIgnoreCase = 0;
+	_ascii          = true;
 }
 
 size_t UString::size() const {
 	return _size;
 }
 
+bool UString::isASCII() const {
+	return _ascii;
+}
+
+size_t UString::hashIgnoreCase() const {
+	return _hashIgnoreCase;
+}
+
 bool UString::empty() const {
 	return _string.empty() || (_string[0] == '\0');
 }
@@ -389,7 +440,7 @@ void UString::trim() {
 			break;
 
 	_string = std::string(itStart.base(), itEnd.base());
-	recalculateSize();
+	recalculate();
 }
 
 void UString::trimLeft() {
@@ -404,7 +455,7 @@ void UString::trimLeft() {
 			break;
 
 	_string = std::string(itStart.base(), end().base());
-	recalculateSize();
+	recalculate();
 }
 
 void UString::trimRight() {
@@ -429,7 +480,7 @@ void UString::trimRight() {
 	}
 
 	_string = std::string(begin().base(), itEnd.base());
-	recalculateSize();
+	recalculate();
 }
 
 void UString::replaceAll(uint32 what, uint32 with) {
@@ -464,10 +515,14 @@ void UString::replaceAll(uint32 what, uint32 with) {
 		Exception e(se);
 		throw e;
 	}
+
+	recalculate();
 }
 
 void UString::replaceAll(const UString &what, const UString &with) {
 	boost::replace_all(_string, what._string, with._string);
+
+	recalculate();
 }
 
 void UString::makeLower() {
@@ -479,6 +534,16 @@ void UString::makeUpper() {
 }
 
 UString UString::toLower() const {
+	if (_ascii) {
+		// Only ASCII characters, so we can just lowercase the bytes
+		UString str(*this);
+
+		for (std::string::iterator it = str._string.begin(); it != str._string.end(); ++it)
+			*it = (char) toLower((byte) *it);
+
+		return str;
+	}
+
 	UString str;
 
 	str._string.reserve(_string.size());
@@ -489,6 +554,16 @@ UString UString::toLower() const {
 }
 
 UString UString::toUpper() const {
+	if (_ascii) {
+		// Only ASCII characters, so we can just uppercase the bytes
+		UString str(*this);
+
+		for (std::string::iterator it = str._string.begin(); it != str._string.end(); ++it)
+			*it = (char) toUpper((byte) *it);
+
+		return str;
+	}
+
 	UString str;
 
 	str._string.reserve(_string.size());
@@ -499,12 +574,18 @@ UString UString::toUpper() const {
 }
 
 UString::iterator UString::getPosition(size_t n) const {
+	if (_ascii)
+		return iterator(_string.begin() + MIN(n, _string.size()), _string.begin(), _string.end());
+
 	iterator it = begin();
 	for (size_t i = 0; (i < n) && (it != end()); i++, ++it);
 	return it;
 }
 
 size_t UString::getPosition(iterator it) const {
+	if (_ascii)
+		return it.base() - _string.begin();
+
 	size_t n = 0;
 	for (iterator i = begin(); i != it; ++i, n++);
 	return n;
@@ -753,33 +834,64 @@ size_t UString::split(const UString &text, uint32 delim, std::vector<UString> &t
 	return length;
 }
 
-void UString::recalculateSize() {
-	try {
-		// Calculate the "distance" in characters from the beginning and end
-		_size = utf8::distance(_string.begin(), _string.end());
-	} catch (const std::exception &se) {
-		Exception e(se);
-		throw e;
+void UString::recalculate() {
+	_ascii = true;
+	for (std::string::const_iterator it = _string.begin(); it != _string.end(); ++it) {
+		if (!isASCII((byte) *it)) {
+			_ascii = false;
+			break;
+		}
 	}
+
+	if (_ascii) {
+		// One byte per character
+		_size = _string.size();
+
+	} else {
+
+		try {
+			// Calculate the "distance" in characters from the beginning and end
+			_size = utf8::distance(_string.begin(), _string.end());
+		} catch (const std::exception &se) {
+			Exception e(se);
+			throw e;
+		}
+	}
+
+	_hashIgnoreCase = 0;
+	hashLower(_hashIgnoreCase, _string, _ascii);
+}
+
+void UString::hashLower(size_t &seed, const std::string &str, bool ascii) {
+	if (ascii) {
+		for (std::string::const_iterator it = str.begin(); it != str.end(); ++it)
+			boost::hash_combine<uint32>(seed, toLower((byte) *it));
+
+		return;
+	}
+
+	iterator end(str.end(), str.begin(), str.end());
+	for (iterator it(str.begin(), str.begin(), str.end()); it != end; ++it)
+		boost::hash_combine<uint32>(seed, toLower(*it));
 }
 
 // NOTE: If we ever need uppercase<->lowercase mappings for non-ASCII
 //       characters: http://www.unicode.org/reports/tr21/tr21-5.html
 
 uint32 UString::toLower(uint32 c) {
-	if (!isASCII(c))
-		// We don't know how to lowercase that
-		return c;
+	// We don't know how to lowercase anything but ASCII
+	if ((c >= 'A') && (c <= 'Z'))
+		return c + ('a' - 'A');
 
-	return std::tolower(c);
+	return c;
 }
 
 uint32 UString::toUpper(uint32 c) {
-	if (!isASCII(c))
-		// We don't know how to uppercase that
-		return c;
+	// We don't know how to uppercase anything but ASCII
+	if ((c >= 'a') && (c <= 'z'))
+		return c - ('a' - 'A');
 
-	return std::toupper(c);
+	return c;
 }
 
 bool UString::isASCII(uint32 c) {
@@ -116,6 +116,12 @@ public:
 	/** Return the size of the string, in characters. */
 	size_t size() const;
 
+	/** Does the string only consist of (non-extended) ASCII characters? */
+	bool isASCII() const;
+
+	/** Return a hash of the lowercased string, as used by hashUStringCaseInsensitive. */
+	size_t hashIgnoreCase() const;
+
 	/** Is the string empty? */
 	bool empty() const;
 
@@ -202,9 +208,15 @@ public:
 private:
 	std::string _string; ///< Internal string holding the actual data.
 
-	size_t _size;
+	size_t _size;           ///< The size of the string, in characters.
+	size_t _hashIgnoreCase; ///< Hash over the lowercased characters.
+	bool   _ascii;          ///< Are all characters ASCII?
 
-	void recalculateSize();
+	/** Recalculate the size, hash and ASCII flag from the string data. */
+	void recalculate();
+
+	/** Combine the lowercased characters of this UTF-8 string into a hash seed. */
+	static void hashLower(size_t &seed, const std::string &str, bool ascii);
 };
 
 
@@ -233,12 +245,7 @@ struct hashUStringCaseSensitive {
 
 struct hashUStringCaseInsensitive {
 	size_t operator()(const UString &str) const {
-		size_t seed = 0;
-
-		for (UString::iterator it = str.begin(); it != str.end(); ++it)
-			boost::hash_combine<uint32>(seed, UString::toLower(*it));
-
-		return seed;
+		return str.hashIgnoreCase();
 	}
 };
 
@@ -33,6 +33,7 @@
 #include "src/common/filepath.h"
 #include "src/common/readline.h"
 #include "src/common/configman.h"
+#include "src/common/frametimes.h"
 
 #include "src/aurora/resman.h"
 #include "src/aurora/talkman.h"
@@ -745,6 +746,10 @@ Console::Console(Engine &engine, const Common::UString &font, int fontHeight) :
 			"Usage: setoption <option> <value>\nSet the value of a config option for this session");
 	registerCommand("showfps"    , boost::bind(&Console::cmdShowFPS    , this, _1),
 			"Usage: showfps <true/false>\nShow/Hide the frames-per-second display");
+	registerCommand("showframestats", boost::bind(&Console::cmdShowFrameStats, this, _1),
+			"Usage: showframestats <true/false>\nShow/Hide the frame time statistics display");
+	registerCommand("dumpframetimes", boost::bind(&Console::cmdDumpFrameTimes, this, _1),
+			"Usage: dumpframetimes <file>\nDump the recorded frame times as CSV to file");
 	registerCommand("listlangs"  , boost::bind(&Console::cmdListLangs  , this, _1),
 			"Usage: listlangs\nLists all languages supported by this game version");
 	registerCommand("getlang"    , boost::bind(&Console::cmdGetLang    , this, _1),
@@ -1308,6 +1313,7 @@ void Console::cmdSetOption(const CommandLine &cl) {
 
 	ConfigMan.setCommandlineKey(args[0], args[1]);
 	_engine->showFPS();
+	_engine->showFrameStats();
 
 	printf("\"%s\" = \"%s\"", args[0].c_str(), ConfigMan.getString(args[0]).c_str());
 }
@@ -1322,6 +1328,35 @@ void Console::cmdShowFPS(const CommandLine &cl) {
 	_engine->showFPS();
 }
 
+void Console::cmdShowFrameStats(const CommandLine &cl) {
+	if (cl.args.empty()) {
+		printCommandHelp(cl.cmd);
+		return;
+	}
+
+	ConfigMan.setCommandlineKey("showframestats", cl.args);
+	_engine->showFrameStats();
+}
+
+void Console::cmdDumpFrameTimes(const CommandLine &cl) {
+	if (cl.args.empty()) {
+		printCommandHelp(cl.cmd);
+		return;
+	}
+
+	Common::UString file = Common::FilePath::getUserDataFile(cl.args);
+
+	if (!dumpFrameTimes(file)) {
+		printf("Failed dumping frame times to file \"%s\"", file.c_str());
+		return;
+	}
+
+	printf("Dumped %u frame times to file \"%s\"", (uint) FrameTimesMan.getFrameCount(), file.c_str());
+	printf("p50: %.2fms, p95: %.2fms, p99: %.2fms",
+	       FrameTimesMan.getPercentile(50) / 1000.0, FrameTimesMan.getPercentile(95) / 1000.0,
+	       FrameTimesMan.getPercentile(99) / 1000.0);
+}
+
 void Console::cmdListLangs(const CommandLine &UNUSED(cl)) {
 	std::vector<Aurora::Language> langs;
 	if (_engine->detectLanguages(langs)) {
@@ -300,6 +300,8 @@ private:
 	void cmdGetOption  (const CommandLine &cl);
 	void cmdSetOption  (const CommandLine &cl);
 	void cmdShowFPS    (const CommandLine &cl);
+	void cmdShowFrameStats(const CommandLine &cl);
+	void cmdDumpFrameTimes(const CommandLine &cl);
 	void cmdListLangs  (const CommandLine &cl);
 	void cmdGetLang    (const CommandLine &cl);
 	void cmdSetLang    (const CommandLine &cl);
@@ -30,6 +30,7 @@
 #include "src/common/writefile.h"
 #include "src/common/configman.h"
 #include "src/common/debug.h"
+#include "src/common/frametimes.h"
 
 #include "src/aurora/util.h"
 #include "src/aurora/resman.h"
@@ -242,4 +243,21 @@ bool dump2DA(const Common::UString &name, const Common::UString &file) {
 	return false;
 }
 
+bool dumpFrameTimes(const Common::UString &file) {
+	Common::WriteFile frameTimes;
+	if (!frameTimes.open(file))
+		return false;
+
+	try {
+		FrameTimesMan.write(frameTimes);
+
+		frameTimes.flush();
+
+	} catch (...) {
+		return false;
+	}
+
+	return true;
+}
+
 } // End of namespace Engines
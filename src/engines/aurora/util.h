@@ -80,6 +80,9 @@ bool dumpTGA(const Common::UString &name, const Common::UString &file = "");
 /** Debug method to quickly dump a 2DA to disk. */
 bool dump2DA(const Common::UString &name, const Common::UString &file = "");
 
+/** Debug method to quickly dump the recorded frame times to disk. */
+bool dumpFrameTimes(const Common::UString &file);
+
 } // End of namespace Engines
 
 #endif // ENGINES_AURORA_UTIL_H
@@ -331,11 +331,11 @@ void Functions::getObjectByTag(Aurora::NWScript::FunctionContext &ctx) {
 
 	int nth = ctx.getParams()[1].getInt();
 
-	Common::ScopedPtr<Aurora::NWScript::ObjectSearch> search(campaign->findObjectsByTag(tag));
+	Aurora::NWScript::ObjectSearch search = campaign->findObjectsByTag(tag);
 	while (nth-- > 0)
-		search->next();
+		search.next();
 
-	ctx.getReturn() = search->get();
+	ctx.getReturn() = search.get();
 }
 
 void Functions::getNearestObject(Aurora::NWScript::FunctionContext &ctx) {
@@ -369,11 +369,11 @@ void Functions::getNearestObject(Aurora::NWScript::FunctionContext &ctx) {
 	if (count == 0)
 		return;
 
-	Common::ScopedPtr<Aurora::NWScript::ObjectSearch> search(campaign->findObjects());
+	Aurora::NWScript::ObjectSearch search = campaign->findObjects();
 	Aurora::NWScript::Object *object = 0;
 
 	std::list<Object *> objects;
-	while ((object = search->next())) {
+	while ((object = search.next())) {
 		// Needs to be a valid object and not the target
 		DragonAge2::Object *daObject = DragonAge2::ObjectContainer::toObject(object);
 		if (!daObject || (daObject == target))
@@ -429,11 +429,11 @@ void Functions::getNearestObjectByTag(Aurora::NWScript::FunctionContext &ctx) {
 	if (count == 0)
 		return;
 
-	Common::ScopedPtr<Aurora::NWScript::ObjectSearch> search(campaign->findObjectsByTag(tag));
+	Aurora::NWScript::ObjectSearch search = campaign->findObjectsByTag(tag);
 	Aurora::NWScript::Object       *object = 0;
 
 	std::list<Object *> objects;
-	while ((object = search->next())) {
+	while ((object = search.next())) {
 		// Needs to be a valid object and not the target
 		DragonAge2::Object *daObject = DragonAge2::ObjectContainer::toObject(object);
 		if (!daObject || (daObject == target))
@@ -475,11 +475,11 @@ void Functions::UT_getNearestObjectByTag(Aurora::NWScript::FunctionContext &ctx)
 		return;
 	}
 
-	Common::ScopedPtr<Aurora::NWScript::ObjectSearch> search(campaign->findObjectsByTag(tag));
+	Aurora::NWScript::ObjectSearch search = campaign->findObjectsByTag(tag);
 	Aurora::NWScript::Object *object = 0;
 
 	std::list<Object *> objects;
-	while ((object = search->next())) {
+	while ((object = search.next())) {
 		// Needs to be a valid object and not the target
 		DragonAge2::Object *daObject = DragonAge2::ObjectContainer::toObject(object);
 		if (!daObject || (daObject == target))
@@ -28,6 +28,7 @@
 #include "src/common/configman.h"
 
 #include "src/graphics/aurora/fps.h"
+#include "src/graphics/aurora/framestats.h"
 #include "src/graphics/aurora/fontman.h"
 
 #include "src/engines/engine.h"
@@ -80,6 +81,7 @@ bool Engine::changeLanguage() {
 
 void Engine::start(Aurora::GameID game, const Common::UString &target, Aurora::Platform platform) {
 	showFPS();
+	showFrameStats();
 
 	_game     = game;
 	_platform = platform;
@@ -103,6 +105,21 @@ void Engine::showFPS() {
 	}
 }
 
+void Engine::showFrameStats() {
+	bool show = ConfigMan.getBool("showframestats", false);
+
+	if        ( show && !_frameStats) {
+
+		_frameStats.reset(new Graphics::Aurora::FrameStats(FontMan.get(Graphics::Aurora::kSystemFontMono, 13)));
+		_frameStats->show();
+
+	} else if (!show &&  _frameStats) {
+
+		_frameStats.reset();
+
+	}
+}
+
 static bool hasLanguage(const std::vector<Aurora::Language> &langs, Aurora::Language lang) {
 	return std::find(langs.begin(), langs.end(), lang) != langs.end();
 }
@@ -38,6 +38,7 @@
 namespace Graphics {
 	namespace Aurora {
 		class FPS;
+		class FrameStats;
 	}
 }
 
@@ -78,6 +79,8 @@ public:
 
 	/** Evaluate the FPS display setting and show/hide the FPS display. */
 	void showFPS();
+	/** Evaluate the frame statistics setting and show/hide the frame statistics display. */
+	void showFrameStats();
 
 protected:
 	Aurora::GameID   _game;
@@ -87,6 +90,7 @@ protected:
 	Common::ScopedPtr<Console> _console;
 
 	Common::ScopedPtr<Graphics::Aurora::FPS> _fps;
+	Common::ScopedPtr<Graphics::Aurora::FrameStats> _frameStats;
 
 
 	/** Run the game. */
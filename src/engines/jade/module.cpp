@@ -42,13 +42,8 @@ namespace Engines {
 
 namespace Jade {
 
-bool Module::Action::operator<(const Action &s) const {
-	return timestamp < s.timestamp;
-}
-
-
 Module::Module(::Engines::Console &console) : _console(&console), _hasModule(false),
-	_running(false), _exit(false) {
+	_running(false), _exit(false), _delayedActions(*this) {
 
 }
 
@@ -288,20 +283,7 @@ void Module::handleEvents() {
 }
 
 void Module::handleActions() {
-	uint32 now = EventMan.getTimestamp();
-
-	while (!_delayedActions.empty()) {
-		ActionQueue::iterator action = _delayedActions.begin();
-
-		if (now < action->timestamp)
-			break;
-
-		if (action->type == kActionScript)
-			ScriptContainer::runScript(action->script, action->state,
-			                           action->owner, action->triggerer);
-
-		_delayedActions.erase(action);
-	}
+	_delayedActions.run(EventMan.getTimestamp());
 }
 
 void Module::movePC(float x, float y, float z) {
@@ -343,16 +325,7 @@ void Module::delayScript(const Common::UString &script,
                          const Aurora::NWScript::ScriptState &state,
                          Aurora::NWScript::Object *owner,
                          Aurora::NWScript::Object *triggerer, uint32 delay) {
-	Action action;
-
-	action.type      = kActionScript;
-	action.script    = script;
-	action.state     = state;
-	action.owner     = owner;
-	action.triggerer = triggerer;
-	action.timestamp = EventMan.getTimestamp() + delay;
-
-	_delayedActions.insert(action);
+	_delayedActions.schedule(script, state, owner, triggerer, EventMan.getTimestamp() + delay);
 }
 
 } // End of namespace Jade
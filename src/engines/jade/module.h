@@ -26,7 +26,6 @@
 #define ENGINES_JADE_MODULE_H
 
 #include <list>
-#include <set>
 
 #include "src/common/scopedptr.h"
 #include "src/common/ustring.h"
@@ -34,6 +33,7 @@
 #include "src/common/configman.h"
 
 #include "src/aurora/nwscript/object.h"
+#include "src/aurora/nwscript/scheduler.h"
 
 #include "src/events/types.h"
 
@@ -129,27 +129,7 @@ public:
 	// '---
 
 private:
-	enum ActionType {
-		kActionNone   = 0,
-		kActionScript = 1
-	};
-
-	struct Action {
-		ActionType type;
-
-		Common::UString script;
-
-		Aurora::NWScript::ScriptState state;
-		Aurora::NWScript::Object *owner;
-		Aurora::NWScript::Object *triggerer;
-
-		uint32 timestamp;
-
-		bool operator<(const Action &s) const;
-	};
-
 	typedef std::list<Events::Event> EventQueue;
-	typedef std::multiset<Action> ActionQueue;
 
 
 	::Engines::Console *_console;
@@ -169,8 +149,8 @@ private:
 
 	Common::ScopedPtr<Area> _area; ///< The current module's area.
 
-	EventQueue  _eventQueue;
-	ActionQueue _delayedActions;
+	EventQueue _eventQueue;
+	Aurora::NWScript::ScriptScheduler _delayedActions;
 
 
 	// .--- Unloading
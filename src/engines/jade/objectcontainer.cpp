@@ -55,15 +55,6 @@ float ObjectDistanceSort::getDistance(Jade::Object &a) {
 }
 
 
-class SearchType : public ::Aurora::NWScript::SearchRange< std::list<Jade::Object *> > {
-public:
-	SearchType(const iterator &a, const iterator &b) : ::Aurora::NWScript::SearchRange<type>(std::make_pair(a, b)) { }
-	SearchType(const type &l) : ::Aurora::NWScript::SearchRange<type>(std::make_pair(l.begin(), l.end())) { }
-	~SearchType() { }
-
-	::Aurora::NWScript::Object *getObject(const iterator &t) { return *t; }
-};
-
 
 ObjectContainer::ObjectContainer() {
 }
@@ -71,55 +62,12 @@ ObjectContainer::ObjectContainer() {
 ObjectContainer::~ObjectContainer() {
 }
 
-void ObjectContainer::clearObjects() {
-	lock();
-
-	for (size_t i = 0; i < kObjectTypeMAX; i++)
-		_objects[i].clear();
-
-	::Aurora::NWScript::ObjectContainer::clearObjects();
-
-	unlock();
-}
-
 void ObjectContainer::addObject(Jade::Object &object) {
-	lock();
-
-	::Aurora::NWScript::ObjectContainer::addObject(object);
-
-	ObjectType type = object.getType();
-	if (((uint) type) < kObjectTypeMAX)
-		_objects[type].push_back(&object);
-
-	unlock();
+	::Aurora::NWScript::ObjectContainer::addObject(object, object.getType());
 }
 
 void ObjectContainer::removeObject(Jade::Object &object) {
-	lock();
-
-	ObjectType type = object.getType();
-	if (((uint) type) < kObjectTypeMAX)
-		_objects[type].remove(&object);
-
-	::Aurora::NWScript::ObjectContainer::removeObject(object);
-
-	unlock();
-}
-
-::Aurora::NWScript::Object *ObjectContainer::getFirstObjectByType(ObjectType type) const {
-	if (((uint) type) >= kObjectTypeMAX)
-		return 0;
-
-	SearchType ctx(_objects[type]);
-
-	return ctx.get();
-}
-
-::Aurora::NWScript::ObjectSearch *ObjectContainer::findObjectsByType(ObjectType type) const {
-	if (((uint) type) >= kObjectTypeMAX)
-		return new SearchType(_objects[0].end(), _objects[0].end());
-
-	return new SearchType(_objects[type]);
+	::Aurora::NWScript::ObjectContainer::removeObject(object, object.getType());
 }
 
 Jade::Object *ObjectContainer::toObject(::Aurora::NWScript::Object *object) {
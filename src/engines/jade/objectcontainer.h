@@ -25,8 +25,6 @@
 #ifndef ENGINES_JADE_OBJECTCONTAINER_H
 #define ENGINES_JADE_OBJECTCONTAINER_H
 
-#include <list>
-
 #include "src/common/types.h"
 
 #include "src/aurora/nwscript/objectcontainer.h"
@@ -64,19 +62,11 @@ public:
 	ObjectContainer();
 	~ObjectContainer();
 
-	void clearObjects();
-
 	/** Add an object to this container. */
 	void addObject(Jade::Object &object);
 	/** Remove an object from this container. */
 	void removeObject(Jade::Object &object);
 
-	/** Return the first object of this type. */
-	::Aurora::NWScript::Object *getFirstObjectByType(ObjectType type) const;
-
-	/** Return a search context to iterate over all objects of this type. */
-	::Aurora::NWScript::ObjectSearch *findObjectsByType(ObjectType type) const;
-
 	static Jade::Object *toObject(::Aurora::NWScript::Object *object);
 
 	static Area      *toArea     (Aurora::NWScript::Object *object);
@@ -87,11 +77,6 @@ public:
 
 	static Location *toLocation(Aurora::NWScript::EngineType *engineType);
 	static Event    *toEvent   (Aurora::NWScript::EngineType *engineType);
-
-private:
-	typedef std::list<Jade::Object *> ObjectList;
-
-	ObjectList _objects[kObjectTypeMAX];
 };
 
 } // End of namespace Jade
@@ -204,11 +204,11 @@ void Functions::getObjectByTag(Aurora::NWScript::FunctionContext &ctx) {
 
 	int nth = ctx.getParams()[1].getInt();
 
-	Common::ScopedPtr<Aurora::NWScript::ObjectSearch> search(_game->getModule().findObjectsByTag(tag));
+	Aurora::NWScript::ObjectSearch search = _game->getModule().findObjectsByTag(tag);
 	while (nth-- > 0)
-		search->next();
+		search.next();
 
-	ctx.getReturn() = search->get();
+	ctx.getReturn() = search.get();
 }
 
 void Functions::getWaypointByTag(Aurora::NWScript::FunctionContext &ctx) {
@@ -218,10 +218,10 @@ void Functions::getWaypointByTag(Aurora::NWScript::FunctionContext &ctx) {
 	if (tag.empty())
 		return;
 
-	Common::ScopedPtr<Aurora::NWScript::ObjectSearch> search(_game->getModule().findObjectsByTag(tag));
+	Aurora::NWScript::ObjectSearch search = _game->getModule().findObjectsByTag(tag);
 	Aurora::NWScript::Object *object = 0;
 
-	while ((object = search->next())) {
+	while ((object = search.next())) {
 		Waypoint *waypoint = Jade::ObjectContainer::toWaypoint(object);
 
 		if (waypoint) {
@@ -243,11 +243,11 @@ void Functions::getNearestObject(Aurora::NWScript::FunctionContext &ctx) {
 	// We want the nth nearest object
 	size_t nth  = MAX<int32>(ctx.getParams()[2].getInt() - 1, 0);
 
-	Common::ScopedPtr<Aurora::NWScript::ObjectSearch> search(_game->getModule().findObjects());
+	Aurora::NWScript::ObjectSearch search = _game->getModule().findObjects();
 	Aurora::NWScript::Object *object = 0;
 
 	std::list<Object *> objects;
-	while ((object = search->next())) {
+	while ((object = search.next())) {
 		// Needs to be a valid object, not the target, but in the target's area
 		Jade::Object *nwnObject = Jade::ObjectContainer::toObject(object);
 		if (!nwnObject || (nwnObject == target) || (nwnObject->getArea() != target->getArea()))
@@ -26,7 +26,6 @@
 #define ENGINES_KOTOR_MODULE_H
 
 #include <list>
-#include <set>
 
 #include "src/common/scopedptr.h"
 #include "src/common/ustring.h"
@@ -35,6 +34,8 @@
 
 #include "src/aurora/ifofile.h"
 
+#include "src/aurora/nwscript/scheduler.h"
+
 #include "src/graphics/aurora/fadequad.h"
 
 #include "src/events/types.h"
@@ -175,27 +176,7 @@ public:
 	void addItemToActiveObject(const Common::UString &item, int count);
 
 private:
-	enum ActionType {
-		kActionNone   = 0,
-		kActionScript = 1
-	};
-
-	struct Action {
-		ActionType type;
-
-		Common::UString script;
-
-		Aurora::NWScript::ScriptState state;
-		Aurora::NWScript::Object *owner;
-		Aurora::NWScript::Object *triggerer;
-
-		uint32 timestamp;
-
-		bool operator<(const Action &s) const;
-	};
-
 	typedef std::list<Events::Event> EventQueue;
-	typedef std::multiset<Action> ActionQueue;
 
 
 	::Engines::Console *_console;
@@ -243,8 +224,8 @@ private:
 	std::list<Creature *> _party;
 	// '---
 
-	EventQueue  _eventQueue;
-	ActionQueue _delayedActions;
+	EventQueue _eventQueue;
+	Aurora::NWScript::ScriptScheduler _delayedActions;
 
 	bool _freeCamEnabled;
 	uint32 _prevTimestamp;
@@ -55,15 +55,6 @@ float ObjectDistanceSort::getDistance(KotOR::Object &a) {
 }
 
 
-class SearchType : public ::Aurora::NWScript::SearchRange< std::list<KotOR::Object *> > {
-public:
-	SearchType(const iterator &a, const iterator &b) : ::Aurora::NWScript::SearchRange<type>(std::make_pair(a, b)) { }
-	SearchType(const type &l) : ::Aurora::NWScript::SearchRange<type>(std::make_pair(l.begin(), l.end())) { }
-	~SearchType() { }
-
-	::Aurora::NWScript::Object *getObject(const iterator &t) { return *t; }
-};
-
 
 ObjectContainer::ObjectContainer() {
 }
@@ -71,54 +62,12 @@ ObjectContainer::ObjectContainer() {
 ObjectContainer::~ObjectContainer() {
 }
 
-void ObjectContainer::clearObjects() {
-	lock();
-
-	_objects.clear();
-
-	::Aurora::NWScript::ObjectContainer::clearObjects();
-
-	unlock();
-}
-
 void ObjectContainer::addObject(KotOR::Object &object) {
-	lock();
-
-	::Aurora::NWScript::ObjectContainer::addObject(object);
-
-	_objects[object.getType()].push_back(&object);
-
-	unlock();
+	::Aurora::NWScript::ObjectContainer::addObject(object, object.getType());
 }
 
 void ObjectContainer::removeObject(KotOR::Object &object) {
-	lock();
-
-	_objects[object.getType()].remove(&object);
-
-	::Aurora::NWScript::ObjectContainer::removeObject(object);
-
-	unlock();
-}
-
-::Aurora::NWScript::Object *ObjectContainer::getFirstObjectByType(ObjectType type) const {
-	ObjectMap::const_iterator l = _objects.find(type);
-	if (l == _objects.end())
-		return 0;
-
-	SearchType ctx(l->second);
-
-	return ctx.get();
-}
-
-::Aurora::NWScript::ObjectSearch *ObjectContainer::findObjectsByType(ObjectType type) const {
-	static const ObjectList kEmptyObjectList;
-
-	ObjectMap::const_iterator l = _objects.find(type);
-	if (l == _objects.end())
-		return new SearchType(kEmptyObjectList.begin(), kEmptyObjectList.end());
-
-	return new SearchType(l->second);
+	::Aurora::NWScript::ObjectContainer::removeObject(object, object.getType());
 }
 
 KotOR::Object *ObjectContainer::toObject(::Aurora::NWScript::Object *object) {
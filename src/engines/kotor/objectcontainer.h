@@ -25,9 +25,6 @@
 #ifndef ENGINES_KOTOR_OBJECTCONTAINER_H
 #define ENGINES_KOTOR_OBJECTCONTAINER_H
 
-#include <list>
-#include <map>
-
 #include "src/common/types.h"
 
 #include "src/aurora/nwscript/objectcontainer.h"
@@ -65,19 +62,11 @@ public:
 	ObjectContainer();
 	~ObjectContainer();
 
-	void clearObjects();
-
 	/** Add an object to this container. */
 	void addObject(KotOR::Object &object);
 	/** Remove an object from this container. */
 	void removeObject(KotOR::Object &object);
 
-	/** Return the first object of this type. */
-	::Aurora::NWScript::Object *getFirstObjectByType(ObjectType type) const;
-
-	/** Return a search context to iterate over all objects of this type. */
-	::Aurora::NWScript::ObjectSearch *findObjectsByType(ObjectType type) const;
-
 	static KotOR::Object *toObject(::Aurora::NWScript::Object *object);
 
 	static Module    *toModule     (Aurora::NWScript::Object *object);
@@ -89,12 +78,6 @@ public:
 	static Creature  *toCreature   (Aurora::NWScript::Object *object);
 	static Creature  *toPC         (Aurora::NWScript::Object *object);
 	static Creature  *toPartyMember(Aurora::NWScript::Object *object);
-
-private:
-	typedef std::list<KotOR::Object *> ObjectList;
-	typedef std::map<ObjectType, ObjectList> ObjectMap;
-
-	ObjectMap _objects;
 };
 
 } // End of namespace KotOR
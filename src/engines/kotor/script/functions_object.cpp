@@ -69,12 +69,12 @@ void Functions::getObjectByTag(Aurora::NWScript::FunctionContext &ctx) {
 	Common::UString name = ctx.getParams()[0].getString();
 	int nth = ctx.getParams()[1].getInt();
 
-	Common::ScopedPtr<Aurora::NWScript::ObjectSearch> search(_game->getModule().findObjectsByTag(name));
+	Aurora::NWScript::ObjectSearch search = _game->getModule().findObjectsByTag(name);
 	for (int i = 0; i < nth; ++i) {
-		search->next();
+		search.next();
 	}
 
-	ctx.getReturn() = search->get();
+	ctx.getReturn() = search.get();
 }
 
 void Functions::getMinOneHP(Aurora::NWScript::FunctionContext &ctx) {
@@ -62,11 +62,6 @@ namespace KotOR2 {
 
 static const float kPCMovementSpeed = 5;
 
-bool Module::Action::operator<(const Action &s) const {
-	return timestamp < s.timestamp;
-}
-
-
 Module::Module(::Engines::Console &console)
 		: Object(kObjectTypeModule),
 		  _console(&console),
@@ -76,6 +71,7 @@ Module::Module(::Engines::Console &console)
 		  _exit(false),
 		  _entryLocationType(kObjectTypeAll),
 		  _dialog(new DialogGUI(*this)),
+		  _delayedActions(*this, this),
 		  _freeCamEnabled(false),
 		  _prevTimestamp(0),
 		  _frameTime(0),
@@ -366,12 +362,12 @@ bool Module::getObjectLocation(const Common::UString &object, ObjectType locatio
 	if (object.empty())
 		return false;
 
-	Common::ScopedPtr<Aurora::NWScript::ObjectSearch> search(findObjectsByTag(object));
+	Aurora::NWScript::ObjectSearch search = findObjectsByTag(object);
 
 
 	KotOR2::Object *kotorObject = 0;
-	while (!kotorObject && search->get()) {
-		kotorObject = KotOR2::ObjectContainer::toObject(search->next());
+	while (!kotorObject && search.get()) {
+		kotorObject = KotOR2::ObjectContainer::toObject(search.next());
 		if (!kotorObject || !(kotorObject->getType() & location))
 			kotorObject = 0;
 	}
@@ -536,20 +532,7 @@ void Module::handleEvents() {
 }
 
 void Module::handleActions() {
-	uint32 now = EventMan.getTimestamp();
-
-	while (!_delayedActions.empty()) {
-		ActionQueue::iterator action = _delayedActions.begin();
-
-		if (now < action->timestamp)
-			break;
-
-		if (action->type == kActionScript)
-			ScriptContainer::runScript(action->script, action->state,
-			                           action->owner, action->triggerer);
-
-		_delayedActions.erase(action);
-	}
+	_delayedActions.run(EventMan.getTimestamp());
 }
 
 void Module::handlePCMovement() {
@@ -651,16 +634,7 @@ void Module::delayScript(const Common::UString &script,
                          const Aurora::NWScript::ScriptState &state,
                          Aurora::NWScript::Object *owner,
                          Aurora::NWScript::Object *triggerer, uint32 delay) {
-	Action action;
-
-	action.type      = kActionScript;
-	action.script    = script;
-	action.state     = state;
-	action.owner     = owner;
-	action.triggerer = triggerer;
-	action.timestamp = EventMan.getTimestamp() + delay;
-
-	_delayedActions.insert(action);
+	_delayedActions.schedule(script, state, owner, triggerer, EventMan.getTimestamp() + delay);
 }
 
 Common::UString Module::getName(const Common::UString &module) {
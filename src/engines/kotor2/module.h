@@ -26,7 +26,6 @@
 #define ENGINES_KOTOR2_MODULE_H
 
 #include <list>
-#include <set>
 
 #include "src/common/scopedptr.h"
 #include "src/common/ustring.h"
@@ -35,6 +34,8 @@
 
 #include "src/aurora/ifofile.h"
 
+#include "src/aurora/nwscript/scheduler.h"
+
 #include "src/events/types.h"
 
 #include "src/engines/kotor2/objectcontainer.h"
@@ -136,27 +137,7 @@ public:
 	                                 const Common::UString &headAnim);
 
 private:
-	enum ActionType {
-		kActionNone   = 0,
-		kActionScript = 1
-	};
-
-	struct Action {
-		ActionType type;
-
-		Common::UString script;
-
-		Aurora::NWScript::ScriptState state;
-		Aurora::NWScript::Object *owner;
-		Aurora::NWScript::Object *triggerer;
-
-		uint32 timestamp;
-
-		bool operator<(const Action &s) const;
-	};
-
 	typedef std::list<Events::Event> EventQueue;
-	typedef std::multiset<Action> ActionQueue;
 
 
 	::Engines::Console *_console;
@@ -190,8 +171,8 @@ private:
 	Common::ScopedPtr<Area> _area; ///< The current module's area.
 	Common::ScopedPtr<DialogGUI> _dialog; ///< Conversation/cutscene GUI.
 
-	EventQueue  _eventQueue;
-	ActionQueue _delayedActions;
+	EventQueue _eventQueue;
+	Aurora::NWScript::ScriptScheduler _delayedActions;
 
 	bool _freeCamEnabled;
 	uint32 _prevTimestamp;
@@ -35,6 +35,7 @@
 
 #include "src/graphics/aurora/cursorman.h"
 #include "src/graphics/aurora/model.h"
+#include "src/graphics/aurora/instancedmodel.h"
 
 #include "src/sound/sound.h"
 
@@ -93,9 +94,7 @@ void Area::clear() {
 	_objects.clear();
 
 	// Delete tiles and tileset
-	for (std::vector<Tile>::iterator t = _tiles.begin(); t != _tiles.end(); ++t)
-		delete t->model;
-
+	_tileModels.clear();
 	_tiles.clear();
 
 	_tileset.reset();
@@ -227,8 +226,8 @@ void Area::show() {
 	GfxMan.lockFrame();
 
 	// Show tiles
-	for (std::vector<Tile>::iterator t = _tiles.begin(); t != _tiles.end(); ++t)
-		t->model->show();
+	for (TileModelMap::iterator t = _tileModels.begin(); t != _tileModels.end(); ++t)
+		t->second->show();
 
 	// Show objects
 	for (ObjectList::iterator o = _objects.begin(); o != _objects.end(); ++o)
@@ -258,8 +257,8 @@ void Area::hide() {
 		(*o)->hide();
 
 	// Hide tiles
-	for (std::vector<Tile>::iterator t = _tiles.begin(); t != _tiles.end(); ++t)
-		t->model->hide();
+	for (TileModelMap::iterator t = _tileModels.begin(); t != _tileModels.end(); ++t)
+		t->second->hide();
 
 	GfxMan.unlockFrame();
 
@@ -383,8 +382,7 @@ void Area::loadTile(const Aurora::GFF3Struct &t, Tile &tile) {
 	tile.animLoop[1] = t.getBool("Tile_AnimLoop2", false);
 	tile.animLoop[2] = t.getBool("Tile_AnimLoop3", false);
 
-	tile.tile  = 0;
-	tile.model = 0;
+	tile.tile = 0;
 }
 
 void Area::loadModels() {
@@ -450,9 +448,19 @@ void Area::loadTiles() {
 
 			t.tile = &_tileset->getTile(t.tileID);
 
-			t.model = loadModelObject(t.tile->model);
-			if (!t.model)
-				throw Common::Exception("Can't load tile model \"%s\"", t.tile->model.c_str());
+			/* Most tiles in an area share their model with many others, so we
+			 * load each model only once and render all its tiles as instances. */
+
+			TileModelMap::iterator model = _tileModels.find(t.tile->model);
+			if (model == _tileModels.end()) {
+				Common::ScopedPtr<Graphics::Aurora::Model> tileModel(loadModelObject(t.tile->model));
+				if (!tileModel)
+					throw Common::Exception("Can't load tile model \"%s\"", t.tile->model.c_str());
+
+				Graphics::Aurora::InstancedModel *instanced = new Graphics::Aurora::InstancedModel(tileModel.release());
+
+				model = _tileModels.insert(std::make_pair(t.tile->model, instanced)).first;
+			}
 
 			// A tile is 10 units wide and deep.
 			// There's extra special 5x5 tiles at the edges.
@@ -462,25 +470,16 @@ void Area::loadTiles() {
 			// The actual height of a tile is dictated by the tileset.
 			const float tileZ = t.height * _tileset->getTilesHeight();
 
-			t.model->setPosition(tileX, tileY, tileZ);
-			t.model->setOrientation(0.0f, 0.0f, 1.0f, ((int) t.orientation) * 90.0f);
+			model->second->addInstance(tileX, tileY, tileZ, ((int) t.orientation) * 90.0f);
 		}
 	}
 }
 
 void Area::unloadTiles() {
-	for (uint32 y = 0; y < _height; y++) {
-		for (uint32 x = 0; x < _width; x++) {
-			uint32 n = y * _width + x;
-
-			Tile &t = _tiles[n];
-
-			t.tile = 0;
+	for (std::vector<Tile>::iterator t = _tiles.begin(); t != _tiles.end(); ++t)
+		t->tile = 0;
 
-			delete t.model;
-			t.model = 0;
-		}
-	}
+	_tileModels.clear();
 }
 
 void Area::loadObject(NWN::Object &object) {
@@ -31,6 +31,7 @@
 
 #include "src/common/types.h"
 #include "src/common/ptrlist.h"
+#include "src/common/ptrmap.h"
 #include "src/common/ustring.h"
 #include "src/common/mutex.h"
 
@@ -143,10 +144,11 @@ private:
 		bool animLoop[3]; ///< Should the tile's AnimLoop0[123] play?
 
 		const Tileset::Tile *tile; ///< The actual tile within the tileset.
-
-		Graphics::Aurora::Model *model; ///< The tile's model.
 	};
 
+	/** The models of the tiles, shared by all tiles with the same model. */
+	typedef Common::PtrMap<Common::UString, Graphics::Aurora::InstancedModel> TileModelMap;
+
 	typedef Common::PtrList<NWN::Object> ObjectList;
 	typedef std::map<uint32, NWN::Object *> ObjectMap;
 
@@ -187,6 +189,8 @@ private:
 
 	std::vector<Tile> _tiles; ///< The area's tiles.
 
+	TileModelMap _tileModels; ///< The area's tile models, indexed by model name.
+
 	ObjectList _objects;   ///< List of all objects in the area.
 	ObjectMap  _objectMap; ///< Map of all non-static objects in the area.
 
@@ -109,6 +109,8 @@ public:
 		GfxMan.unlockFrame();
 	}
 
+	using Graphics::Aurora::Model_NWN::render;
+
 	void render(Graphics::RenderPass pass) {
 		bool isTransparent = _fadeValue < 1.0f;
 		if (((pass == Graphics::kRenderPassOpaque     ) &&  isTransparent) ||
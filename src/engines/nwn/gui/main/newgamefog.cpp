@@ -24,6 +24,8 @@
 
 #include <cstdlib>
 
+#include "glm/gtc/matrix_transform.hpp"
+
 #include "src/common/scopedptr.h"
 #include "src/common/maths.h"
 #include "src/common/readstream.h"
@@ -74,16 +76,20 @@ public:
 	~NewGameFog() {
 	}
 
-	void render(Graphics::RenderPass pass) {
+	using Graphics::Aurora::Model_NWN::render;
+
+	void render(Graphics::RenderPass pass, const glm::mat4 &modelview) {
 		if (pass == Graphics::kRenderPassTransparent)
 			return;
 
 		uint32 curTime = EventMan.getTimestamp();
 
 		uint32 diffRotate = curTime - _timeRotate;
-		glRotatef(diffRotate / _rotateSpeed, 0.0f, 0.0f, -1.0f);
 
-		glScalef(_curZoom, _curZoom, 1.0f);
+		glm::mat4 transform = modelview;
+		transform = glm::rotate(transform, Common::deg2rad(diffRotate / _rotateSpeed), glm::vec3(0.0f, 0.0f, -1.0f));
+		transform = glm::scale(transform, glm::vec3(_curZoom, _curZoom, 1.0f));
+
 		_curZoom += ((curTime - _lastTime) / 3000.0f) * _curZoom;
 
 		if (_curFade >= 1.0f)
@@ -97,7 +103,7 @@ public:
 
 		glColor4f(1.0f, 1.0f, 1.0f, _curFade);
 
-		Graphics::Aurora::Model_NWN::render(pass);
+		Graphics::Aurora::Model_NWN::render(pass, transform);
 
 		glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
 
@@ -149,7 +149,7 @@ void Portrait::calculateDistance() {
 
 void Portrait::render(Graphics::RenderPass pass) {
 	bool isTransparent = (_bA < 1.0f) ||
-	                     (!_texture.empty() && _texture.getTexture().hasAlpha());
+	                     (!_texture.empty() && _texture.getTexture().hasUploadedAlpha());
 	if (((pass == Graphics::kRenderPassOpaque)      &&  isTransparent) ||
 			((pass == Graphics::kRenderPassTransparent) && !isTransparent))
 		return;
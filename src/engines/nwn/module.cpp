@@ -97,14 +97,10 @@ namespace Engines {
 
 namespace NWN {
 
-bool Module::Action::operator<(const Action &s) const {
-	return timestamp < s.timestamp;
-}
-
-
 Module::Module(::Engines::Console &console, const Version &gameVersion) : Object(kObjectTypeModule),
 	_console(&console), _gameVersion(&gameVersion), _hasModule(false),
-	_running(false), _currentTexturePack(-1), _exit(false), _currentArea(0) {
+	_running(false), _currentTexturePack(-1), _exit(false), _currentArea(0),
+	_delayedActions(*this, this) {
 
 	_ingameGUI.reset(new IngameGUI(*this, _console));
 }
@@ -514,20 +510,7 @@ void Module::handleEvents() {
 }
 
 void Module::handleActions() {
-	uint32 now = EventMan.getTimestamp();
-
-	while (!_delayedActions.empty()) {
-		ActionQueue::iterator action = _delayedActions.begin();
-
-		if (now < action->timestamp)
-			break;
-
-		if (action->type == kActionScript)
-			ScriptContainer::runScript(action->script, action->state,
-			                           action->owner, action->triggerer);
-
-		_delayedActions.erase(action);
-	}
+	_delayedActions.run(EventMan.getTimestamp());
 }
 
 void Module::unload(bool completeUnload) {
@@ -547,7 +530,7 @@ void Module::unload(bool completeUnload) {
 
 void Module::unloadModule() {
 	runScript(kScriptExit, this, _pc.get());
-	handleActions();
+	_delayedActions.runAll(EventMan.getTimestamp());
 
 	_eventQueue.clear();
 	_delayedActions.clear();
@@ -757,16 +740,7 @@ void Module::delayScript(const Common::UString &script,
                          const Aurora::NWScript::ScriptState &state,
                          Aurora::NWScript::Object *owner,
                          Aurora::NWScript::Object *triggerer, uint32 delay) {
-	Action action;
-
-	action.type      = kActionScript;
-	action.script    = script;
-	action.state     = state;
-	action.owner     = owner;
-	action.triggerer = triggerer;
-	action.timestamp = EventMan.getTimestamp() + delay;
-
-	_delayedActions.insert(action);
+	_delayedActions.schedule(script, state, owner, triggerer, EventMan.getTimestamp() + delay);
 }
 
 Common::UString Module::getDescriptionExtra(Common::UString module) {
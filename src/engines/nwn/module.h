@@ -27,7 +27,6 @@
 
 #include <list>
 #include <map>
-#include <set>
 
 #include "src/common/scopedptr.h"
 #include "src/common/ptrmap.h"
@@ -36,6 +35,8 @@
 
 #include "src/aurora/ifofile.h"
 
+#include "src/aurora/nwscript/scheduler.h"
+
 #include "src/graphics/aurora/types.h"
 
 #include "src/events/types.h"
@@ -147,29 +148,9 @@ public:
 	// '---
 
 private:
-	enum ActionType {
-		kActionNone   = 0,
-		kActionScript = 1
-	};
-
-	struct Action {
-		ActionType type;
-
-		Common::UString script;
-
-		Aurora::NWScript::ScriptState state;
-		Aurora::NWScript::Object *owner;
-		Aurora::NWScript::Object *triggerer;
-
-		uint32 timestamp;
-
-		bool operator<(const Action &s) const;
-	};
-
 	typedef Common::PtrMap<Common::UString, Area> AreaMap;
 
 	typedef std::list<Events::Event> EventQueue;
-	typedef std::multiset<Action> ActionQueue;
 
 
 	::Engines::Console *_console;
@@ -205,8 +186,8 @@ private:
 
 	Common::UString _newModule; ///< The module we should change to.
 
-	EventQueue  _eventQueue;
-	ActionQueue _delayedActions;
+	EventQueue _eventQueue;
+	Aurora::NWScript::ScriptScheduler _delayedActions;
 
 
 	// .--- Unloading
@@ -25,9 +25,6 @@
 #ifndef ENGINES_NWN_OBJECTCONTAINER_H
 #define ENGINES_NWN_OBJECTCONTAINER_H
 
-#include <list>
-#include <map>
-
 #include "src/common/types.h"
 
 #include "src/aurora/nwscript/objectcontainer.h"
@@ -66,19 +63,11 @@ public:
 	ObjectContainer();
 	~ObjectContainer();
 
-	void clearObjects();
-
 	/** Add an object to this container. */
 	void addObject(NWN::Object &object);
 	/** Remove an object from this container. */
 	void removeObject(NWN::Object &object);
 
-	/** Return the first object of this type. */
-	::Aurora::NWScript::Object *getFirstObjectByType(ObjectType type) const;
-
-	/** Return a search context to iterate over all objects of this type. */
-	::Aurora::NWScript::ObjectSearch *findObjectsByType(ObjectType type) const;
-
 	static NWN::Object *toObject(::Aurora::NWScript::Object *object);
 
 	static Module    *toModule   (Aurora::NWScript::Object *object);
@@ -91,12 +80,6 @@ public:
 	static Creature  *toPC       (Aurora::NWScript::Object *object);
 
 	static Location *toLocation(Aurora::NWScript::EngineType *engineType);
-
-private:
-	typedef std::list<NWN::Object *> ObjectList;
-	typedef std::map<ObjectType, ObjectList> ObjectMap;
-
-	ObjectMap _objects;
 };
 
 } // End of namespace NWN
@@ -199,11 +199,11 @@ void Functions::getObjectByTag(Aurora::NWScript::FunctionContext &ctx) {
 
 	int nth = ctx.getParams()[1].getInt();
 
-	Common::ScopedPtr<Aurora::NWScript::ObjectSearch> search(_game->getModule().findObjectsByTag(tag));
+	Aurora::NWScript::ObjectSearch search = _game->getModule().findObjectsByTag(tag);
 	while (nth-- > 0)
-		search->next();
+		search.next();
 
-	ctx.getReturn() = search->get();
+	ctx.getReturn() = search.get();
 }
 
 void Functions::getWaypointByTag(Aurora::NWScript::FunctionContext &ctx) {
@@ -213,10 +213,10 @@ void Functions::getWaypointByTag(Aurora::NWScript::FunctionContext &ctx) {
 	if (tag.empty())
 		return;
 
-	Common::ScopedPtr<Aurora::NWScript::ObjectSearch> search(_game->getModule().findObjectsByTag(tag));
+	Aurora::NWScript::ObjectSearch search = _game->getModule().findObjectsByTag(tag);
 	Aurora::NWScript::Object *object = 0;
 
-	while ((object = search->next())) {
+	while ((object = search.next())) {
 		Waypoint *waypoint = NWN::ObjectContainer::toWaypoint(object);
 
 		if (waypoint) {
@@ -238,11 +238,11 @@ void Functions::getNearestObject(Aurora::NWScript::FunctionContext &ctx) {
 	// We want the nth nearest object
 	size_t nth  = MAX<int32>(ctx.getParams()[2].getInt() - 1, 0);
 
-	Common::ScopedPtr<Aurora::NWScript::ObjectSearch> search(_game->getModule().findObjects());
+	Aurora::NWScript::ObjectSearch search = _game->getModule().findObjects();
 	Aurora::NWScript::Object *object = 0;
 
 	std::list<Object *> objects;
-	while ((object = search->next())) {
+	while ((object = search.next())) {
 		// Needs to be a valid object, not the target, but in the target's area
 		NWN::Object *nwnObject = NWN::ObjectContainer::toObject(object);
 		if (!nwnObject || (nwnObject == target) || (nwnObject->getArea() != target->getArea()))
@@ -280,11 +280,11 @@ void Functions::getNearestObjectByTag(Aurora::NWScript::FunctionContext &ctx) {
 
 	size_t nth = MAX<int32>(ctx.getParams()[2].getInt() - 1, 0);
 
-	Common::ScopedPtr<Aurora::NWScript::ObjectSearch> search(_game->getModule().findObjectsByTag(tag));
+	Aurora::NWScript::ObjectSearch search = _game->getModule().findObjectsByTag(tag);
 	Aurora::NWScript::Object *object = 0;
 
 	std::list<Object *> objects;
-	while ((object = search->next())) {
+	while ((object = search.next())) {
 		// Needs to be a valid object, not the target, but in the target's area
 		NWN::Object *nwnObject = NWN::ObjectContainer::toObject(object);
 		if (!nwnObject || (nwnObject == target) || (nwnObject->getArea() != target->getArea()))
@@ -322,11 +322,11 @@ void Functions::getNearestCreature(Aurora::NWScript::FunctionContext &ctx) {
 	 * int crit3Value = ctx.getParams()[7].getInt();
 	 */
 
-	Common::ScopedPtr<Aurora::NWScript::ObjectSearch> search(_game->getModule().findObjects());
+	Aurora::NWScript::ObjectSearch search = _game->getModule().findObjects();
 	Aurora::NWScript::Object *object = 0;
 
 	std::list<Object *> creatures;
-	while ((object = search->next())) {
+	while ((object = search.next())) {
 		Creature *creature = NWN::ObjectContainer::toCreature(object);
 
 		if (creature && (creature != target) && (creature->getArea() == target->getArea()))
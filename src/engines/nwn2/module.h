@@ -28,7 +28,6 @@
 #include <vector>
 #include <list>
 #include <map>
-#include <set>
 
 #include "src/common/ptrmap.h"
 #include "src/common/ustring.h"
@@ -36,6 +35,8 @@
 
 #include "src/aurora/ifofile.h"
 
+#include "src/aurora/nwscript/scheduler.h"
+
 #include "src/events/types.h"
 
 #include "src/engines/nwn2/objectcontainer.h"
@@ -123,29 +124,9 @@ public:
 	// '---
 
 private:
-	enum ActionType {
-		kActionNone   = 0,
-		kActionScript = 1
-	};
-
-	struct Action {
-		ActionType type;
-
-		Common::UString script;
-
-		Aurora::NWScript::ScriptState state;
-		Aurora::NWScript::Object *owner;
-		Aurora::NWScript::Object *triggerer;
-
-		uint32 timestamp;
-
-		bool operator<(const Action &s) const;
-	};
-
 	typedef Common::PtrMap<Common::UString, Area> AreaMap;
 
 	typedef std::list<Events::Event> EventQueue;
-	typedef std::multiset<Action> ActionQueue;
 
 
 	::Engines::Console *_console;
@@ -175,8 +156,8 @@ private:
 
 	Common::UString _newModule; ///< The module we should change to.
 
-	EventQueue  _eventQueue;
-	ActionQueue _delayedActions;
+	EventQueue _eventQueue;
+	Aurora::NWScript::ScriptScheduler _delayedActions;
 
 
 	// .--- Unloading
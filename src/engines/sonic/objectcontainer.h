@@ -25,9 +25,6 @@
 #ifndef ENGINES_SONIC_OBJECTCONTAINER_H
 #define ENGINES_SONIC_OBJECTCONTAINER_H
 
-#include <list>
-#include <map>
-
 #include "src/common/types.h"
 
 #include "src/aurora/nwscript/objectcontainer.h"
@@ -61,30 +58,16 @@ public:
 	ObjectContainer();
 	~ObjectContainer();
 
-	void clearObjects();
-
 	/** Add an object to this container. */
 	void addObject(Sonic::Object &object);
 	/** Remove an object from this container. */
 	void removeObject(Sonic::Object &object);
 
-	/** Return the first object of this type. */
-	::Aurora::NWScript::Object *getFirstObjectByType(ObjectType type) const;
-
-	/** Return a search context to iterate over all objects of this type. */
-	::Aurora::NWScript::ObjectSearch *findObjectsByType(ObjectType type) const;
-
 	static Sonic::Object *toObject(::Aurora::NWScript::Object *object);
 
 	static Module    *toModule   (Aurora::NWScript::Object *object);
 	static Area      *toArea     (Aurora::NWScript::Object *object);
 	static Placeable *toPlaceable(Aurora::NWScript::Object *object);
-
-private:
-	typedef std::list<Sonic::Object *> ObjectList;
-	typedef std::map<ObjectType, ObjectList> ObjectMap;
-
-	ObjectMap _objects;
 };
 
 } // End of namespace Sonic
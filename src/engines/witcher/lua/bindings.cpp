@@ -38,7 +38,7 @@ namespace Engines {
 
 namespace Witcher {
 
-static int pushFakeObject(lua_State &state, const Common::UString &type) {
+static int pushFakeObject(lua_State &state, const char *type) {
 	static int fake = 1;
 
 	Aurora::Lua::Stack stack(state);
@@ -281,7 +281,7 @@ void LuaBindings::CAuroraSettings::registerLuaBindings() {
 	LuaScriptMan.endRegister();
 }
 
-Common::UString LuaBindings::CAuroraSettings::getLuaType() {
+const char *LuaBindings::CAuroraSettings::getLuaType() {
 	return "CAuroraSettings";
 }
 
@@ -309,7 +309,7 @@ void LuaBindings::CCamera::registerLuaBindings() {
 	LuaScriptMan.endRegister();
 }
 
-Common::UString LuaBindings::CCamera::getLuaType() {
+const char *LuaBindings::CCamera::getLuaType() {
 	return "CCamera";
 }
 
@@ -341,7 +341,7 @@ void LuaBindings::CGUIMan::registerLuaBindings() {
 	LuaScriptMan.endRegister();
 }
 
-Common::UString LuaBindings::CGUIMan::getLuaType() {
+const char *LuaBindings::CGUIMan::getLuaType() {
 	return "CGuiMan";
 }
 
@@ -370,7 +370,7 @@ void LuaBindings::CGUIInGame::registerLuaBindings() {
 	LuaScriptMan.endRegister();
 }
 
-Common::UString LuaBindings::CGUIInGame::getLuaType() {
+const char *LuaBindings::CGUIInGame::getLuaType() {
 	return "CGuiInGame";
 }
 
@@ -387,7 +387,7 @@ void LuaBindings::CGUIObject::registerLuaBindings() {
 	LuaScriptMan.endRegister();
 }
 
-Common::UString LuaBindings::CGUIObject::getLuaType() {
+const char *LuaBindings::CGUIObject::getLuaType() {
 	return "CGuiObject";
 }
 
@@ -403,7 +403,7 @@ void LuaBindings::CGUIControlBinds::registerLuaBindings() {
 	LuaScriptMan.endRegister();
 }
 
-Common::UString LuaBindings::CGUIControlBinds::getLuaType() {
+const char *LuaBindings::CGUIControlBinds::getLuaType() {
 	return "CGuiControlBinds";
 }
 
@@ -432,7 +432,7 @@ void LuaBindings::CGUIPanel::registerLuaBindings() {
 	LuaScriptMan.endRegister();
 }
 
-Common::UString LuaBindings::CGUIPanel::getLuaType() {
+const char *LuaBindings::CGUIPanel::getLuaType() {
 	return "CGuiPanel";
 }
 
@@ -484,7 +484,7 @@ void LuaBindings::CGUIModalPanel::registerLuaBindings() {
 	LuaScriptMan.endRegister();
 }
 
-Common::UString LuaBindings::CGUIModalPanel::getLuaType() {
+const char *LuaBindings::CGUIModalPanel::getLuaType() {
 	return "CGuiModalPanel";
 }
 
@@ -509,7 +509,7 @@ void LuaBindings::CGUINewControl::registerLuaBindings() {
 	LuaScriptMan.endRegister();
 }
 
-Common::UString LuaBindings::CGUINewControl::getLuaType() {
+const char *LuaBindings::CGUINewControl::getLuaType() {
 	return "CGuiNewControl";
 }
 
@@ -587,7 +587,7 @@ void LuaBindings::CPhysics::registerLuaBindings() {
 	LuaScriptMan.endRegister();
 }
 
-Common::UString LuaBindings::CPhysics::getLuaType() {
+const char *LuaBindings::CPhysics::getLuaType() {
 	return "CPhysics";
 }
 
@@ -608,7 +608,7 @@ void LuaBindings::CTlkTable::registerLuaBindings() {
 	LuaScriptMan.endRegister();
 }
 
-Common::UString LuaBindings::CTlkTable::getLuaType() {
+const char *LuaBindings::CTlkTable::getLuaType() {
 	return "CTlkTable";
 }
 
@@ -631,7 +631,7 @@ void LuaBindings::CAttackDefList::registerLuaBindings() {
 	LuaScriptMan.endRegister();
 }
 
-Common::UString LuaBindings::CAttackDefList::getLuaType() {
+const char *LuaBindings::CAttackDefList::getLuaType() {
 	return "CAttackDefList";
 }
 
@@ -654,7 +654,7 @@ void LuaBindings::CFontMgr::registerLuaBindings() {
 	LuaScriptMan.endRegister();
 }
 
-Common::UString LuaBindings::CFontMgr::getLuaType() {
+const char *LuaBindings::CFontMgr::getLuaType() {
 	return "CFontMgr";
 }
 
@@ -687,7 +687,7 @@ void LuaBindings::CRules::registerLuaBindings() {
 	LuaScriptMan.endRegister();
 }
 
-Common::UString LuaBindings::CRules::getLuaType() {
+const char *LuaBindings::CRules::getLuaType() {
 	return "CRules";
 }
 
@@ -717,7 +717,7 @@ void LuaBindings::CDefs::registerLuaBindings() {
 	LuaScriptMan.endRegister();
 }
 
-Common::UString LuaBindings::CDefs::getLuaType() {
+const char *LuaBindings::CDefs::getLuaType() {
 	return "CDefs";
 }
 
@@ -767,7 +767,7 @@ void LuaBindings::CAttrs::registerLuaBindings() {
 	LuaScriptMan.endRegister();
 }
 
-Common::UString LuaBindings::CAttrs::getLuaType() {
+const char *LuaBindings::CAttrs::getLuaType() {
 	return "CAttrs";
 }
 
@@ -788,7 +788,7 @@ void LuaBindings::C2DArrays::registerLuaBindings() {
 	LuaScriptMan.endRegister();
 }
 
-Common::UString LuaBindings::C2DArrays::getLuaType() {
+const char *LuaBindings::C2DArrays::getLuaType() {
 	return "C2DArrays";
 }
 
@@ -818,7 +818,7 @@ void LuaBindings::C2DA::registerLuaBindings() {
 	LuaScriptMan.endRegister();
 }
 
-Common::UString LuaBindings::C2DA::getLuaType() {
+const char *LuaBindings::C2DA::getLuaType() {
 	return "C2DA";
 }
 
@@ -897,7 +897,7 @@ void LuaBindings::CClientExoApp::registerLuaBindings() {
 	LuaScriptMan.endRegister();
 }
 
-Common::UString LuaBindings::CClientExoApp::getLuaType() {
+const char *LuaBindings::CClientExoApp::getLuaType() {
 	return "CClientExoApp";
 }
 
@@ -922,7 +922,7 @@ void LuaBindings::CNWCModule::registerLuaBindings() {
 	LuaScriptMan.endRegister();
 }
 
-Common::UString LuaBindings::CNWCModule::getLuaType() {
+const char *LuaBindings::CNWCModule::getLuaType() {
 	return "CNWCModule";
 }
 
@@ -937,7 +937,7 @@ void LuaBindings::CNWCCreature::registerLuaBindings() {
 	LuaScriptMan.endRegister();
 }
 
-Common::UString LuaBindings::CNWCCreature::getLuaType() {
+const char *LuaBindings::CNWCCreature::getLuaType() {
 	return "CNWCCreature";
 }
 
@@ -952,7 +952,7 @@ void LuaBindings::CAurObject::registerLuaBindings() {
 	LuaScriptMan.endRegister();
 }
 
-Common::UString LuaBindings::CAurObject::getLuaType() {
+const char *LuaBindings::CAurObject::getLuaType() {
 	return "CAurObject";
 }
 
@@ -969,7 +969,7 @@ void LuaBindings::CEffectDuration::registerLuaBindings() {
 	LuaScriptMan.endRegister();
 }
 
-Common::UString LuaBindings::CEffectDuration::getLuaType() {
+const char *LuaBindings::CEffectDuration::getLuaType() {
 	return "CEffectDuration";
 }
 
@@ -986,7 +986,7 @@ void LuaBindings::CAbility::registerLuaBindings() {
 	LuaScriptMan.endRegister();
 }
 
-Common::UString LuaBindings::CAbility::getLuaType() {
+const char *LuaBindings::CAbility::getLuaType() {
 	return "CAbility";
 }
 
@@ -1003,7 +1003,7 @@ void LuaBindings::CAbilityCondition::registerLuaBindings() {
 	LuaScriptMan.endRegister();
 }
 
-Common::UString LuaBindings::CAbilityCondition::getLuaType() {
+const char *LuaBindings::CAbilityCondition::getLuaType() {
 	return "CAbilityCondition";
 }
 
@@ -1018,7 +1018,7 @@ void LuaBindings::CWeatherRain::registerLuaBindings() {
 	LuaScriptMan.endRegister();
 }
 
-Common::UString LuaBindings::CWeatherRain::getLuaType() {
+const char *LuaBindings::CWeatherRain::getLuaType() {
 	return "CWeatherRain";
 }
 
@@ -1033,7 +1033,7 @@ void LuaBindings::CWeatherFog::registerLuaBindings() {
 	LuaScriptMan.endRegister();
 }
 
-Common::UString LuaBindings::CWeatherFog::getLuaType() {
+const char *LuaBindings::CWeatherFog::getLuaType() {
 	return "CWeatherFog";
 }
 
@@ -1048,7 +1048,7 @@ void LuaBindings::CAurFullScreenFXMgr::registerLuaBindings() {
 	LuaScriptMan.endRegister();
 }
 
-Common::UString LuaBindings::CAurFullScreenFXMgr::getLuaType() {
+const char *LuaBindings::CAurFullScreenFXMgr::getLuaType() {
 	return "CAurFullScreenFXMgr";
 }
 
@@ -1066,7 +1066,7 @@ void LuaBindings::CExoSoundSource::registerLuaBindings() {
 	LuaScriptMan.endRegister();
 }
 
-Common::UString LuaBindings::CExoSoundSource::getLuaType() {
+const char *LuaBindings::CExoSoundSource::getLuaType() {
 	return "CExoSoundSource";
 }
 
@@ -1098,7 +1098,7 @@ void LuaBindings::CMiniGamesInterface::registerLuaBindings() {
 	LuaScriptMan.endRegister();
 }
 
-Common::UString LuaBindings::CMiniGamesInterface::getLuaType() {
+const char *LuaBindings::CMiniGamesInterface::getLuaType() {
 	return "CMiniGamesInterface";
 }
 
@@ -1113,7 +1113,7 @@ void LuaBindings::LuaScriptedTextureController::registerLuaBindings() {
 	LuaScriptMan.endRegister();
 }
 
-Common::UString LuaBindings::LuaScriptedTextureController::getLuaType() {
+const char *LuaBindings::LuaScriptedTextureController::getLuaType() {
 	return "LuaScriptedTextureController";
 }
 
@@ -1129,7 +1129,7 @@ void LuaBindings::Quaternion::registerLuaBindings() {
 	LuaScriptMan.endRegister();
 }
 
-Common::UString LuaBindings::Quaternion::getLuaType() {
+const char *LuaBindings::Quaternion::getLuaType() {
 	return "Quaternion";
 }
 
@@ -1156,7 +1156,7 @@ void LuaBindings::Vector::registerLuaBindings() {
 	LuaScriptMan.endRegister();
 }
 
-Common::UString LuaBindings::Vector::getLuaType() {
+const char *LuaBindings::Vector::getLuaType() {
 	return "Vector";
 }
 
@@ -1283,7 +1283,7 @@ void LuaBindings::ScreenSizes::registerLuaBindings() {
 	LuaScriptMan.endRegister();
 }
 
-Common::UString LuaBindings::ScreenSizes::getLuaType() {
+const char *LuaBindings::ScreenSizes::getLuaType() {
 	return "ScreenSizes";
 }
 
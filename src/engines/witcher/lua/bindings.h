@@ -28,10 +28,6 @@
 
 #include "src/aurora/lua/types.h"
 
-namespace Common {
-	class UString;
-}
-
 namespace Engines {
 
 namespace Witcher {
@@ -46,7 +42,7 @@ private:
 	public:
 		static void registerLuaBindings();
 
-		static Common::UString getLuaType();
+		static const char *getLuaType();
 
 	private:
 		static int luaGetDialogHorizontalOffset(lua_State *state);
@@ -56,7 +52,7 @@ private:
 	public:
 		static void registerLuaBindings();
 
-		static Common::UString getLuaType();
+		static const char *getLuaType();
 
 	private:
 		static int luaDist(lua_State *state);
@@ -68,7 +64,7 @@ private:
 	public:
 		static void registerLuaBindings();
 
-		static Common::UString getLuaType();
+		static const char *getLuaType();
 
 	private:
 		static int luaCreateAurObject(lua_State *state);
@@ -79,7 +75,7 @@ private:
 	public:
 		static void registerLuaBindings();
 
-		static Common::UString getLuaType();
+		static const char *getLuaType();
 
 	private:
 		static int luaNew(lua_State *state);
@@ -89,7 +85,7 @@ private:
 	public:
 		static void registerLuaBindings();
 
-		static Common::UString getLuaType();
+		static const char *getLuaType();
 
 	private:
 		static int luaNew(lua_State *state);
@@ -105,14 +101,14 @@ private:
 	public:
 		static void registerLuaBindings();
 
-		static Common::UString getLuaType();
+		static const char *getLuaType();
 	};
 
 	class CGUINewControl {
 	public:
 		static void registerLuaBindings();
 
-		static Common::UString getLuaType();
+		static const char *getLuaType();
 
 	private:
 		static int luaCreateModel(lua_State *state);
@@ -132,21 +128,21 @@ private:
 	public:
 		static void registerLuaBindings();
 
-		static Common::UString getLuaType();
+		static const char *getLuaType();
 	};
 
 	class CGUIObject {
 	public:
 		static void registerLuaBindings();
 
-		static Common::UString getLuaType();
+		static const char *getLuaType();
 	};
 
 	class CPhysics {
 	public:
 		static void registerLuaBindings();
 
-		static Common::UString getLuaType();
+		static const char *getLuaType();
 
 	private:
 		static int luaSetEnableCamera(lua_State *state);
@@ -156,7 +152,7 @@ private:
 	public:
 		static void registerLuaBindings();
 
-		static Common::UString getLuaType();
+		static const char *getLuaType();
 
 	private:
 		static int luaGetTlkTable(lua_State *state);
@@ -166,7 +162,7 @@ private:
 	public:
 		static void registerLuaBindings();
 
-		static Common::UString getLuaType();
+		static const char *getLuaType();
 
 	private:
 		static int luaClear(lua_State *state);
@@ -176,7 +172,7 @@ private:
 	public:
 		static void registerLuaBindings();
 
-		static Common::UString getLuaType();
+		static const char *getLuaType();
 
 	private:
 		static int luaGetFontMgr(lua_State *state);
@@ -188,7 +184,7 @@ private:
 	public:
 		static void registerLuaBindings();
 
-		static Common::UString getLuaType();
+		static const char *getLuaType();
 
 	private:
 		static int luaGet2DArrays(lua_State *state);
@@ -198,7 +194,7 @@ private:
 	public:
 		static void registerLuaBindings();
 
-		static Common::UString getLuaType();
+		static const char *getLuaType();
 
 	private:
 		static int luaClear(lua_State *state);
@@ -213,7 +209,7 @@ private:
 	public:
 		static void registerLuaBindings();
 
-		static Common::UString getLuaType();
+		static const char *getLuaType();
 
 	private:
 		static int luaGet(lua_State *state);
@@ -223,7 +219,7 @@ private:
 	public:
 		static void registerLuaBindings();
 
-		static Common::UString getLuaType();
+		static const char *getLuaType();
 
 	private:
 		static int luaGetLanguagesTable(lua_State *state);
@@ -233,7 +229,7 @@ private:
 	public:
 		static void registerLuaBindings();
 
-		static Common::UString getLuaType();
+		static const char *getLuaType();
 
 	private:
 		static int luaNew(lua_State *state);
@@ -250,7 +246,7 @@ private:
 	public:
 		static void registerLuaBindings();
 
-		static Common::UString getLuaType();
+		static const char *getLuaType();
 
 	private:
 		static int luaGetClientTextLanguage(lua_State *state);
@@ -260,70 +256,70 @@ private:
 	public:
 		static void registerLuaBindings();
 
-		static Common::UString getLuaType();
+		static const char *getLuaType();
 	};
 
 	class CNWCCreature {
 	public:
 		static void registerLuaBindings();
 
-		static Common::UString getLuaType();
+		static const char *getLuaType();
 	};
 
 	class CAurObject {
 	public:
 		static void registerLuaBindings();
 
-		static Common::UString getLuaType();
+		static const char *getLuaType();
 	};
 
 	class CEffectDuration {
 	public:
 		static void registerLuaBindings();
 
-		static Common::UString getLuaType();
+		static const char *getLuaType();
 	};
 
 	class CAbility {
 	public:
 		static void registerLuaBindings();
 
-		static Common::UString getLuaType();
+		static const char *getLuaType();
 	};
 
 	class CAbilityCondition {
 	public:
 		static void registerLuaBindings();
 
-		static Common::UString getLuaType();
+		static const char *getLuaType();
 	};
 
 	class CWeatherRain {
 	public:
 		static void registerLuaBindings();
 
-		static Common::UString getLuaType();
+		static const char *getLuaType();
 	};
 
 	class CWeatherFog {
 	public:
 		static void registerLuaBindings();
 
-		static Common::UString getLuaType();
+		static const char *getLuaType();
 	};
 
 	class CAurFullScreenFXMgr {
 	public:
 		static void registerLuaBindings();
 
-		static Common::UString getLuaType();
+		static const char *getLuaType();
 	};
 
 	class CExoSoundSource {
 	public:
 		static void registerLuaBindings();
 
-		static Common::UString getLuaType();
+		static const char *getLuaType();
 
 	private:
 		static int luaNewLocal(lua_State *state);
@@ -335,21 +331,21 @@ private:
 	public:
 		static void registerLuaBindings();
 
-		static Common::UString getLuaType();
+		static const char *getLuaType();
 	};
 
 	class LuaScriptedTextureController {
 	public:
 		static void registerLuaBindings();
 
-		static Common::UString getLuaType();
+		static const char *getLuaType();
 	};
 
 	class Quaternion {
 	public:
 		static void registerLuaBindings();
 
-		static Common::UString getLuaType();
+		static const char *getLuaType();
 
 	private:
 		static int luaNewLocal(lua_State *state);
@@ -359,7 +355,7 @@ private:
 	public:
 		static void registerLuaBindings();
 
-		static Common::UString getLuaType();
+		static const char *getLuaType();
 
 	private:
 		static int luaNewLocal(lua_State *state);
@@ -376,7 +372,7 @@ private:
 	public:
 		static void registerLuaBindings();
 
-		static Common::UString getLuaType();
+		static const char *getLuaType();
 
 	private:
 		static int luaGetActualGUIWidth(lua_State *state);
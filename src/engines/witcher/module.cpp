@@ -51,13 +51,9 @@ namespace Engines {
 
 namespace Witcher {
 
-bool Module::Action::operator<(const Action &s) const {
-	return timestamp < s.timestamp;
-}
-
-
 Module::Module(::Engines::Console &console) : Object(kObjectTypeModule), _console(&console),
-	_hasModule(false), _running(false), _exit(false), _pc(0), _currentArea(0) {
+	_hasModule(false), _running(false), _exit(false), _pc(0), _currentArea(0),
+	_delayedActions(*this, this) {
 
 }
 
@@ -216,11 +212,11 @@ bool Module::getObjectLocation(const Common::UString &object, Common::UString &a
 	if (object.empty())
 		return false;
 
-	Common::ScopedPtr<Aurora::NWScript::ObjectSearch> search(findObjectsByTag(object));
+	Aurora::NWScript::ObjectSearch search = findObjectsByTag(object);
 
 	Witcher::Object *witcherObject = 0;
-	while (!witcherObject && search->get()) {
-		witcherObject = Witcher::ObjectContainer::toObject(search->next());
+	while (!witcherObject && search.get()) {
+		witcherObject = Witcher::ObjectContainer::toObject(search.next());
 		if (!witcherObject || (witcherObject->getType() != kObjectTypeWaypoint))
 			witcherObject = 0;
 	}
@@ -334,20 +330,7 @@ void Module::handleEvents() {
 }
 
 void Module::handleActions() {
-	uint32 now = EventMan.getTimestamp();
-
-	while (!_delayedActions.empty()) {
-		ActionQueue::iterator action = _delayedActions.begin();
-
-		if (now < action->timestamp)
-			break;
-
-		if (action->type == kActionScript)
-			ScriptContainer::runScript(action->script, action->state,
-			                           action->owner, action->triggerer);
-
-		_delayedActions.erase(action);
-	}
+	_delayedActions.run(EventMan.getTimestamp());
 }
 
 void Module::unload() {
@@ -506,16 +489,7 @@ void Module::delayScript(const Common::UString &script,
                          const Aurora::NWScript::ScriptState &state,
                          Aurora::NWScript::Object *owner,
                          Aurora::NWScript::Object *triggerer, uint32 delay) {
-	Action action;
-
-	action.type      = kActionScript;
-	action.script    = script;
-	action.state     = state;
-	action.owner     = owner;
-	action.triggerer = triggerer;
-	action.timestamp = EventMan.getTimestamp() + delay;
-
-	_delayedActions.insert(action);
+	_delayedActions.schedule(script, state, owner, triggerer, EventMan.getTimestamp() + delay);
 }
 
 Common::UString Module::getName(const Common::UString &module) {
@@ -27,7 +27,6 @@
 
 #include <list>
 #include <map>
-#include <set>
 
 #include "src/common/ptrmap.h"
 #include "src/common/ustring.h"
@@ -35,6 +34,8 @@
 
 #include "src/aurora/ifofile.h"
 
+#include "src/aurora/nwscript/scheduler.h"
+
 #include "src/events/types.h"
 
 #include "src/engines/witcher/objectcontainer.h"
@@ -131,29 +132,9 @@ public:
 	// '---
 
 private:
-	enum ActionType {
-		kActionNone   = 0,
-		kActionScript = 1
-	};
-
-	struct Action {
-		ActionType type;
-
-		Common::UString script;
-
-		Aurora::NWScript::ScriptState state;
-		Aurora::NWScript::Object *owner;
-		Aurora::NWScript::Object *triggerer;
-
-		uint32 timestamp;
-
-		bool operator<(const Action &s) const;
-	};
-
 	typedef Common::PtrMap<Common::UString, Area> AreaMap;
 
 	typedef std::list<Events::Event> EventQueue;
-	typedef std::multiset<Action> ActionQueue;
 
 
 	::Engines::Console  *_console;
@@ -180,8 +161,8 @@ private:
 	/** The tag of the object in the start location for this module. */
 	Common::UString _entryLocation;
 
-	EventQueue  _eventQueue;
-	ActionQueue _delayedActions;
+	EventQueue _eventQueue;
+	Aurora::NWScript::ScriptScheduler _delayedActions;
 
 
 	// .--- Unloading
@@ -194,11 +194,11 @@ void Functions::getObjectByTag(Aurora::NWScript::FunctionContext &ctx) {
 
 	int nth = ctx.getParams()[1].getInt();
 
-	Common::ScopedPtr<Aurora::NWScript::ObjectSearch> search(_game->getModule().findObjectsByTag(tag));
+	Aurora::NWScript::ObjectSearch search = _game->getModule().findObjectsByTag(tag);
 	while (nth-- > 0)
-		search->next();
+		search.next();
 
-	ctx.getReturn() = search->get();
+	ctx.getReturn() = search.get();
 }
 
 void Functions::getWaypointByTag(Aurora::NWScript::FunctionContext &ctx) {
@@ -208,10 +208,10 @@ void Functions::getWaypointByTag(Aurora::NWScript::FunctionContext &ctx) {
 	if (tag.empty())
 		return;
 
-	Common::ScopedPtr<Aurora::NWScript::ObjectSearch> search(_game->getModule().findObjectsByTag(tag));
+	Aurora::NWScript::ObjectSearch search = _game->getModule().findObjectsByTag(tag);
 	Aurora::NWScript::Object *object = 0;
 
-	while ((object = search->next())) {
+	while ((object = search.next())) {
 		Waypoint *waypoint = Witcher::ObjectContainer::toWaypoint(object);
 
 		if (waypoint) {
@@ -233,11 +233,11 @@ void Functions::getNearestObject(Aurora::NWScript::FunctionContext &ctx) {
 	// We want the nth nearest object
 	size_t nth  = MAX<int32>(ctx.getParams()[2].getInt() - 1, 0);
 
-	Common::ScopedPtr<Aurora::NWScript::ObjectSearch> search(_game->getModule().findObjects());
+	Aurora::NWScript::ObjectSearch search = _game->getModule().findObjects();
 	Aurora::NWScript::Object *object = 0;
 
 	std::list<Object *> objects;
-	while ((object = search->next())) {
+	while ((object = search.next())) {
 		// Needs to be a valid object, not the target, but in the target's area
 		Witcher::Object *witcherObject = Witcher::ObjectContainer::toObject(object);
 		if (!witcherObject || (witcherObject == target) || (witcherObject->getArea() != target->getArea()))
@@ -275,11 +275,11 @@ void Functions::getNearestObjectByTag(Aurora::NWScript::FunctionContext &ctx) {
 
 	size_t nth = MAX<int32>(ctx.getParams()[2].getInt() - 1, 0);
 
-	Common::ScopedPtr<Aurora::NWScript::ObjectSearch> search(_game->getModule().findObjectsByTag(tag));
+	Aurora::NWScript::ObjectSearch search = _game->getModule().findObjectsByTag(tag);
 	Aurora::NWScript::Object *object = 0;
 
 	std::list<Object *> objects;
-	while ((object = search->next())) {
+	while ((object = search.next())) {
 		// Needs to be a valid object, not the target, but in the target's area
 		Witcher::Object *witcherObject = Witcher::ObjectContainer::toObject(object);
 		if (!witcherObject || (witcherObject == target) || (witcherObject->getArea() != target->getArea()))
@@ -317,11 +317,11 @@ void Functions::getNearestCreature(Aurora::NWScript::FunctionContext &ctx) {
 	 * int crit3Value = ctx.getParams()[7].getInt();
 	 */
 
-	Common::ScopedPtr<Aurora::NWScript::ObjectSearch> search(_game->getModule().findObjects());
+	Aurora::NWScript::ObjectSearch search = _game->getModule().findObjects();
 	Aurora::NWScript::Object *object = 0;
 
 	std::list<Object *> creatures;
-	while ((object = search->next())) {
+	while ((object = search.next())) {
 		Creature *creature = Witcher::ObjectContainer::toCreature(object);
 
 		if (creature && (creature != target) && (creature->getArea() == target->getArea()))
@@ -33,6 +33,7 @@ STOP_IGNORE_IMPLICIT_FALLTHROUGH
 #include "src/common/error.h"
 #include "src/common/threads.h"
 #include "src/common/configman.h"
+#include "src/common/frametimes.h"
 
 #include "src/events/events.h"
 #include "src/events/requests.h"
@@ -210,6 +211,8 @@ bool EventsManager::parseITC(const Event &event) {
 void EventsManager::processEvents() {
 	Common::enforceMainThread();
 
+	Common::FrameTimer timer(FrameTimesMan, Common::kFramePhaseEvents);
+
 	Common::StackLock lock(_eventQueueMutex);
 
 	Event event;
@@ -35,6 +35,8 @@
 #include "src/graphics/aurora/modelnode.h"
 #include "src/graphics/aurora/animation.h"
 #include "src/graphics/aurora/animnode.h"
+#include "src/graphics/aurora/skinning.h"
+#include "src/graphics/aurora/keyframes.h"
 
 using Common::kDebugGraphics;
 
@@ -42,6 +44,9 @@ namespace Graphics {
 
 namespace Aurora {
 
+Animation::Binding::Binding() : scale(1.0f), generation(0) {
+}
+
 Animation::Animation() : _length(0.0f), _transtime(0.0f) {
 
 }
@@ -71,26 +76,107 @@ void Animation::setTransTime(float transtime) {
 	_transtime = transtime;
 }
 
+void Animation::bind(Model *model, Binding &binding) const {
+	binding.nodes.clear();
+	binding.sources.clear();
+	binding.scale      = model->getAnimationScale(_name);
+	binding.generation = model->_nodeGeneration.load(boost::memory_order_acquire);
+
+	/* Changing the state of an attached model or the supermodel changes the
+	 * nodes we might bind to, but only bumps that model's own generation. */
+	for (std::map<Common::UString, Model *>::const_iterator m = model->_attachedModels.begin();
+	     m != model->_attachedModels.end(); ++m) {
+
+		Binding::Source source;
+		source.model      = m->second;
+		source.generation = m->second->_nodeGeneration.load(boost::memory_order_acquire);
+
+		binding.sources.push_back(source);
+	}
+
+	if (model->_superModel) {
+		Binding::Source source;
+		source.model      = model->_superModel;
+		source.generation = model->_superModel->_nodeGeneration.load(boost::memory_order_acquire);
+
+		binding.sources.push_back(source);
+	}
+
+	uint32 track = 0;
+	for (NodeList::const_iterator an = nodeList.begin(); an != nodeList.end(); ++an, ++track) {
+		if ((_positionTracks[track].count == 0) && (_orientationTracks[track].count == 0))
+			continue;
+
+		const Common::UString &animNodeName = (*an)->_nodedata->getName();
+
+		ModelNode *target = 0;
+
+		// Search for the corresponding node in this model
+		if (model->_currentState) {
+			Model::NodeMap::iterator n = model->_currentState->nodeMap.find(animNodeName);
+			if (n != model->_currentState->nodeMap.end())
+				target = n->second;
+		}
+
+		// Search for the corresponding node in this model's attached models
+		for (std::map<Common::UString, Model *>::iterator m = model->_attachedModels.begin();
+				!target && (m != model->_attachedModels.end()); ++m) {
+			Model::State *state = m->second->_currentState;
+			if (!state)
+				continue;
+
+			Model::NodeMap::iterator n = state->nodeMap.find(animNodeName);
+			if (n != state->nodeMap.end())
+				target = n->second;
+		}
+
+		// Search for the corresponding node in this model's super model
+		if (!target && model->_superModel)
+			target = model->_superModel->getNode(animNodeName);
+
+		if (!target)
+			continue;
+
+		Binding::Node node;
+		node.track             = track;
+		node.target            = target;
+		node.positionCursor    = 0;
+		node.orientationCursor = 0;
+
+		binding.nodes.push_back(node);
+	}
+}
+
+bool Animation::isBound(const Model *model, const Binding &binding) {
+	// Check the model first: attaching or detaching models changes its generation
+	if (binding.generation != model->_nodeGeneration.load(boost::memory_order_acquire))
+		return false;
+
+	for (std::vector<Binding::Source>::const_iterator s = binding.sources.begin(); s != binding.sources.end(); ++s)
+		if (s->generation != s->model->_nodeGeneration.load(boost::memory_order_acquire))
+			return false;
+
+	return true;
+}
+
 void Animation::update(Model *model,
                        float UNUSED(lastFrame),
                        float nextFrame,
-                       const std::vector<ModelNode *> &modelNodeMap) {
+                       Binding &binding) {
 	// TODO: Also need to fire off associated events
 	//       for event in _events event->fire()
 
 
-	float scale = model->getAnimationScale(_name);
-	for (NodeList::iterator n = nodeList.begin(); n != nodeList.end(); ++n) {
-		ModelNode *animNode = (*n)->_nodedata;
-		ModelNode *target = modelNodeMap[animNode->_nodeNumber];
-		if (!target)
-			continue;
+	for (std::vector<Binding::Node>::iterator n = binding.nodes.begin(); n != binding.nodes.end(); ++n) {
+		const Track &position    = _positionTracks[n->track];
+		const Track &orientation = _orientationTracks[n->track];
 
 		// Update position and orientation based on time
-		if (!animNode->_positionFrames.empty())
-			interpolatePosition(animNode, target, nextFrame, scale, model->_positionRelative);
-		if (!animNode->_orientationFrames.empty())
-			interpolateOrientation(animNode, target, nextFrame);
+		if (position.count > 0)
+			interpolatePosition(position, n->target, nextFrame, binding.scale,
+			                    model->_positionRelative, n->positionCursor);
+		if (orientation.count > 0)
+			interpolateOrientation(orientation, n->target, nextFrame, n->orientationCursor);
 	}
 
 	if (model->_skinned)
@@ -100,6 +186,39 @@ void Animation::update(Model *model,
 void Animation::addAnimNode(AnimNode *node) {
 	nodeList.push_back(node);
 	nodeMap.insert(std::make_pair(node->getName(), node));
+
+	const ModelNode *data = node->_nodedata;
+
+	Track position;
+	position.first = _positionFrames.time.size();
+	position.count = data->_positionFrames.size();
+
+	for (std::vector<PositionKeyFrame>::const_iterator p = data->_positionFrames.begin();
+	     p != data->_positionFrames.end(); ++p) {
+
+		_positionFrames.time.push_back(p->time);
+		_positionFrames.x.push_back(p->x);
+		_positionFrames.y.push_back(p->y);
+		_positionFrames.z.push_back(p->z);
+	}
+
+	_positionTracks.push_back(position);
+
+	Track orientation;
+	orientation.first = _orientationFrames.time.size();
+	orientation.count = data->_orientationFrames.size();
+
+	for (std::vector<QuaternionKeyFrame>::const_iterator o = data->_orientationFrames.begin();
+	     o != data->_orientationFrames.end(); ++o) {
+
+		_orientationFrames.time.push_back(o->time);
+		_orientationFrames.x.push_back(o->x);
+		_orientationFrames.y.push_back(o->y);
+		_orientationFrames.z.push_back(o->z);
+		_orientationFrames.q.push_back(o->q);
+	}
+
+	_orientationTracks.push_back(orientation);
 }
 
 bool Animation::hasNode(const Common::UString &node) const {
@@ -145,8 +264,8 @@ static void normQuaternion(float  xIn , float  yIn , float  zIn , float  qIn,
 	qOut = qIn / magnitude;
 }
 
-void Animation::interpolatePosition(ModelNode *animNode, ModelNode *target, float time, float scale,
-                                    bool relative) const {
+void Animation::interpolatePosition(const Track &track, ModelNode *target, float time, float scale,
+                                    bool relative, uint32 &cursor) const {
 	float dx = 0;
 	float dy = 0;
 	float dz = 0;
@@ -157,80 +276,74 @@ void Animation::interpolatePosition(ModelNode *animNode, ModelNode *target, floa
 		dz = pos.z;
 	}
 
+	const float *times = &_positionFrames.time[track.first];
+	const float *px    = &_positionFrames.x[track.first];
+	const float *py    = &_positionFrames.y[track.first];
+	const float *pz    = &_positionFrames.z[track.first];
+
 	// If only one keyframe, don't interpolate, just set the only position
-	if (animNode->_positionFrames.size() == 1) {
-		const PositionKeyFrame &pos = animNode->_positionFrames[0];
-		target->setBufferedPosition((dx + pos.x) * scale,
-		                            (dy + pos.y) * scale,
-		                            (dz + pos.z) * scale);
+	if (track.count == 1) {
+		target->setBufferedPosition((dx + px[0]) * scale,
+		                            (dy + py[0]) * scale,
+		                            (dz + pz[0]) * scale);
 		return;
 	}
 
-	size_t lastFrame = 0;
-	for (size_t i = 0; i < animNode->_positionFrames.size(); i++) {
-		const PositionKeyFrame &pos = animNode->_positionFrames[i];
-		if (pos.time >= time)
-			break;
-
-		lastFrame = i;
-	}
-
-	const PositionKeyFrame &last = animNode->_positionFrames[lastFrame];
-	if (lastFrame + 1 >= animNode->_positionFrames.size() || last.time >= time) {
-		target->setBufferedPosition((dx + last.x) * scale,
-		                            (dy + last.y) * scale,
-		                            (dz + last.z) * scale);
+	const uint32 last = findKeyFrame(times, track.count, time, cursor);
+	if (last + 1 >= track.count || times[last] >= time) {
+		target->setBufferedPosition((dx + px[last]) * scale,
+		                            (dy + py[last]) * scale,
+		                            (dz + pz[last]) * scale);
 		return;
 	}
 
-	const PositionKeyFrame &next = animNode->_positionFrames[lastFrame + 1];
+	const uint32 next = last + 1;
 
-	const float f = (time - last.time) / (next.time - last.time);
-	const float x = f * next.x + (1.0f - f) * last.x;
-	const float y = f * next.y + (1.0f - f) * last.y;
-	const float z = f * next.z + (1.0f - f) * last.z;
+	const float f = (time - times[last]) / (times[next] - times[last]);
+	const float x = f * px[next] + (1.0f - f) * px[last];
+	const float y = f * py[next] + (1.0f - f) * py[last];
+	const float z = f * pz[next] + (1.0f - f) * pz[last];
 
 	target->setBufferedPosition((dx + x) * scale,
 	                            (dy + y) * scale,
 	                            (dz + z) * scale);
 }
 
-void Animation::interpolateOrientation(ModelNode *animNode, ModelNode *target, float time) const {
-	// If only one keyframe, don't interpolate just set the only orientation
-	if (animNode->_orientationFrames.size() == 1) {
-		const QuaternionKeyFrame &ori = animNode->_orientationFrames[0];
-		target->setBufferedOrientation(ori.x, ori.y, ori.z, Common::rad2deg(acos(ori.q) * 2.0));
-		return;
-	}
+void Animation::interpolateOrientation(const Track &track, ModelNode *target, float time,
+                                       uint32 &cursor) const {
 
-	size_t lastFrame = 0;
-	for (size_t i = 0; i < animNode->_orientationFrames.size(); i++) {
-		const QuaternionKeyFrame &ori = animNode->_orientationFrames[i];
-		if (ori.time >= time)
-			break;
+	const float *times = &_orientationFrames.time[track.first];
+	const float *ox    = &_orientationFrames.x[track.first];
+	const float *oy    = &_orientationFrames.y[track.first];
+	const float *oz    = &_orientationFrames.z[track.first];
+	const float *oq    = &_orientationFrames.q[track.first];
 
-		lastFrame = i;
+	// If only one keyframe, don't interpolate just set the only orientation
+	if (track.count == 1) {
+		target->setBufferedOrientation(ox[0], oy[0], oz[0], Common::rad2deg(acos(oq[0]) * 2.0));
+		return;
 	}
 
-	const QuaternionKeyFrame &last = animNode->_orientationFrames[lastFrame];
-	if (lastFrame + 1 >= animNode->_orientationFrames.size() || last.time >= time) {
-		target->setBufferedOrientation(last.x, last.y, last.z, Common::rad2deg(acos(last.q) * 2.0));
+	const uint32 last = findKeyFrame(times, track.count, time, cursor);
+	if (last + 1 >= track.count || times[last] >= time) {
+		target->setBufferedOrientation(ox[last], oy[last], oz[last], Common::rad2deg(acos(oq[last]) * 2.0));
 		return;
 	}
 
-	const QuaternionKeyFrame &next = animNode->_orientationFrames[lastFrame + 1];
+	const uint32 next = last + 1;
 
-	const float f = (time - last.time) / (next.time - last.time);
+	const float f = (time - times[last]) / (times[next] - times[last]);
 
 	/* If the angle is > 90°, we need to flip the direction of one quaternion to
 	   get a smooth transition instead of wild jumps. */
-	const float angle = acos(dotQuaternion(last.x, last.y, last.z, last.q, next.x, next.y, next.z, next.q));
+	const float angle = acos(dotQuaternion(ox[last], oy[last], oz[last], oq[last],
+	                                       ox[next], oy[next], oz[next], oq[next]));
 	const float dir   = (angle >= (M_PI / 2)) ? -1.0f : 1.0f;
 
-	float x = f * dir * next.x + (1.0f - f) * last.x;
-	float y = f * dir * next.y + (1.0f - f) * last.y;
-	float z = f * dir * next.z + (1.0f - f) * last.z;
-	float q = f * dir * next.q + (1.0f - f) * last.q;
+	float x = f * dir * ox[next] + (1.0f - f) * ox[last];
+	float y = f * dir * oy[next] + (1.0f - f) * oy[last];
+	float z = f * dir * oz[next] + (1.0f - f) * oz[last];
+	float q = f * dir * oq[next] + (1.0f - f) * oq[last];
 
 	// Normalize the result for slightly better results
 	normQuaternion(x, y, z, q, x, y, z, q);
@@ -238,16 +351,6 @@ void Animation::interpolateOrientation(ModelNode *animNode, ModelNode *target, f
 	target->setBufferedOrientation(x, y, z, Common::rad2deg(acos(q) * 2.0));
 }
 
-static void multiply(const float *v, const glm::mat4 &m, float *rv) {
-	rv[0]   = v[0] * m[0][0] + v[1] * m[1][0] + v[2] * m[2][0] + m[3][0];
-	rv[1]   = v[0] * m[0][1] + v[1] * m[1][1] + v[2] * m[2][1] + m[3][1];
-	rv[2]   = v[0] * m[0][2] + v[1] * m[1][2] + v[2] * m[2][2] + m[3][2];
-	float w = v[0] * m[0][3] + v[1] * m[1][3] + v[2] * m[2][3] + m[3][3];
-	rv[0] /= w;
-	rv[1] /= w;
-	rv[2] /= w;
-}
-
 void Animation::updateSkinnedModel(Model *model) {
 	const std::list<ModelNode *> &nodes = model->getNodes();
 	for (std::list<ModelNode *>::const_iterator it = nodes.begin(); it != nodes.end(); ++it) {
@@ -264,15 +367,23 @@ void Animation::updateSkinnedModel(Model *model) {
 		if (node->_parent && node->_parent->_name.stricmp("f_jaw_g") == 0)
 			continue;
 
-		glm::mat4 invTransform = node->_invBindPose;
-		glm::mat4 transform = glm::inverse(invTransform);
-
 		ModelNode::Skin *skin = node->_mesh->skin;
 
+		/* Combine the whole chain of transformations a vertex goes through
+		 * for each bone into a single matrix, so that the skinning itself
+		 * only needs one matrix per bone and vertex. */
+
+		skin->bonePalette.resize(skin->boneNodeMap.size());
 		for (uint16 i = 0; i < skin->boneMappingCount; ++i) {
 			int index = static_cast<int>(skin->boneMapping[i]);
-			if (index != -1)
-				skin->boneNodeMap[index]->computeAbsoluteTransform();
+			if (index == -1)
+				continue;
+
+			ModelNode *bone = skin->boneNodeMap[index];
+			bone->computeAbsoluteTransform();
+
+			skin->bonePalette[index] = node->_invBindPose * bone->_absoluteTransform *
+			                           bone->_invBindPose * node->_bindPose;
 		}
 
 		// TODO: Use vertex shader
@@ -282,39 +393,11 @@ void Animation::updateSkinnedModel(Model *model) {
 
 		std::vector<float> &vcb = node->_vertexCoordsBuffer;
 		vcb.resize(3 * vertexCount);
-		float *v = &vcb[0];
-
-		float *iv = &meshData->initialVertexCoords[0];
-		float *boneWeights = &skin->boneWeights[0];
-		float *boneMappingId = &skin->boneMappingId[0];
-
-		for (uint32 i = 0; i < vertexCount; ++i) {
-			v[0] = 0;
-			v[1] = 0;
-			v[2] = 0;
-			for (uint8 j = 0; j < 4; ++j) {
-				int index = static_cast<int>(boneMappingId[j]);
-				if (index != -1) {
-					float rv[3];
-					float tv[3];
-					const glm::mat4 &invBindPose = skin->boneNodeMap[index]->_invBindPose;
-					const glm::mat4 &boneTransform = skin->boneNodeMap[index]->_absoluteTransform;
-
-					multiply(iv, transform, rv);
-					multiply(rv, invBindPose, tv);
-					multiply(tv, boneTransform, rv);
-					multiply(rv, invTransform, tv);
-
-					v[0] += tv[0] * boneWeights[j];
-					v[1] += tv[1] * boneWeights[j];
-					v[2] += tv[2] * boneWeights[j];
-				}
-			}
-			v += 3;
-			iv += 3;
-			boneWeights += 4;
-			boneMappingId += 4;
-		}
+
+		if ((vertexCount > 0) && !skin->bonePalette.empty())
+			skinVertices(&vcb[0], &meshData->initialVertexCoords[0], &skin->boneMappingId[0],
+			             &skin->boneWeights[0], vertexCount, glm::value_ptr(skin->bonePalette[0]),
+			             skin->bonePalette.size());
 
 		node->_vertexCoordsBuffered = true;
 	}
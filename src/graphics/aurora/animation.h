@@ -27,6 +27,7 @@
 
 #include <list>
 #include <map>
+#include <vector>
 
 #include "src/common/ustring.h"
 #include "src/common/boundingbox.h"
@@ -49,6 +50,29 @@ class AnimNode;
 
 class Animation {
 public:
+	/** The model nodes an animation drives, and where the keyframe searches left off. */
+	struct Binding {
+		struct Node {
+			uint32 track;             ///< Index of the animated node.
+			ModelNode *target;        ///< The model node driven by the animated node.
+			uint32 positionCursor;    ///< Position keyframe found in the last update.
+			uint32 orientationCursor; ///< Orientation keyframe found in the last update.
+		};
+
+		/** Another model the nodes might belong to. */
+		struct Source {
+			const Model *model; ///< An attached model or the supermodel.
+			uint32 generation;  ///< That model's node generation when this binding was made.
+		};
+
+		std::vector<Node> nodes;     ///< All animated nodes with a target.
+		std::vector<Source> sources; ///< The attached models and the supermodel.
+		float scale;                 ///< The model's scale for this animation.
+		uint32 generation;           ///< The model's node generation when this binding was made.
+
+		Binding();
+	};
+
 	Animation();
 	~Animation();
 
@@ -62,8 +86,13 @@ public:
 
 	void setTransTime(float transtime);
 
+	/** Bind the animation's nodes to the nodes of a model, its attached models and its supermodel. */
+	void bind(Model *model, Binding &binding) const;
+	/** Do the nodes of the model, its attached models and its supermodel still match the binding? */
+	static bool isBound(const Model *model, const Binding &binding);
+
 	/** Update the model position and orientation */
-	void update(Model *model, float lastFrame, float nextFrame, const std::vector<ModelNode *> &modelNodeMap);
+	void update(Model *model, float lastFrame, float nextFrame, Binding &binding);
 
 	// Nodes
 
@@ -93,9 +122,30 @@ protected:
 	float _transtime;
 
 private:
-	void interpolatePosition(ModelNode *animNode, ModelNode *target, float time, float scale,
-	                         bool relative) const;
-	void interpolateOrientation(ModelNode *animNode, ModelNode *target, float time) const;
+	/** Keyframes of all animated nodes, in struct-of-arrays layout. */
+	struct KeyFrames {
+		std::vector<float> time;
+		std::vector<float> x;
+		std::vector<float> y;
+		std::vector<float> z;
+		std::vector<float> q; ///< Only used by orientations.
+	};
+
+	/** The range of keyframes belonging to one animated node. */
+	struct Track {
+		uint32 first;
+		uint32 count;
+	};
+
+	KeyFrames _positionFrames;    ///< The position keyframes of all animated nodes.
+	KeyFrames _orientationFrames; ///< The orientation keyframes of all animated nodes.
+
+	std::vector<Track> _positionTracks;    ///< The position keyframes of each animated node.
+	std::vector<Track> _orientationTracks; ///< The orientation keyframes of each animated node.
+
+	void interpolatePosition(const Track &track, ModelNode *target, float time, float scale,
+	                         bool relative, uint32 &cursor) const;
+	void interpolateOrientation(const Track &track, ModelNode *target, float time, uint32 &cursor) const;
 
 	/** Transform vertices for each node of the specified model based on current animation. */
 	void updateSkinnedModel(Model *model);
@@ -26,7 +26,6 @@
 
 #include "src/graphics/aurora/animation.h"
 #include "src/graphics/aurora/animationchannel.h"
-#include "src/graphics/aurora/animnode.h"
 #include "src/graphics/aurora/model.h"
 
 namespace Graphics {
@@ -42,6 +41,7 @@ AnimationChannel::AnimationChannel(Model *model)
 		  _animationTime(0.0f),
 		  _animationLoopLength(1.0f),
 		  _animationLoopTime(0.0f),
+		  _binding(0),
 		  _manageSem(true) {
 }
 
@@ -129,9 +129,13 @@ void AnimationChannel::manageAnimations(float dt) {
 		return;
 	}
 
+	// The model's nodes changed since we bound the animation
+	if (!Animation::isBound(_model, *_binding))
+		bindCurrentAnimation();
+
 	// The loop of the animation ended: make sure to play the last frame
 	if (lastFrame < _animationLoopLength && nextFrame >= _animationLoopLength) {
-		_currentAnimation->update(_model, lastFrame, _animationLoopLength, _modelNodeMap);
+		_currentAnimation->update(_model, lastFrame, _animationLoopLength, *_binding);
 
 		_animationTime += dt;
 		_animationLoopTime = _animationLoopLength;
@@ -146,7 +150,7 @@ void AnimationChannel::manageAnimations(float dt) {
 		_nextAnimation = 0;
 
 		if (_currentAnimation)
-			_currentAnimation->update(_model, 0.0f, 0.0f, _modelNodeMap);
+			_currentAnimation->update(_model, 0.0f, 0.0f, *_binding);
 
 		_model->createBound();
 		_manageSem.unlock();
@@ -155,7 +159,7 @@ void AnimationChannel::manageAnimations(float dt) {
 
 	// Start the next loop of the animation
 	if (lastFrame >= _animationLoopLength) {
-		_currentAnimation->update(_model, 0.0f, 0.0f, _modelNodeMap);
+		_currentAnimation->update(_model, 0.0f, 0.0f, *_binding);
 
 		lastFrame = 0.0f;
 		nextFrame = _animationSpeed * dt;
@@ -164,7 +168,7 @@ void AnimationChannel::manageAnimations(float dt) {
 	}
 
 	// Update the animation
-	_currentAnimation->update(_model, lastFrame, nextFrame, _modelNodeMap);
+	_currentAnimation->update(_model, lastFrame, nextFrame, *_binding);
 
 	_animationTime += dt;
 	_animationLoopTime = nextFrame;
@@ -210,58 +214,18 @@ void AnimationChannel::setCurrentAnimation(Animation *anim) {
 	_animationLoopTime = 0.0f;
 
 	if (_currentAnimation)
-		makeModelNodeMap();
+		bindCurrentAnimation();
 }
 
-void AnimationChannel::makeModelNodeMap() {
-	const std::list<AnimNode *> &animNodes = _currentAnimation->getNodes();
-	int maxNodeNumber = -1;
-
-	for (std::list<AnimNode *>::const_iterator n = animNodes.begin();
-			n != animNodes.end(); ++n) {
-		int nodeNumber = (*n)->getNodeData()->getNodeNumber();
-		if (nodeNumber > maxNodeNumber)
-			maxNodeNumber = nodeNumber;
-	}
-
-	_modelNodeMap.clear();
+void AnimationChannel::bindCurrentAnimation() {
+	std::pair<Bindings::iterator, bool> b =
+		_bindings.insert(std::make_pair(_currentAnimation, Animation::Binding()));
 
-	if (maxNodeNumber == -1)
-		return;
+	_binding = &b.first->second;
 
-	_modelNodeMap.resize(maxNodeNumber + 1, 0);
-
-	for (std::list<AnimNode *>::const_iterator an = animNodes.begin();
-			an != animNodes.end(); ++an) {
-		ModelNode *animNode = (*an)->getNodeData();
-		int nodeNumber = animNode->getNodeNumber();
-		const Common::UString &animNodeName = animNode->getName();
-
-		// Search for the corresponding node in this model
-		Model::NodeMap::iterator n = _model->_currentState->nodeMap.find(animNodeName);
-		if (n != _model->_currentState->nodeMap.end()) {
-			_modelNodeMap[nodeNumber] = n->second;
-			continue;
-		}
-
-		// Search for the corresponding node in this model's attached models
-		for (std::map<Common::UString, Model *>::iterator m = _model->_attachedModels.begin();
-				m != _model->_attachedModels.end(); ++m) {
-			Model::State *state = m->second->_currentState;
-			if (!state)
-				continue;
-
-			n = state->nodeMap.find(animNodeName);
-			if (n != state->nodeMap.end()) {
-				_modelNodeMap[nodeNumber] = n->second;
-				break;
-			}
-		}
-
-		// Search for the corresponding node in this model's super model
-		if (_model->_superModel && !_modelNodeMap[nodeNumber])
-			_modelNodeMap[nodeNumber] = _model->_superModel->getNode(animNodeName);
-	}
+	// Bind an animation only the first time it's played, unless the model changed
+	if (b.second || !Animation::isBound(_model, *_binding))
+		_currentAnimation->bind(_model, *_binding);
 }
 
 } // End of namespace Aurora
@@ -26,17 +26,17 @@
 #define GRAPHICS_AURORA_ANIMATIONCHANNEL_H
 
 #include <list>
-#include <vector>
+#include <map>
 
 #include "src/common/mutex.h"
 
+#include "src/graphics/aurora/animation.h"
+
 namespace Graphics {
 
 namespace Aurora {
 
 class Model;
-class ModelNode;
-class Animation;
 
 class AnimationChannel {
 public:
@@ -81,6 +81,7 @@ private:
 	};
 
 	typedef std::list<DefaultAnimation> DefaultAnimations;
+	typedef std::map<Animation *, Animation::Binding> Bindings;
 
 	Model *_model;
 	Animation *_currentAnimation; ///< The currently playing animation.
@@ -91,13 +92,14 @@ private:
 	float _animationLoopLength; ///< The length of one loop of the current animation.
 	float _animationLoopTime; ///< The time the current loop of the current animation has played.
 	DefaultAnimations _defaultAnimations;
-	std::vector<ModelNode *> _modelNodeMap;
+	Bindings _bindings; ///< The bindings of all animations played so far.
+	Animation::Binding *_binding; ///< The binding of the current animation.
 	Common::Semaphore _manageSem;
 
 	void playDefaultAnimationInternal();
 	Animation *selectDefaultAnimation();
 	void setCurrentAnimation(Animation *anim);
-	void makeModelNodeMap();
+	void bindCurrentAnimation();
 };
 
 } // End of namespace Aurora
@@ -25,6 +25,7 @@
 #include "glm/gtc/type_ptr.hpp"
 
 #include "src/common/threads.h"
+#include "src/common/frametimes.h"
 
 #include "src/events/events.h"
 
@@ -37,15 +38,21 @@ namespace Graphics {
 
 namespace Aurora {
 
+/** Target length of one animation loop iteration, in milliseconds. */
+static const uint32 kLoopTime = 10;
+
 AnimationThread::PoolModel::PoolModel(Model *m)
 		: model(m),
 		  lastChanged(0),
 		  skippedCount(0) {
 }
 
+void AnimationThread::ModelJob::run() {
+	AnimationThread::manageAnimations(model, dt);
+}
+
 AnimationThread::AnimationThread()
 		: _paused(true),
-		  _flushing(false),
 		  _modelsSem(1),
 		  _registerSem(1) {
 }
@@ -80,21 +87,9 @@ void AnimationThread::unregisterModel(Model *model) {
 	}
 }
 
-void AnimationThread::flush() {
-	_flushing.store(true);
-	_modelsSem.lock();
-
-	for (ModelList::iterator m = _models.begin();
-			m != _models.end();
-			++m) {
-		m->model->flushNodeBuffers();
-	}
-
-	_modelsSem.unlock();
-	_flushing.store(false);
-}
-
 void AnimationThread::threadMethod() {
+	_pool.reset(new Common::ThreadPool(Common::ThreadPool::getDefaultThreadCount()));
+
 	while (!_killThread) {
 		if (EventMan.quitRequested())
 			break;
@@ -104,6 +99,8 @@ void AnimationThread::threadMethod() {
 			continue;
 		}
 
+		const uint32 loopStart = EventMan.getTimestamp();
+
 		_modelsSem.lock();
 
 		// Register queued models
@@ -121,38 +118,53 @@ void AnimationThread::threadMethod() {
 			continue;
 		}
 
-		for (ModelList::iterator m = _models.begin();
-				m != _models.end();
-				++m) {
-			if (EventMan.quitRequested() || _paused.load())
-				break;
-
-			if (m->skippedCount < getNumIterationsToSkip(m->model)) {
-				++m->skippedCount;
-				continue;
-			} else
-				m->skippedCount = 0;
-
-			if (_flushing.load()) {
-				_modelsSem.unlock();
-				while (_flushing.load()) // Spin until flushing is complete
-					;
-				_modelsSem.lock();
-			}
+		updateModels();
 
-			uint32 now = EventMan.getTimestamp();
-			float dt = 0;
-			if (m->lastChanged > 0)
-				dt = (now - m->lastChanged) / 1000.f;
-			m->lastChanged = now;
+		_modelsSem.unlock();
 
-			m->model->manageAnimations(dt);
-		}
+		// Only sleep for what's left of this iteration's time slice
+		const uint32 loopLength = EventMan.getTimestamp() - loopStart;
+		if (loopLength < kLoopTime)
+			EventMan.delay(kLoopTime - loopLength);
+	}
 
-		_modelsSem.unlock();
+	_pool.reset();
+}
+
+void AnimationThread::updateModels() {
+	Common::FrameTimer timer(FrameTimesMan, Common::kFramePhaseAnimation);
+
+	// Collect the models that are due for an update
+
+	_jobs.clear();
+
+	const uint32 now = EventMan.getTimestamp();
+	for (ModelList::iterator m = _models.begin(); m != _models.end(); ++m) {
+		if (m->skippedCount < getNumIterationsToSkip(m->model)) {
+			++m->skippedCount;
+			continue;
+		} else
+			m->skippedCount = 0;
 
-		EventMan.delay(10);
+		ModelJob job;
+		job.model = m->model;
+		job.dt    = 0.0f;
+
+		if (m->lastChanged > 0)
+			job.dt = (now - m->lastChanged) / 1000.f;
+		m->lastChanged = now;
+
+		_jobs.push_back(job);
 	}
+
+	/* Each model publishes its new pose when its update is done. The renderer
+	 * picks that up on its own, so we don't need to stop for it. */
+
+	_jobPointers.clear();
+	for (size_t i = 0; i < _jobs.size(); i++)
+		_jobPointers.push_back(&_jobs[i]);
+
+	_pool->run(_jobPointers);
 }
 
 void AnimationThread::registerModelInternal(Model *model) {
@@ -183,6 +195,11 @@ uint8 AnimationThread::getNumIterationsToSkip(Model *model) const {
 	return roundf(dist) / 8;
 }
 
+void AnimationThread::manageAnimations(Model *model, float dt) {
+	model->manageAnimations(dt);
+	model->publishNodeBuffers();
+}
+
 } // End of namespace Aurora
 
 } // End of namespace Engines
@@ -26,14 +26,17 @@
 #define GRAPHICS_AURORA_ANIMATIONTHREAD_H
 
 #include <queue>
+#include <vector>
 
 #include <boost/atomic.hpp>
 
 #include "glm/vec3.hpp"
 #include "glm/vec4.hpp"
 
+#include "src/common/scopedptr.h"
 #include "src/common/mutex.h"
 #include "src/common/thread.h"
+#include "src/common/threadpool.h"
 
 namespace Graphics {
 
@@ -41,6 +44,12 @@ namespace Aurora {
 
 class Model;
 
+/** A thread advancing the animations of all registered models.
+ *
+ *  The models themselves are updated in parallel, by a pool of worker
+ *  threads sized to the number of CPU cores. Each model then publishes
+ *  its new pose, which the render thread picks up without locking.
+ */
 class AnimationThread : public Common::Thread {
 public:
 	AnimationThread();
@@ -52,8 +61,6 @@ public:
 	void registerModel(Model *model);
 	/** Remove a model from the processing pool. */
 	void unregisterModel(Model *model);
-	/** Apply changes to position and geometry of all models in the processing pool. */
-	void flush();
 	// '---
 private:
 	struct PoolModel {
@@ -64,22 +71,39 @@ private:
 		PoolModel(Model *m);
 	};
 
+	/** A job advancing the animations of one model. */
+	class ModelJob : public Common::ThreadPoolJob {
+	public:
+		Model *model;
+		float dt;
+
+		void run();
+	};
+
 	typedef std::list<PoolModel> ModelList;
 	typedef std::queue<Model *> ModelQueue;
 
 	ModelList _models;
 	ModelQueue _registerQueue;
 
+	Common::ScopedPtr<Common::ThreadPool> _pool; ///< The workers updating the models.
+
+	std::vector<ModelJob> _jobs; ///< The models to update in this loop iteration.
+	std::vector<Common::ThreadPoolJob *> _jobPointers;
+
 	boost::atomic<bool> _paused;
-	boost::atomic<bool> _flushing;
 
 	Common::Semaphore _modelsSem;   ///< Semaphore protecting access to the model list.
 	Common::Semaphore _registerSem; ///< Semaphore protecting access to the registration queue.
 
 	void threadMethod();
+	/** Update the animations of all models that are due in this loop iteration. */
+	void updateModels();
 	void registerModelInternal(Model *model);
 	void unregisterModelInternal(Model *model);
 	uint8 getNumIterationsToSkip(Model *model) const;
+
+	static void manageAnimations(Model *model, float dt);
 };
 
 } // End of namespace Aurora
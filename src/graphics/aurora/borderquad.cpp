@@ -107,8 +107,8 @@ void BorderQuad::calculateDistance() {
 }
 
 void BorderQuad::render(RenderPass pass) {
-	bool isTransparent = (!_corner.empty() && _corner.getTexture().hasAlpha()) ||
-	                     (!_edge.empty() && _edge.getTexture().hasAlpha());
+	bool isTransparent = (!_corner.empty() && _corner.getTexture().hasUploadedAlpha()) ||
+	                     (!_edge.empty() && _edge.getTexture().hasUploadedAlpha());
 	if (((pass == kRenderPassOpaque)      &&  isTransparent) ||
 			((pass == kRenderPassTransparent) && !isTransparent))
 		return;
@@ -66,7 +66,7 @@ void CubeSide::calculateDistance() {
 }
 
 void CubeSide::render(RenderPass pass) {
-	bool isTransparent = _parent->_texture.getTexture().hasAlpha();
+	bool isTransparent = _parent->_texture.getTexture().hasUploadedAlpha();
 	if (((pass == kRenderPassOpaque)      &&  isTransparent) ||
 			((pass == kRenderPassTransparent) && !isTransparent))
 		return;
@@ -0,0 +1,142 @@
+/* xoreos - A reimplementation of BioWare's Aurora engine
+ *
+ * xoreos is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * xoreos is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * xoreos is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with xoreos. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  A text object displaying frame time statistics.
+ */
+
+#include "src/common/system.h"
+#include "src/common/ustring.h"
+#include "src/common/frametimes.h"
+
+#include "src/events/events.h"
+
+#include "src/graphics/graphics.h"
+#include "src/graphics/font.h"
+
+#include "src/graphics/aurora/framestats.h"
+
+namespace Graphics {
+
+namespace Aurora {
+
+/** Time between updates of the displayed statistics, in milliseconds. */
+static const uint32 kUpdateInterval = 500;
+
+/** Length of the longest histogram bar, in characters. */
+static const size_t kBarLength = 30;
+
+/** Space to leave at the top, for the FPS display. */
+static const float kTopMargin = 20.0f;
+
+static Common::UString formatTime(uint32 time) {
+	return Common::UString::format("%5.1fms", time / 1000.0f);
+}
+
+FrameStats::FrameStats(const FontHandle &font) :
+	Text(font, WindowMan.getWindowWidth(), WindowMan.getWindowHeight(), ""), _lastUpdate(0) {
+
+	init();
+}
+
+FrameStats::~FrameStats() {
+	hide();
+
+	GfxMan.setGPUTiming(false);
+}
+
+void FrameStats::init() {
+	setTag("FrameStats");
+	notifyResized(0, 0, WindowMan.getWindowWidth(), WindowMan.getWindowHeight());
+
+	GfxMan.setGPUTiming(true);
+}
+
+void FrameStats::render(RenderPass pass) {
+	// Text objects should always be transparent
+	if (pass == kRenderPassOpaque)
+		return;
+
+	const uint32 now = EventMan.getTimestamp();
+	if ((_lastUpdate == 0) || ((now - _lastUpdate) >= kUpdateInterval)) {
+		_lastUpdate = now;
+
+		update();
+	}
+
+	Text::render(pass);
+}
+
+void FrameStats::update() {
+	Common::UString text;
+
+	// Percentiles of the whole frame time
+
+	text += Common::UString::format("%u frames: p50 ", (uint) FrameTimesMan.getFrameCount());
+	text += formatTime(FrameTimesMan.getPercentile(50)) + "  p95 ";
+	text += formatTime(FrameTimesMan.getPercentile(95)) + "  p99 ";
+	text += formatTime(FrameTimesMan.getPercentile(99)) + "\n";
+
+	// Average time of each phase
+
+	for (size_t i = 0; i < Common::kFramePhaseMAX; i++) {
+		const Common::FramePhase phase = (Common::FramePhase) i;
+
+		text += Common::UString::format("%-9s ", Common::FrameTimes::getPhaseName(phase));
+		text += formatTime(FrameTimesMan.getPhaseAverage(phase)) + "\n";
+	}
+
+	// Histogram of the frame times
+
+	Common::FrameTimes::Histogram histogram;
+	FrameTimesMan.getHistogram(histogram);
+
+	uint32 maxCount = 1;
+	for (size_t i = 0; i < Common::FrameTimes::kHistogramSize; i++)
+		maxCount = MAX(maxCount, histogram.buckets[i]);
+
+	for (size_t i = 0; i < Common::FrameTimes::kHistogramSize; i++) {
+		const uint32 limit = Common::FrameTimes::getHistogramLimit(i);
+
+		if (limit == 0xFFFFFFFF)
+			text += Common::UString::format(">%4ums ", (uint) (Common::FrameTimes::getHistogramLimit(i - 1) / 1000));
+		else
+			text += Common::UString::format("<=%3ums ", (uint) (limit / 1000));
+
+		const size_t length = (histogram.buckets[i] * kBarLength + maxCount - 1) / maxCount;
+
+		text += Common::UString('#', length);
+		text += Common::UString::format(" %u\n", (uint) histogram.buckets[i]);
+	}
+
+	setText(text);
+}
+
+void FrameStats::notifyResized(int UNUSED(oldWidth), int UNUSED(oldHeight), int newWidth, int newHeight) {
+	float posX = -(newWidth  / 2.0f);
+	float posY = -(newHeight / 2.0f);
+
+	setPosition(posX, posY);
+	setSize(newWidth, newHeight - kTopMargin);
+}
+
+} // End of namespace Aurora
+
+} // End of namespace Graphics
@@ -235,7 +235,7 @@ void GUIQuad::calculateDistance() {
 }
 
 void GUIQuad::render(RenderPass pass) {
-	bool isTransparent = (_a < 1.0f) || (!_texture.empty() && _texture.getTexture().hasAlpha());
+	bool isTransparent = (_a < 1.0f) || (!_texture.empty() && _texture.getTexture().hasUploadedAlpha());
 	if (((pass == kRenderPassOpaque)      &&  isTransparent) ||
 			((pass == kRenderPassTransparent) && !isTransparent))
 		return;
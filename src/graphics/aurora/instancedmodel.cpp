@@ -0,0 +1,162 @@
+/* xoreos - A reimplementation of BioWare's Aurora engine
+ *
+ * xoreos is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * xoreos is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * xoreos is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with xoreos. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  A model rendered at many places at once.
+ */
+
+#include <cassert>
+
+#include "glm/gtc/matrix_transform.hpp"
+
+#include "src/common/util.h"
+#include "src/common/maths.h"
+
+#include "src/graphics/graphics.h"
+#include "src/graphics/camera.h"
+#include "src/graphics/frustum.h"
+
+#include "src/graphics/aurora/instancedmodel.h"
+#include "src/graphics/aurora/model.h"
+
+namespace Graphics {
+
+namespace Aurora {
+
+InstancedModel::InstancedModel(Model *model) : Renderable(kRenderableTypeObject), _model(model) {
+	assert(_model);
+}
+
+InstancedModel::~InstancedModel() {
+	hide();
+}
+
+Model &InstancedModel::getModel() {
+	return *_model;
+}
+
+void InstancedModel::addInstance(float x, float y, float z, float angle) {
+	glm::mat4 transform;
+	transform = glm::translate(transform, glm::vec3(x, y, z));
+	transform = glm::rotate(transform, Common::deg2rad(angle), glm::vec3(0.0f, 0.0f, 1.0f));
+
+	// Transform the model's bounding box into a box around this instance
+
+	BVH::Box box;
+
+	float min[3], max[3];
+	if (_model->getBounds(min, max)) {
+		for (int i = 0; i < 3; i++) {
+			box.min[i] =  1e30f;
+			box.max[i] = -1e30f;
+		}
+
+		for (int c = 0; c < 8; c++) {
+			const glm::vec4 corner = transform * glm::vec4((c & 1) ? max[0] : min[0],
+			                                               (c & 2) ? max[1] : min[1],
+			                                               (c & 4) ? max[2] : min[2], 1.0f);
+
+			for (int i = 0; i < 3; i++) {
+				box.min[i] = MIN(box.min[i], corner[i]);
+				box.max[i] = MAX(box.max[i], corner[i]);
+			}
+		}
+
+	} else {
+		// Without a bounding box, never cull the instance
+		for (int i = 0; i < 3; i++) {
+			box.min[i] = -1e30f;
+			box.max[i] =  1e30f;
+		}
+	}
+
+	lockFrameIfVisible();
+
+	_instances.push_back(transform);
+	_bounds.push_back(box);
+
+	unlockFrameIfVisible();
+}
+
+size_t InstancedModel::getInstanceCount() const {
+	return _instances.size();
+}
+
+void InstancedModel::show() {
+	Renderable::show();
+	GfxMan.registerAnimatedModel(_model.get());
+}
+
+void InstancedModel::hide() {
+	GfxMan.unregisterAnimatedModel(_model.get());
+	Renderable::hide();
+}
+
+void InstancedModel::calculateDistance() {
+	const float cameraX = -CameraMan.getPosition()[0];
+	const float cameraY = -CameraMan.getPosition()[1];
+	const float cameraZ = -CameraMan.getPosition()[2];
+
+	// The distance to the closest instance
+	_distance = 1e30;
+	for (std::vector<BVH::Box>::const_iterator b = _bounds.begin(); b != _bounds.end(); ++b) {
+		const float x = ABS((b->min[0] + b->max[0]) * 0.5f - cameraX);
+		const float y = ABS((b->min[1] + b->max[1]) * 0.5f - cameraY);
+		const float z = ABS((b->min[2] + b->max[2]) * 0.5f - cameraZ);
+
+		_distance = MIN<double>(_distance, x + y + z);
+	}
+}
+
+void InstancedModel::render(RenderPass pass) {
+	const glm::mat4 &modelview = GfxMan.getModelviewMatrix();
+
+	const Frustum frustum(GfxMan.getProjectionMatrix() * modelview);
+
+	_visible.clear();
+	for (size_t i = 0; i < _instances.size(); i++)
+		if (frustum.isIn(_bounds[i].min, _bounds[i].max))
+			_visible.push_back(_instances[i]);
+
+	_model->renderInstances(pass, modelview, _visible);
+}
+
+bool InstancedModel::getBounds(float min[3], float max[3]) const {
+	if (_bounds.empty())
+		return false;
+
+	for (int i = 0; i < 3; i++) {
+		min[i] = _bounds[0].min[i];
+		max[i] = _bounds[0].max[i];
+	}
+
+	for (std::vector<BVH::Box>::const_iterator b = _bounds.begin(); b != _bounds.end(); ++b) {
+		for (int i = 0; i < 3; i++) {
+			min[i] = MIN(min[i], b->min[i]);
+			max[i] = MAX(max[i], b->max[i]);
+		}
+	}
+
+	return true;
+}
+
+} // End of namespace Aurora
+
+} // End of namespace Graphics
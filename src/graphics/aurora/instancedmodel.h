@@ -0,0 +1,87 @@
+/* xoreos - A reimplementation of BioWare's Aurora engine
+ *
+ * xoreos is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * xoreos is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * xoreos is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with xoreos. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  A model rendered at many places at once.
+ */
+
+#ifndef GRAPHICS_AURORA_INSTANCEDMODEL_H
+#define GRAPHICS_AURORA_INSTANCEDMODEL_H
+
+#include <vector>
+
+#include "glm/mat4x4.hpp"
+
+#include "src/common/scopedptr.h"
+
+#include "src/graphics/renderable.h"
+#include "src/graphics/bvh.h"
+
+namespace Graphics {
+
+namespace Aurora {
+
+class Model;
+
+/** A model rendered at many places at once.
+ *
+ *  All instances share the geometry, textures and animation state of one
+ *  model, which only has to be loaded once. Each mesh of the model is
+ *  drawn for all instances within the view frustum in one go.
+ *
+ *  This is meant for static level geometry repeated all over an area,
+ *  like the tiles in Neverwinter Nights.
+ */
+class InstancedModel : public Renderable {
+public:
+	/** Create an instanced model, taking over the ownership of the model. */
+	InstancedModel(Model *model);
+	~InstancedModel();
+
+	/** Get the model shared by all instances. */
+	Model &getModel();
+
+	/** Add an instance at this position, rotated by an angle (in degrees) around the z axis. */
+	void addInstance(float x, float y, float z, float angle);
+	/** Return the number of instances. */
+	size_t getInstanceCount() const;
+
+	void show();
+	void hide();
+
+	// Renderable
+	void calculateDistance();
+	void render(RenderPass pass);
+	bool getBounds(float min[3], float max[3]) const;
+
+private:
+	Common::ScopedPtr<Model> _model;
+
+	std::vector<glm::mat4> _instances; ///< The transformation of each instance.
+	std::vector<BVH::Box>  _bounds;    ///< The bounding box of each instance.
+
+	std::vector<glm::mat4> _visible; ///< The instances within the view frustum.
+};
+
+} // End of namespace Aurora
+
+} // End of namespace Graphics
+
+#endif // GRAPHICS_AURORA_INSTANCEDMODEL_H
@@ -0,0 +1,45 @@
+/* xoreos - A reimplementation of BioWare's Aurora engine
+ *
+ * xoreos is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * xoreos is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * xoreos is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with xoreos. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  Searching animation keyframes.
+ */
+
+#include "src/graphics/aurora/keyframes.h"
+
+namespace Graphics {
+
+namespace Aurora {
+
+uint32 findKeyFrame(const float *times, uint32 count, float time, uint32 &cursor) {
+	uint32 frame = cursor;
+	if ((frame >= count) || ((frame > 0) && (times[frame] >= time)))
+		frame = 0;
+
+	while (((frame + 1) < count) && (times[frame + 1] < time))
+		frame++;
+
+	cursor = frame;
+	return frame;
+}
+
+} // End of namespace Aurora
+
+} // End of namespace Graphics
@@ -0,0 +1,55 @@
+/* xoreos - A reimplementation of BioWare's Aurora engine
+ *
+ * xoreos is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * xoreos is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * xoreos is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with xoreos. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  Searching animation keyframes.
+ */
+
+#ifndef GRAPHICS_AURORA_KEYFRAMES_H
+#define GRAPHICS_AURORA_KEYFRAMES_H
+
+#include "src/common/types.h"
+
+namespace Graphics {
+
+namespace Aurora {
+
+/** Find the last keyframe before this time, starting the search at the cursor.
+ *
+ *  Animations usually play forward, so the search continues where the
+ *  last one, stored in the cursor, ended. Only when the time went
+ *  backwards, like when the animation looped, or when the cursor is out
+ *  of range, does the search start from the beginning again.
+ *
+ *  If the time is before the second keyframe, the first keyframe is found.
+ *
+ *  @param  times  The times of the keyframes, in ascending order.
+ *  @param  count  The number of keyframes. Has to be at least 1.
+ *  @param  time   The time to find the keyframe for.
+ *  @param  cursor The keyframe found by the last search, updated to the one found now.
+ *  @return The index of the keyframe found.
+ */
+uint32 findKeyFrame(const float *times, uint32 count, float time, uint32 &cursor);
+
+} // End of namespace Aurora
+
+} // End of namespace Graphics
+
+#endif // GRAPHICS_AURORA_KEYFRAMES_H
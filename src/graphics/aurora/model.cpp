@@ -37,6 +37,7 @@ STOP_IGNORE_IMPLICIT_FALLTHROUGH
 #include "src/common/readstream.h"
 #include "src/common/debug.h"
 
+#include "src/graphics/graphics.h"
 #include "src/graphics/camera.h"
 
 #include "src/graphics/aurora/model.h"
@@ -56,6 +57,9 @@ namespace Graphics {
 
 namespace Aurora {
 
+Model::PoseSnapshot::PoseSnapshot() : generation(0) {
+}
+
 Model::Model(ModelType type)
 		: Renderable((RenderableType) type),
 		  _type(type),
@@ -63,6 +67,8 @@ Model::Model(ModelType type)
 		  _currentState(0),
 		  _skinned(false),
 		  _positionRelative(false),
+		  _nodeGeneration(0),
+		  _renderGeneration(0),
 		  _drawBound(false),
 		  _drawSkeleton(false),
 		  _drawSkeletonInvisible(false) {
@@ -160,6 +166,27 @@ bool Model::isIn(float x1, float y1, float z1, float x2, float y2, float z2) con
 	return _absoluteBoundBox.isIn(x1, y1, z1, x2, y2, z2);
 }
 
+bool Model::getBounds(float min[3], float max[3]) const {
+	if ((_type != kModelTypeObject) || _absoluteBoundBox.empty())
+		return false;
+
+	_absoluteBoundBox.getMin(min[0], min[1], min[2]);
+	_absoluteBoundBox.getMax(max[0], max[1], max[2]);
+
+	/* The bounding box is that of the model at rest. Animations and attached
+	 * models can reach outside of it, so give those some leeway. */
+	if (!_animationMap.empty() || _superModel || !_attachedModels.empty()) {
+		const float size = MAX(MAX(max[0] - min[0], max[1] - min[1]), max[2] - min[2]) * 0.5f;
+
+		for (int i = 0; i < 3; i++) {
+			min[i] -= size;
+			max[i] += size;
+		}
+	}
+
+	return true;
+}
+
 float Model::getWidth() const {
 	return _boundBox.getWidth() * _scale[0];
 }
@@ -301,17 +328,23 @@ void Model::getTooltipAnchor(float &x, float &y, float &z) const {
 	z = pos[3][2];
 }
 
-void Model::createAbsolutePosition() {
-	_absolutePosition = glm::mat4();
+glm::mat4 Model::getModelTransform() const {
+	glm::mat4 transform;
 
-	_absolutePosition = glm::translate(_absolutePosition, glm::vec3(_position[0], _position[1], _position[2]));
+	transform = glm::translate(transform, glm::vec3(_position[0], _position[1], _position[2]));
 
 	if (_orientation[0] != 0 || _orientation[1] != 0 || _orientation[2] != 0)
-		_absolutePosition = glm::rotate(_absolutePosition,
+		transform = glm::rotate(transform,
 				Common::deg2rad(_orientation[3]),
 				glm::vec3(_orientation[0], _orientation[1], _orientation[2]));
 
-	_absolutePosition = glm::scale(_absolutePosition, glm::vec3(_scale[0], _scale[1], _scale[2]));
+	transform = glm::scale(transform, glm::vec3(_scale[0], _scale[1], _scale[2]));
+
+	return transform;
+}
+
+void Model::createAbsolutePosition() {
+	_absolutePosition = getModelTransform();
 
 	_absoluteBoundBox = _boundBox;
 	_absoluteBoundBox.transform(_absolutePosition);
@@ -349,6 +382,7 @@ void Model::setState(const Common::UString &name) {
 	}
 
 	_currentState = state;
+	_nodeGeneration.fetch_add(1, boost::memory_order_release);
 
 	createBound();
 
@@ -490,6 +524,8 @@ void Model::attachModel(const Common::UString &nodeName, Model *model) {
 		if (model)
 			_attachedModels.insert(std::pair<Common::UString, Model *>(nodeName, model));
 
+		_nodeGeneration.fetch_add(1, boost::memory_order_release);
+
 		createBound();
 	}
 }
@@ -589,23 +625,55 @@ void Model::calculateDistance() {
 
 void Model::advanceTime(float dt) {
 	manageAnimations(dt);
+	publishNodeBuffers();
 	flushNodeBuffers();
 }
 
-void Model::flushNodeBuffers() {
+void Model::publishNodeBuffers() {
 	for (std::map<Common::UString, Model *>::iterator m = _attachedModels.begin();
 			m != _attachedModels.end(); ++m) {
-		m->second->flushNodeBuffers();
+		m->second->publishNodeBuffers();
 	}
 
 	if (!_currentState)
 		return;
 
+	PoseSnapshot &snapshot = _poses.getBack();
+
+	snapshot.generation = _nodeGeneration.load(boost::memory_order_acquire);
+	snapshot.nodes.clear();
+	snapshot.vertexCoords.clear();
+
+	ModelNode::Pose pose;
+
 	NodeList &nodes = _currentState->nodeList;
 	for (NodeList::iterator n = nodes.begin();
 			n != nodes.end();
 			++n) {
-		(*n)->flushBuffers();
+		if ((*n)->publishBuffers(pose, snapshot.vertexCoords))
+			snapshot.nodes.push_back(pose);
+	}
+
+	_poses.publish();
+}
+
+void Model::flushNodeBuffers() {
+	for (std::map<Common::UString, Model *>::iterator m = _attachedModels.begin();
+			m != _attachedModels.end(); ++m) {
+		m->second->flushNodeBuffers();
+	}
+
+	if (!_poses.update())
+		return;
+
+	// Ignore a pose taken before the model's nodes changed
+	const PoseSnapshot &snapshot = _poses.getFront();
+	if (!_currentState || (snapshot.generation != _nodeGeneration.load(boost::memory_order_acquire)))
+		return;
+
+	for (std::vector<ModelNode::Pose>::const_iterator p = snapshot.nodes.begin();
+			p != snapshot.nodes.end(); ++p) {
+		p->node->flushBuffers(*p, snapshot.vertexCoords);
 	}
 }
 
@@ -631,37 +699,90 @@ void Model::manageAnimations(float dt) {
 }
 
 void Model::render(RenderPass pass) {
+	/* The graphics manager draws world objects relative to the camera
+	 * and GUI elements without any further transformation. */
+	if (_type == kModelTypeObject)
+		render(pass, GfxMan.getModelviewMatrix());
+	else
+		render(pass, glm::mat4());
+}
+
+void Model::render(RenderPass pass, const glm::mat4 &modelview) {
 	if (!_currentState || (pass > kRenderPassAll))
 		return;
 
 	if (pass == kRenderPassAll) {
-		Model::render(kRenderPassOpaque);
-		Model::render(kRenderPassTransparent);
+		Model::render(kRenderPassOpaque, modelview);
+		Model::render(kRenderPassTransparent, modelview);
 		return;
 	}
 
-	// Apply our global model transformation
-	glTranslatef(_position[0], _position[1], _position[2]);
-	glRotatef(_orientation[3], _orientation[0], _orientation[1], _orientation[2]);
-	glScalef(_scale[0], _scale[1], _scale[2]);
+	/* Once per frame, before the first pass, pick up the newest animated pose
+	 * and flatten the node hierarchy into one list of node transformations. */
+	if ((pass == kRenderPassOpaque) || (_renderGeneration != _nodeGeneration.load(boost::memory_order_acquire))) {
+		flushNodeBuffers();
+		flattenNodeTransforms();
+	}
 
 	// Draw the bounding box, if requested
 	doDrawBound();
 
 	// Draw the nodes
-	for (NodeList::iterator n = _currentState->rootNodes.begin();
-	     n != _currentState->rootNodes.end(); ++n) {
+	for (size_t i = 0; i < _renderNodes.size(); i++)
+		_renderNodes[i]->render(pass, modelview * _renderTransforms[i]);
+
+	// Reset the first texture units
+	TextureMan.reset();
+
+	// Draw the skeleton, if requested
+	if (_drawSkeleton) {
+		glLoadMatrixf(glm::value_ptr(modelview * getModelTransform()));
+		doDrawSkeleton();
+	}
 
-		glPushMatrix();
-		(*n)->render(pass);
-		glPopMatrix();
+	glLoadMatrixf(glm::value_ptr(modelview));
+}
+
+void Model::renderInstances(RenderPass pass, const glm::mat4 &modelview, const std::vector<glm::mat4> &instances) {
+	if (!_currentState || (pass > kRenderPassAll) || instances.empty())
+		return;
+
+	if (pass == kRenderPassAll) {
+		Model::renderInstances(kRenderPassOpaque, modelview, instances);
+		Model::renderInstances(kRenderPassTransparent, modelview, instances);
+		return;
+	}
+
+	if ((pass == kRenderPassOpaque) || (_renderGeneration != _nodeGeneration.load(boost::memory_order_acquire))) {
+		flushNodeBuffers();
+		flattenNodeTransforms();
 	}
 
+	_instanceParents.clear();
+	for (std::vector<glm::mat4>::const_iterator i = instances.begin(); i != instances.end(); ++i)
+		_instanceParents.push_back(modelview * *i);
+
+	// Draw the nodes
+	for (size_t i = 0; i < _renderNodes.size(); i++)
+		_renderNodes[i]->renderInstances(pass, _renderTransforms[i], _instanceParents, _instanceTransforms);
+
+	glLoadMatrixf(glm::value_ptr(modelview));
+
 	// Reset the first texture units
 	TextureMan.reset();
+}
 
-	// Draw the skeleton, if requested
-	doDrawSkeleton();
+void Model::flattenNodeTransforms() {
+	_renderNodes.clear();
+	_renderTransforms.clear();
+
+	_renderGeneration = _nodeGeneration.load(boost::memory_order_acquire);
+
+	const glm::mat4 transform = getModelTransform();
+
+	for (NodeList::iterator n = _currentState->rootNodes.begin();
+	     n != _currentState->rootNodes.end(); ++n)
+		(*n)->flattenTransforms(transform, _renderNodes, _renderTransforms);
 }
 
 void Model::doDrawBound() {
@@ -733,11 +854,38 @@ void Model::doDrawSkeleton() {
 
 	glm::mat4 tform;
 
+	std::vector<float> joints, invisibleJoints, bones;
+	for (NodeList::iterator n = _currentState->rootNodes.begin(); n != _currentState->rootNodes.end(); ++n)
+		(*n)->drawSkeleton(tform, _drawSkeletonInvisible, joints, invisibleJoints, bones);
+
 	if (_type == kModelTypeObject)
 		glDisable(GL_DEPTH_TEST);
 
-	for (NodeList::iterator n = _currentState->rootNodes.begin(); n != _currentState->rootNodes.end(); ++n)
-		(*n)->drawSkeleton(tform, _drawSkeletonInvisible);
+	glEnableClientState(GL_VERTEX_ARRAY);
+
+	glPointSize(5.0f);
+
+	if (!joints.empty()) {
+		glColor4f(0.0f, 1.0f, 0.0f, 1.0f);
+		glVertexPointer(3, GL_FLOAT, 0, &joints[0]);
+		glDrawArrays(GL_POINTS, 0, joints.size() / 3);
+	}
+
+	if (!invisibleJoints.empty()) {
+		glColor4f(1.0f, 0.0f, 0.0f, 1.0f);
+		glVertexPointer(3, GL_FLOAT, 0, &invisibleJoints[0]);
+		glDrawArrays(GL_POINTS, 0, invisibleJoints.size() / 3);
+	}
+
+	glLineWidth(2.0f);
+
+	if (!bones.empty()) {
+		glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+		glVertexPointer(3, GL_FLOAT, 0, &bones[0]);
+		glDrawArrays(GL_LINES, 0, bones.size() / 3);
+	}
+
+	glDisableClientState(GL_VERTEX_ARRAY);
 
 	if (_type == kModelTypeObject)
 		glEnable(GL_DEPTH_TEST);
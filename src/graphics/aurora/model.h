@@ -25,6 +25,8 @@
 #ifndef GRAPHICS_AURORA_MODEL_H
 #define GRAPHICS_AURORA_MODEL_H
 
+#include "src/common/atomic.h"
+
 #include <vector>
 #include <list>
 #include <map>
@@ -33,6 +35,7 @@
 
 #include "src/common/ustring.h"
 #include "src/common/boundingbox.h"
+#include "src/common/triplebuffer.h"
 
 #include "src/graphics/types.h"
 #include "src/graphics/glcontainer.h"
@@ -95,6 +98,7 @@ public:
 	/** Does the line from x1.y1.z1 to x2.y2.z2 intersect with model's bounding box? */
 	bool isIn(float x1, float y1, float z1, float x2, float y2, float z2) const;
 
+	bool getBounds(float min[3], float max[3]) const;
 
 	// Positioning
 
@@ -185,7 +189,33 @@ public:
 	void render(RenderPass pass);
 	void advanceTime(float dt);
 
-	/** Apply buffered changes to model nodes position and geometry. */
+	/** Render the model, placed into the scene by this modelview matrix.
+	 *
+	 *  The modelview matrix is the transformation the model is drawn
+	 *  relative to: the camera view for world objects, the identity for
+	 *  GUI elements, and the node's transformation for attached models.
+	 */
+	virtual void render(RenderPass pass, const glm::mat4 &modelview);
+
+	/** Render the model once with each of these transformations.
+	 *
+	 *  All instances share the model's current state, animation and textures.
+	 *  Each mesh is drawn for all instances at once.
+	 *
+	 *  The instance transformations are placed in the world by the modelview
+	 *  matrix, which is usually the camera view of the graphics manager.
+	 */
+	void renderInstances(RenderPass pass, const glm::mat4 &modelview, const std::vector<glm::mat4> &instances);
+
+	/** Publish a snapshot of the animated pose of all nodes.
+	 *
+	 *  Called by the thread advancing the model's animations, after each update.
+	 */
+	void publishNodeBuffers();
+	/** Apply the most recently published pose to model nodes position and geometry.
+	 *
+	 *  Called by the render thread. Never blocks the animation thread.
+	 */
 	void flushNodeBuffers();
 
 	Model *getAttachedModel(const Common::UString &node);
@@ -248,12 +278,43 @@ protected:
 	bool _skinned;
 	bool _positionRelative;
 
+	/** Changes whenever the nodes animations are bound to might have changed.
+	 *
+	 *  Written by the game thread, read by the animation workers and the render thread.
+	 */
+	boost::atomic<uint32> _nodeGeneration;
+
+	/** A snapshot of the animated pose of the current state's nodes. */
+	struct PoseSnapshot {
+		uint32 generation; ///< The node generation the snapshot was taken in.
+
+		std::vector<ModelNode::Pose> nodes;
+		std::vector<float> vertexCoords; ///< Skinned vertex coordinates of all nodes.
+
+		PoseSnapshot();
+	};
+
+	/** Node poses handed from the animation thread to the render thread. */
+	Common::TripleBuffer<PoseSnapshot> _poses;
+
+	// .--- Flattened node hierarchy, updated by the render thread once per frame
+	std::vector<ModelNode *> _renderNodes;        ///< All nodes of the current state, in render order.
+	std::vector<glm::mat4>   _renderTransforms;   ///< The nodes' transformations, including the model's own.
+	std::vector<glm::mat4>   _instanceParents;    ///< The instances' transformations, including the view.
+	std::vector<glm::mat4>   _instanceTransforms; ///< Scratch space for instanced rendering.
+
+	uint32 _renderGeneration; ///< The node generation the flattened nodes were created in.
+	// '---
+
 
 	// Rendering
 
 	void doDrawBound();
 	void doDrawSkeleton();
 
+	/** Recalculate the transformations of all nodes, relative to the model's parent. */
+	void flattenNodeTransforms();
+
 	// Animation
 
 	/** Get the animation from its name. */
@@ -284,6 +345,8 @@ private:
 	void createBound();
 
 	void createAbsolutePosition();
+	/** Return the model's position, orientation and scale as one matrix. */
+	glm::mat4 getModelTransform() const;
 
 	void manageAnimations(float dt);
 
@@ -1333,7 +1333,7 @@ glm::mat4 Model_Sonic::createPivot(double a, double b, uint8 select, uint8 negat
 	return glm::make_mat4(pivot);
 }
 
-void Model_Sonic::render(RenderPass pass) {
+void Model_Sonic::render(RenderPass pass, const glm::mat4 &modelview) {
 	/* We're overriding Model::render() here, because Model_Sonic keeps the geometry,
 	 * while in other Model classes, the geometry is inside the ModelNodes.
 	 *
@@ -1344,11 +1344,13 @@ void Model_Sonic::render(RenderPass pass) {
 		return;
 
 	if (pass == kRenderPassAll) {
-		Model_Sonic::render(kRenderPassOpaque);
-		Model_Sonic::render(kRenderPassTransparent);
+		Model_Sonic::render(kRenderPassOpaque, modelview);
+		Model_Sonic::render(kRenderPassTransparent, modelview);
 		return;
 	}
 
+	glLoadMatrixf(glm::value_ptr(modelview));
+
 	// Apply our global model transformation
 	glTranslatef(_position[0], _position[1], _position[2]);
 	glRotatef(_orientation[3], _orientation[0], _orientation[1], _orientation[2]);
@@ -118,7 +118,8 @@ public:
 	Model_Sonic(const Common::UString &name, ModelType type = kModelTypeObject);
 	~Model_Sonic();
 
-	void render(RenderPass pass);
+	using Model::render;
+	void render(RenderPass pass, const glm::mat4 &modelview);
 
 private:
 	// === Loading-time ===
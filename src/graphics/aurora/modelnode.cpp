@@ -61,7 +61,7 @@ ModelNode::MeshData::MeshData() : envMapMode(kModeEnvironmentBlendedUnder) {
 
 ModelNode::Mesh::Mesh() : shininess(1.0f), alpha(1.0f), tilefade(0), render(false),
 	shadow(false), beaming(false), inheritcolor(false), rotatetexture(false),
-	isTransparent(false), hasTransparencyHint(false), transparencyHint(false),
+	isTransparent(false), texturesPending(false), hasTransparencyHint(false), transparencyHint(false),
 	data(0), dangly(0), skin(0) {
 }
 
@@ -304,11 +304,6 @@ void ModelNode::loadTextures(const std::vector<Common::UString> &textures) {
 
 	_mesh->data->textures.resize(textures.size());
 
-	bool hasAlpha = true;
-	bool isDecal  = true;
-
-	Common::UString envMap;
-
 	for (size_t t = 0; t != textures.size(); t++) {
 
 		try {
@@ -319,19 +314,6 @@ void ModelNode::loadTextures(const std::vector<Common::UString> &textures) {
 					continue;
 
 				hasTexture = true;
-
-				if (!_mesh->data->textures[t].getTexture().hasAlpha())
-					hasAlpha = false;
-				if (_mesh->data->textures[t].getTexture().getTXI().getFeatures().alphaMean == 1.0f)
-					hasAlpha = false;
-
-				if (!_mesh->data->textures[t].getTexture().getTXI().getFeatures().decal)
-					isDecal = false;
-
-				if (!_mesh->data->textures[t].getTexture().getTXI().getFeatures().bumpyShinyTexture.empty())
-					envMap = _mesh->data->textures[t].getTexture().getTXI().getFeatures().bumpyShinyTexture;
-				if (!_mesh->data->textures[t].getTexture().getTXI().getFeatures().envMapTexture.empty())
-					envMap = _mesh->data->textures[t].getTexture().getTXI().getFeatures().envMapTexture;
 			}
 
 		} catch (...) {
@@ -340,6 +322,24 @@ void ModelNode::loadTextures(const std::vector<Common::UString> &textures) {
 
 	}
 
+	/* The environment map is named in the TXI. A separate TXI file is read
+	 * right away, only a TXI embedded in the image has to wait for the
+	 * decoding. All textures are queued by now, so they decode side by side. */
+	Common::UString envMap;
+
+	const std::vector<TextureHandle> &handles = _mesh->data->textures;
+	for (std::vector<TextureHandle>::const_iterator t = handles.begin(); t != handles.end(); ++t) {
+		if (t->empty())
+			continue;
+
+		const TXI::Features &features = t->getTexture().getTXI().getFeatures();
+
+		if (!features.bumpyShinyTexture.empty())
+			envMap = features.bumpyShinyTexture;
+		if (!features.envMapTexture.empty())
+			envMap = features.envMapTexture;
+	}
+
 	envMap.trim();
 	if (!envMap.empty()) {
 		try {
@@ -349,13 +349,10 @@ void ModelNode::loadTextures(const std::vector<Common::UString> &textures) {
 		}
 	}
 
-	if (_mesh->hasTransparencyHint) {
-		_mesh->isTransparent = _mesh->transparencyHint;
-		if (isDecal)
-			_mesh->isTransparent = true;
-	} else {
-		_mesh->isTransparent = hasAlpha;
-	}
+	/* The textures are decoded in the background. Their transparency is
+	 * evaluated once they're all done, by the render thread, so that loading
+	 * the model doesn't have to wait for them. */
+	_mesh->texturesPending = true;
 
 	// If the node has no actual texture, we just assume
 	// that the geometry shouldn't be rendered.
@@ -363,6 +360,47 @@ void ModelNode::loadTextures(const std::vector<Common::UString> &textures) {
 		_render = false;
 }
 
+bool ModelNode::evaluateTextures(Mesh &mesh) {
+	if (!mesh.texturesPending)
+		return true;
+
+	const std::vector<TextureHandle> &textures = mesh.data->textures;
+
+	for (std::vector<TextureHandle>::const_iterator t = textures.begin(); t != textures.end(); ++t)
+		if (!t->empty() && !t->getTexture().isDecoded())
+			return false;
+
+	bool hasAlpha = true;
+	bool isDecal  = true;
+
+	for (std::vector<TextureHandle>::const_iterator t = textures.begin(); t != textures.end(); ++t) {
+		if (t->empty())
+			continue;
+
+		const Texture &texture = t->getTexture();
+		const TXI::Features &features = texture.getTXI().getFeatures();
+
+		if (!texture.hasAlpha())
+			hasAlpha = false;
+		if (features.alphaMean == 1.0f)
+			hasAlpha = false;
+
+		if (!features.decal)
+			isDecal = false;
+	}
+
+	if (mesh.hasTransparencyHint) {
+		mesh.isTransparent = mesh.transparencyHint;
+		if (isDecal)
+			mesh.isTransparent = true;
+	} else {
+		mesh.isTransparent = hasAlpha;
+	}
+
+	mesh.texturesPending = false;
+	return true;
+}
+
 void ModelNode::createBound() {
 	_boundBox.clear();
 
@@ -482,15 +520,15 @@ void ModelNode::orderChildren() {
 		(*c)->orderChildren();
 }
 
-void ModelNode::renderGeometry(Mesh &mesh) {
+void ModelNode::renderGeometry(Mesh &mesh, const std::vector<glm::mat4> *transforms) {
 	if (!mesh.data->envMap.empty()) {
 		switch (mesh.data->envMapMode) {
 			case kModeEnvironmentBlendedUnder:
-				renderGeometryEnvMappedUnder(mesh);
+				renderGeometryEnvMappedUnder(mesh, transforms);
 				break;
 
 			case kModeEnvironmentBlendedOver:
-				renderGeometryEnvMappedOver(mesh);
+				renderGeometryEnvMappedOver(mesh, transforms);
 				break;
 
 			default:
@@ -500,10 +538,10 @@ void ModelNode::renderGeometry(Mesh &mesh) {
 		return;
 	}
 
-	renderGeometryNormal(mesh);
+	renderGeometryNormal(mesh, transforms);
 }
 
-void ModelNode::renderGeometryNormal(Mesh &mesh) {
+void ModelNode::renderGeometryNormal(Mesh &mesh, const std::vector<glm::mat4> *transforms) {
 	for (size_t t = 0; t < mesh.data->textures.size(); t++) {
 		TextureMan.activeTexture(t);
 		TextureMan.set(mesh.data->textures[t]);
@@ -512,7 +550,7 @@ void ModelNode::renderGeometryNormal(Mesh &mesh) {
 	if (mesh.data->textures.empty())
 		glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
 
-	mesh.data->vertexBuffer.draw(GL_TRIANGLES, mesh.data->indexBuffer);
+	drawMesh(mesh, transforms);
 
 	for (size_t t = 0; t < mesh.data->textures.size(); t++) {
 		TextureMan.activeTexture(t);
@@ -523,7 +561,7 @@ void ModelNode::renderGeometryNormal(Mesh &mesh) {
 		glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
 }
 
-void ModelNode::renderGeometryEnvMappedUnder(Mesh &mesh) {
+void ModelNode::renderGeometryEnvMappedUnder(Mesh &mesh, const std::vector<glm::mat4> *transforms) {
 	/* First draw the node with only the environment map, then simply
 	 * blend a semi-transparent diffuse texture on top.
 	 *
@@ -531,14 +569,14 @@ void ModelNode::renderGeometryEnvMappedUnder(Mesh &mesh) {
 	 */
 
 	TextureMan.set(mesh.data->envMap, TextureManager::kModeEnvironmentMapReflective);
-	mesh.data->vertexBuffer.draw(GL_TRIANGLES, mesh.data->indexBuffer);
+	drawMesh(mesh, transforms);
 
 	for (size_t t = 0; t < mesh.data->textures.size(); t++) {
 		TextureMan.activeTexture(t);
 		TextureMan.set(mesh.data->textures[t], TextureManager::kModeDiffuse);
 	}
 
-	mesh.data->vertexBuffer.draw(GL_TRIANGLES, mesh.data->indexBuffer);
+	drawMesh(mesh, transforms);
 
 	for (size_t t = 0; t < mesh.data->textures.size(); t++) {
 		TextureMan.activeTexture(t);
@@ -546,7 +584,7 @@ void ModelNode::renderGeometryEnvMappedUnder(Mesh &mesh) {
 	}
 }
 
-void ModelNode::renderGeometryEnvMappedOver(Mesh &mesh) {
+void ModelNode::renderGeometryEnvMappedOver(Mesh &mesh, const std::vector<glm::mat4> *transforms) {
 	/* First draw the node with diffuse textures, then draw it again with
 	 * only the environment map. This performs a more complex blending of
 	 * the textures, allowing the color of a transparent diffuse texture
@@ -563,7 +601,7 @@ void ModelNode::renderGeometryEnvMappedOver(Mesh &mesh) {
 
 		glBlendFunc(GL_ONE, GL_ZERO);
 
-		mesh.data->vertexBuffer.draw(GL_TRIANGLES, mesh.data->indexBuffer);
+		drawMesh(mesh, transforms);
 
 		for (size_t t = 0; t < mesh.data->textures.size(); t++) {
 			TextureMan.activeTexture(t);
@@ -576,7 +614,7 @@ void ModelNode::renderGeometryEnvMappedOver(Mesh &mesh) {
 		glDisable(GL_ALPHA_TEST);
 		glBlendFunc(GL_ZERO, GL_ONE);
 
-		mesh.data->vertexBuffer.draw(GL_TRIANGLES, mesh.data->indexBuffer);
+		drawMesh(mesh, transforms);
 	}
 
 	TextureMan.activeTexture(0);
@@ -584,7 +622,7 @@ void ModelNode::renderGeometryEnvMappedOver(Mesh &mesh) {
 
 	glBlendFunc(GL_ONE_MINUS_DST_ALPHA, GL_ONE);
 
-	mesh.data->vertexBuffer.draw(GL_TRIANGLES, mesh.data->indexBuffer);
+	drawMesh(mesh, transforms);
 
 	TextureMan.set();
 
@@ -596,18 +634,14 @@ bool ModelNode::renderableMesh(Mesh *mesh) {
 	return mesh && mesh->data && mesh->data->indexBuffer.getCount() > 0;
 }
 
-void ModelNode::render(RenderPass pass) {
-	// Apply the node's transformation
-
-	glTranslatef(_position[0], _position[1], _position[2]);
-	glRotatef(_orientation[3], _orientation[0], _orientation[1], _orientation[2]);
-
-	glRotatef(_rotation[0], 1.0f, 0.0f, 0.0f);
-	glRotatef(_rotation[1], 0.0f, 1.0f, 0.0f);
-	glRotatef(_rotation[2], 0.0f, 0.0f, 1.0f);
-
-	glScalef(_scale[0], _scale[1], _scale[2]);
+void ModelNode::drawMesh(Mesh &mesh, const std::vector<glm::mat4> *transforms) {
+	if (transforms)
+		mesh.data->vertexBuffer.draw(GL_TRIANGLES, mesh.data->indexBuffer, *transforms);
+	else
+		mesh.data->vertexBuffer.draw(GL_TRIANGLES, mesh.data->indexBuffer);
+}
 
+ModelNode::Mesh *ModelNode::getRenderMesh(RenderPass pass) {
 	Mesh *mesh = _mesh;
 	bool doRender = _render;
 	if (!_model->getState().empty() && !renderableMesh(mesh)) {
@@ -618,7 +652,9 @@ void ModelNode::render(RenderPass pass) {
 		}
 	}
 
-	// Render the node's geometry
+	// Meshes are only rendered once all their textures are ready
+	if (mesh && mesh->data && !evaluateTextures(*mesh))
+		return 0;
 
 	bool isTransparent = mesh && mesh->isTransparent;
 	bool shouldRender = doRender && renderableMesh(mesh);
@@ -626,24 +662,82 @@ void ModelNode::render(RenderPass pass) {
 	    ((pass == kRenderPassTransparent) && !isTransparent))
 		shouldRender = false;
 
-	if (shouldRender)
-		renderGeometry(*mesh);
+	return shouldRender ? mesh : 0;
+}
 
-	if (_attachedModel) {
-		glPushMatrix();
-		_attachedModel->render(pass);
-		glPopMatrix();
+glm::mat4 ModelNode::getLocalTransform() const {
+	glm::mat4 transform;
+
+	transform = glm::translate(transform, glm::vec3(_position[0], _position[1], _position[2]));
+
+	if (_orientation[0] != 0 || _orientation[1] != 0 || _orientation[2] != 0)
+		transform = glm::rotate(transform,
+				Common::deg2rad(_orientation[3]),
+				glm::vec3(_orientation[0], _orientation[1], _orientation[2]));
+
+	if (_rotation[0] != 0)
+		transform = glm::rotate(transform, Common::deg2rad(_rotation[0]), glm::vec3(1.0f, 0.0f, 0.0f));
+	if (_rotation[1] != 0)
+		transform = glm::rotate(transform, Common::deg2rad(_rotation[1]), glm::vec3(0.0f, 1.0f, 0.0f));
+	if (_rotation[2] != 0)
+		transform = glm::rotate(transform, Common::deg2rad(_rotation[2]), glm::vec3(0.0f, 0.0f, 1.0f));
+
+	transform = glm::scale(transform, glm::vec3(_scale[0], _scale[1], _scale[2]));
+
+	return transform;
+}
+
+void ModelNode::flattenTransforms(const glm::mat4 &parent, std::vector<ModelNode *> &nodes,
+                                  std::vector<glm::mat4> &transforms) {
+
+	const glm::mat4 transform = parent * getLocalTransform();
+
+	nodes.push_back(this);
+	transforms.push_back(transform);
+
+	for (std::list<ModelNode *>::iterator c = _children.begin(); c != _children.end(); ++c)
+		(*c)->flattenTransforms(transform, nodes, transforms);
+}
+
+void ModelNode::render(RenderPass pass, const glm::mat4 &transform) {
+	Mesh *mesh = getRenderMesh(pass);
+	if (!mesh && !_attachedModel)
+		return;
+
+	if (mesh) {
+		glLoadMatrixf(glm::value_ptr(transform));
+		renderGeometry(*mesh, 0);
 	}
 
-	// Render the node's children
-	for (std::list<ModelNode *>::iterator c = _children.begin(); c != _children.end(); ++c) {
-		glPushMatrix();
-		(*c)->render(pass);
-		glPopMatrix();
+	if (_attachedModel)
+		_attachedModel->render(pass, transform);
+}
+
+void ModelNode::renderInstances(RenderPass pass, const glm::mat4 &transform,
+                                const std::vector<glm::mat4> &instances, std::vector<glm::mat4> &transforms) {
+
+	Mesh *mesh = getRenderMesh(pass);
+	if (!mesh && !_attachedModel)
+		return;
+
+	transforms.clear();
+	for (std::vector<glm::mat4>::const_iterator i = instances.begin(); i != instances.end(); ++i)
+		transforms.push_back(*i * transform);
+
+	// Render the node's geometry, with all instances at once
+
+	if (mesh)
+		renderGeometry(*mesh, &transforms);
+
+	if (_attachedModel) {
+		for (std::vector<glm::mat4>::const_iterator t = transforms.begin(); t != transforms.end(); ++t)
+			_attachedModel->render(pass, *t);
 	}
 }
 
-void ModelNode::drawSkeleton(const glm::mat4 &parent, bool showInvisible) {
+void ModelNode::drawSkeleton(const glm::mat4 &parent, bool showInvisible, std::vector<float> &joints,
+                             std::vector<float> &invisibleJoints, std::vector<float> &bones) {
+
 	glm::mat4 mine = parent;
 
 	mine = glm::translate(mine, glm::vec3(_position[0], _position[1], _position[2]));
@@ -656,28 +750,22 @@ void ModelNode::drawSkeleton(const glm::mat4 &parent, bool showInvisible) {
 	mine = glm::scale(mine, glm::vec3(_scale[0], _scale[1], _scale[2]));
 
 	if (_render || showInvisible) {
-		glPointSize(5.0f);
-
-		if (_render)
-			glColor4f(0.0f, 1.0f, 0.0f, 1.0f);
-		else
-			glColor4f(1.0f, 0.0f, 0.0f, 1.0f);
-
-		glBegin(GL_POINTS);
-			glVertex3f(mine[3][0], mine[3][1], mine[3][2]);
-		glEnd();
-
-		glLineWidth(2.0f);
-		glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
-
-		glBegin(GL_LINES);
-			glVertex3f(parent[3][0], parent[3][1], parent[3][2]);
-			glVertex3f(mine[3][0], mine[3][1], mine[3][2]);
-		glEnd();
+		std::vector<float> &joint = _render ? joints : invisibleJoints;
+
+		joint.push_back(mine[3][0]);
+		joint.push_back(mine[3][1]);
+		joint.push_back(mine[3][2]);
+
+		bones.push_back(parent[3][0]);
+		bones.push_back(parent[3][1]);
+		bones.push_back(parent[3][2]);
+		bones.push_back(mine[3][0]);
+		bones.push_back(mine[3][1]);
+		bones.push_back(mine[3][2]);
 	}
 
 	for (std::list<ModelNode *>::iterator c = _children.begin(); c != _children.end(); ++c)
-		(*c)->drawSkeleton(mine, showInvisible);
+		(*c)->drawSkeleton(mine, showInvisible, joints, invisibleJoints, bones);
 }
 
 void ModelNode::lockFrame() {
@@ -711,27 +799,54 @@ void ModelNode::setBufferedOrientation(float x, float y, float z, float angle) {
 	_orientationBuffered = true;
 }
 
-void ModelNode::flushBuffers() {
-	if (_positionBuffered) {
-		_position[0] = _positionBuffer[0] / _model->_scale[0];
-		_position[1] = _positionBuffer[1] / _model->_scale[1];
-		_position[2] = _positionBuffer[2] / _model->_scale[2];
-		_positionBuffered = false;
+bool ModelNode::publishBuffers(Pose &pose, std::vector<float> &vertexCoords) const {
+	if (!_positionBuffered && !_orientationBuffered && !_vertexCoordsBuffered)
+		return false;
+
+	pose.node = const_cast<ModelNode *>(this);
+
+	pose.hasPosition     = _positionBuffered;
+	pose.hasOrientation  = _orientationBuffered;
+	pose.hasVertexCoords = _vertexCoordsBuffered;
+
+	pose.position[0] = _positionBuffer[0];
+	pose.position[1] = _positionBuffer[1];
+	pose.position[2] = _positionBuffer[2];
+
+	pose.orientation[0] = _orientationBuffer[0];
+	pose.orientation[1] = _orientationBuffer[1];
+	pose.orientation[2] = _orientationBuffer[2];
+	pose.orientation[3] = _orientationBuffer[3];
+
+	pose.vertexCoordsOffset = vertexCoords.size();
+	if (_vertexCoordsBuffered)
+		vertexCoords.insert(vertexCoords.end(), _vertexCoordsBuffer.begin(), _vertexCoordsBuffer.end());
+
+	return true;
+}
+
+void ModelNode::flushBuffers(const Pose &pose, const std::vector<float> &vertexCoords) {
+	if (pose.hasPosition) {
+		_position[0] = pose.position[0] / _model->_scale[0];
+		_position[1] = pose.position[1] / _model->_scale[1];
+		_position[2] = pose.position[2] / _model->_scale[2];
 	}
 
-	if (_orientationBuffered) {
-		_orientation[0] = _orientationBuffer[0];
-		_orientation[1] = _orientationBuffer[1];
-		_orientation[2] = _orientationBuffer[2];
-		_orientation[3] = _orientationBuffer[3];
-		_orientationBuffered = false;
+	if (pose.hasOrientation) {
+		_orientation[0] = pose.orientation[0];
+		_orientation[1] = pose.orientation[1];
+		_orientation[2] = pose.orientation[2];
+		_orientation[3] = pose.orientation[3];
 	}
 
-	if (_vertexCoordsBuffered) {
-		const float *vcb = &_vertexCoordsBuffer[0];
+	if (pose.hasVertexCoords && (_mesh->data->vertexBuffer.getCount() > 0)) {
 		VertexBuffer &vb = _mesh->data->vertexBuffer;
 		int vertexCount = vb.getCount();
 		int stride = vb.getSize() / sizeof(float);
+
+		assert(pose.vertexCoordsOffset + 3 * vertexCount <= vertexCoords.size());
+
+		const float *vcb = &vertexCoords[pose.vertexCoordsOffset];
 		float *v = reinterpret_cast<float *>(vb.getData());
 		for (int i = 0; i < vertexCount; ++i) {
 			v[0] = vcb[0];
@@ -740,7 +855,6 @@ void ModelNode::flushBuffers() {
 			v += stride;
 			vcb += 3;
 		}
-		_vertexCoordsBuffered = false;
 	}
 }
 
@@ -750,7 +864,7 @@ void ModelNode::computeInverseBindPose() {
 		nodeChain.push_back(node);
 	}
 
-	_invBindPose = glm::mat4();
+	_bindPose = glm::mat4();
 
 	for (std::vector<ModelNode *>::reverse_iterator n = nodeChain.rbegin();
 			n != nodeChain.rend();
@@ -759,19 +873,19 @@ void ModelNode::computeInverseBindPose() {
 
 		if (node->_positionFrames.size() > 0) {
 			const PositionKeyFrame &pos = node->_positionFrames[0];
-			_invBindPose = glm::translate(_invBindPose, glm::vec3(pos.x, pos.y, pos.z));
+			_bindPose = glm::translate(_bindPose, glm::vec3(pos.x, pos.y, pos.z));
 		}
 
 		if (node->_orientationFrames.size() > 0) {
 			const QuaternionKeyFrame &ori = node->_orientationFrames[0];
 			if (ori.x != 0 || ori.y != 0 || ori.z != 0)
-				_invBindPose = glm::rotate(_invBindPose,
+				_bindPose = glm::rotate(_bindPose,
 						acosf(ori.q) * 2.0f,
 						glm::vec3(ori.x, ori.y, ori.z));
 		}
 	}
 
-	_invBindPose = glm::inverse(_invBindPose);
+	_invBindPose = glm::inverse(_bindPose);
 }
 
 void ModelNode::computeAbsoluteTransform() {
@@ -140,6 +140,7 @@ public:
 		std::vector<float>       boneWeights;
 		std::vector<float>       boneMappingId;
 		std::vector<ModelNode *> boneNodeMap;
+		std::vector<glm::mat4>   bonePalette; ///< Combined skinning matrix of each bone.
 
 		Skin();
 	};
@@ -178,6 +179,7 @@ public:
 		bool rotatetexture;
 
 		bool isTransparent;
+		bool texturesPending; ///< Are the textures still waiting to be evaluated?
 
 		bool hasTransparencyHint;
 		bool transparencyHint;
@@ -223,9 +225,28 @@ protected:
 
 	uint16 _nodeNumber;
 
+	glm::mat4 _bindPose;          ///< Bind pose matrix used for animations.
 	glm::mat4 _invBindPose;       ///< Inverse bind pose matrix used for animations.
 	glm::mat4 _absoluteTransform; ///< Absolute transformation matrix used for animations.
 
+	/** The animated pose of a node, as published by the animation thread. */
+	struct Pose {
+		ModelNode *node;
+
+		bool hasPosition;
+		bool hasOrientation;
+		bool hasVertexCoords;
+
+		float position[3];
+		float orientation[4];
+
+		size_t vertexCoordsOffset; ///< Offset of this node's vertex coordinates in the snapshot.
+	};
+
+	/* Node position and geometry buffers, owned by the animation thread.
+	 * Once the animation touched one of them, it's published with every
+	 * snapshot of the model's pose. */
+
 	// .--- Node position and geometry buffers
 	float _positionBuffer[3];
 	bool _positionBuffered;
@@ -244,8 +265,26 @@ protected:
 	void createAbsoluteBound();
 	void createAbsoluteBound(Common::BoundingBox parentPosition);
 
-	void render(RenderPass pass);
-	void drawSkeleton(const glm::mat4 &parent, bool showInvisible);
+	/** Append this node and all its children, in render order, together with
+	 *  their transformations relative to the model. */
+	void flattenTransforms(const glm::mat4 &parent, std::vector<ModelNode *> &nodes,
+	                       std::vector<glm::mat4> &transforms);
+
+	/** Render the node with this modelview matrix. */
+	void render(RenderPass pass, const glm::mat4 &transform);
+	/** Render the node once with each of these instance modelview matrices.
+	 *
+	 *  @param pass       The render pass.
+	 *  @param transform  The node's transformation relative to the model.
+	 *  @param instances  The modelview matrices of all model instances.
+	 *  @param transforms Scratch space for the final matrices.
+	 */
+	void renderInstances(RenderPass pass, const glm::mat4 &transform,
+	                     const std::vector<glm::mat4> &instances, std::vector<glm::mat4> &transforms);
+
+	/** Add the node's joint and its bone to the parent to the skeleton vertex arrays. */
+	void drawSkeleton(const glm::mat4 &parent, bool showInvisible, std::vector<float> &joints,
+	                  std::vector<float> &invisibleJoints, std::vector<float> &bones);
 
 	void lockFrame();
 	void unlockFrame();
@@ -255,7 +294,14 @@ protected:
 
 	void setBufferedPosition(float x, float y, float z);
 	void setBufferedOrientation(float x, float y, float z, float angle);
-	void flushBuffers();
+
+	/** Copy the buffered pose of this node into a snapshot.
+	 *
+	 *  @return false if the animation never touched this node.
+	 */
+	bool publishBuffers(Pose &pose, std::vector<float> &vertexCoords) const;
+	/** Apply a pose snapshot to the node's position and geometry. */
+	void flushBuffers(const Pose &pose, const std::vector<float> &vertexCoords);
 
 
 private:
@@ -263,13 +309,29 @@ private:
 
 	void orderChildren();
 
-	static void renderGeometry(Mesh &mesh);
-	static void renderGeometryNormal(Mesh &mesh);
-	static void renderGeometryEnvMappedUnder(Mesh &mesh);
-	static void renderGeometryEnvMappedOver(Mesh &mesh);
+	/** Return the mesh to render in this pass, or 0 if there's nothing to render. */
+	Mesh *getRenderMesh(RenderPass pass);
+	/** Return the node's transformation relative to its parent. */
+	glm::mat4 getLocalTransform() const;
+
+	/* The geometry is rendered either once with the current modelview matrix
+	 * or, when given a list of transforms, once with each of these. */
+
+	static void renderGeometry(Mesh &mesh, const std::vector<glm::mat4> *transforms);
+	static void renderGeometryNormal(Mesh &mesh, const std::vector<glm::mat4> *transforms);
+	static void renderGeometryEnvMappedUnder(Mesh &mesh, const std::vector<glm::mat4> *transforms);
+	static void renderGeometryEnvMappedOver(Mesh &mesh, const std::vector<glm::mat4> *transforms);
+
+	static void drawMesh(Mesh &mesh, const std::vector<glm::mat4> *transforms);
 
 	static bool renderableMesh(Mesh *mesh);
 
+	/** Evaluate the transparency of the mesh's textures, once they're all decoded.
+	 *
+	 *  @return false if some textures are still being decoded.
+	 */
+	static bool evaluateTextures(Mesh &mesh);
+
 public:
 	// General helpers
 
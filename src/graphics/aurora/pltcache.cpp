@@ -0,0 +1,143 @@
+/* xoreos - A reimplementation of BioWare's Aurora engine
+ *
+ * xoreos is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * xoreos is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * xoreos is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with xoreos. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  A cache for the palettes and built images of PLT textures.
+ */
+
+#include <cstring>
+
+#include "src/common/scopedptr.h"
+#include "src/common/util.h"
+#include "src/common/error.h"
+
+#include "src/graphics/images/decoder.h"
+
+#include "src/graphics/aurora/pltcache.h"
+#include "src/graphics/aurora/pltfile.h"
+
+namespace Graphics {
+
+namespace Aurora {
+
+PLTCache::PLTCache() {
+}
+
+PLTCache::~PLTCache() {
+}
+
+void PLTCache::clear() {
+	Common::StackLock lock(_mutex);
+
+	_palettes.clear();
+	_built.clear();
+}
+
+bool PLTCache::getColorRow(const Common::UString &palette, uint8 color, byte row[4 * 256]) {
+	Common::StackLock lock(_mutex);
+
+	const Palette &data = getPalette(palette);
+
+	const size_t height = data.size() / (4 * 256);
+	if (color >= height) {
+		if (height > 0)
+			warning("Invalid color %u for palette \"%s\" (%u rows)", color, palette.c_str(), (uint) height);
+
+		return false;
+	}
+
+	// The images have their origin at the bottom left, so we flip the color row
+	std::memcpy(row, &data[(height - 1 - color) * 4 * 256], 4 * 256);
+
+	return true;
+}
+
+const PLTCache::Palette &PLTCache::getPalette(const Common::UString &name) {
+	PaletteMap::iterator palette = _palettes.find(name);
+	if (palette != _palettes.end())
+		return palette->second;
+
+	// Remember failed palettes as well, so that we don't try to load them over and over again
+	palette = _palettes.insert(std::make_pair(name, Palette())).first;
+
+	try {
+		loadPalette(name, palette->second);
+	} catch (...) {
+		palette->second.clear();
+
+		Common::exceptionDispatcherWarning("Failed to load palette \"%s\"", name.c_str());
+	}
+
+	return palette->second;
+}
+
+void PLTCache::loadPalette(const Common::UString &name, Palette &palette) {
+	Common::ScopedPtr<ImageDecoder> image(Texture::loadImage(name));
+
+	if (image->getFormat() != kPixelFormatBGRA)
+		throw Common::Exception("Invalid format (%d)", image->getFormat());
+
+	if (image->getMipMapCount() < 1)
+		throw Common::Exception("No mip maps");
+
+	const ImageDecoder::MipMap &mipMap = image->getMipMap(0);
+
+	if (mipMap.width != 256)
+		throw Common::Exception("Invalid width (%d)", mipMap.width);
+
+	const size_t size = 4 * 256 * mipMap.height;
+	if (mipMap.size < size)
+		throw Common::Exception("Not enough data (%u < %u)", (uint) mipMap.size, (uint) size);
+
+	palette.assign(mipMap.data.get(), mipMap.data.get() + size);
+}
+
+bool PLTCache::shareBuilt(const Common::UString &key, PLTFile &plt) {
+	Common::StackLock lock(_mutex);
+
+	std::pair<BuiltMap::iterator, BuiltMap::iterator> built = _built.equal_range(key);
+	for (BuiltMap::iterator b = built.first; b != built.second; ++b)
+		if ((b->second != &plt) && plt.copyImage(*b->second))
+			return true;
+
+	return false;
+}
+
+void PLTCache::addBuilt(const Common::UString &key, PLTFile &plt) {
+	Common::StackLock lock(_mutex);
+
+	_built.insert(std::make_pair(key, &plt));
+}
+
+void PLTCache::removeBuilt(const Common::UString &key, PLTFile &plt) {
+	Common::StackLock lock(_mutex);
+
+	std::pair<BuiltMap::iterator, BuiltMap::iterator> built = _built.equal_range(key);
+	for (BuiltMap::iterator b = built.first; b != built.second; ++b) {
+		if (b->second == &plt) {
+			_built.erase(b);
+			break;
+		}
+	}
+}
+
+} // End of namespace Aurora
+
+} // End of namespace Graphics
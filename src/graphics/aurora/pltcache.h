@@ -0,0 +1,95 @@
+/* xoreos - A reimplementation of BioWare's Aurora engine
+ *
+ * xoreos is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * xoreos is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * xoreos is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with xoreos. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  A cache for the palettes and built images of PLT textures.
+ */
+
+#ifndef GRAPHICS_AURORA_PLTCACHE_H
+#define GRAPHICS_AURORA_PLTCACHE_H
+
+#include <map>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+#include "src/common/types.h"
+#include "src/common/ustring.h"
+#include "src/common/mutex.h"
+
+namespace Graphics {
+
+namespace Aurora {
+
+class PLTFile;
+
+/** Caches what's needed to build PLT layer textures.
+ *
+ *  The palette images are only loaded once, and then kept around, so that
+ *  a PLT can quickly pick the color rows for all its layers.
+ *
+ *  Additionally, the cache keeps track of all PLTs that have been built,
+ *  by their name and layer colors. A PLT with the same name and colors as
+ *  an already built one, like for several creatures with the same outfit,
+ *  can simply copy its image instead of building it again.
+ */
+class PLTCache : boost::noncopyable {
+public:
+	PLTCache();
+	~PLTCache();
+
+	/** Forget all cached palettes and built PLTs. */
+	void clear();
+
+	/** Copy one color row of this palette image into the buffer.
+	 *
+	 *  Return false if the palette couldn't be loaded, or doesn't contain that color.
+	 */
+	bool getColorRow(const Common::UString &palette, uint8 color, byte row[4 * 256]);
+
+	/** Copy the image of an already built PLT with this key into this PLT. */
+	bool shareBuilt(const Common::UString &key, PLTFile &plt);
+	/** Register this built PLT under this key. */
+	void addBuilt(const Common::UString &key, PLTFile &plt);
+	/** Unregister this PLT, because it's rebuilt or about to be destroyed. */
+	void removeBuilt(const Common::UString &key, PLTFile &plt);
+
+private:
+	/** The BGRA pixels of a palette image, 256 per row. Empty if loading failed. */
+	typedef std::vector<byte> Palette;
+
+	typedef std::map<Common::UString, Palette> PaletteMap;
+	typedef std::multimap<Common::UString, PLTFile *> BuiltMap;
+
+	PaletteMap _palettes;
+	BuiltMap _built;
+
+	Common::Mutex _mutex;
+
+	const Palette &getPalette(const Common::UString &name);
+
+	static void loadPalette(const Common::UString &name, Palette &palette);
+};
+
+} // End of namespace Aurora
+
+} // End of namespace Graphics
+
+#endif // GRAPHICS_AURORA_PLTCACHE_H
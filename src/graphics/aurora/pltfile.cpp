@@ -59,6 +59,8 @@
 #include "src/graphics/images/surface.h"
 
 #include "src/graphics/aurora/pltfile.h"
+#include "src/graphics/aurora/pltcache.h"
+#include "src/graphics/aurora/textureman.h"
 
 static const uint32 kPLTID     = MKTAG('P', 'L', 'T', ' ');
 static const uint32 kVersion1  = MKTAG('V', '1', ' ', ' ');
@@ -77,6 +79,12 @@ PLTFile::PLTFile(const Common::UString &name, Common::SeekableReadStream &plt) :
 }
 
 PLTFile::~PLTFile() {
+	// The build job calls back into us
+	waitDecodeJob();
+
+	// Other PLTs mustn't copy our image anymore
+	if (!_builtKey.empty())
+		TextureMan.getPLTCache().removeBuilt(_builtKey, *this);
 }
 
 bool PLTFile::isDynamic() const {
@@ -91,10 +99,17 @@ bool PLTFile::reload() {
 void PLTFile::setLayerColor(Layer layer, uint8 color) {
 	assert((layer >= 0) && (layer < kLayerMAX));
 
+	// A running build job reads the colors
+	waitDecoded();
+
 	_colors[layer] = color;
 }
 
 void PLTFile::rebuild() {
+	queueDecode();
+}
+
+void PLTFile::decode() {
 	build();
 	refresh();
 }
@@ -124,14 +139,14 @@ void PLTFile::load(Common::SeekableReadStream &plt) {
 
 	size_t size = width * height;
 
-	_dataImage.reset(new uint8[size]);
-	_dataLayers.reset(new uint8[size]);
+	_dataIndices.reset(new uint16[size]);
 
-	uint8 *image = _dataImage.get();
-	uint8 *layer = _dataLayers.get();
+	uint16 *index = _dataIndices.get();
 	while (size-- > 0) {
-		*image++ = plt.readByte();
-		*layer++ = MIN<uint8>(plt.readByte(), kLayerMAX - 1);
+		const uint8 intensity = plt.readByte();
+		const uint8 layer     = MIN<uint8>(plt.readByte(), kLayerMAX - 1);
+
+		*index++ = layer * 256 + intensity;
 	}
 
 	// --- Create the actual texture surface ---
@@ -145,21 +160,63 @@ void PLTFile::load(Common::SeekableReadStream &plt) {
 }
 
 void PLTFile::build() {
+	PLTCache &cache = TextureMan.getPLTCache();
+
+	// Our old image doesn't match our colors anymore
+	if (!_builtKey.empty()) {
+		cache.removeBuilt(_builtKey, *this);
+		_builtKey.clear();
+	}
+
+	const Common::UString key = createBuiltKey();
+
+	// Another PLT with the same colors, like for the same outfit, might already be built
+	if (!cache.shareBuilt(key, *this))
+		compose(cache);
+
+	cache.addBuilt(key, *this);
+	_builtKey = key;
+}
+
+void PLTFile::compose(PLTCache &cache) {
 	/* For all layers, copy one whole row of pixels into the row buffer.
 	 * The row picked for each layer corresponds to the color index we want.
 	 * We don't care about the other rows, as they belong to other color indices. */
-	byte rows[4 * 256 * kLayerMAX];
-	getColorRows(rows, _colors);
+	uint32 rows[256 * kLayerMAX];
+	getColorRows(cache, rows, _colors);
+
+	// Don't change the image while the render thread is uploading it
+	Common::StackLock lock(_decodeMutex);
 
 	const size_t pixels = _width * _height;
-	const uint8 *image  = _dataImage.get();
-	const uint8 *layer  = _dataLayers.get();
-	      byte  *dst    = _surface->getData();
+	const uint16 *index = _dataIndices.get();
+	      byte   *dst   = _surface->getData();
 
 	/* Now iterate over all pixels, each time copying the correct BGRA values
-	 * for the pixel's intensity into the final image. */
-	for (size_t i = 0; i < pixels; i++, image++, layer++, dst += 4)
-		memcpy(dst, rows + (*layer * 4 * 256) + (*image * 4), 4);
+	 * for the pixel's layer and intensity into the final image. */
+	for (size_t i = 0; i < pixels; i++, index++, dst += 4)
+		memcpy(dst, rows + *index, 4);
+}
+
+Common::UString PLTFile::createBuiltKey() const {
+	Common::UString key = _name;
+
+	for (size_t i = 0; i < kLayerMAX; i++)
+		key += Common::UString::format("#%u", _colors[i]);
+
+	return key;
+}
+
+bool PLTFile::copyImage(PLTFile &source) {
+	Common::StackLock sourceLock(source._decodeMutex);
+	Common::StackLock lock(_decodeMutex);
+
+	if ((_surface->getWidth() != source._surface->getWidth()) ||
+	    (_surface->getHeight() != source._surface->getHeight()))
+		return false;
+
+	memcpy(_surface->getData(), source._surface->getData(), _surface->getWidth() * _surface->getHeight() * 4);
+	return true;
 }
 
 /** The palette image resource names for all layers. */
@@ -176,51 +233,19 @@ static const char * const kPalettes[PLTFile::kLayerMAX] = {
 	"pal_tattoo01"
 };
 
-/** Load a specific layer palette image and perform some sanity checks. */
-ImageDecoder *PLTFile::getLayerPalette(uint32 layer, uint8 row) {
-	assert(layer < kLayerMAX);
-
-	// TODO: We may want to cache these somehow...
-	Common::ScopedPtr<ImageDecoder> palette(loadImage(kPalettes[layer]));
-
-	if (palette->getFormat() != kPixelFormatBGRA)
-		throw Common::Exception("Invalid format (%d)", palette->getFormat());
-
-	if (palette->getMipMapCount() < 1)
-		throw Common::Exception("No mip maps");
-
-	const ImageDecoder::MipMap &mipMap = palette->getMipMap(0);
-
-	if (mipMap.width != 256)
-		throw Common::Exception("Invalid width (%d)", mipMap.width);
-
-	if (row >= mipMap.height)
-		throw Common::Exception("Invalid height (%d >= %d)", row, mipMap.height);
-
-	return palette.release();
-}
-
-void PLTFile::getColorRows(byte rows[4 * 256 * kLayerMAX], const uint8 colors[kLayerMAX]) {
-	for (size_t i = 0; i < kLayerMAX; i++, rows += 4 * 256) {
-		try {
-			Common::ScopedPtr<ImageDecoder> palette(getLayerPalette(i, colors[i]));
-
-			// The images have their origin at the bottom left, so we flip the color row
-			const uint8 row = palette->getMipMap(0).height - 1 - colors[i];
-
-			// Copy the whole row into the buffer
-			memcpy(rows, palette->getMipMap(0).data.get() + (row * 4 * 256), 4 * 256);
+void PLTFile::getColorRows(PLTCache &cache, uint32 rows[256 * kLayerMAX], const uint8 colors[kLayerMAX]) {
+	for (size_t i = 0; i < kLayerMAX; i++) {
+		byte *row = reinterpret_cast<byte *>(rows + i * 256);
 
-		} catch (...) {
-			// On error set to pink (while honoring intensity), for high debug visibility
-			for (size_t p = 0; p < 256; p++) {
-				rows[p * 4 + 0] = p;
-				rows[p * 4 + 1] = 0x00;
-				rows[p * 4 + 2] = p;
-				rows[p * 4 + 3] = 0xFF;
-			}
+		if (cache.getColorRow(kPalettes[i], colors[i], row))
+			continue;
 
-			Common::exceptionDispatcherWarning("Failed to load palette \"%s\"", kPalettes[i]);
+		// On error set to pink (while honoring intensity), for high debug visibility
+		for (size_t p = 0; p < 256; p++) {
+			row[p * 4 + 0] = p;
+			row[p * 4 + 1] = 0x00;
+			row[p * 4 + 2] = p;
+			row[p * 4 + 3] = 0xFF;
 		}
 	}
 }
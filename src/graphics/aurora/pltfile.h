@@ -37,6 +37,8 @@ class Surface;
 
 namespace Aurora {
 
+class PLTCache;
+
 class PLTFile : public ::Aurora::AuroraFile, public Texture {
 public:
 	enum Layer {
@@ -57,7 +59,7 @@ public:
 
 	/** Set the color of one layer within this layer texture. */
 	void setLayerColor(Layer layer, uint8 color);
-	/** Rebuild the combined texture image. */
+	/** Rebuild the combined texture image, in the background if possible. */
 	void rebuild();
 
 	bool isDynamic() const;
@@ -69,21 +71,33 @@ private:
 
 	Surface *_surface;
 
-	Common::ScopedArray<uint8> _dataImage;
-	Common::ScopedArray<uint8> _dataLayers;
+	/** For each pixel, its layer and intensity combined into an index into the color rows. */
+	Common::ScopedArray<uint16> _dataIndices;
 
 	uint8 _colors[kLayerMAX];
 
+	/** The key this PLT is registered under in the PLT cache, once it's built. */
+	Common::UString _builtKey;
+
 
 	PLTFile(const Common::UString &name, Common::SeekableReadStream &plt);
 
 	void load(Common::SeekableReadStream &plt);
 	void build();
+	void compose(PLTCache &cache);
+
+	/** Build the image. Called by the decoding job. */
+	void decode();
+
+	/** Return the key identifying PLTs with the same name and colors. */
+	Common::UString createBuiltKey() const;
+	/** Copy the image of an identical, already built PLT. */
+	bool copyImage(PLTFile &source);
 
-	static ImageDecoder *getLayerPalette(uint32 layer, uint8 row);
-	static void getColorRows(byte rows[4 * 256 * kLayerMAX], const uint8 colors[kLayerMAX]);
+	static void getColorRows(PLTCache &cache, uint32 rows[256 * kLayerMAX], const uint8 colors[kLayerMAX]);
 
 	friend class Texture;
+	friend class PLTCache;
 };
 
 } // End of namespace Aurora
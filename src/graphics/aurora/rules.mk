@@ -27,7 +27,9 @@ src_graphics_aurora_libaurora_la_SOURCES += \
     src/graphics/aurora/texture.h \
     src/graphics/aurora/texturehandle.h \
     src/graphics/aurora/textureman.h \
+    src/graphics/aurora/texturestreamer.h \
     src/graphics/aurora/pltfile.h \
+    src/graphics/aurora/pltcache.h \
     src/graphics/aurora/cursor.h \
     src/graphics/aurora/cursorman.h \
     src/graphics/aurora/texturefont.h \
@@ -40,6 +42,7 @@ src_graphics_aurora_libaurora_la_SOURCES += \
     src/graphics/aurora/text.h \
     src/graphics/aurora/highlightabletext.h \
     src/graphics/aurora/fps.h \
+    src/graphics/aurora/framestats.h \
     src/graphics/aurora/cube.h \
     src/graphics/aurora/guiquad.h \
     src/graphics/aurora/highlightableguiquad.h \
@@ -62,13 +65,18 @@ src_graphics_aurora_libaurora_la_SOURCES += \
     src/graphics/aurora/animationthread.h \
     src/graphics/aurora/walkmesh.h \
     src/graphics/aurora/animationchannel.h \
+    src/graphics/aurora/skinning.h \
+    src/graphics/aurora/keyframes.h \
+    src/graphics/aurora/instancedmodel.h \
     $(EMPTY)
 
 src_graphics_aurora_libaurora_la_SOURCES += \
     src/graphics/aurora/texture.cpp \
     src/graphics/aurora/texturehandle.cpp \
     src/graphics/aurora/textureman.cpp \
+    src/graphics/aurora/texturestreamer.cpp \
     src/graphics/aurora/pltfile.cpp \
+    src/graphics/aurora/pltcache.cpp \
     src/graphics/aurora/cursor.cpp \
     src/graphics/aurora/cursorman.cpp \
     src/graphics/aurora/texturefont.cpp \
@@ -81,6 +89,7 @@ src_graphics_aurora_libaurora_la_SOURCES += \
     src/graphics/aurora/text.cpp \
     src/graphics/aurora/highlightabletext.cpp \
     src/graphics/aurora/fps.cpp \
+    src/graphics/aurora/framestats.cpp \
     src/graphics/aurora/cube.cpp \
     src/graphics/aurora/highlightableguiquad.cpp \
     src/graphics/aurora/guiquad.cpp \
@@ -103,4 +112,7 @@ src_graphics_aurora_libaurora_la_SOURCES += \
     src/graphics/aurora/animationthread.cpp \
     src/graphics/aurora/walkmesh.cpp \
     src/graphics/aurora/animationchannel.cpp \
+    src/graphics/aurora/skinning.cpp \
+    src/graphics/aurora/keyframes.cpp \
+    src/graphics/aurora/instancedmodel.cpp \
     $(EMPTY)
@@ -0,0 +1,126 @@
+/* xoreos - A reimplementation of BioWare's Aurora engine
+ *
+ * xoreos is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * xoreos is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * xoreos is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with xoreos. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  Skinning of mesh vertices by weighted bone matrices.
+ */
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 1))
+	#define XOREOS_SKINNING_SSE 1
+	#include <xmmintrin.h>
+#endif
+
+#include "src/graphics/aurora/skinning.h"
+
+namespace Graphics {
+
+namespace Aurora {
+
+/** Return the palette index of a bone slot, or -1 if the slot is unused. */
+static inline int getBoneIndex(float id, size_t boneCount) {
+	const int index = static_cast<int>(id);
+	if ((index < 0) || (static_cast<size_t>(index) >= boneCount))
+		return -1;
+
+	return index;
+}
+
+void skinVerticesScalar(float *out, const float *in, const float *boneIDs, const float *boneWeights,
+                        size_t vertexCount, const float *palette, size_t boneCount) {
+
+	for (size_t i = 0; i < vertexCount; i++, out += 3, in += 3, boneIDs += 4, boneWeights += 4) {
+		float x = 0.0f, y = 0.0f, z = 0.0f;
+
+		for (size_t j = 0; j < 4; j++) {
+			const int index = getBoneIndex(boneIDs[j], boneCount);
+			if (index < 0)
+				continue;
+
+			const float *m = palette + 16 * index;
+			const float  w = boneWeights[j];
+
+			x += w * (in[0] * m[0] + in[1] * m[4] + in[2] * m[ 8] + m[12]);
+			y += w * (in[0] * m[1] + in[1] * m[5] + in[2] * m[ 9] + m[13]);
+			z += w * (in[0] * m[2] + in[1] * m[6] + in[2] * m[10] + m[14]);
+		}
+
+		out[0] = x;
+		out[1] = y;
+		out[2] = z;
+	}
+}
+
+#ifdef XOREOS_SKINNING_SSE
+
+void skinVertices(float *out, const float *in, const float *boneIDs, const float *boneWeights,
+                  size_t vertexCount, const float *palette, size_t boneCount) {
+
+	/* Instead of transforming the vertex by each bone and blending the results,
+	 * we blend the bone matrices column by column and transform the vertex once.
+	 * Since each vertex references its own set of bones, this keeps the four
+	 * SSE lanes busy without having to gather matrix elements of several bones. */
+
+	for (size_t i = 0; i < vertexCount; i++, out += 3, in += 3, boneIDs += 4, boneWeights += 4) {
+		__m128 c0 = _mm_setzero_ps();
+		__m128 c1 = _mm_setzero_ps();
+		__m128 c2 = _mm_setzero_ps();
+		__m128 c3 = _mm_setzero_ps();
+
+		for (size_t j = 0; j < 4; j++) {
+			const int index = getBoneIndex(boneIDs[j], boneCount);
+			if (index < 0)
+				continue;
+
+			const float *m = palette + 16 * index;
+			const __m128 w = _mm_set1_ps(boneWeights[j]);
+
+			c0 = _mm_add_ps(c0, _mm_mul_ps(_mm_loadu_ps(m +  0), w));
+			c1 = _mm_add_ps(c1, _mm_mul_ps(_mm_loadu_ps(m +  4), w));
+			c2 = _mm_add_ps(c2, _mm_mul_ps(_mm_loadu_ps(m +  8), w));
+			c3 = _mm_add_ps(c3, _mm_mul_ps(_mm_loadu_ps(m + 12), w));
+		}
+
+		__m128 v = c3;
+		v = _mm_add_ps(v, _mm_mul_ps(c0, _mm_set1_ps(in[0])));
+		v = _mm_add_ps(v, _mm_mul_ps(c1, _mm_set1_ps(in[1])));
+		v = _mm_add_ps(v, _mm_mul_ps(c2, _mm_set1_ps(in[2])));
+
+		float result[4];
+		_mm_storeu_ps(result, v);
+
+		out[0] = result[0];
+		out[1] = result[1];
+		out[2] = result[2];
+	}
+}
+
+#else // XOREOS_SKINNING_SSE
+
+void skinVertices(float *out, const float *in, const float *boneIDs, const float *boneWeights,
+                  size_t vertexCount, const float *palette, size_t boneCount) {
+
+	skinVerticesScalar(out, in, boneIDs, boneWeights, vertexCount, palette, boneCount);
+}
+
+#endif // XOREOS_SKINNING_SSE
+
+} // End of namespace Aurora
+
+} // End of namespace Graphics
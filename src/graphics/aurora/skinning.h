@@ -0,0 +1,62 @@
+/* xoreos - A reimplementation of BioWare's Aurora engine
+ *
+ * xoreos is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * xoreos is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * xoreos is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with xoreos. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  Skinning of mesh vertices by weighted bone matrices.
+ */
+
+#ifndef GRAPHICS_AURORA_SKINNING_H
+#define GRAPHICS_AURORA_SKINNING_H
+
+#include <cstddef>
+
+namespace Graphics {
+
+namespace Aurora {
+
+/** Skin vertices by up to four weighted bone matrices each.
+ *
+ *  The palette holds one combined, affine bone matrix per bone, as 16
+ *  floats in column-major order. Each vertex references four palette
+ *  entries by index, negative indices marking unused slots. The skinned
+ *  position is the weighted sum of the vertex transformed by each bone.
+ *
+ *  Uses SSE instructions where available.
+ *
+ *  @param out         The skinned vertex positions, 3 floats per vertex.
+ *  @param in          The vertex positions in the bind pose, 3 floats per vertex.
+ *  @param boneIDs     Palette indices, 4 floats per vertex.
+ *  @param boneWeights Bone weights, 4 floats per vertex.
+ *  @param vertexCount The number of vertices to skin.
+ *  @param palette     The bone matrices.
+ *  @param boneCount   The number of matrices in the palette.
+ */
+void skinVertices(float *out, const float *in, const float *boneIDs, const float *boneWeights,
+                  size_t vertexCount, const float *palette, size_t boneCount);
+
+/** Same as skinVertices(), but never uses SIMD instructions. */
+void skinVerticesScalar(float *out, const float *in, const float *boneIDs, const float *boneWeights,
+                        size_t vertexCount, const float *palette, size_t boneCount);
+
+} // End of namespace Aurora
+
+} // End of namespace Graphics
+
+#endif // GRAPHICS_AURORA_SKINNING_H
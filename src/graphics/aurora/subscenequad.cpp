@@ -29,6 +29,7 @@
 #include "src/common/maths.h"
 
 #include "src/graphics/aurora/subscenequad.h"
+#include "src/graphics/aurora/model.h"
 
 #include "src/events/events.h"
 
@@ -82,9 +83,9 @@ void SubSceneQuad::render(RenderPass pass) {
 
 	_lastSampled = now;
 
-	for (size_t i = 0; i < _renderables.size(); ++i) {
-		_renderables[i]->advanceTime(elapsedTime);
-		_renderables[i]->render(pass);
+	for (size_t i = 0; i < _models.size(); ++i) {
+		_models[i]->advanceTime(elapsedTime);
+		_models[i]->render(pass, _transformation);
 	}
 
 	glDisable(GL_SCISSOR_TEST);
@@ -117,14 +118,14 @@ void SubSceneQuad::setGlobalTransformationMatrix(const glm::mat4 &transformation
 	_transformation = transformation;
 }
 
-void SubSceneQuad::add(Renderable *renderable) {
-	_renderables.push_back(renderable);
+void SubSceneQuad::add(Model *model) {
+	_models.push_back(model);
 }
 
-void SubSceneQuad::remove(Renderable *renderable) {
-	std::vector<Renderable *>::iterator iter = std::find(_renderables.begin(), _renderables.end(), renderable);
-	if (iter != _renderables.end()) {
-		_renderables.erase(iter);
+void SubSceneQuad::remove(Model *model) {
+	std::vector<Model *>::iterator iter = std::find(_models.begin(), _models.end(), model);
+	if (iter != _models.end()) {
+		_models.erase(iter);
 	}
 }
 
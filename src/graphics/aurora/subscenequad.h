@@ -33,6 +33,8 @@ namespace Graphics {
 
 namespace Aurora {
 
+class Model;
+
 class SubSceneQuad : public GUIElement {
 public:
 	SubSceneQuad();
@@ -46,13 +48,13 @@ public:
 	void setProjectionMatrix(const glm::mat4 &projection);
 	void setGlobalTransformationMatrix(const glm::mat4 &transformation);
 
-	/** Add a renderable to the sub scene. */
-	void add(Renderable *renderable);
-	/** Remove a renderable from the sub scene. */
-	void remove(Renderable *renderable);
+	/** Add a model to the sub scene. */
+	void add(Model *model);
+	/** Remove a model from the sub scene. */
+	void remove(Model *model);
 
 private:
-	std::vector<Renderable *> _renderables;
+	std::vector<Model *> _models;
 
 	glm::mat4 _projection;
 	glm::mat4 _transformation;
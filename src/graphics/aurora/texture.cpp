@@ -29,6 +29,7 @@
 #include "src/common/strutil.h"
 #include "src/common/error.h"
 #include "src/common/readstream.h"
+#include "src/common/parallelfor.h"
 
 #include "src/graphics/aurora/texture.h"
 #include "src/graphics/aurora/pltfile.h"
@@ -55,44 +56,150 @@ namespace Graphics {
 
 namespace Aurora {
 
-Texture::Texture() : _type(::Aurora::kFileTypeNone), _width(0), _height(0) {
+/** Streamed textures always keep the mip maps up to this size resident. */
+static const int kStreamingBaseSize = 128;
+
+static const GLenum kCubeMapFaceTarget[6] = {
+	GL_TEXTURE_CUBE_MAP_POSITIVE_X,
+	GL_TEXTURE_CUBE_MAP_NEGATIVE_X,
+	GL_TEXTURE_CUBE_MAP_POSITIVE_Y,
+	GL_TEXTURE_CUBE_MAP_NEGATIVE_Y,
+	GL_TEXTURE_CUBE_MAP_POSITIVE_Z,
+	GL_TEXTURE_CUBE_MAP_NEGATIVE_Z
+};
+
+Texture::DecodeJob::DecodeJob(Texture &texture) : _texture(&texture) {
+}
+
+void Texture::DecodeJob::run() {
+	try {
+		_texture->decode();
+	} catch (...) {
+		Common::exceptionDispatcherWarning("Failed to decode texture \"%s\"", _texture->_name.c_str());
+	}
+
+	_texture->_decoded.store(true, boost::memory_order_release);
+
+	// This has to be the very last access, the texture might be deleted right after
+	_texture->_decodeDone.unlock();
+}
+
+class Texture::CubeSideBody : public Common::ParallelForBody {
+public:
+	CubeSideBody(Common::SeekableReadStream *(&streams)[6], ::Aurora::FileType (&types)[6],
+	             ImageDecoder *(&layers)[6], TXI *txi, Common::ThreadPool *pool) :
+		_streams(streams), _types(types), _layers(layers), _txi(txi), _pool(pool) {
+	}
+
+	void run(size_t index) {
+		// loadImage() takes over the stream, even if it fails
+		Common::SeekableReadStream *imageStream = _streams[index];
+		_streams[index] = 0;
+
+		_layers[index] = loadImage(imageStream, _types[index], _txi, _pool);
+	}
+
+private:
+	Common::SeekableReadStream *(&_streams)[6];
+	::Aurora::FileType (&_types)[6];
+
+	ImageDecoder *(&_layers)[6];
+
+	TXI *_txi;
+	Common::ThreadPool *_pool;
+};
+
+
+Texture::Texture() : _type(::Aurora::kFileTypeNone), _hasTXIFile(false), _width(0), _height(0),
+	_uploadedCubeMap(false), _uploadedAlpha(false), _streamable(false), _residentMipMap(0),
+	_decodePool(0), _decodeJob(*this), _decoded(true), _decodeDone(1) {
 }
 
 Texture::Texture(const Common::UString &name, ImageDecoder *image, ::Aurora::FileType type, TXI *txi) :
-	_name(name), _type(type), _width(0), _height(0) {
+	_name(name), _type(type), _hasTXIFile(txi != 0), _width(0), _height(0),
+	_uploadedCubeMap(false), _uploadedAlpha(false), _streamable(false), _residentMipMap(0),
+	_decodePool(0), _decodeJob(*this), _decoded(true), _decodeDone(1) {
 
 	set(name, image, type, txi);
 	addToQueues();
 }
 
+Texture::Texture(const Common::UString &name, Common::SeekableReadStream *imageStream, ::Aurora::FileType type,
+                 TXI *txi, Common::ThreadPool *pool) :
+	_name(name), _type(type), _txi(txi), _hasTXIFile(txi != 0), _width(0), _height(0),
+	_uploadedCubeMap(false), _uploadedAlpha(false), _streamable(false), _residentMipMap(0),
+	_decodePool(pool), _decodeJob(*this), _decoded(true), _decodeDone(1), _imageStream(imageStream) {
+
+}
+
 Texture::~Texture() {
+	waitDecodeJob();
+
 	removeFromQueues();
 
 	if (_textureID != 0)
 		GfxMan.abandon(&_textureID, 1);
 }
 
+bool Texture::isDecoded() const {
+	return _decoded.load(boost::memory_order_acquire);
+}
+
 uint32 Texture::getWidth() const {
+	waitDecoded();
+
 	return _width;
 }
 
 uint32 Texture::getHeight() const {
+	waitDecoded();
+
 	return _height;
 }
 
 bool Texture::hasAlpha() const {
+	waitDecoded();
+
 	if (!_image)
 		return false;
 
 	return _image->hasAlpha();
 }
 
+bool Texture::isUploadedCubeMap() const {
+	return _uploadedCubeMap;
+}
+
+bool Texture::hasUploadedAlpha() const {
+	return _uploadedAlpha;
+}
+
 bool Texture::isDynamic() const {
 	return false;
 }
 
+/** Can an image of this type carry its own TXI data? */
+static bool canEmbedTXI(::Aurora::FileType type) {
+	return (type == ::Aurora::kFileTypeTPC) || (type == ::Aurora::kFileTypeTXB) ||
+	       (type == ::Aurora::kFileTypeXEOSITEX);
+}
+
 static const TXI kEmptyTXI;
 const TXI &Texture::getTXI() const {
+	// The decoding job doesn't change a TXI read from a separate file
+	if (_hasTXIFile)
+		return *_txi;
+
+	// Only wait for the decoding job if the TXI might be embedded in the image
+	if (!isDecoded() && !canEmbedTXI(_type))
+		return kEmptyTXI;
+
+	waitDecoded();
+
+	return getCurrentTXI();
+}
+
+const TXI &Texture::getCurrentTXI() const {
 	if (_txi)
 		return *_txi;
 
@@ -103,6 +210,8 @@ const TXI &Texture::getTXI() const {
 }
 
 const ImageDecoder &Texture::getImage() const {
+	waitDecoded();
+
 	assert(_image);
 
 	return *_image;
@@ -112,6 +221,8 @@ bool Texture::reload() {
 	if (_name.empty())
 		return false;
 
+	waitDecoded();
+
 	::Aurora::FileType type = ::Aurora::kFileTypeNone;
 	ImageDecoder *image = 0;
 	TXI *txi = 0;
@@ -132,16 +243,114 @@ bool Texture::reload() {
 	set(_name, image, type, txi);
 	addToQueues();
 
+	_hasTXIFile = txi != 0;
+
 	return true;
 }
 
 bool Texture::dumpTGA(const Common::UString &fileName) const {
+	waitDecoded();
+
 	if (!_image)
 		return false;
 
 	return _image->dumpTGA(fileName);
 }
 
+bool Texture::isStreamable() const {
+	return _streamable;
+}
+
+void Texture::disableStreaming() {
+	_streamable = false;
+}
+
+size_t Texture::getBaseMipMap() const {
+	if (!_streamable)
+		return 0;
+
+	return findBaseMipMap(*_image);
+}
+
+size_t Texture::getResidentMipMap() const {
+	return _residentMipMap;
+}
+
+size_t Texture::getMipMapSize(size_t mipMap) const {
+	if (!_image || (mipMap >= _image->getMipMapCount()))
+		return 0;
+
+	size_t size = 0;
+	for (size_t i = 0; i < _image->getLayerCount(); i++)
+		size += _image->getMipMap(mipMap, i).size;
+
+	return size;
+}
+
+size_t Texture::getResidentSize() const {
+	if (!_image)
+		return 0;
+
+	size_t size = 0;
+	for (size_t i = _residentMipMap; i < _image->getMipMapCount(); i++)
+		size += getMipMapSize(i);
+
+	return size;
+}
+
+bool Texture::hasMipMapData(size_t mipMap) const {
+	if (!_image || (mipMap >= _image->getMipMapCount()))
+		return false;
+
+	return _image->getMipMap(mipMap).data.get() != 0;
+}
+
+bool Texture::promote() {
+	if ((_textureID == 0) || (_residentMipMap == 0) || !hasMipMapData(_residentMipMap - 1))
+		return false;
+
+	_residentMipMap--;
+
+	setAlign();
+
+	if (_image->isCubeMap()) {
+		glBindTexture(GL_TEXTURE_CUBE_MAP, _textureID);
+
+		for (size_t i = 0; i < _image->getLayerCount(); i++)
+			setMipMapData(kCubeMapFaceTarget[i], i, _residentMipMap);
+
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_BASE_LEVEL, _residentMipMap);
+		return true;
+	}
+
+	glBindTexture(GL_TEXTURE_2D, _textureID);
+
+	setMipMapData(GL_TEXTURE_2D, 0, _residentMipMap);
+
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, _residentMipMap);
+	return true;
+}
+
+void Texture::evict() {
+	const size_t baseMipMap = getBaseMipMap();
+	if (_residentMipMap >= baseMipMap)
+		return;
+
+	_residentMipMap = baseMipMap;
+	_image->unloadMipMaps(baseMipMap);
+
+	// Recreate the texture, so that the driver can actually free the larger mip maps
+	destroy();
+	rebuild();
+}
+
+bool Texture::restore(ImageDecoder &image) {
+	if (!_image)
+		return false;
+
+	return _image->reloadMipMaps(image, getBaseMipMap());
+}
+
 void Texture::doDestroy() {
 	if (_textureID == 0)
 		return;
@@ -152,20 +361,26 @@ void Texture::doDestroy() {
 }
 
 void Texture::doRebuild() {
-	if (!_image)
-		// No image
+	// The decoding job is changing the image, it will queue us again when done
+	if (!_decodeMutex.lockTry())
 		return;
 
-	// Generate the texture ID
-	if (_textureID == 0)
-		glGenTextures(1, &_textureID);
+	if (_image) {
+		// Remember what we uploaded, so that the render thread never has to wait for the image
+		_uploadedCubeMap = _image->isCubeMap();
+		_uploadedAlpha   = _image->hasAlpha();
 
-	if (_image->isCubeMap()) {
-		createCubeMapTexture();
-		return;
+		// Generate the texture ID
+		if (_textureID == 0)
+			glGenTextures(1, &_textureID);
+
+		if (_image->isCubeMap())
+			createCubeMapTexture();
+		else
+			create2DTexture();
 	}
 
-	create2DTexture();
+	_decodeMutex.unlock();
 }
 
 void Texture::setWrap(GLenum target, GLint wrapModeX, GLint wrapModeY) {
@@ -213,7 +428,8 @@ void Texture::setAlign() {
 }
 
 void Texture::setFilter(GLenum target) {
-	const TXI::Features &features = getTXI().getFeatures();
+	// Don't wait for a decoding job here, we might be blocking it
+	const TXI::Features &features = getCurrentTXI().getFeatures();
 
 	if (features.filter) {
 		glTexParameteri(target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -235,7 +451,7 @@ void Texture::setMipMaps(GLenum target) {
 		// Texture does specify mip maps, use these
 
 		glTexParameteri(target, GL_GENERATE_MIPMAP, GL_FALSE);
-		glTexParameteri(target, GL_TEXTURE_BASE_LEVEL, 0);
+		glTexParameteri(target, GL_TEXTURE_BASE_LEVEL, _residentMipMap);
 		glTexParameteri(target, GL_TEXTURE_MAX_LEVEL, _image->getMipMapCount() - 1);
 	}
 }
@@ -268,8 +484,8 @@ void Texture::create2DTexture() {
 	// Mip map parameters
 	setMipMaps(GL_TEXTURE_2D);
 
-	// Texture image data
-	for (size_t i = 0; i < _image->getMipMapCount(); i++)
+	// Texture image data, only from the largest resident mip map on
+	for (size_t i = _residentMipMap; i < _image->getMipMapCount(); i++)
 		setMipMapData(GL_TEXTURE_2D, 0, i);
 }
 
@@ -291,23 +507,16 @@ void Texture::createCubeMapTexture() {
 
 	assert(_image->getLayerCount() == 6);
 
-	static const GLenum faceTarget[6] = {
-		GL_TEXTURE_CUBE_MAP_POSITIVE_X,
-		GL_TEXTURE_CUBE_MAP_NEGATIVE_X,
-		GL_TEXTURE_CUBE_MAP_POSITIVE_Y,
-		GL_TEXTURE_CUBE_MAP_NEGATIVE_Y,
-		GL_TEXTURE_CUBE_MAP_POSITIVE_Z,
-		GL_TEXTURE_CUBE_MAP_NEGATIVE_Z
-	};
-
-	// Texture image data
+	// Texture image data, only from the largest resident mip map on
 	for (size_t i = 0; i < _image->getLayerCount(); i++)
-		for (size_t j = 0; j < _image->getMipMapCount(); j++)
-			setMipMapData(faceTarget[i], i, j);
+		for (size_t j = _residentMipMap; j < _image->getMipMapCount(); j++)
+			setMipMapData(kCubeMapFaceTarget[i], i, j);
 }
 
-Texture *Texture::createPLT(const Common::UString &name, Common::SeekableReadStream *imageStream) {
-	Texture *texture = 0;
+Texture *Texture::createPLT(const Common::UString &name, Common::SeekableReadStream *imageStream,
+                            Common::ThreadPool *pool) {
+
+	PLTFile *texture = 0;
 	try {
 		texture = new PLTFile(name, *imageStream);
 	} catch (...) {
@@ -316,35 +525,26 @@ Texture *Texture::createPLT(const Common::UString &name, Common::SeekableReadStr
 	}
 
 	delete imageStream;
+
+	texture->_decodePool = pool;
 	return texture;
 }
 
-Texture *Texture::create(const Common::UString &name) {
+Texture *Texture::create(const Common::UString &name, Common::ThreadPool *pool) {
 	::Aurora::FileType type = ::Aurora::kFileTypeNone;
-	ImageDecoder *image = 0;
-	ImageDecoder *layers[6] = { 0, 0, 0, 0, 0, 0 };
+	Common::SeekableReadStream *imageStream = 0;
 	TXI *txi = 0;
 
+	/* Only read the resources here, so that a missing texture is noticed
+	 * right away. A cube map with each side a separate image file reads
+	 * its sides while decoding. */
+
 	try {
 		txi = loadTXI(name);
 
 		const bool isFileCubeMap = txi && txi->getFeatures().cube && (txi->getFeatures().fileRange == 6);
-		if (isFileCubeMap) {
-			// A cube map with each side a separate image file
-
-			for (size_t i = 0; i < 6; i++) {
-				const Common::UString side = name + Common::composeString(i);
-				Common::SeekableReadStream *imageStream = ResMan.getResource(::Aurora::kResourceImage, side, &type);
-				if (!imageStream)
-					throw Common::Exception("No such cube side image resource \"%s\"", side.c_str());
-
-				layers[i] = loadImage(imageStream, type, txi);
-			}
-
-			image = new CubeMapCombiner(layers);
-
-		} else {
-			Common::SeekableReadStream *imageStream = ResMan.getResource(::Aurora::kResourceImage, name, &type);
+		if (!isFileCubeMap) {
+			imageStream = ResMan.getResource(::Aurora::kResourceImage, name, &type);
 			if (!imageStream)
 				throw Common::Exception("No such image resource \"%s\"", name.c_str());
 
@@ -352,24 +552,29 @@ Texture *Texture::create(const Common::UString &name) {
 			if (type == ::Aurora::kFileTypePLT) {
 				delete txi;
 
-				return createPLT(name, imageStream);
+				return createPLT(name, imageStream, pool);
 			}
-
-			image = loadImage(imageStream, type, txi);
 		}
 
 	} catch (Common::Exception &e) {
 		delete txi;
-		delete image;
 
-		for (size_t i = 0; i < ARRAYSIZE(layers); i++)
-			delete layers[i];
+		e.add("Failed to create texture \"%s\" (%d)", name.c_str(), type);
+		throw;
+	}
+
+	Texture *texture = new Texture(name, imageStream, type, txi, pool);
+
+	try {
+		texture->queueDecode();
+	} catch (Common::Exception &e) {
+		delete texture;
 
 		e.add("Failed to create texture \"%s\" (%d)", name.c_str(), type);
 		throw;
 	}
 
-	return new Texture(name, image, type, txi);
+	return texture;
 }
 
 Texture *Texture::create(ImageDecoder *image, ::Aurora::FileType type, TXI *txi) {
@@ -387,10 +592,83 @@ void Texture::set(const Common::UString &name, ImageDecoder *image, ::Aurora::Fi
 	_type   = type;
 
 	_image.reset(image);
-	_txi.reset(txi);
+
+	// The decoding job hands back the TXI we already own, which might be read concurrently
+	if (txi != _txi.get())
+		_txi.reset(txi);
 
 	_width  = _image->getMipMap(0).width;
 	_height = _image->getMipMap(0).height;
+
+	/* Only named, static textures can be reloaded when their larger mip maps
+	 * were evicted. They start out with only their small mip maps uploaded,
+	 * the TextureManager promotes them when they're actually used. */
+	_streamable     = !_name.empty() && !isDynamic() && (_image->getMipMapCount() > 1);
+	_residentMipMap = getBaseMipMap();
+
+	if (_residentMipMap == 0)
+		_streamable = false;
+}
+
+void Texture::queueDecode() {
+	// Wait for the previous job, and mark a new one as pending
+	_decodeDone.lock();
+
+	if (!_decodePool) {
+		try {
+			decode();
+		} catch (...) {
+			_decodeDone.unlock();
+			throw;
+		}
+
+		_decodeDone.unlock();
+		return;
+	}
+
+	_decoded.store(false, boost::memory_order_release);
+	_decodePool->queue(&_decodeJob);
+}
+
+void Texture::waitDecoded() const {
+	if (isDecoded())
+		return;
+
+	waitDecodeJob();
+}
+
+void Texture::waitDecodeJob() const {
+	_decodeDone.lock();
+	_decodeDone.unlock();
+}
+
+void Texture::decode() {
+	::Aurora::FileType type = _type;
+
+	ImageDecoder *image = 0;
+	if (_imageStream)
+		image = loadImage(_imageStream.release(), type, _txi.get(), _decodePool);
+	else
+		image = loadImage(_name, type, _txi.get(), _decodePool);
+
+	{
+		Common::StackLock lock(_decodeMutex);
+
+		set(_name, image, type, _txi.get());
+	}
+
+	addToQueues();
+}
+
+size_t Texture::findBaseMipMap(const ImageDecoder &image) {
+	size_t mipMap = 0;
+
+	while ((mipMap < (image.getMipMapCount() - 1)) &&
+	       ((image.getMipMap(mipMap).width  > kStreamingBaseSize) ||
+	        (image.getMipMap(mipMap).height > kStreamingBaseSize)))
+		mipMap++;
+
+	return mipMap;
 }
 
 ImageDecoder *Texture::loadImage(const Common::UString &name) {
@@ -418,40 +696,58 @@ ImageDecoder *Texture::loadImage(const Common::UString &name, ::Aurora::FileType
 	return loadImage(name, type, 0);
 }
 
-ImageDecoder *Texture::loadImage(const Common::UString &name, ::Aurora::FileType &type, TXI *txi) {
+ImageDecoder *Texture::loadImageWithTXI(const Common::UString &name) {
+	::Aurora::FileType type = ::Aurora::kFileTypeNone;
+
+	Common::ScopedPtr<TXI> txi(loadTXI(name));
+
+	return loadImage(name, type, txi.get());
+}
+
+ImageDecoder *Texture::loadImage(const Common::UString &name, ::Aurora::FileType &type, TXI *txi,
+                                 Common::ThreadPool *pool) {
+
 	const bool isFileCubeMap = txi && txi->getFeatures().cube && (txi->getFeatures().fileRange == 6);
 	if (!isFileCubeMap) {
 		Common::SeekableReadStream *imageStream = ResMan.getResource(::Aurora::kResourceImage, name, &type);
 		if (!imageStream)
 			throw Common::Exception("No such image resource \"%s\"", name.c_str());
 
-		return loadImage(imageStream, type, txi);
+		return loadImage(imageStream, type, txi, pool);
 	}
 
+	Common::SeekableReadStream *streams[6] = { 0, 0, 0, 0, 0, 0 };
+	::Aurora::FileType types[6];
 	ImageDecoder *layers[6] = { 0, 0, 0, 0, 0, 0 };
 
 	try {
 		for (size_t i = 0; i < 6; i++) {
 			const Common::UString side = name + Common::composeString(i);
-			Common::SeekableReadStream *imageStream = ResMan.getResource(::Aurora::kResourceImage, side, &type);
-			if (!imageStream)
+			streams[i] = ResMan.getResource(::Aurora::kResourceImage, side, &types[i]);
+			if (!streams[i])
 				throw Common::Exception("No such cube side image resource \"%s\"", side.c_str());
-
-			layers[i] = loadImage(imageStream, type, txi);
 		}
 
+		type = types[5];
+
+		// The sides are independent of each other, so they can be decoded side by side
+		CubeSideBody body(streams, types, layers, txi, pool);
+		Common::parallelFor(pool, 0, ARRAYSIZE(layers), body);
+
 		return new CubeMapCombiner(layers);
 
 	} catch (...) {
-		for (size_t i = 0; i < ARRAYSIZE(layers); i++)
+		for (size_t i = 0; i < ARRAYSIZE(layers); i++) {
+			delete streams[i];
 			delete layers[i];
+		}
 
 		throw;
 	}
 }
 
 ImageDecoder *Texture::loadImage(Common::SeekableReadStream *imageStream, ::Aurora::FileType type,
-                                 TXI *txi) {
+                                 TXI *txi, Common::ThreadPool *pool) {
 
 	// Check for a cube map, but only those that don't use a file for each side
 	const bool isCubeMap = txi && txi->getFeatures().cube && (txi->getFeatures().fileRange == 0);
@@ -464,9 +760,9 @@ ImageDecoder *Texture::loadImage(Common::SeekableReadStream *imageStream, ::Auro
 		else if (type == ::Aurora::kFileTypeDDS)
 			image = new DDS(*imageStream);
 		else if (type == ::Aurora::kFileTypeTPC)
-			image = new TPC(*imageStream);
+			image = new TPC(*imageStream, pool);
 		else if (type == ::Aurora::kFileTypeTXB)
-			image = new TXB(*imageStream);
+			image = new TXB(*imageStream, pool);
 		else if (type == ::Aurora::kFileTypeSBM)
 			image = new SBM(*imageStream);
 		else if (type == ::Aurora::kFileTypeXEOSITEX)
@@ -479,7 +775,7 @@ ImageDecoder *Texture::loadImage(Common::SeekableReadStream *imageStream, ::Auro
 
 		// Decompress
 		if (GfxMan.needManualDeS3TC())
-			image->decompress();
+			image->decompress(pool);
 
 	} catch (...) {
 		delete image;
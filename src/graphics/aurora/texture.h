@@ -25,8 +25,12 @@
 #ifndef GRAPHICS_AURORA_TEXTURE_H
 #define GRAPHICS_AURORA_TEXTURE_H
 
+#include "src/common/atomic.h"
+
 #include "src/common/scopedptr.h"
 #include "src/common/ustring.h"
+#include "src/common/mutex.h"
+#include "src/common/threadpool.h"
 
 #include "src/graphics/types.h"
 #include "src/graphics/texture.h"
@@ -44,20 +48,39 @@ class TXI;
 
 namespace Aurora {
 
-/** A texture. */
+/** A texture.
+ *
+ *  Textures created from a named resource can be decoded in the background,
+ *  by a thread pool. Until then, the texture has no image, and it's neither
+ *  uploaded nor bound. Querying the image or its properties waits for the
+ *  decoding to finish. The render thread instead only looks at the image
+ *  that was last uploaded, which stays bound while a new image is decoded.
+ */
 class Texture : public Graphics::Texture {
 public:
 	virtual ~Texture();
 
+	/** Has the image been decoded yet? */
+	bool isDecoded() const;
+
 	uint32 getWidth()  const;
 	uint32 getHeight() const;
 
 	bool hasAlpha() const;
 
+	/** Is the uploaded image a cube map? Doesn't wait for decoding. */
+	bool isUploadedCubeMap() const;
+	/** Does the uploaded image have an alpha channel? Doesn't wait for decoding. */
+	bool hasUploadedAlpha() const;
+
 	/** Is this a dynamic texture, or a shared static one? */
 	virtual bool isDynamic() const;
 
-	/** Return the TXI. */
+	/** Return the TXI.
+	 *
+	 *  A separate TXI file is read when the texture is created. This only
+	 *  waits for the decoding if the TXI might be embedded in the image.
+	 */
 	const TXI &getTXI() const;
 	/** Return the image. */
 	const ImageDecoder &getImage() const;
@@ -68,34 +91,114 @@ public:
 	/** Dump the texture into a TGA. */
 	bool dumpTGA(const Common::UString &fileName) const;
 
+	// .--- Streaming
+	/** Can the larger mip maps of this texture be evicted and reloaded? */
+	bool isStreamable() const;
+	/** Stop streaming this texture, keeping the currently resident mip maps. */
+	void disableStreaming();
+
+	/** Return the smallest mip map that's always resident. */
+	size_t getBaseMipMap() const;
+	/** Return the largest mip map that's currently uploaded. */
+	size_t getResidentMipMap() const;
+
+	/** Return the number of bytes taken up by this mip map in all layers. */
+	size_t getMipMapSize(size_t mipMap) const;
+	/** Return the number of bytes taken up by all the uploaded mip maps. */
+	size_t getResidentSize() const;
+
+	/** Is the image data of this mip map still in memory? */
+	bool hasMipMapData(size_t mipMap) const;
+
+	/** Upload the next larger mip map. */
+	bool promote();
+	/** Drop all mip maps larger than the base mip map, from both video and system memory. */
+	void evict();
+	/** Take over the larger mip maps from a reloaded copy of the image. */
+	bool restore(ImageDecoder &image);
+	// '---
+
 
 	/** Load an image in any of the common texture formats. */
 	static ImageDecoder *loadImage(const Common::UString &name);
 	/** Load an image in any of the common texture formats. */
 	static ImageDecoder *loadImage(const Common::UString &name, ::Aurora::FileType &type);
-
-	/** Create a texture from this image resource. */
-	static Texture *create(const Common::UString &name);
+	/** Load an image in any of the common texture formats, taking its TXI into account. */
+	static ImageDecoder *loadImageWithTXI(const Common::UString &name);
+
+	/** Create a texture from this image resource.
+	 *
+	 *  The resources are read right away. If a pool is given, the image is
+	 *  then decoded by the pool, in the background.
+	 */
+	static Texture *create(const Common::UString &name, Common::ThreadPool *pool = 0);
 	/** Take over the image and create a texture from it. */
 	static Texture *create(ImageDecoder *image, ::Aurora::FileType type = ::Aurora::kFileTypeNone, TXI *txi = 0);
 
 
 protected:
+	/** Decodes the texture's image in the background. */
+	class DecodeJob : public Common::ThreadPoolJob {
+	public:
+		DecodeJob(Texture &texture);
+
+		void run();
+
+	private:
+		Texture *_texture;
+	};
+
+	/** Decodes the sides of a cube map that are kept in separate files. */
+	class CubeSideBody;
+
 	Common::UString    _name; ///< The name of the texture's image's file.
 	::Aurora::FileType _type; ///< The type of the texture's image's file.
 
 	Common::ScopedPtr<ImageDecoder> _image; ///< The actual image.
 	Common::ScopedPtr<TXI> _txi;            ///< The TXI.
 
+	bool _hasTXIFile; ///< Was the TXI read from a separate file?
+
 	uint32 _width;
 	uint32 _height;
 
+	bool _uploadedCubeMap; ///< Is the uploaded image a cube map?
+	bool _uploadedAlpha;   ///< Does the uploaded image have an alpha channel?
+
+	bool   _streamable;     ///< Can the larger mip maps be evicted and reloaded?
+	size_t _residentMipMap; ///< The largest mip map that's currently uploaded.
+
+	Common::ThreadPool *_decodePool; ///< The pool decoding the image, if any.
+	DecodeJob           _decodeJob;  ///< The job decoding the image.
+
+	boost::atomic<bool>       _decoded;     ///< Is no decoding job pending?
+	mutable Common::Semaphore _decodeDone;  ///< Held while a decoding job is pending.
+	Common::Mutex             _decodeMutex; ///< Held while the decoding job changes the image.
+
+	/** The undecoded image, read from the resources. */
+	Common::ScopedPtr<Common::SeekableReadStream> _imageStream;
+
 
 	Texture();
 	Texture(const Common::UString &name, ImageDecoder *image, ::Aurora::FileType type, TXI *txi = 0);
+	/** Create a texture whose image still needs to be decoded from this stream. */
+	Texture(const Common::UString &name, Common::SeekableReadStream *imageStream, ::Aurora::FileType type,
+	        TXI *txi, Common::ThreadPool *pool);
 
 	void set(const Common::UString &name, ImageDecoder *image, ::Aurora::FileType type, TXI *txi);
 
+	/** Run decode() in the background, or right away without a pool. */
+	void queueDecode();
+	/** Wait until the pending decoding job, if any, has finished. */
+	void waitDecoded() const;
+	/** Wait until the decoding job doesn't touch this texture anymore. */
+	void waitDecodeJob() const;
+	/** Decode the image. Called by the decoding job. */
+	virtual void decode();
+
+	/** Return the TXI, without waiting for the decoding job. */
+	const TXI &getCurrentTXI() const;
+
 	void addToQueues();
 	void removeFromQueues();
 	void refresh();
@@ -115,13 +218,17 @@ protected:
 	void setMipMaps(GLenum target);
 	void setMipMapData(GLenum target, size_t layer, size_t mipMap);
 
+	static size_t findBaseMipMap(const ImageDecoder &image);
+
 	static TXI *loadTXI(const Common::UString &name);
 	static ImageDecoder *loadImage(Common::SeekableReadStream *imageStream, ::Aurora::FileType type,
-	                               TXI *txi = 0);
+	                               TXI *txi = 0, Common::ThreadPool *pool = 0);
 
-	static ImageDecoder *loadImage(const Common::UString &name, ::Aurora::FileType &type, TXI *txi);
+	static ImageDecoder *loadImage(const Common::UString &name, ::Aurora::FileType &type, TXI *txi,
+	                               Common::ThreadPool *pool = 0);
 
-	static Texture *createPLT(const Common::UString &name, Common::SeekableReadStream *imageStream);
+	static Texture *createPLT(const Common::UString &name, Common::SeekableReadStream *imageStream,
+	                          Common::ThreadPool *pool);
 };
 
 } // End of namespace Aurora
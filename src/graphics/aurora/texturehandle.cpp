@@ -32,7 +32,7 @@ namespace Graphics {
 
 namespace Aurora {
 
-ManagedTexture::ManagedTexture(Texture *t) : texture(t), referenceCount(0) {
+ManagedTexture::ManagedTexture(Texture *t) : texture(t), referenceCount(0), lastUsed(0), reloading(false) {
 }
 
 ManagedTexture::~ManagedTexture() {
@@ -75,7 +75,7 @@ const Common::UString &TextureHandle::getName() const {
 	if (_empty)
 		return kEmptyString;
 
-	return _it->first;
+	return _it->first.str();
 }
 
 void TextureHandle::clear() {
@@ -29,6 +29,7 @@
 
 #include "src/common/types.h"
 #include "src/common/ustring.h"
+#include "src/common/internedstring.h"
 
 namespace Graphics {
 
@@ -41,11 +42,19 @@ struct ManagedTexture {
 	Texture *texture;
 	uint32 referenceCount;
 
+	uint32 lastUsed;  ///< The last frame this texture was used in.
+	bool   reloading; ///< Are the evicted mip maps of this texture being reloaded?
+
 	ManagedTexture(Texture *t);
 	~ManagedTexture();
 };
 
-typedef std::map<Common::UString, ManagedTexture *> TextureMap;
+/** All managed textures, by name.
+ *
+ *  The names are interned, so lookups only compare pointers. Unlike with
+ *  a hash map, the iterators stay valid when other textures are added.
+ */
+typedef std::map<Common::InternedString, ManagedTexture *> TextureMap;
 
 /** A handle to a texture. */
 class TextureHandle {
@@ -22,6 +22,9 @@
  *  The Aurora texture manager.
  */
 
+#include <algorithm>
+#include <vector>
+
 #include "src/common/scopedptr.h"
 #include "src/common/util.h"
 #include "src/common/error.h"
@@ -79,8 +82,23 @@ static GLenum kTextureUnit[] = {
 
 static const size_t kTextureUnitCount = ARRAYSIZE(kTextureUnit);
 
+/** Number of frames after its last use a texture still counts as used, and is promoted. */
+static const uint32 kStreamingUsedFrames = 2;
+/** Number of frames after its last use a texture's larger mip maps may be evicted. */
+static const uint32 kStreamingKeepFrames = 300;
+
+/** Maximum number of bytes uploaded by promoting textures, per frame. */
+static const size_t kStreamingUploadSize = 4 * 1024 * 1024;
 
-TextureManager::TextureManager() : _recordNewTextures(false) {
+static bool compareLastUsed(const ManagedTexture *a, const ManagedTexture *b) {
+	return a->lastUsed < b->lastUsed;
+}
+
+
+TextureManager::TextureManager() : _recordNewTextures(false),
+	_decodePool(Common::ThreadPool::getDefaultThreadCount()), _streamingBudget(0), _frame(1) {
+
+	_streamer.createThread("TextureStreamer");
 }
 
 TextureManager::~TextureManager() {
@@ -92,12 +110,17 @@ void TextureManager::clear() {
 
 	_bogusTextures.clear();
 
-	for (TextureMap::iterator t = _textures.begin(); t != _textures.end(); ++t)
+	for (TextureMap::iterator t = _textures.begin(); t != _textures.end(); ++t) {
+		_streamer.cancel(t->second);
+
 		delete t->second;
+	}
 	_textures.clear();
 
 	_recordNewTextures = false;
 	_newTextureNames.clear();
+
+	_pltCache.clear();
 }
 
 void TextureManager::addBogusTexture(const Common::UString &name) {
@@ -111,7 +134,9 @@ bool TextureManager::hasTexture(const Common::UString &name) {
 
 	if (_bogusTextures.find(name) != _bogusTextures.end())
 		return true;
-	if (_textures.find(name) != _textures.end())
+
+	Common::InternedString internedName;
+	if (Common::InternedString::lookup(name, internedName) && (_textures.find(internedName) != _textures.end()))
 		return true;
 
 	return false;
@@ -130,7 +155,8 @@ TextureHandle TextureManager::add(Texture *texture, Common::UString name) {
 
 	Common::ScopedPtr<ManagedTexture> managedTexture(new ManagedTexture(texture));
 
-	std::pair<TextureMap::iterator, bool> result = _textures.insert(std::make_pair(name, managedTexture.get()));
+	std::pair<TextureMap::iterator, bool> result =
+		_textures.insert(std::make_pair(Common::InternedString(name), managedTexture.get()));
 	if (!result.second)
 		throw Common::Exception("Texture \"%s\" already exists", name.c_str());
 
@@ -149,16 +175,21 @@ TextureHandle TextureManager::get(Common::UString name) {
 	if (_bogusTextures.find(name) != _bogusTextures.end())
 		return TextureHandle();
 
-	TextureMap::iterator texture = _textures.find(name);
+	Common::InternedString internedName;
+
+	TextureMap::iterator texture = _textures.end();
+	if (Common::InternedString::lookup(name, internedName))
+		texture = _textures.find(internedName);
+
 	if (texture == _textures.end()) {
 		std::pair<TextureMap::iterator, bool> result;
 
-		ManagedTexture *managedTexture = new ManagedTexture(Texture::create(name));
+		ManagedTexture *managedTexture = new ManagedTexture(Texture::create(name, &_decodePool));
 
 		if (managedTexture->texture->isDynamic())
 			name = name + "#" + Common::generateIDRandomString();
 
-		result = _textures.insert(std::make_pair(name, managedTexture));
+		result = _textures.insert(std::make_pair(Common::InternedString(name), managedTexture));
 
 		texture = result.first;
 	}
@@ -175,7 +206,11 @@ TextureHandle TextureManager::getIfExist(const Common::UString &name) {
 	if (_bogusTextures.find(name) != _bogusTextures.end())
 		return TextureHandle();
 
-	TextureMap::iterator texture = _textures.find(name);
+	Common::InternedString internedName;
+	if (!Common::InternedString::lookup(name, internedName))
+		return TextureHandle();
+
+	TextureMap::iterator texture = _textures.find(internedName);
 	if (texture != _textures.end())
 		return TextureHandle(texture);
 
@@ -213,6 +248,8 @@ void TextureManager::release(TextureHandle &texture) {
 
 	if (!texture._empty && (texture._it != _textures.end())) {
 		if (--texture._it->second->referenceCount == 0) {
+			_streamer.cancel(texture._it->second);
+
 			delete texture._it->second;
 			_textures.erase(texture._it);
 		}
@@ -225,6 +262,9 @@ void TextureManager::release(TextureHandle &texture) {
 void TextureManager::reloadAll() {
 	Common::StackLock lock(_mutex);
 
+	// The palettes might have changed as well
+	_pltCache.clear();
+
 	GfxMan.lockFrame();
 
 	for (TextureMap::iterator texture = _textures.begin(); texture != _textures.end(); ++texture) {
@@ -239,6 +279,10 @@ void TextureManager::reloadAll() {
 	GfxMan.unlockFrame();
 }
 
+PLTCache &TextureManager::getPLTCache() {
+	return _pltCache;
+}
+
 void TextureManager::reset() {
 	for (size_t i = 0; i < kTextureUnitCount; i++) {
 		activeTexture(i);
@@ -273,11 +317,16 @@ void TextureManager::set(const TextureHandle &handle, TextureMode mode) {
 		return;
 	}
 
+	handle._it->second->lastUsed = _frame;
+
+	// The texture might still be decoding, or waiting to be uploaded
 	TextureID id = handle._it->second->texture->getID();
-	if (id == 0)
-		warning("Empty texture ID for texture \"%s\"", handle._it->first.c_str());
+	if (id == 0) {
+		set();
+		return;
+	}
 
-	if (handle._it->second->texture->getImage().isCubeMap()) {
+	if (handle._it->second->texture->isUploadedCubeMap()) {
 		glBindTexture(GL_TEXTURE_CUBE_MAP, id);
 
 		glDisable(GL_TEXTURE_2D);
@@ -291,7 +340,7 @@ void TextureManager::set(const TextureHandle &handle, TextureMode mode) {
 
 	switch (mode) {
 		case kModeEnvironmentMapReflective:
-			if (handle._it->second->texture->getImage().isCubeMap()) {
+			if (handle._it->second->texture->isUploadedCubeMap()) {
 				glTexGeni(GL_S, GL_TEXTURE_GEN_MODE, GL_REFLECTION_MAP);
 				glTexGeni(GL_T, GL_TEXTURE_GEN_MODE, GL_REFLECTION_MAP);
 				glTexGeni(GL_R, GL_TEXTURE_GEN_MODE, GL_REFLECTION_MAP);
@@ -325,6 +374,121 @@ void TextureManager::activeTexture(size_t n) {
 	glActiveTextureARB(kTextureUnit[n]);
 }
 
+void TextureManager::setStreamingBudget(size_t budget) {
+	Common::StackLock lock(_mutex);
+
+	_streamingBudget = budget;
+}
+
+void TextureManager::updateStreaming() {
+	// Don't stall the frame while another thread is loading a texture
+	if (!_mutex.lockTry())
+		return;
+
+	const uint32 frame = ++_frame;
+
+	restoreStreamedTextures();
+
+	size_t residentSize = 0;
+
+	std::vector<ManagedTexture *> used, unused;
+	for (TextureMap::iterator t = _textures.begin(); t != _textures.end(); ++t) {
+		Texture &texture = *t->second->texture;
+
+		// Still being decoded in the background
+		if (!texture.isDecoded())
+			continue;
+
+		residentSize += texture.getResidentSize();
+		if (!texture.isStreamable())
+			continue;
+
+		const uint32 lastUsed = t->second->lastUsed;
+
+		if        ((lastUsed != 0) && ((lastUsed + kStreamingUsedFrames) >= frame)) {
+			if (texture.getResidentMipMap() == 0)
+				continue;
+
+			if (!texture.hasMipMapData(texture.getResidentMipMap() - 1)) {
+				if (!t->second->reloading) {
+					t->second->reloading = true;
+					_streamer.request(t->second, t->first.str());
+				}
+
+				continue;
+			}
+
+			used.push_back(t->second);
+
+		} else if ((lastUsed + kStreamingKeepFrames) < frame) {
+			if (texture.getResidentMipMap() < texture.getBaseMipMap())
+				unused.push_back(t->second);
+		}
+	}
+
+	// Evict the textures that haven't been used for the longest time first
+	std::sort(unused.begin(), unused.end(), compareLastUsed);
+	std::vector<ManagedTexture *>::iterator evict = unused.begin();
+
+	if (_streamingBudget > 0) {
+		while ((residentSize > _streamingBudget) && (evict != unused.end())) {
+			Texture &texture = *(*evict++)->texture;
+
+			residentSize -= texture.getResidentSize();
+			texture.evict();
+			residentSize += texture.getResidentSize();
+		}
+	}
+
+	size_t uploaded = 0;
+	for (std::vector<ManagedTexture *>::iterator u = used.begin(); u != used.end(); ++u) {
+		Texture &texture = *(*u)->texture;
+
+		while ((texture.getResidentMipMap() > 0) && texture.hasMipMapData(texture.getResidentMipMap() - 1)) {
+			const size_t size = texture.getMipMapSize(texture.getResidentMipMap() - 1);
+			if ((uploaded > 0) && ((uploaded + size) > kStreamingUploadSize))
+				break;
+
+			// Make room by evicting unused textures
+			while ((_streamingBudget > 0) && ((residentSize + size) > _streamingBudget) && (evict != unused.end())) {
+				Texture &evicted = *(*evict++)->texture;
+
+				residentSize -= evicted.getResidentSize();
+				evicted.evict();
+				residentSize += evicted.getResidentSize();
+			}
+
+			if ((_streamingBudget > 0) && ((residentSize + size) > _streamingBudget))
+				break;
+
+			if (!texture.promote())
+				break;
+
+			residentSize += size;
+			uploaded     += size;
+		}
+	}
+
+	_mutex.unlock();
+}
+
+void TextureManager::restoreStreamedTextures() {
+	std::list<TextureStreamer::Result> results;
+	_streamer.collect(results);
+
+	for (std::list<TextureStreamer::Result>::iterator r = results.begin(); r != results.end(); ++r) {
+		Common::ScopedPtr<ImageDecoder> image(r->image);
+
+		r->texture->reloading = false;
+
+		if (!image || !r->texture->texture->restore(*image)) {
+			warning("Failed to restore the mip maps of a streamed texture");
+
+			r->texture->texture->disableStreaming();
+		}
+	}
+}
+
 } // End of namespace Aurora
 
 } // End of namespace Graphics
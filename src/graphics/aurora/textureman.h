@@ -32,14 +32,28 @@
 #include "src/common/singleton.h"
 #include "src/common/mutex.h"
 #include "src/common/ustring.h"
+#include "src/common/threadpool.h"
 
 #include "src/graphics/aurora/texturehandle.h"
+#include "src/graphics/aurora/texturestreamer.h"
+#include "src/graphics/aurora/pltcache.h"
 
 namespace Graphics {
 
 namespace Aurora {
 
-/** The global Aurora texture manager. */
+/** The global Aurora texture manager.
+ *
+ *  Textures loaded by name are decoded in the background, by a pool of
+ *  worker threads. The render thread only uploads them once they're done.
+ *
+ *  Named static textures are streamed: they start out with only their small
+ *  mip maps uploaded. Once per frame, the render thread promotes the textures
+ *  that were used recently, one mip map at a time, and evicts the larger mip
+ *  maps of textures that haven't been used in a while whenever the streamed
+ *  textures would exceed the memory budget. Evicted mip maps are reloaded by
+ *  a background thread when the texture is used again.
+ */
 class TextureManager : public Common::Singleton<TextureManager> {
 public:
 	/** The mode/usage of a specific texture. */
@@ -78,6 +92,9 @@ public:
 
 	/** Reload and rebuild all managed textures, if possible. */
 	void reloadAll();
+
+	/** Return the cache for the palettes and images of PLT textures. */
+	PLTCache &getPLTCache();
 	// '---
 
 	// .--- Texture rendering
@@ -92,6 +109,13 @@ public:
 	void activeTexture(size_t n);
 	// '---
 
+	// .--- Texture streaming
+	/** Set the number of bytes all textures together may take up. 0 means unlimited. */
+	void setStreamingBudget(size_t budget);
+	/** Promote recently used and evict unused textures. Called once per frame by the render thread. */
+	void updateStreaming();
+	// '---
+
 private:
 	TextureMap _textures;
 
@@ -102,6 +126,18 @@ private:
 	bool _recordNewTextures;
 	std::list<Common::UString> _newTextureNames;
 
+	PLTCache _pltCache; ///< Palettes and built images of PLT textures.
+
+	Common::ThreadPool _decodePool; ///< Decodes the textures' images in the background.
+
+	TextureStreamer _streamer;
+
+	size_t _streamingBudget; ///< Number of bytes all textures may take up.
+	uint32 _frame;           ///< The current frame, for the textures' last use.
+
+	/** Take over the mip maps the streamer reloaded. */
+	void restoreStreamedTextures();
+
 	void assign(TextureHandle &texture, const TextureHandle &from);
 	void release(TextureHandle &texture);
 
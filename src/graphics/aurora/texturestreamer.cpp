@@ -0,0 +1,139 @@
+/* xoreos - A reimplementation of BioWare's Aurora engine
+ *
+ * xoreos is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * xoreos is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * xoreos is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with xoreos. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  A thread reloading the evicted mip maps of streamed textures.
+ */
+
+#include "src/common/scopedptr.h"
+#include "src/common/error.h"
+
+#include "src/graphics/images/decoder.h"
+
+#include "src/graphics/aurora/texturestreamer.h"
+#include "src/graphics/aurora/texture.h"
+
+namespace Graphics {
+
+namespace Aurora {
+
+/** Time to wait for new requests before checking whether the thread should end, in milliseconds. */
+static const uint32 kRequestTimeout = 100;
+
+TextureStreamer::TextureStreamer() : _current(0), _requestsAvailable(0) {
+}
+
+TextureStreamer::~TextureStreamer() {
+	destroyThread();
+
+	deleteResults(_results);
+}
+
+void TextureStreamer::request(ManagedTexture *texture, const Common::UString &name) {
+	Request request;
+	request.texture = texture;
+	request.name    = name;
+
+	{
+		Common::StackLock lock(_mutex);
+
+		_requests.push_back(request);
+	}
+
+	_requestsAvailable.unlock();
+}
+
+void TextureStreamer::cancel(ManagedTexture *texture) {
+	Common::StackLock lock(_mutex);
+
+	for (std::list<Request>::iterator r = _requests.begin(); r != _requests.end(); ) {
+		if (r->texture == texture)
+			r = _requests.erase(r);
+		else
+			++r;
+	}
+
+	if (_current == texture)
+		_current = 0;
+
+	deleteResults(_results, texture);
+}
+
+void TextureStreamer::collect(std::list<Result> &results) {
+	Common::StackLock lock(_mutex);
+
+	results.splice(results.end(), _results);
+}
+
+void TextureStreamer::threadMethod() {
+	while (!_killThread) {
+		if (!_requestsAvailable.lock(kRequestTimeout))
+			continue;
+
+		Request request;
+
+		{
+			Common::StackLock lock(_mutex);
+
+			if (_requests.empty())
+				continue;
+
+			request = _requests.front();
+			_requests.pop_front();
+
+			_current = request.texture;
+		}
+
+		Common::ScopedPtr<ImageDecoder> image;
+		try {
+			image.reset(Texture::loadImageWithTXI(request.name));
+		} catch (...) {
+			Common::exceptionDispatcherWarning("Failed to stream texture \"%s\"", request.name.c_str());
+		}
+
+		Common::StackLock lock(_mutex);
+
+		// The texture might have been deleted in the meantime
+		if (_current != request.texture)
+			continue;
+
+		Result result;
+		result.texture = request.texture;
+		result.image   = image.release();
+
+		_results.push_back(result);
+
+		_current = 0;
+	}
+}
+
+void TextureStreamer::deleteResults(std::list<Result> &results, ManagedTexture *texture) {
+	for (std::list<Result>::iterator r = results.begin(); r != results.end(); ) {
+		if (!texture || (r->texture == texture)) {
+			delete r->image;
+			r = results.erase(r);
+		} else
+			++r;
+	}
+}
+
+} // End of namespace Aurora
+
+} // End of namespace Graphics
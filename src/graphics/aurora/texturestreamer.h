@@ -0,0 +1,89 @@
+/* xoreos - A reimplementation of BioWare's Aurora engine
+ *
+ * xoreos is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * xoreos is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * xoreos is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with xoreos. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  A thread reloading the evicted mip maps of streamed textures.
+ */
+
+#ifndef GRAPHICS_AURORA_TEXTURESTREAMER_H
+#define GRAPHICS_AURORA_TEXTURESTREAMER_H
+
+#include <list>
+
+#include "src/common/ustring.h"
+#include "src/common/mutex.h"
+#include "src/common/thread.h"
+
+namespace Graphics {
+
+class ImageDecoder;
+
+namespace Aurora {
+
+struct ManagedTexture;
+
+/** A thread reloading the full images of streamed textures in the background.
+ *
+ *  The TextureManager requests the reload of a texture whose larger mip maps
+ *  were evicted, and later collects the decoded image to restore the texture.
+ */
+class TextureStreamer : public Common::Thread {
+public:
+	/** A finished reload. */
+	struct Result {
+		ManagedTexture *texture; ///< The texture that requested the reload.
+		ImageDecoder *image;     ///< The reloaded image, or 0 if reloading failed.
+	};
+
+	TextureStreamer();
+	~TextureStreamer();
+
+	/** Queue the reloading of the image of this texture. */
+	void request(ManagedTexture *texture, const Common::UString &name);
+	/** Forget about any queued or finished reloading for this texture. */
+	void cancel(ManagedTexture *texture);
+	/** Take over all finished reloads. The caller takes over the images. */
+	void collect(std::list<Result> &results);
+
+private:
+	struct Request {
+		ManagedTexture *texture;
+		Common::UString name;
+	};
+
+	std::list<Request> _requests; ///< Reloads still waiting for the thread.
+	std::list<Result>  _results;  ///< Finished reloads.
+
+	/** The texture the thread is currently reloading, or 0 if it was cancelled. */
+	ManagedTexture *_current;
+
+	Common::Mutex _mutex;
+	Common::Semaphore _requestsAvailable;
+
+	void threadMethod();
+
+	static void deleteResults(std::list<Result> &results, ManagedTexture *texture = 0);
+};
+
+} // End of namespace Aurora
+
+} // End of namespace Graphics
+
+#endif // GRAPHICS_AURORA_TEXTURESTREAMER_H
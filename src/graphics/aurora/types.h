@@ -55,6 +55,7 @@ enum ModelType {
 
 class Model;
 class ModelNode;
+class InstancedModel;
 class Text;
 class GUIQuad;
 
@@ -0,0 +1,270 @@
+/* xoreos - A reimplementation of BioWare's Aurora engine
+ *
+ * xoreos is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * xoreos is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * xoreos is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with xoreos. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  A bounding volume hierarchy, for culling and picking.
+ */
+
+#include <cassert>
+
+#include <algorithm>
+
+#include "src/common/util.h"
+
+#include "src/graphics/bvh.h"
+#include "src/graphics/frustum.h"
+
+namespace Graphics {
+
+static void setBox(BVH::Box &box, const BVH::Box &source) {
+	for (int i = 0; i < 3; i++) {
+		box.min[i] = source.min[i];
+		box.max[i] = source.max[i];
+	}
+}
+
+static void addBox(BVH::Box &box, const BVH::Box &source) {
+	for (int i = 0; i < 3; i++) {
+		box.min[i] = MIN(box.min[i], source.min[i]);
+		box.max[i] = MAX(box.max[i], source.max[i]);
+	}
+}
+
+/** Does the line segment start + t * direction, 0 <= t <= 1, intersect the box? */
+static bool intersectsSegment(const BVH::Box &box, const float start[3], const float direction[3]) {
+	float tMin = 0.0f, tMax = 1.0f;
+
+	for (int i = 0; i < 3; i++) {
+		if (direction[i] == 0.0f) {
+			if ((start[i] < box.min[i]) || (start[i] > box.max[i]))
+				return false;
+
+			continue;
+		}
+
+		float t1 = (box.min[i] - start[i]) / direction[i];
+		float t2 = (box.max[i] - start[i]) / direction[i];
+		if (t1 > t2)
+			SWAP(t1, t2);
+
+		tMin = MAX(tMin, t1);
+		tMax = MIN(tMax, t2);
+
+		if (tMin > tMax)
+			return false;
+	}
+
+	return true;
+}
+
+/** Orders item indices by their center along one axis. */
+struct CenterLess {
+	const std::vector<float> *centers;
+	int axis;
+
+	CenterLess(const std::vector<float> &c, int a) : centers(&c), axis(a) {
+	}
+
+	bool operator()(uint32 a, uint32 b) const {
+		return (*centers)[a * 3 + axis] < (*centers)[b * 3 + axis];
+	}
+};
+
+
+BVH::BVH() {
+}
+
+BVH::~BVH() {
+}
+
+void BVH::clear() {
+	_nodes.clear();
+	_items.clear();
+	_boxes.clear();
+}
+
+bool BVH::empty() const {
+	return _items.empty();
+}
+
+size_t BVH::size() const {
+	return _items.size();
+}
+
+void BVH::build(const std::vector<Box> &boxes) {
+	clear();
+	if (boxes.empty())
+		return;
+
+	_boxes = boxes;
+
+	_items.resize(_boxes.size());
+	std::vector<float> centers(_boxes.size() * 3);
+
+	for (size_t i = 0; i < _boxes.size(); i++) {
+		_items[i] = i;
+
+		for (int j = 0; j < 3; j++)
+			centers[i * 3 + j] = (_boxes[i].min[j] + _boxes[i].max[j]) * 0.5f;
+	}
+
+	_nodes.reserve(2 * (_boxes.size() / kMaxLeafItems) + 1);
+
+	buildNode(centers, 0, _items.size());
+}
+
+uint32 BVH::buildNode(std::vector<float> &centers, uint32 first, uint32 count) {
+	const uint32 index = _nodes.size();
+
+	_nodes.push_back(Node());
+	_nodes[index].first = first;
+	_nodes[index].count = count;
+	_nodes[index].left  = 0;
+	_nodes[index].right = 0;
+
+	// Find the bounds of the item centers, to decide where to split
+
+	float centerMin[3], centerMax[3];
+	for (int j = 0; j < 3; j++)
+		centerMin[j] = centerMax[j] = centers[_items[first] * 3 + j];
+
+	for (uint32 i = first + 1; i < (first + count); i++) {
+		for (int j = 0; j < 3; j++) {
+			centerMin[j] = MIN(centerMin[j], centers[_items[i] * 3 + j]);
+			centerMax[j] = MAX(centerMax[j], centers[_items[i] * 3 + j]);
+		}
+	}
+
+	int axis = 0;
+	for (int j = 1; j < 3; j++)
+		if ((centerMax[j] - centerMin[j]) > (centerMax[axis] - centerMin[axis]))
+			axis = j;
+
+	// Few enough items, or all in the same spot: make this a leaf
+	if ((count <= kMaxLeafItems) || (centerMax[axis] <= centerMin[axis])) {
+		refitNode(_nodes[index]);
+		return index;
+	}
+
+	const uint32 half = count / 2;
+
+	std::nth_element(_items.begin() + first, _items.begin() + first + half,
+	                 _items.begin() + first + count, CenterLess(centers, axis));
+
+	const uint32 left  = buildNode(centers, first       , half        );
+	const uint32 right = buildNode(centers, first + half, count - half);
+
+	Node &node = _nodes[index];
+
+	node.left  = left;
+	node.right = right;
+
+	setBox(node.box, _nodes[left].box);
+	addBox(node.box, _nodes[right].box);
+
+	return index;
+}
+
+void BVH::refit(const std::vector<Box> &boxes) {
+	assert(boxes.size() == _boxes.size());
+
+	_boxes = boxes;
+
+	// Children always come after their parents, so go backwards
+	for (std::vector<Node>::reverse_iterator n = _nodes.rbegin(); n != _nodes.rend(); ++n) {
+		if (n->left == 0) {
+			refitNode(*n);
+			continue;
+		}
+
+		setBox(n->box, _nodes[n->left].box);
+		addBox(n->box, _nodes[n->right].box);
+	}
+}
+
+void BVH::refitNode(Node &node) const {
+	setBox(node.box, _boxes[_items[node.first]]);
+
+	for (uint32 i = node.first + 1; i < (node.first + node.count); i++)
+		addBox(node.box, _boxes[_items[i]]);
+}
+
+void BVH::findVisible(const Frustum &frustum, std::vector<size_t> &items) const {
+	if (_nodes.empty())
+		return;
+
+	std::vector<uint32> stack;
+	stack.push_back(0);
+
+	while (!stack.empty()) {
+		const Node &node = _nodes[stack.back()];
+		stack.pop_back();
+
+		const Frustum::Intersection intersection = frustum.intersect(node.box.min, node.box.max);
+		if (intersection == Frustum::kOutside)
+			continue;
+
+		// Everything below this node is visible
+		if (intersection == Frustum::kInside) {
+			items.insert(items.end(), _items.begin() + node.first, _items.begin() + node.first + node.count);
+			continue;
+		}
+
+		if (node.left != 0) {
+			stack.push_back(node.right);
+			stack.push_back(node.left);
+			continue;
+		}
+
+		for (uint32 i = node.first; i < (node.first + node.count); i++)
+			if (frustum.isIn(_boxes[_items[i]].min, _boxes[_items[i]].max))
+				items.push_back(_items[i]);
+	}
+}
+
+void BVH::findIntersecting(const float start[3], const float end[3], std::vector<size_t> &items) const {
+	if (_nodes.empty())
+		return;
+
+	const float direction[3] = { end[0] - start[0], end[1] - start[1], end[2] - start[2] };
+
+	std::vector<uint32> stack;
+	stack.push_back(0);
+
+	while (!stack.empty()) {
+		const Node &node = _nodes[stack.back()];
+		stack.pop_back();
+
+		if (!intersectsSegment(node.box, start, direction))
+			continue;
+
+		if (node.left != 0) {
+			stack.push_back(node.right);
+			stack.push_back(node.left);
+			continue;
+		}
+
+		for (uint32 i = node.first; i < (node.first + node.count); i++)
+			if (intersectsSegment(_boxes[_items[i]], start, direction))
+				items.push_back(_items[i]);
+	}
+}
+
+} // End of namespace Graphics
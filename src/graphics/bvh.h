@@ -0,0 +1,102 @@
+/* xoreos - A reimplementation of BioWare's Aurora engine
+ *
+ * xoreos is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * xoreos is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * xoreos is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with xoreos. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  A bounding volume hierarchy, for culling and picking.
+ */
+
+#ifndef GRAPHICS_BVH_H
+#define GRAPHICS_BVH_H
+
+#include <vector>
+
+#include "src/common/types.h"
+
+namespace Graphics {
+
+class Frustum;
+
+/** A bounding volume hierarchy over axis-aligned boxes.
+ *
+ *  The hierarchy is built top-down, splitting at the median along the
+ *  longest axis. When the items move, refit() updates the boxes in place
+ *  without changing the structure of the tree, which is far cheaper than
+ *  a full build but loosens the tree over time.
+ *
+ *  Items are identified by their index in the vector of boxes the
+ *  hierarchy was built from.
+ */
+class BVH {
+public:
+	/** An axis-aligned bounding box. */
+	struct Box {
+		float min[3];
+		float max[3];
+	};
+
+	BVH();
+	~BVH();
+
+	void clear();
+
+	bool empty() const;
+
+	/** Return the number of items in the hierarchy. */
+	size_t size() const;
+
+	/** Build the hierarchy anew over these boxes. */
+	void build(const std::vector<Box> &boxes);
+
+	/** Update the boxes of the items, keeping the hierarchy's structure.
+	 *
+	 *  The number of boxes has to be the same as in the last build().
+	 */
+	void refit(const std::vector<Box> &boxes);
+
+	/** Add all items whose boxes are at least partially inside the frustum. */
+	void findVisible(const Frustum &frustum, std::vector<size_t> &items) const;
+
+	/** Add all items whose boxes intersect the line segment from start to end. */
+	void findIntersecting(const float start[3], const float end[3], std::vector<size_t> &items) const;
+
+private:
+	static const size_t kMaxLeafItems = 4;
+
+	struct Node {
+		Box box;
+
+		uint32 first; ///< Index of the node's first item in _items.
+		uint32 count; ///< Number of items below this node.
+
+		uint32 left;  ///< Index of the left child, 0 for leaf nodes.
+		uint32 right; ///< Index of the right child, 0 for leaf nodes.
+	};
+
+	std::vector<Node>   _nodes; ///< All nodes, parents always before their children.
+	std::vector<uint32> _items; ///< Item indices, ordered so that each node's items are adjacent.
+	std::vector<Box>    _boxes; ///< The boxes of all items.
+
+	uint32 buildNode(std::vector<float> &centers, uint32 first, uint32 count);
+	void refitNode(Node &node) const;
+};
+
+} // End of namespace Graphics
+
+#endif // GRAPHICS_BVH_H
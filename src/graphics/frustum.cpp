@@ -0,0 +1,102 @@
+/* xoreos - A reimplementation of BioWare's Aurora engine
+ *
+ * xoreos is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * xoreos is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * xoreos is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with xoreos. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  A view frustum, for culling.
+ */
+
+#include <cmath>
+
+#include "src/graphics/frustum.h"
+
+namespace Graphics {
+
+Frustum::Frustum() {
+	// Without a matrix, the frustum contains everything
+	for (int i = 0; i < 6; i++) {
+		_planes[i][0] = 0.0f;
+		_planes[i][1] = 0.0f;
+		_planes[i][2] = 0.0f;
+		_planes[i][3] = 1.0f;
+	}
+}
+
+Frustum::Frustum(const glm::mat4 &matrix) {
+	set(matrix);
+}
+
+Frustum::~Frustum() {
+}
+
+void Frustum::set(const glm::mat4 &matrix) {
+	/* Each plane is the sum or difference of the fourth row of the matrix
+	 * and one of the other rows (Gribb & Hartmann). glm matrices are
+	 * column-major, so row r is (m[0][r], m[1][r], m[2][r], m[3][r]). */
+
+	for (int i = 0; i < 6; i++) {
+		const int   row  = i / 2;
+		const float sign = (i % 2) ? -1.0f : 1.0f;
+
+		for (int j = 0; j < 4; j++)
+			_planes[i][j] = matrix[j][3] + sign * matrix[j][row];
+
+		const float length = std::sqrt(_planes[i][0] * _planes[i][0] +
+		                               _planes[i][1] * _planes[i][1] +
+		                               _planes[i][2] * _planes[i][2]);
+
+		if (length > 0.0f)
+			for (int j = 0; j < 4; j++)
+				_planes[i][j] /= length;
+	}
+}
+
+bool Frustum::isIn(const float min[3], const float max[3]) const {
+	return intersect(min, max) != kOutside;
+}
+
+Frustum::Intersection Frustum::intersect(const float min[3], const float max[3]) const {
+	Intersection result = kInside;
+
+	for (int i = 0; i < 6; i++) {
+		const float *plane = _planes[i];
+
+		// The corners furthest along and furthest against the plane normal
+		float pDist = plane[3], nDist = plane[3];
+		for (int j = 0; j < 3; j++) {
+			if (plane[j] >= 0.0f) {
+				pDist += plane[j] * max[j];
+				nDist += plane[j] * min[j];
+			} else {
+				pDist += plane[j] * min[j];
+				nDist += plane[j] * max[j];
+			}
+		}
+
+		if (pDist < 0.0f)
+			return kOutside;
+
+		if (nDist < 0.0f)
+			result = kIntersecting;
+	}
+
+	return result;
+}
+
+} // End of namespace Graphics
@@ -0,0 +1,66 @@
+/* xoreos - A reimplementation of BioWare's Aurora engine
+ *
+ * xoreos is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * xoreos is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * xoreos is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with xoreos. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  A view frustum, for culling.
+ */
+
+#ifndef GRAPHICS_FRUSTUM_H
+#define GRAPHICS_FRUSTUM_H
+
+#include "glm/mat4x4.hpp"
+
+namespace Graphics {
+
+/** The six clipping planes of a view frustum.
+ *
+ *  The planes are extracted from a combined projection and modelview
+ *  matrix, so all tests are done in world coordinates.
+ */
+class Frustum {
+public:
+	/** How a volume relates to the frustum. */
+	enum Intersection {
+		kOutside,      ///< Completely outside the frustum.
+		kIntersecting, ///< Partially inside the frustum.
+		kInside        ///< Completely inside the frustum.
+	};
+
+	Frustum();
+	Frustum(const glm::mat4 &matrix);
+	~Frustum();
+
+	/** Extract the planes from a projection * modelview matrix. */
+	void set(const glm::mat4 &matrix);
+
+	/** Is any part of this axis-aligned box inside the frustum? */
+	bool isIn(const float min[3], const float max[3]) const;
+
+	/** Check how this axis-aligned box relates to the frustum. */
+	Intersection intersect(const float min[3], const float max[3]) const;
+
+private:
+	/** Plane normals and distances. A point p is inside if n.p + d >= 0 for all planes. */
+	float _planes[6][4];
+};
+
+} // End of namespace Graphics
+
+#endif // GRAPHICS_FRUSTUM_H
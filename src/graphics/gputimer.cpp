@@ -0,0 +1,127 @@
+/* xoreos - A reimplementation of BioWare's Aurora engine
+ *
+ * xoreos is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * xoreos is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * xoreos is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with xoreos. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  Measuring the GPU time of frames with timer queries.
+ */
+
+#include "src/common/frametimes.h"
+
+#include "src/graphics/gputimer.h"
+
+namespace Graphics {
+
+GPUTimer::GPUTimer() : _enabled(false), _created(false), _currentFrame(0), _inFrame(false) {
+	for (size_t i = 0; i < kFrameCount; i++) {
+		_queries[i][0] = _queries[i][1] = 0;
+		_pending[i] = false;
+		_frames [i] = 0;
+	}
+}
+
+GPUTimer::~GPUTimer() {
+}
+
+void GPUTimer::setEnabled(bool enabled) {
+	_enabled.store(enabled);
+}
+
+void GPUTimer::create() {
+	for (size_t i = 0; i < kFrameCount; i++) {
+		glGenQueries(2, _queries[i]);
+		_pending[i] = false;
+	}
+
+	_currentFrame = 0;
+	_created = true;
+}
+
+void GPUTimer::destroy() {
+	if (!_created)
+		return;
+
+	for (size_t i = 0; i < kFrameCount; i++) {
+		glDeleteQueries(2, _queries[i]);
+
+		_queries[i][0] = _queries[i][1] = 0;
+		_pending[i] = false;
+	}
+
+	_created = false;
+	_inFrame = false;
+}
+
+void GPUTimer::collect(size_t frame) {
+	if (!_pending[frame])
+		return;
+
+	GLint available = 0;
+	glGetQueryObjectiv(_queries[frame][1], GL_QUERY_RESULT_AVAILABLE, &available);
+	if (!available)
+		return;
+
+	GLuint64 start = 0, end = 0;
+	glGetQueryObjectui64v(_queries[frame][0], GL_QUERY_RESULT, &start);
+	glGetQueryObjectui64v(_queries[frame][1], GL_QUERY_RESULT, &end);
+
+	_pending[frame] = false;
+
+	if (end > start)
+		FrameTimesMan.addTime(_frames[frame], Common::kFramePhaseGPU, (end - start) / 1000);
+}
+
+void GPUTimer::beginFrame() {
+	_inFrame = false;
+
+	if (!_enabled.load() || !GLEW_ARB_timer_query) {
+		destroy();
+		return;
+	}
+
+	if (!_created)
+		create();
+
+	// Pick up the results of all older frames that are done by now
+	for (size_t i = 0; i < kFrameCount; i++)
+		collect(i);
+
+	// Still waiting for the results the last time we used this pair? Skip this frame then
+	if (_pending[_currentFrame])
+		return;
+
+	glQueryCounter(_queries[_currentFrame][0], GL_TIMESTAMP);
+	_frames[_currentFrame] = FrameTimesMan.getCurrentFrame();
+
+	_inFrame = true;
+}
+
+void GPUTimer::endFrame() {
+	if (!_inFrame)
+		return;
+
+	glQueryCounter(_queries[_currentFrame][1], GL_TIMESTAMP);
+
+	_pending[_currentFrame] = true;
+	_currentFrame = (_currentFrame + 1) % kFrameCount;
+
+	_inFrame = false;
+}
+
+} // End of namespace Graphics
@@ -0,0 +1,80 @@
+/* xoreos - A reimplementation of BioWare's Aurora engine
+ *
+ * xoreos is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * xoreos is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * xoreos is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with xoreos. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  Measuring the GPU time of frames with timer queries.
+ */
+
+#ifndef GRAPHICS_GPUTIMER_H
+#define GRAPHICS_GPUTIMER_H
+
+#include "src/common/atomic.h"
+
+#include "src/graphics/types.h"
+
+namespace Graphics {
+
+/** Measures how long the GPU takes for each frame, using GL_TIMESTAMP queries.
+ *
+ *  Query results are only read back a few frames later, once they are
+ *  available, so measuring never stalls the pipeline. The results are
+ *  added to the global frame times as the GPU phase, of the frame they
+ *  were measured in.
+ *
+ *  Needs GL_ARB_timer_query. Without it, nothing is measured.
+ */
+class GPUTimer {
+public:
+	GPUTimer();
+	~GPUTimer();
+
+	/** Enable or disable the measuring. Can be called from any thread. */
+	void setEnabled(bool enabled);
+
+	/** Mark the start of a frame. Must be called from the render thread. */
+	void beginFrame();
+	/** Mark the end of a frame. Must be called from the render thread. */
+	void endFrame();
+
+	/** Delete all queries. Must be called from the render thread. */
+	void destroy();
+
+private:
+	/** Number of frames a query can be in flight. */
+	static const size_t kFrameCount = 4;
+
+	boost::atomic<bool> _enabled;
+
+	bool _created; ///< Were the queries created?
+
+	GLuint _queries[kFrameCount][2]; ///< Start and end timestamp queries for each frame.
+	bool   _pending[kFrameCount];    ///< Are we still waiting for the results of this frame?
+	uint64 _frames [kFrameCount];    ///< The number of the frame measured by each query pair.
+
+	size_t _currentFrame; ///< The query pair of the frame currently being rendered.
+	bool   _inFrame;      ///< Did we issue the start query of the current frame?
+
+	void create();
+	void collect(size_t frame);
+};
+
+} // End of namespace Graphics
+
+#endif // GRAPHICS_GPUTIMER_H
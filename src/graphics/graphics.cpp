@@ -25,6 +25,8 @@
 #include <cassert>
 #include <cstring>
 
+#include <algorithm>
+
 #include <boost/bind.hpp>
 
 #include "glm/gtc/type_ptr.hpp"
@@ -38,6 +40,7 @@
 #include "src/common/configman.h"
 #include "src/common/debugman.h"
 #include "src/common/threads.h"
+#include "src/common/frametimes.h"
 
 #include "src/events/requests.h"
 #include "src/events/events.h"
@@ -51,6 +54,7 @@
 #include "src/graphics/glcontainer.h"
 #include "src/graphics/renderable.h"
 #include "src/graphics/camera.h"
+#include "src/graphics/frustum.h"
 
 #include "src/graphics/images/decoder.h"
 #include "src/graphics/images/screenshot.h"
@@ -60,12 +64,20 @@
 #include "src/graphics/shader/surfaceman.h"
 #include "src/graphics/mesh/meshman.h"
 
+#include "src/graphics/aurora/textureman.h"
+
 DECLARE_SINGLETON(Graphics::GraphicsManager)
 
 static glm::mat4 inverse(const glm::mat4 &m);
 
 namespace Graphics {
 
+/** How long to sleep at most while waiting for the end of a frame, in milliseconds. */
+static const uint32 kFrameEndTimeout = 5;
+
+/** Time the render thread may spend uploading new textures each frame, in microseconds. */
+static const uint64 kTextureUploadBudget = 4000;
+
 PFNGLCOMPRESSEDTEXIMAGE2DPROC glCompressedTexImage2D;
 
 GraphicsManager::GraphicsManager() : Events::Notifyable() {
@@ -97,6 +109,7 @@ GraphicsManager::GraphicsManager() : Events::Notifyable() {
 	_fpsCounter.reset(new FPSCounter(3));
 
 	_frameLock.store(0);
+	_frameCount.store(0);
 
 	_cursor = 0;
 
@@ -108,6 +121,10 @@ GraphicsManager::GraphicsManager() : Events::Notifyable() {
 
 	_lastSampled = 0;
 
+	_textureUploadTime = 0;
+
+	_worldBVHGeneration = 0;
+
 	glCompressedTexImage2D = 0;
 }
 
@@ -146,6 +163,10 @@ void GraphicsManager::init() {
 	MaterialMan.init();
 	MeshMan.init();
 
+	FrameTimesMan.reset();
+
+	TextureMan.setStreamingBudget(MAX(ConfigMan.getInt("texturebudget", 1024), 0) * (size_t) (1024 * 1024));
+
 	_animationThread.createThread();
 
 	_ready = true;
@@ -162,6 +183,8 @@ void GraphicsManager::deinit() {
 	_animationThread.pause();
 	_animationThread.destroyThread();
 
+	_gpuTimer.destroy();
+
 	MeshMan.deinit();
 	MaterialMan.deinit();
 	SurfaceMan.deinit();
@@ -199,6 +222,10 @@ uint32 GraphicsManager::getFPS() const {
 	return _fpsCounter->getFPS();
 }
 
+void GraphicsManager::setGPUTiming(bool enabled) {
+	_gpuTimer.setEnabled(enabled);
+}
+
 bool GraphicsManager::setFSAA(int level) {
 	// Force calling it from the main thread
 	if (!Common::isMainThread()) {
@@ -698,8 +725,13 @@ void GraphicsManager::lockFrame() {
 	if (Common::isMainThread() || EventMan.quitRequested() || (lock > 0))
 		return;
 
-	_frameEndSignal.store(false, boost::memory_order_release);
-	while (!_frameEndSignal.load(boost::memory_order_acquire));
+	/* Sleep instead of spinning, so we don't steal the CPU from the render
+	 * thread and the animation workers. The render thread signals without
+	 * taking a lock, so a wakeup can get lost; the timeout covers that. */
+
+	const uint32 frame = _frameCount.load(boost::memory_order_acquire);
+	while ((_frameCount.load(boost::memory_order_acquire) == frame) && !EventMan.quitRequested())
+		_frameEnd.wait(kFrameEndTimeout);
 }
 
 void GraphicsManager::unlockFrame() {
@@ -824,7 +856,7 @@ Renderable *GraphicsManager::getGUIObjectAt(float x, float y) const {
 	return object;
 }
 
-Renderable *GraphicsManager::getWorldObjectAt(float x, float y) const {
+Renderable *GraphicsManager::getWorldObjectAt(float x, float y) {
 	if (QueueMan.isQueueEmpty(kQueueVisibleWorldObject))
 		return 0;
 
@@ -835,23 +867,36 @@ Renderable *GraphicsManager::getWorldObjectAt(float x, float y) const {
 	if (!unproject(x, y, x1, y1, z1, x2, y2, z2))
 		return 0;
 
+	const float start[3] = { x1, y1, z1 };
+	const float end  [3] = { x2, y2, z2 };
+
 	Renderable *object = 0;
 
 	QueueMan.lockQueue(kQueueVisibleWorldObject);
 	const std::list<Queueable *> &objects = QueueMan.getQueue(kQueueVisibleWorldObject);
 
-	for (std::list<Queueable *>::const_iterator o = objects.begin(); o != objects.end(); ++o) {
-		Renderable &r = static_cast<Renderable &>(**o);
+	// Only check the objects whose bounding boxes the line goes through
+	updateWorldBVH(objects);
+
+	_worldBVHPicked.clear();
+	_worldBVH.findIntersecting(start, end, _worldBVHPicked);
+
+	// The candidates come in no particular order, so look for the closest one
+	std::sort(_worldBVHPicked.begin(), _worldBVHPicked.end());
+
+	for (std::vector<size_t>::const_iterator p = _worldBVHPicked.begin(); p != _worldBVHPicked.end(); ++p) {
+		Renderable &r = *_worldBVHObjects[*p];
 
 		if (!r.isClickable())
 			// Object isn't clickable, don't check
 			continue;
 
-		// If the line intersects with the object, return it
-		if (r.isIn(x1, y1, z1, x2, y2, z2)) {
+		if (object && (object->getDistance() <= r.getDistance()))
+			continue;
+
+		// If the line intersects with the object, remember it
+		if (r.isIn(x1, y1, z1, x2, y2, z2))
 			object = &r;
-			break;
-		}
 	}
 
 	QueueMan.unlockQueue(kQueueVisibleWorldObject);
@@ -871,26 +916,90 @@ Renderable *GraphicsManager::getObjectAt(float x, float y) {
 }
 
 void GraphicsManager::buildNewTextures() {
+	/* Textures are decoded in the background, and a freshly loaded area can
+	 * queue hundreds of them at once. Only upload as many as fit into this
+	 * frame's time budget. The budget is checked before each upload, so at
+	 * least one texture is uploaded every frame.
+	 * The queue stays locked, so that no texture vanishes while uploading. */
+
 	QueueMan.lockQueue(kQueueNewTexture);
-	const std::list<Queueable *> &text = QueueMan.getQueue(kQueueNewTexture);
-	if (text.empty()) {
-		QueueMan.unlockQueue(kQueueNewTexture);
-		return;
-	}
 
-	for (std::list<Queueable *>::const_iterator t = text.begin(); t != text.end(); ++t)
-		static_cast<GLContainer *>(*t)->rebuild();
+	while (_textureUploadTime < kTextureUploadBudget) {
+		const uint64 start = Common::FrameTimes::getMicroseconds();
+
+		GLContainer *texture = static_cast<GLContainer *>(QueueMan.takeFromQueue(kQueueNewTexture));
+		if (!texture)
+			break;
+
+		texture->rebuild();
+
+		_textureUploadTime += Common::FrameTimes::getMicroseconds() - start;
+	}
 
-	QueueMan.clearQueue(kQueueNewTexture);
 	QueueMan.unlockQueue(kQueueNewTexture);
 }
 
+void GraphicsManager::updateWorldBVH(const std::list<Queueable *> &objects) {
+	/* The hierarchy is only rebuilt when objects are shown or hidden. When
+	 * they merely move, the boxes are refit into the existing hierarchy. */
+
+	const uint32 generation = QueueMan.getQueueGeneration(kQueueVisibleWorldObject);
+	const bool   rebuild    = (generation != _worldBVHGeneration) || (objects.size() != _worldBVHObjects.size());
+
+	if (rebuild) {
+		_worldBVHObjects.clear();
+		_worldBVHObjects.reserve(objects.size());
+
+		for (std::list<Queueable *>::const_iterator o = objects.begin(); o != objects.end(); ++o)
+			_worldBVHObjects.push_back(static_cast<Renderable *>(*o));
+	}
+
+	// Objects without a bounding box get one that's always visible
+	static const float kUnbounded = 1.0e30f;
+
+	_worldBVHBoxes.resize(_worldBVHObjects.size());
+	for (size_t i = 0; i < _worldBVHObjects.size(); i++) {
+		Renderable &object = *_worldBVHObjects[i];
+		BVH::Box   &box    = _worldBVHBoxes[i];
+
+		if (!object.getBounds(box.min, box.max)) {
+			for (int j = 0; j < 3; j++) {
+				box.min[j] = -kUnbounded;
+				box.max[j] =  kUnbounded;
+			}
+		}
+	}
+
+	if (rebuild) {
+		_worldBVH.build(_worldBVHBoxes);
+		_worldBVHGeneration = generation;
+	} else
+		_worldBVH.refit(_worldBVHBoxes);
+}
+
+void GraphicsManager::cullWorld(const std::list<Queueable *> &objects) {
+	updateWorldBVH(objects);
+
+	for (std::vector<Renderable *>::iterator o = _worldBVHObjects.begin(); o != _worldBVHObjects.end(); ++o)
+		(*o)->_culled = true;
+
+	_worldBVHVisible.clear();
+	_worldBVH.findVisible(Frustum(_projection * _modelview), _worldBVHVisible);
+
+	for (std::vector<size_t>::const_iterator v = _worldBVHVisible.begin(); v != _worldBVHVisible.end(); ++v)
+		_worldBVHObjects[*v]->_culled = false;
+}
+
 void GraphicsManager::beginScene() {
 	WindowMan.beginScene();
 
 	if (_fsaa > 0)
 		glEnable(GL_MULTISAMPLE_ARB);
 
+	_gpuTimer.beginFrame();
+
+	_textureUploadTime = 0;
+
 	// Clear
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
@@ -901,6 +1010,8 @@ bool GraphicsManager::playVideo() {
 	if (QueueMan.isQueueEmpty(kQueueVisibleVideo))
 		return false;
 
+	Common::FrameTimer timer(FrameTimesMan, Common::kFramePhaseVideo);
+
 	glMatrixMode(GL_PROJECTION);
 	glLoadIdentity();
 	glScalef(2.0f / WindowMan.getWindowWidth(), 2.0f / WindowMan.getWindowHeight(), 0.0f);
@@ -925,6 +1036,8 @@ bool GraphicsManager::renderWorld() {
 	if (QueueMan.isQueueEmpty(kQueueVisibleWorldObject))
 		return false;
 
+	Common::FrameTimer timer(FrameTimesMan, Common::kFramePhaseWorld);
+
 	float cPos[3];
 	float cOrient[3];
 
@@ -958,14 +1071,18 @@ bool GraphicsManager::renderWorld() {
 
 	buildNewTextures();
 
-	_animationThread.flush();
+	cullWorld(objects);
 
 	// Draw opaque objects
 	for (std::list<Queueable *>::const_reverse_iterator o = objects.rbegin();
 	     o != objects.rend(); ++o) {
 
+		Renderable &object = static_cast<Renderable &>(**o);
+		if (object._culled)
+			continue;
+
 		glPushMatrix();
-		static_cast<Renderable *>(*o)->render(kRenderPassOpaque);
+		object.render(kRenderPassOpaque);
 		glPopMatrix();
 	}
 
@@ -973,8 +1090,12 @@ bool GraphicsManager::renderWorld() {
 	for (std::list<Queueable *>::const_reverse_iterator o = objects.rbegin();
 	     o != objects.rend(); ++o) {
 
+		Renderable &object = static_cast<Renderable &>(**o);
+		if (object._culled)
+			continue;
+
 		glPushMatrix();
-		static_cast<Renderable *>(*o)->render(kRenderPassTransparent);
+		object.render(kRenderPassTransparent);
 		glPopMatrix();
 	}
 
@@ -983,6 +1104,8 @@ bool GraphicsManager::renderWorld() {
 }
 
 bool GraphicsManager::renderGUIFront() {
+	Common::FrameTimer timer(FrameTimesMan, Common::kFramePhaseGUI);
+
 	return renderGUI(_scalingType, kQueueVisibleGUIFrontObject, false);
 }
 
@@ -1059,6 +1182,8 @@ bool GraphicsManager::renderCursor() {
 }
 
 void GraphicsManager::endScene() {
+	_gpuTimer.endFrame();
+
 	WindowMan.endScene();
 
 	if (_takeScreenshot) {
@@ -1067,6 +1192,7 @@ void GraphicsManager::endScene() {
 	}
 
 	_fpsCounter->finishedFrame();
+	FrameTimesMan.finishedFrame();
 
 	if (_fsaa > 0)
 		glDisable(GL_MULTISAMPLE_ARB);
@@ -1078,13 +1204,15 @@ void GraphicsManager::renderScene() {
 	cleanupAbandoned();
 
 	if (EventMan.quitRequested() || (_frameLock.load(boost::memory_order_acquire) > 0)) {
-		_frameEndSignal.store(true, boost::memory_order_release);
+		signalFrameEnd();
 
 		return;
 	}
 
 	beginScene();
 
+	TextureMan.updateStreaming();
+
 	if (playVideo()) {
 		endScene();
 		return;
@@ -1098,7 +1226,13 @@ void GraphicsManager::renderScene() {
 
 	endScene();
 
-	_frameEndSignal.store(true, boost::memory_order_release);
+	signalFrameEnd();
+}
+
+void GraphicsManager::signalFrameEnd() {
+	_frameCount.fetch_add(1, boost::memory_order_release);
+	// Several threads might be waiting in lockFrame()
+	_frameEnd.broadcast();
 }
 
 const glm::mat4 &GraphicsManager::getProjectionMatrix() const {
@@ -1169,6 +1303,8 @@ void GraphicsManager::destroyContext() {
 	// Destroying all GL containers, since we need to
 	// reload/rebuild them anyway when the context is recreated
 	destroyGLContainers();
+
+	_gpuTimer.destroy();
 }
 
 void GraphicsManager::rebuildContext() {
@@ -40,6 +40,8 @@
 
 #include "src/graphics/types.h"
 #include "src/graphics/windowman.h"
+#include "src/graphics/bvh.h"
+#include "src/graphics/gputimer.h"
 
 #include "src/graphics/aurora/animationthread.h"
 
@@ -53,6 +55,7 @@ namespace Aurora {
 
 class FPSCounter;
 class Cursor;
+class Queueable;
 class Renderable;
 
 /** The graphics manager. */
@@ -93,6 +96,9 @@ public:
 	/** How many frames per second to we render at the moments? */
 	uint32 getFPS() const;
 
+	/** Enable/Disable measuring the GPU time of each frame. */
+	void setGPUTiming(bool enabled);
+
 	/** Enable/Disable face culling. */
 	void setCullFace(bool enabled, GLenum mode = GL_BACK);
 
@@ -215,15 +221,20 @@ private:
 
 	Common::ScopedPtr<FPSCounter> _fpsCounter; ///< Counts the current frames per seconds value.
 
+	GPUTimer _gpuTimer; ///< Measures the GPU time of each frame.
+
 	uint32 _lastSampled; ///< Timestamp used to advance animations.
 
+	uint64 _textureUploadTime; ///< Time spent uploading new textures this frame, in microseconds.
+
 	glm::mat4 _projection;    ///< Our projection matrix.
 	glm::mat4 _projectionInv; ///< The inverse of our projection matrix.
 	glm::mat4 _modelview;     ///< Our base modelview matrix (i.e camera view).
 	glm::mat4 _modelviewInv;  ///< The inverse of our modelview matrix.
 
 	boost::atomic<uint32> _frameLock;
-	boost::atomic<bool>   _frameEndSignal;
+	boost::atomic<uint32> _frameCount; ///< Number of frames the render thread finished.
+	Common::Condition     _frameEnd;   ///< Signalled whenever the render thread finishes a frame.
 
 	Cursor     *_cursor;       ///< The current cursor.
 
@@ -241,6 +252,14 @@ private:
 
 	Aurora::AnimationThread _animationThread;
 
+	BVH    _worldBVH;           ///< Bounding volume hierarchy over the visible world objects.
+	uint32 _worldBVHGeneration; ///< The world object queue generation the hierarchy was built for.
+
+	std::vector<Renderable *> _worldBVHObjects; ///< The world objects in the hierarchy.
+	std::vector<BVH::Box>     _worldBVHBoxes;   ///< The bounding boxes of the world objects.
+	std::vector<size_t>       _worldBVHVisible; ///< The world objects within the view frustum.
+	std::vector<size_t>       _worldBVHPicked;  ///< The world objects under the mouse cursor.
+
 	void setupScene();
 
 	bool setupSDLGL();
@@ -260,10 +279,15 @@ private:
 	void cleanupAbandoned();
 
 	Renderable *getGUIObjectAt(float x, float y) const;
-	Renderable *getWorldObjectAt(float x, float y) const;
+	Renderable *getWorldObjectAt(float x, float y);
 
 	void buildNewTextures();
 
+	/** Bring the world object hierarchy up to date. The world object queue has to be locked. */
+	void updateWorldBVH(const std::list<Queueable *> &objects);
+	/** Mark all world objects outside the view frustum as culled. */
+	void cullWorld(const std::list<Queueable *> &objects);
+
 	void beginScene();
 	bool playVideo();
 	bool renderWorld();
@@ -273,6 +297,8 @@ private:
 	bool renderGUI(ScalingType scalingType, QueueType guiQueue, bool disableDepthMask);
 	bool renderCursor();
 	void endScene();
+	/** Wake up all threads waiting in lockFrame() for the end of the frame. */
+	void signalFrameEnd();
 
 	void notifyResized(int oldWidth, int oldHeight, int newWidth, int newHeight);
 };
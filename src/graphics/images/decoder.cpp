@@ -24,10 +24,9 @@
 
 #include <cassert>
 
-#include "src/common/scopedptr.h"
 #include "src/common/util.h"
 #include "src/common/error.h"
-#include "src/common/memreadstream.h"
+#include "src/common/parallelfor.h"
 
 #include "src/graphics/graphics.h"
 
@@ -212,7 +211,7 @@ const ImageDecoder::MipMap &ImageDecoder::getMipMap(size_t mipMap, size_t layer)
 	return *_mipMaps[index];
 }
 
-void ImageDecoder::decompress(MipMap &out, const MipMap &in, PixelFormatRaw format) {
+void ImageDecoder::decompress(MipMap &out, const MipMap &in, PixelFormatRaw format, Common::ThreadPool *pool) {
 	if ((format != kPixelFormatDXT1) &&
 	    (format != kPixelFormatDXT3) &&
 	    (format != kPixelFormatDXT5))
@@ -229,36 +228,80 @@ void ImageDecoder::decompress(MipMap &out, const MipMap &in, PixelFormatRaw form
 
 	out.data.reset(new byte[out.size]);
 
-	Common::ScopedPtr<Common::MemoryReadStream> stream(new Common::MemoryReadStream(in.data.get(), in.size));
-
 	if      (format == kPixelFormatDXT1)
-		decompressDXT1(out.data.get(), *stream, out.width, out.height, out.width * 4);
+		decompressDXT1(out.data.get(), in.data.get(), in.size, out.width, out.height, out.width * 4, pool);
 	else if (format == kPixelFormatDXT3)
-		decompressDXT3(out.data.get(), *stream, out.width, out.height, out.width * 4);
+		decompressDXT3(out.data.get(), in.data.get(), in.size, out.width, out.height, out.width * 4, pool);
 	else if (format == kPixelFormatDXT5)
-		decompressDXT5(out.data.get(), *stream, out.width, out.height, out.width * 4);
+		decompressDXT5(out.data.get(), in.data.get(), in.size, out.width, out.height, out.width * 4, pool);
 }
 
-void ImageDecoder::decompress() {
-	if (!_compressed)
-		return;
+/** Decompresses one mip map of an image in each iteration. */
+class ImageDecoder::DecompressBody : public Common::ParallelForBody {
+public:
+	DecompressBody(ImageDecoder &image, Common::ThreadPool *pool) : _image(&image), _pool(pool) {
+	}
+
+	void run(size_t index) {
+		MipMap &mipMap = *_image->_mipMaps[index];
 
-	for (MipMaps::iterator m = _mipMaps.begin(); m != _mipMaps.end(); ++m) {
-		MipMap decompressed(this);
+		MipMap decompressed(_image);
 
-		decompress(decompressed, **m, _formatRaw);
+		decompress(decompressed, mipMap, _image->_formatRaw, _pool);
 
-		decompressed.swap(**m);
+		decompressed.swap(mipMap);
 	}
 
+private:
+	ImageDecoder *_image;
+	Common::ThreadPool *_pool;
+};
+
+void ImageDecoder::decompress(Common::ThreadPool *pool) {
+	if (!_compressed)
+		return;
+
+	/* All mip maps and cube sides are decompressed side by side, and the
+	 * larger ones are additionally split into rows of blocks. */
+	DecompressBody body(*this, pool);
+	Common::parallelFor(pool, 0, _mipMaps.size(), body);
+
 	_format     = kPixelFormatRGBA;
 	_formatRaw  = kPixelFormatRGBA8;
 	_dataType   = kPixelDataType8;
 	_compressed = false;
 }
 
+void ImageDecoder::unloadMipMaps(size_t count) {
+	const size_t mipMapCount = getMipMapCount();
+
+	for (size_t i = 0; i < _layerCount; i++)
+		for (size_t j = 0; (j < count) && (j < mipMapCount); j++)
+			_mipMaps[i * mipMapCount + j]->data.reset();
+}
+
+bool ImageDecoder::reloadMipMaps(ImageDecoder &image, size_t count) {
+	if ((image._formatRaw  != _formatRaw)  || (image._layerCount != _layerCount) ||
+	    (image._mipMaps.size() != _mipMaps.size()))
+		return false;
+
+	for (size_t i = 0; i < _mipMaps.size(); i++)
+		if ((image._mipMaps[i]->width  != _mipMaps[i]->width ) ||
+		    (image._mipMaps[i]->height != _mipMaps[i]->height) ||
+		    (image._mipMaps[i]->size   != _mipMaps[i]->size  ))
+			return false;
+
+	const size_t mipMapCount = getMipMapCount();
+
+	for (size_t i = 0; i < _layerCount; i++)
+		for (size_t j = 0; (j < count) && (j < mipMapCount); j++)
+			_mipMaps[i * mipMapCount + j]->data.swap(image._mipMaps[i * mipMapCount + j]->data);
+
+	return true;
+}
+
 bool ImageDecoder::dumpTGA(const Common::UString &fileName) const {
-	if (_mipMaps.size() < 1)
+	if ((_mipMaps.size() < 1) || !_mipMaps[0]->data)
 		return false;
 
 	if (!_compressed) {
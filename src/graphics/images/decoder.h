@@ -40,6 +40,7 @@
 namespace Common {
 	class SeekableReadStream;
 	class UString;
+	class ThreadPool;
 }
 
 namespace Graphics {
@@ -104,8 +105,22 @@ public:
 	/** Return a mip map. */
 	const MipMap &getMipMap(size_t mipMap, size_t layer = 0) const;
 
-	/** Manually decompress the texture image data. */
-	void decompress();
+	/** Manually decompress the texture image data.
+	 *
+	 *  If a thread pool is given, each image is decompressed by its workers.
+	 */
+	void decompress(Common::ThreadPool *pool = 0);
+
+	/** Free the data of the largest count mip maps in each layer, to save memory.
+	 *
+	 *  The mip maps keep their dimensions, but their data is empty afterwards.
+	 */
+	void unloadMipMaps(size_t count);
+	/** Take over the data of the largest count mip maps in each layer from an identical image.
+	 *
+	 *  Return false if the two images don't match in format and dimensions.
+	 */
+	bool reloadMipMaps(ImageDecoder &image, size_t count);
 
 	/** Return the texture information TXI, which may be embedded in the image. */
 	const TXI &getTXI() const;
@@ -132,7 +147,10 @@ protected:
 
 	TXI _txi;
 
-	static void decompress(MipMap &out, const MipMap &in, PixelFormatRaw format);
+	static void decompress(MipMap &out, const MipMap &in, PixelFormatRaw format, Common::ThreadPool *pool);
+
+private:
+	class DecompressBody;
 };
 
 } // End of namespace Graphics
@@ -22,198 +22,223 @@
  *  Manual S3TC DXTn decompression methods.
  */
 
+/* Each DXTn block encodes 4x4 pixels. A block starts with 8 bytes of
+ * alpha data (DXT3 and DXT5 only), followed by 8 bytes of color data:
+ * two RGB565 end point colors and 2-bit indices into a palette of four
+ * colors interpolated from the two end points.
+ *
+ * The blocks are decoded with integer arithmetic straight out of the
+ * raw buffer, into a 4x4 RGBA8 tile that's then copied into the image.
+ * Rows of blocks are independent of each other, so they can be spread
+ * over the workers of a thread pool. */
+
+#include <cstring>
+
 #include "src/common/util.h"
-#include "src/common/readstream.h"
+#include "src/common/error.h"
+#include "src/common/parallelfor.h"
 
 #include "src/graphics/images/s3tc.h"
 
 namespace Graphics {
 
-static inline uint32 convert565To8888(uint16 color) {
-	return ((color & 0x1F) << 11) | ((color & 0x7E0) << 13) | ((color & 0xF800) << 16) | 0xFF;
+/** Minimum number of block rows decoded in one go by a thread pool worker. */
+static const uint32 kMinBlockRowsPerJob = 8;
+
+/** Expand a RGB565 color into RGBA8, replicating the high bits into the low ones. */
+static inline void expand565(uint16 color, byte *rgba) {
+	const uint32 r = (color >> 11) & 0x1F;
+	const uint32 g = (color >>  5) & 0x3F;
+	const uint32 b =  color        & 0x1F;
+
+	rgba[0] = (r << 3) | (r >> 2);
+	rgba[1] = (g << 2) | (g >> 4);
+	rgba[2] = (b << 3) | (b >> 2);
+	rgba[3] = 0xFF;
 }
 
-static inline uint32 interpolate32(double weight, uint32 color_0, uint32 color_1) {
-	byte r[3], g[3], b[3], a[3];
-	r[0] = color_0 >> 24;
-	r[1] = color_1 >> 24;
-	r[2] = (byte)((1.0f - weight) * (double)r[0] + weight * (double)r[1]);
-	g[0] = (color_0 >> 16) & 0xFF;
-	g[1] = (color_1 >> 16) & 0xFF;
-	g[2] = (byte)((1.0f - weight) * (double)g[0] + weight * (double)g[1]);
-	b[0] = (color_0 >> 8) & 0xFF;
-	b[1] = (color_1 >> 8) & 0xFF;
-	b[2] = (byte)((1.0f - weight) * (double)b[0] + weight * (double)b[1]);
-	a[0] = color_0 & 0xFF;
-	a[1] = color_1 & 0xFF;
-	a[2] = (byte)((1.0f - weight) * (double)a[0] + weight * (double)a[1]);
-	return r[2] << 24 | g[2] << 16 | b[2] << 8 | a[2];
+/** Decode the color part of a block into a 4x4 RGBA8 tile.
+ *
+ *  DXT1 blocks whose first end point isn't larger than the second have only
+ *  three colors, the fourth is transparent black. DXT3 and DXT5 blocks
+ *  always have four colors.
+ */
+static inline void decodeColors(const byte *src, byte *tile, bool hasTransparency) {
+	const uint16 color0 = READ_LE_UINT16(src);
+	const uint16 color1 = READ_LE_UINT16(src + 2);
+
+	byte colors[4][4];
+
+	expand565(color0, colors[0]);
+	expand565(color1, colors[1]);
+
+	if (!hasTransparency || (color0 > color1)) {
+		for (size_t i = 0; i < 3; i++) {
+			colors[2][i] = (2 * colors[0][i] +     colors[1][i]) / 3;
+			colors[3][i] = (    colors[0][i] + 2 * colors[1][i]) / 3;
+		}
+
+		colors[2][3] = 0xFF;
+		colors[3][3] = 0xFF;
+	} else {
+		for (size_t i = 0; i < 3; i++)
+			colors[2][i] = (colors[0][i] + colors[1][i]) / 2;
+
+		colors[2][3] = 0xFF;
+
+		std::memset(colors[3], 0, 4);
+	}
+
+	// One byte of indices for each row, with the first pixel in the lowest bits
+	for (size_t y = 0; y < 4; y++) {
+		uint32 indices = src[4 + y];
+
+		for (size_t x = 0; x < 4; x++, indices >>= 2, tile += 4)
+			std::memcpy(tile, colors[indices & 3], 4);
+	}
 }
 
-struct DXT1Texel {
-	uint16 color_0;
-	uint16 color_1;
-	uint32 pixels;
+/** A DXT1 block: only color data. */
+struct DXT1Block {
+	static const size_t kSize = 8;
+
+	static void decode(const byte *src, byte *tile) {
+		decodeColors(src, tile, true);
+	}
 };
 
-#define READ_DXT1_TEXEL(x) \
-	x.color_0 = src.readUint16LE(); \
-	x.color_1 = src.readUint16LE(); \
-	x.pixels = src.readUint32BE()
-
-void decompressDXT1(byte *dest, Common::SeekableReadStream &src, uint32 width, uint32 height, uint32 pitch) {
-	for (int32 ty = height; ty > 0; ty -= 4) {
-		for (uint32 tx = 0; tx < width; tx += 4) {
-			DXT1Texel tex;
-			READ_DXT1_TEXEL(tex);
-			uint32 blended[4];
-
-			blended[0] = convert565To8888(tex.color_0);
-			blended[1] = convert565To8888(tex.color_1);
-
-			if (tex.color_0 > tex.color_1) {
-				blended[2] = interpolate32(0.333333f, blended[0], blended[1]);
-				blended[3] = interpolate32(0.666666f, blended[0], blended[1]);
-			} else {
-				blended[2] = interpolate32(0.5f, blended[0], blended[1]);
-				blended[3] = 0;
-			}
-
-			uint32 cpx = tex.pixels;
-			uint32 blockWidth = MIN<uint32>(width, 4);
-			uint32 blockHeight = MIN<uint32>(height, 4);
-
-			for (byte y = 0; y < blockHeight; ++y) {
-				for (byte x = 0; x < blockWidth; ++x) {
-					const uint32 destX = tx + x;
-					const uint32 destY = height - 1 - (ty - blockHeight + y);
-
-					const uint32 pixel =  blended[cpx & 3];
-
-					cpx >>= 2;
-
-					if ((destX < width) && (destY < height))
-						WRITE_BE_UINT32(dest + destY * pitch + destX * 4, pixel);
-				}
-			}
+/** A DXT3 block: explicit 4-bit alpha values, followed by color data. */
+struct DXT3Block {
+	static const size_t kSize = 16;
+
+	static void decode(const byte *src, byte *tile) {
+		decodeColors(src + 8, tile, false);
+
+		// One 16-bit word of alpha values for each row, with the first pixel in the lowest bits
+		for (size_t y = 0; y < 4; y++) {
+			uint32 alpha = READ_LE_UINT16(src + 2 * y);
+
+			for (size_t x = 0; x < 4; x++, alpha >>= 4, tile += 4)
+				tile[3] = (alpha & 0xF) * 0x11;
 		}
 	}
-}
+};
+
+/** A DXT5 block: two alpha end points with 3-bit indices, followed by color data. */
+struct DXT5Block {
+	static const size_t kSize = 16;
+
+	static void decode(const byte *src, byte *tile) {
+		decodeColors(src + 8, tile, false);
+
+		const uint32 alpha0 = src[0];
+		const uint32 alpha1 = src[1];
+
+		byte alphas[8];
+
+		alphas[0] = alpha0;
+		alphas[1] = alpha1;
 
-struct DXT23Texel : public DXT1Texel {
-	uint16 alpha[4];
+		if (alpha0 > alpha1) {
+			for (uint32 i = 1; i < 7; i++)
+				alphas[i + 1] = ((7 - i) * alpha0 + i * alpha1 + 3) / 7;
+		} else {
+			for (uint32 i = 1; i < 5; i++)
+				alphas[i + 1] = ((5 - i) * alpha0 + i * alpha1 + 2) / 5;
+
+			alphas[6] = 0x00;
+			alphas[7] = 0xFF;
+		}
+
+		// 48 bits of indices, 3 bits per pixel, with the first pixel in the lowest bits
+		uint64 indices = READ_LE_UINT32(src + 2) | ((uint64) READ_LE_UINT16(src + 6) << 32);
+
+		for (size_t i = 0; i < 16; i++, indices >>= 3, tile += 4)
+			tile[3] = alphas[indices & 7];
+	}
 };
 
-#define READ_DXT3_TEXEL(x) \
-	x.alpha[0] = src.readUint16LE(); \
-	x.alpha[1] = src.readUint16LE(); \
-	x.alpha[2] = src.readUint16LE(); \
-	x.alpha[3] = src.readUint16LE(); \
-	READ_DXT1_TEXEL(x)
-
-void decompressDXT3(byte *dest, Common::SeekableReadStream &src, uint32 width, uint32 height, uint32 pitch) {
-	for (int32 ty = height; ty > 0; ty -= 4) {
-		for (uint32 tx = 0; tx < width; tx += 4) {
-			DXT23Texel tex;
-			uint32 blended[4];
-			READ_DXT3_TEXEL(tex);
-
-			blended[0] = convert565To8888(tex.color_0) & 0xFFFFFF00;
-			blended[1] = convert565To8888(tex.color_1) & 0xFFFFFF00;
-			blended[2] = interpolate32(0.333333f, blended[0], blended[1]);
-			blended[3] = interpolate32(0.666666f, blended[0], blended[1]);
-
-			uint32 cpx = tex.pixels;
-			uint32 blockWidth = MIN<uint32>(width, 4);
-			uint32 blockHeight = MIN<uint32>(height, 4);
-
-			for (byte y = 0; y < blockHeight; ++y) {
-				for (byte x = 0; x < blockWidth; ++x) {
-					const uint32 destX = tx + x;
-					const uint32 destY = height - 1 - (ty - blockHeight + y);
-
-					const uint32 alpha = (tex.alpha[y] >> (x * 4)) & 0xF;
-					const uint32 pixel = blended[cpx & 3] | alpha << 4;
-
-					cpx >>= 2;
-
-					if ((destX < width) && (destY < height))
-						WRITE_BE_UINT32(dest + destY * pitch + destX * 4, pixel);
-				}
-			}
+/** Decode a range of block rows. */
+template<typename Block>
+static void decompressRows(byte *dest, const byte *src, uint32 width, uint32 height, uint32 pitch,
+                           uint32 firstRow, uint32 lastRow) {
+
+	const uint32 blocksX = (width + 3) / 4;
+
+	src += firstRow * blocksX * Block::kSize;
+
+	byte tile[4 * 4 * 4];
+
+	for (uint32 by = firstRow; by < lastRow; by++) {
+		const uint32 y = by * 4;
+		const uint32 rows = MIN<uint32>(height - y, 4);
+
+		for (uint32 x = 0; x < width; x += 4, src += Block::kSize) {
+			Block::decode(src, tile);
+
+			// Only copy what's inside the image, for images smaller than a block
+			const uint32 rowSize = MIN<uint32>(width - x, 4) * 4;
+
+			byte *dst = dest + y * pitch + x * 4;
+			for (uint32 i = 0; i < rows; i++, dst += pitch)
+				std::memcpy(dst, tile + i * 4 * 4, rowSize);
 		}
 	}
 }
 
-struct DXT45Texel : public DXT1Texel {
-	byte alpha_0;
-	byte alpha_1;
-	uint64 alphabl;
+/** Decodes one row of blocks in each iteration. */
+template<typename Block>
+class DecompressBody : public Common::ParallelForBody {
+public:
+	DecompressBody(byte *dest, const byte *src, uint32 width, uint32 height, uint32 pitch) :
+		_dest(dest), _src(src), _width(width), _height(height), _pitch(pitch) {
+	}
+
+	void run(size_t row) {
+		decompressRows<Block>(_dest, _src, _width, _height, _pitch, row, row + 1);
+	}
+
+private:
+	byte *_dest;
+	const byte *_src;
+
+	uint32 _width;
+	uint32 _height;
+	uint32 _pitch;
 };
 
-static uint64 readUint48LE(Common::SeekableReadStream &src) {
-	uint64 output = src.readUint32LE();
-	return output | ((uint64)src.readUint16LE() << 32);
+template<typename Block>
+static void decompress(byte *dest, const byte *src, size_t size, uint32 width, uint32 height, uint32 pitch,
+                       Common::ThreadPool *pool) {
+
+	const uint32 blocksX = (width  + 3) / 4;
+	const uint32 blocksY = (height + 3) / 4;
+
+	const size_t needed = (size_t) blocksX * blocksY * Block::kSize;
+	if (size < needed)
+		throw Common::Exception("Not enough DXTn data for %ux%u pixels (%u < %u)",
+		                        width, height, (uint) size, (uint) needed);
+
+	DecompressBody<Block> body(dest, src, width, height, pitch);
+	Common::parallelFor(pool, 0, blocksY, body, kMinBlockRowsPerJob);
 }
 
-#define READ_DXT5_TEXEL(x) \
-	x.alpha_0 = src.readByte(); \
-	x.alpha_1 = src.readByte(); \
-	x.alphabl = readUint48LE(src); \
-	READ_DXT1_TEXEL(x)
-
-void decompressDXT5(byte *dest, Common::SeekableReadStream &src, uint32 width, uint32 height, uint32 pitch) {
-	for (int32 ty = height; ty > 0; ty -= 4) {
-		for (uint32 tx = 0; tx < width; tx += 4) {
-			uint32 blended[4];
-			byte alphab[8];
-			DXT45Texel tex;
-			READ_DXT5_TEXEL(tex);
-
-			alphab[0] = tex.alpha_0;
-			alphab[1] = tex.alpha_1;
-
-			if (tex.alpha_0 > tex.alpha_1) {
-				alphab[2] = (byte)((6.0f * (double)alphab[0] + 1.0f * (double)alphab[1] + 3.0f) / 7.0f);
-				alphab[3] = (byte)((5.0f * (double)alphab[0] + 2.0f * (double)alphab[1] + 3.0f) / 7.0f);
-				alphab[4] = (byte)((4.0f * (double)alphab[0] + 3.0f * (double)alphab[1] + 3.0f) / 7.0f);
-				alphab[5] = (byte)((3.0f * (double)alphab[0] + 4.0f * (double)alphab[1] + 3.0f) / 7.0f);
-				alphab[6] = (byte)((2.0f * (double)alphab[0] + 5.0f * (double)alphab[1] + 3.0f) / 7.0f);
-				alphab[7] = (byte)((1.0f * (double)alphab[0] + 6.0f * (double)alphab[1] + 3.0f) / 7.0f);
-			} else {
-				alphab[2] = (byte)((4.0f * (double)alphab[0] + 1.0f * (double)alphab[1] + 2.0f) / 5.0f);
-				alphab[3] = (byte)((3.0f * (double)alphab[0] + 2.0f * (double)alphab[1] + 2.0f) / 5.0f);
-				alphab[4] = (byte)((2.0f * (double)alphab[0] + 3.0f * (double)alphab[1] + 2.0f) / 5.0f);
-				alphab[5] = (byte)((1.0f * (double)alphab[0] + 4.0f * (double)alphab[1] + 2.0f) / 5.0f);
-				alphab[6] = 0;
-				alphab[7] = 255;
-			}
-
-			blended[0] = convert565To8888(tex.color_0) & 0xFFFFFF00;
-			blended[1] = convert565To8888(tex.color_1) & 0xFFFFFF00;
-			blended[2] = interpolate32(0.333333f, blended[0], blended[1]);
-			blended[3] = interpolate32(0.666666f, blended[0], blended[1]);
-
-			uint32 cpx = tex.pixels;
-			uint32 blockWidth = MIN<uint32>(width, 4);
-			uint32 blockHeight = MIN<uint32>(height, 4);
-
-			for (byte y = 0; y < blockHeight; ++y) {
-				for (byte x = 0; x < blockWidth; ++x) {
-					const uint32 destX = tx + x;
-					const uint32 destY = height - 1 - (ty - blockHeight + y);
-
-					const uint32 alpha = alphab[(tex.alphabl >> (3 * (4 * (3 - y) + x))) & 7];
-					const uint32 pixel = blended[cpx & 3] | alpha;
-
-					cpx >>= 2;
-
-					if ((destX < width) && (destY < height))
-						WRITE_BE_UINT32(dest + destY * pitch + destX * 4, pixel);
-				}
-			}
-		}
-	}
+void decompressDXT1(byte *dest, const byte *src, size_t size, uint32 width, uint32 height, uint32 pitch,
+                    Common::ThreadPool *pool) {
+
+	decompress<DXT1Block>(dest, src, size, width, height, pitch, pool);
+}
+
+void decompressDXT3(byte *dest, const byte *src, size_t size, uint32 width, uint32 height, uint32 pitch,
+                    Common::ThreadPool *pool) {
+
+	decompress<DXT3Block>(dest, src, size, width, height, pitch, pool);
+}
+
+void decompressDXT5(byte *dest, const byte *src, size_t size, uint32 width, uint32 height, uint32 pitch,
+                    Common::ThreadPool *pool) {
+
+	decompress<DXT5Block>(dest, src, size, width, height, pitch, pool);
 }
 
 } // End of namespace Graphics
@@ -28,14 +28,24 @@
 #include "src/common/types.h"
 
 namespace Common {
-	class SeekableReadStream;
+	class ThreadPool;
 }
 
 namespace Graphics {
 
-void decompressDXT1(byte *dest, Common::SeekableReadStream &src, uint32 width, uint32 height, uint32 pitch);
-void decompressDXT3(byte *dest, Common::SeekableReadStream &src, uint32 width, uint32 height, uint32 pitch);
-void decompressDXT5(byte *dest, Common::SeekableReadStream &src, uint32 width, uint32 height, uint32 pitch);
+/* Decompress DXTn data into RGBA8 pixels.
+ *
+ * The source holds rows of 4x4 pixel blocks, size bytes in total. Each row
+ * of pixels in the destination starts pitch bytes after the previous one.
+ * If a thread pool is given, the rows of blocks are spread over its workers.
+ */
+
+void decompressDXT1(byte *dest, const byte *src, size_t size, uint32 width, uint32 height, uint32 pitch,
+                    Common::ThreadPool *pool = 0);
+void decompressDXT3(byte *dest, const byte *src, size_t size, uint32 width, uint32 height, uint32 pitch,
+                    Common::ThreadPool *pool = 0);
+void decompressDXT5(byte *dest, const byte *src, size_t size, uint32 width, uint32 height, uint32 pitch,
+                    Common::ThreadPool *pool = 0);
 
 } // End of namespace Graphics
 
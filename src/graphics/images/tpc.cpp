@@ -29,6 +29,7 @@
 #include "src/common/maths.h"
 #include "src/common/error.h"
 #include "src/common/memreadstream.h"
+#include "src/common/parallelfor.h"
 
 #include "src/graphics/images/tpc.h"
 #include "src/graphics/images/util.h"
@@ -40,23 +41,60 @@ static const byte kEncodingSwizzledBGRA = 0x0C;
 
 namespace Graphics {
 
-TPC::TPC(Common::SeekableReadStream &tpc) {
-	load(tpc);
+/** Deswizzles or expands the raw data of one mip map in each iteration. */
+class TPC::UnpackBody : public Common::ParallelForBody {
+public:
+	UnpackBody(TPC &tpc, byte encoding) : _tpc(&tpc), _encoding(encoding) {
+	}
+
+	void run(size_t index) {
+		unpackMipMap(*_tpc->_mipMaps[index], _encoding);
+	}
+
+private:
+	TPC *_tpc;
+	byte _encoding;
+};
+
+/** Rotates one mip map of one cube side in each iteration. */
+class TPC::RotateBody : public Common::ParallelForBody {
+public:
+	RotateBody(TPC &tpc, int bpp) : _tpc(&tpc), _bpp(bpp) {
+	}
+
+	void run(size_t index) {
+		static const int rotation[6] = { 1, 3, 0, 2, 2, 0 };
+
+		const size_t layer = index / _tpc->getMipMapCount();
+		assert(layer < 6);
+
+		MipMap &mipMap = *_tpc->_mipMaps[index];
+
+		rotate90(mipMap.data.get(), mipMap.width, mipMap.height, _bpp, rotation[layer]);
+	}
+
+private:
+	TPC *_tpc;
+	int _bpp;
+};
+
+TPC::TPC(Common::SeekableReadStream &tpc, Common::ThreadPool *pool) {
+	load(tpc, pool);
 }
 
 TPC::~TPC() {
 }
 
-void TPC::load(Common::SeekableReadStream &tpc) {
+void TPC::load(Common::SeekableReadStream &tpc, Common::ThreadPool *pool) {
 	try {
 
 		byte encoding;
 
 		readHeader(tpc, encoding);
-		readData  (tpc, encoding);
+		readData  (tpc, encoding, pool);
 		readTXI   (tpc);
 
-		fixupCubeMap();
+		fixupCubeMap(pool);
 
 	} catch (Common::Exception &e) {
 		e.add("Failed reading TPC file");
@@ -262,39 +300,44 @@ void TPC::deSwizzle(byte *dst, const byte *src, uint32 width, uint32 height) {
 	}
 }
 
-void TPC::readData(Common::SeekableReadStream &tpc, byte encoding) {
+void TPC::readData(Common::SeekableReadStream &tpc, byte encoding, Common::ThreadPool *pool) {
 	for (MipMaps::iterator mipMap = _mipMaps.begin(); mipMap != _mipMaps.end(); ++mipMap) {
+		(*mipMap)->data.reset(new byte[(*mipMap)->size]);
 
-		// If the texture width is a power of two, the texture memory layout is "swizzled"
-		const bool widthPOT = ((*mipMap)->width & ((*mipMap)->width - 1)) == 0;
-		const bool swizzled = (encoding == kEncodingSwizzledBGRA) && widthPOT;
+		if (tpc.read((*mipMap)->data.get(), (*mipMap)->size) != (*mipMap)->size)
+			throw Common::Exception(Common::kReadError);
+	}
 
-		(*mipMap)->data.reset(new byte[(*mipMap)->size]);
+	if ((encoding != kEncodingSwizzledBGRA) && (encoding != kEncodingGray))
+		return;
 
-		if (swizzled) {
-			std::vector<byte> tmp((*mipMap)->size);
+	// With the stream read through, the mip maps can be unpacked side by side
+	UnpackBody body(*this, encoding);
+	Common::parallelFor(pool, 0, _mipMaps.size(), body);
+}
 
-			if (tpc.read(&tmp[0], (*mipMap)->size) != (*mipMap)->size)
-				throw Common::Exception(Common::kReadError);
+void TPC::unpackMipMap(MipMap &mipMap, byte encoding) {
+	if (encoding == kEncodingSwizzledBGRA) {
+		// If the texture width is a power of two, the texture memory layout is "swizzled"
+		const bool widthPOT = (mipMap.width & (mipMap.width - 1)) == 0;
+		if (!widthPOT)
+			return;
 
-			deSwizzle((*mipMap)->data.get(), &tmp[0], (*mipMap)->width, (*mipMap)->height);
+		Common::ScopedArray<byte> dataSwizzled(mipMap.data.release());
+		mipMap.data.reset(new byte[mipMap.size]);
 
-		} else {
-			if (tpc.read((*mipMap)->data.get(), (*mipMap)->size) != (*mipMap)->size)
-				throw Common::Exception(Common::kReadError);
+		deSwizzle(mipMap.data.get(), dataSwizzled.get(), mipMap.width, mipMap.height);
 
-			// Unpacking 8bpp grayscale data into RGB
-			if (encoding == kEncodingGray) {
-				Common::ScopedArray<byte> dataGray((*mipMap)->data.release());
+	} else if (encoding == kEncodingGray) {
+		// Unpacking 8bpp grayscale data into RGB
 
-				(*mipMap)->size = (*mipMap)->width * (*mipMap)->height * 3;
-				(*mipMap)->data.reset(new byte[(*mipMap)->size]);
+		Common::ScopedArray<byte> dataGray(mipMap.data.release());
 
-				for (int i = 0; i < ((*mipMap)->width * (*mipMap)->height); i++)
-					std::memset((*mipMap)->data.get() + i * 3, dataGray[i], 3);
-			}
-		}
+		mipMap.size = mipMap.width * mipMap.height * 3;
+		mipMap.data.reset(new byte[mipMap.size]);
 
+		for (int i = 0; i < (mipMap.width * mipMap.height); i++)
+			std::memset(mipMap.data.get() + i * 3, dataGray[i], 3);
 	}
 }
 
@@ -311,7 +354,7 @@ void TPC::readTXI(Common::SeekableReadStream &tpc) {
 	}
 }
 
-void TPC::fixupCubeMap() {
+void TPC::fixupCubeMap(Common::ThreadPool *pool) {
 	/* Do various fixups to the cube maps. This includes rotating and swapping a
 	 * few sides around. This is done by the original games as well.
 	 */
@@ -341,7 +384,7 @@ void TPC::fixupCubeMap() {
 	}
 
 	// Since we need to rotate the individual cube sides, we need to decompress them all
-	decompress();
+	decompress(pool);
 
 	// Swap the first two sides of the cube maps
 	for (size_t j = 0; j < getMipMapCount(); j++) {
@@ -360,18 +403,8 @@ void TPC::fixupCubeMap() {
 		return;
 
 	// Rotate the cube sides so that they're all oriented correctly
-	for (size_t i = 0; i < getLayerCount(); i++) {
-		for (size_t j = 0; j < getMipMapCount(); j++) {
-			const size_t index = i * getMipMapCount() + j;
-			assert(index < _mipMaps.size());
-
-			MipMap &mipMap = *_mipMaps[index];
-
-			static const int rotation[6] = { 1, 3, 0, 2, 2, 0 };
-
-			rotate90(mipMap.data.get(), mipMap.width, mipMap.height, bpp, rotation[i]);
-		}
-	}
+	RotateBody body(*this, bpp);
+	Common::parallelFor(pool, 0, _mipMaps.size(), body);
 
 }
 
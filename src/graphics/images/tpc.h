@@ -29,6 +29,7 @@
 
 namespace Common {
 	class SeekableReadStream;
+	class ThreadPool;
 }
 
 namespace Graphics {
@@ -41,19 +42,27 @@ namespace Graphics {
  */
 class TPC : public ImageDecoder {
 public:
-	TPC(Common::SeekableReadStream &tpc);
+	/** Read a TPC image.
+	 *
+	 *  If a thread pool is given, the mip maps are unpacked and decompressed by its workers.
+	 */
+	TPC(Common::SeekableReadStream &tpc, Common::ThreadPool *pool = 0);
 	~TPC();
 
 private:
+	class UnpackBody;
+	class RotateBody;
+
 	// Loading helpers
-	void load(Common::SeekableReadStream &tpc);
+	void load(Common::SeekableReadStream &tpc, Common::ThreadPool *pool);
 	void readHeader(Common::SeekableReadStream &tpc, byte &encoding);
-	void readData(Common::SeekableReadStream &tpc, byte encoding);
+	void readData(Common::SeekableReadStream &tpc, byte encoding, Common::ThreadPool *pool);
 	void readTXI(Common::SeekableReadStream &tpc);
 
 	bool checkCubeMap(uint32 &width, uint32 &height);
-	void fixupCubeMap();
+	void fixupCubeMap(Common::ThreadPool *pool);
 
+	static void unpackMipMap(MipMap &mipMap, byte encoding);
 	static void deSwizzle(byte *dst, const byte *src, uint32 width, uint32 height);
 };
 
@@ -26,6 +26,7 @@
 #include "src/common/util.h"
 #include "src/common/error.h"
 #include "src/common/memreadstream.h"
+#include "src/common/parallelfor.h"
 
 #include "src/graphics/images/txb.h"
 #include "src/graphics/images/util.h"
@@ -37,21 +38,36 @@ static const byte kEncodingDXT5 = 0x0C;
 
 namespace Graphics {
 
-TXB::TXB(Common::SeekableReadStream &txb) {
-	load(txb);
+/** Deswizzles or expands the raw data of one mip map in each iteration. */
+class TXB::UnpackBody : public Common::ParallelForBody {
+public:
+	UnpackBody(TXB &txb, byte encoding) : _txb(&txb), _encoding(encoding) {
+	}
+
+	void run(size_t index) {
+		unpackMipMap(*_txb->_mipMaps[index], _encoding);
+	}
+
+private:
+	TXB *_txb;
+	byte _encoding;
+};
+
+TXB::TXB(Common::SeekableReadStream &txb, Common::ThreadPool *pool) {
+	load(txb, pool);
 }
 
 TXB::~TXB() {
 }
 
-void TXB::load(Common::SeekableReadStream &txb) {
+void TXB::load(Common::SeekableReadStream &txb, Common::ThreadPool *pool) {
 	try {
 
 		uint32 dataSize;
 		byte encoding;
 
 		readHeader(txb, encoding, dataSize);
-		readData  (txb, encoding);
+		readData  (txb, encoding, pool);
 
 		txb.seek(dataSize + 128);
 
@@ -174,46 +190,54 @@ void TXB::deSwizzle(byte *dst, const byte *src, uint32 width, uint32 height, uin
 	}
 }
 
-void TXB::readData(Common::SeekableReadStream &txb, byte encoding) {
+void TXB::readData(Common::SeekableReadStream &txb, byte encoding, Common::ThreadPool *pool) {
 	for (MipMaps::iterator mipMap = _mipMaps.begin(); mipMap != _mipMaps.end(); ++mipMap) {
-		const bool needDeSwizzle = (encoding == kEncodingBGRA) || (encoding == kEncodingGray);
-
-		// If the texture width is a power of two, the texture memory layout is "swizzled"
-		const bool widthPOT = ((*mipMap)->width & ((*mipMap)->width - 1)) == 0;
-		const bool swizzled = needDeSwizzle && widthPOT;
-
 		(*mipMap)->data.reset(new byte[(*mipMap)->size]);
 		if (txb.read((*mipMap)->data.get(), (*mipMap)->size) != (*mipMap)->size)
 			throw Common::Exception(Common::kReadError);
+	}
 
-		if (encoding == kEncodingGray) {
-			// Convert grayscale into BGR
+	if ((encoding != kEncodingBGRA) && (encoding != kEncodingGray))
+		return;
 
-			const uint32 oldSize = (*mipMap)->size;
-			const uint32 newSize = (*mipMap)->size * 3;
+	// With the stream read through, the mip maps can be unpacked side by side
+	UnpackBody body(*this, encoding);
+	Common::parallelFor(pool, 0, _mipMaps.size(), body);
+}
 
-			Common::ScopedArray<byte> tmp1(new byte[newSize]);
-			for (uint32 i = 0; i < oldSize; i++)
-				tmp1[i * 3 + 0] = tmp1[i * 3 + 1] = tmp1[i * 3 + 2] = (*mipMap)->data[i];
+void TXB::unpackMipMap(MipMap &mipMap, byte encoding) {
+	const bool needDeSwizzle = (encoding == kEncodingBGRA) || (encoding == kEncodingGray);
 
-			if (swizzled) {
-				Common::ScopedArray<byte> tmp2(new byte[newSize]);
-				deSwizzle(tmp2.get(), tmp1.get(), (*mipMap)->width, (*mipMap)->height, 3);
+	// If the texture width is a power of two, the texture memory layout is "swizzled"
+	const bool widthPOT = (mipMap.width & (mipMap.width - 1)) == 0;
+	const bool swizzled = needDeSwizzle && widthPOT;
 
-				tmp1.swap(tmp2);
-			}
+	if (encoding == kEncodingGray) {
+		// Convert grayscale into BGR
 
-			(*mipMap)->data.swap(tmp1);
-			(*mipMap)->size = newSize;
+		const uint32 oldSize = mipMap.size;
+		const uint32 newSize = mipMap.size * 3;
 
-		} else if (swizzled) {
-			Common::ScopedArray<byte> tmp(new byte[(*mipMap)->size]);
+		Common::ScopedArray<byte> tmp1(new byte[newSize]);
+		for (uint32 i = 0; i < oldSize; i++)
+			tmp1[i * 3 + 0] = tmp1[i * 3 + 1] = tmp1[i * 3 + 2] = mipMap.data[i];
 
-			deSwizzle(tmp.get(), (*mipMap)->data.get(), (*mipMap)->width, (*mipMap)->height, 4);
+		if (swizzled) {
+			Common::ScopedArray<byte> tmp2(new byte[newSize]);
+			deSwizzle(tmp2.get(), tmp1.get(), mipMap.width, mipMap.height, 3);
 
-			(*mipMap)->data.swap(tmp);
+			tmp1.swap(tmp2);
 		}
 
+		mipMap.data.swap(tmp1);
+		mipMap.size = newSize;
+
+	} else if (swizzled) {
+		Common::ScopedArray<byte> tmp(new byte[mipMap.size]);
+
+		deSwizzle(tmp.get(), mipMap.data.get(), mipMap.width, mipMap.height, 4);
+
+		mipMap.data.swap(tmp);
 	}
 }
 
@@ -29,6 +29,7 @@
 
 namespace Common {
 	class SeekableReadStream;
+	class ThreadPool;
 }
 
 namespace Graphics {
@@ -43,16 +44,24 @@ namespace Graphics {
  */
 class TXB : public ImageDecoder {
 public:
-	TXB(Common::SeekableReadStream &txb);
+	/** Read a TXB image.
+	 *
+	 *  If a thread pool is given, the mip maps are unpacked by its workers.
+	 */
+	TXB(Common::SeekableReadStream &txb, Common::ThreadPool *pool = 0);
 	~TXB();
 
 private:
+	class UnpackBody;
+
 	// Loading helpers
-	void load(Common::SeekableReadStream &txb);
+	void load(Common::SeekableReadStream &txb, Common::ThreadPool *pool);
 	void readHeader(Common::SeekableReadStream &txb, byte &encoding, uint32 &dataSize);
-	void readData(Common::SeekableReadStream &txb, byte encoding);
+	void readData(Common::SeekableReadStream &txb, byte encoding, Common::ThreadPool *pool);
 	void readTXI(Common::SeekableReadStream &txb);
 
+	static void unpackMipMap(MipMap &mipMap, byte encoding);
+
 	static void deSwizzle(byte *dst, const byte *src, uint32 width, uint32 height, uint8 bpp);
 };
 
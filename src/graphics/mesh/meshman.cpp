@@ -48,18 +48,18 @@ void MeshManager::init() {
 	wirebox->init();
 	wirebox->setName("defaultWireBox");
 
-	_resourceMap[wirebox->getName()] = wirebox;
+	_resourceMap[Common::InternedString(wirebox->getName())] = wirebox;
 }
 
 void MeshManager::deinit() {
-	for (std::map<Common::UString, Mesh *>::iterator iter = _resourceMap.begin(); iter != _resourceMap.end(); ++iter) {
+	for (MeshMap::iterator iter = _resourceMap.begin(); iter != _resourceMap.end(); ++iter) {
 		delete iter->second;
 	}
 	_resourceMap.clear();
 }
 
 void MeshManager::cleanup() {
-	std::map<Common::UString, Mesh *>::iterator iter = _resourceMap.begin();
+	MeshMap::iterator iter = _resourceMap.begin();
 	while (iter != _resourceMap.end()) {
 		Mesh *mesh = iter->second;
 		if (mesh->useCount() == 0) {
@@ -75,9 +75,11 @@ void MeshManager::addMesh(Mesh *mesh) {
 		return;
 	}
 
-	std::map<Common::UString, Mesh *>::iterator iter = _resourceMap.find(mesh->getName());
+	const Common::InternedString name(mesh->getName());
+
+	MeshMap::iterator iter = _resourceMap.find(name);
 	if (iter == _resourceMap.end()) {
-		_resourceMap[mesh->getName()] = mesh;
+		_resourceMap[name] = mesh;
 	}
 }
 
@@ -86,14 +88,25 @@ void MeshManager::delMesh(Mesh *mesh) {
 		return;
 	}
 
-	std::map<Common::UString, Mesh *>::iterator iter = _resourceMap.find(mesh->getName());
+	Common::InternedString name;
+	if (!Common::InternedString::lookup(mesh->getName(), name)) {
+		return;
+	}
+
+	MeshMap::iterator iter = _resourceMap.find(name);
 	if (iter != _resourceMap.end()) {
 		delResource(iter);
 	}
 }
 
 Mesh *MeshManager::getMesh(const Common::UString &name) {
-	std::map<Common::UString, Mesh *>::iterator iter = _resourceMap.find(name);
+	// A name that was never interned can't be in the map
+	Common::InternedString internedName;
+	if (!Common::InternedString::lookup(name, internedName)) {
+		return 0;
+	}
+
+	MeshMap::iterator iter = _resourceMap.find(internedName);
 	if (iter != _resourceMap.end()) {
 		return iter->second;
 	} else {
@@ -101,13 +114,10 @@ Mesh *MeshManager::getMesh(const Common::UString &name) {
 	}
 }
 
-std::map<Common::UString, Mesh *>::iterator MeshManager::delResource(std::map<Common::UString, Mesh *>::iterator iter) {
-	std::map<Common::UString, Mesh *>::iterator inext = iter;
-	inext++;
+MeshManager::MeshMap::iterator MeshManager::delResource(MeshMap::iterator iter) {
 	delete iter->second;
-	_resourceMap.erase(iter);
 
-	return inext;
+	return _resourceMap.erase(iter);
 }
 
 } // End of namespace Mesh
@@ -25,9 +25,10 @@
 #ifndef GRAPHICS_MESH_MESHMAN_H
 #define GRAPHICS_MESH_MESHMAN_H
 
-#include <map>
+#include <boost/unordered_map.hpp>
 
 #include "src/common/ustring.h"
+#include "src/common/internedstring.h"
 #include "src/common/singleton.h"
 #include "src/common/mutex.h"
 
@@ -61,9 +62,11 @@ public:
 	Mesh *getMesh(const Common::UString &name);
 
 private:
-	std::map<Common::UString, Mesh *> _resourceMap;
+	typedef boost::unordered_map<Common::InternedString, Mesh *, Common::hashInternedString> MeshMap;
 
-	std::map<Common::UString, Mesh *>::iterator delResource(std::map<Common::UString, Mesh *>::iterator iter);
+	MeshMap _resourceMap;
+
+	MeshMap::iterator delResource(MeshMap::iterator iter);
 };
 
 } // End of namespace Mesh
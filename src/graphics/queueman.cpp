@@ -35,6 +35,8 @@ static bool queueComp(Queueable *a, Queueable *b) {
 
 
 QueueManager::QueueManager() {
+	for (int i = 0; i < kQueueMAX; i++)
+		_generation[i] = 0;
 }
 
 QueueManager::~QueueManager() {
@@ -59,6 +61,10 @@ const std::list<Queueable *> &QueueManager::getQueue(QueueType queue) const {
 	return _queue[queue];
 }
 
+uint32 QueueManager::getQueueGeneration(QueueType queue) const {
+	return _generation[queue];
+}
+
 void QueueManager::sortQueue(QueueType queue) {
 	lockQueue(queue);
 
@@ -73,6 +79,8 @@ std::list<Queueable *>::iterator QueueManager::addToQueue(QueueType queue, Queue
 	_queue[queue].push_back(&q);
 	std::list<Queueable *>::iterator ref = --_queue[queue].end();
 
+	_generation[queue]++;
+
 	unlockQueue(queue);
 
 	return ref;
@@ -85,6 +93,8 @@ void QueueManager::removeFromQueue(QueueType queue,
 
 	_queue[queue].erase(ref);
 
+	_generation[queue]++;
+
 	unlockQueue(queue);
 }
 
@@ -97,9 +107,29 @@ void QueueManager::clearQueue(QueueType queue) {
 
 	_queue[queue].clear();
 
+	_generation[queue]++;
+
 	unlockQueue(queue);
 }
 
+Queueable *QueueManager::takeFromQueue(QueueType queue) {
+	lockQueue(queue);
+
+	Queueable *q = 0;
+	if (!_queue[queue].empty()) {
+		q = _queue[queue].front();
+		q->kickedOut(queue);
+
+		_queue[queue].pop_front();
+
+		_generation[queue]++;
+	}
+
+	unlockQueue(queue);
+
+	return q;
+}
+
 void QueueManager::clearAllQueues() {
 	for (int i = 0; i < kQueueMAX; i++)
 		clearQueue((QueueType) i);
@@ -50,15 +50,26 @@ public:
 
 	const std::list<Queueable *> &getQueue(QueueType queue) const;
 
+	/** Return a counter that changes whenever objects are added to or removed from the queue.
+	 *
+	 *  Sorting the queue does not change the counter. The queue should be locked.
+	 */
+	uint32 getQueueGeneration(QueueType queue) const;
+
 	void sortQueue(QueueType queue);
 	void clearQueue(QueueType queue);
 
+	/** Remove the first object from the queue and return it, or 0 if the queue is empty. */
+	Queueable *takeFromQueue(QueueType queue);
+
 	void clearAllQueues();
 
 private:
 	Common::Mutex _queueMutex[kQueueMAX];
 	std::list<Queueable *> _queue[kQueueMAX];
 
+	uint32 _generation[kQueueMAX];
+
 	std::list<Queueable *>::iterator addToQueue(QueueType queue, Queueable &q);
 	void removeFromQueue(QueueType queue, const std::list<Queueable *>::iterator &ref);
 
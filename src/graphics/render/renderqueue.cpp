@@ -29,34 +29,12 @@
 #include "src/graphics/render/renderqueue.h"
 #include "src/common/util.h"
 
-#include <algorithm>
-
 namespace Graphics {
 
 namespace Render {
 
-bool compareShader(const RenderQueue::RenderQueueNode &a, const RenderQueue::RenderQueueNode &b)
-{
-	if (a.program < b.program)
-		return false;
-	else if (a.program > b.program)
-		return true;
-	if (a.material < b.material)  // node_program values are equal.
-		return false;
-	else if (a.material > b.material)
-		return true;
-	else  // node material values are equal, compare mesh values next.
-		return (a.mesh <= b.mesh ? false : true);
-	// No, surfaces are not compared here.
-}
-
-bool compareDepth(const RenderQueue::RenderQueueNode &a, const RenderQueue::RenderQueueNode &b) {
-	return (a.reference <= b.reference);
-	//return (a.reference.lengthSquared() <= b.reference.lengthSquared());
-}
-
-RenderQueue::RenderQueue(uint32 precache) : _nodeArray(precache) {
-//	_nodeArray.reserve(1000);
+RenderQueue::RenderQueue(uint32 precache) {
+	_nodeArray.reserve(precache);
 }
 
 RenderQueue::~RenderQueue()
@@ -83,11 +61,44 @@ void RenderQueue::queueItem(Shader::ShaderRenderable *renderable, const glm::mat
 }
 
 void RenderQueue::sortShader() {
-	std::sort(_nodeArray.begin(), _nodeArray.end(), compareShader);
+	/* Group nodes with the same program, material, surface and mesh together,
+	 * so that render() can skip rebinding them. Within each group, nodes are
+	 * ordered front to back. */
+
+	_sortItems.resize(_nodeArray.size());
+	for (size_t i = 0; i < _nodeArray.size(); i++) {
+		const RenderQueueNode &node = _nodeArray[i];
+
+		_sortItems[i].key   = makeStateKey(_programIDs.get(node.program), _materialIDs.get(node.material),
+		                                   _surfaceIDs.get(node.surface), _meshIDs.get(node.mesh),
+		                                   node.reference);
+		_sortItems[i].index = i;
+	}
+
+	sortByKeys();
 }
 
 void RenderQueue::sortDepth() {
-	std::sort(_nodeArray.begin(), _nodeArray.end(), compareDepth);
+	_sortItems.resize(_nodeArray.size());
+	for (size_t i = 0; i < _nodeArray.size(); i++) {
+		const RenderQueueNode &node = _nodeArray[i];
+
+		_sortItems[i].key   = makeDepthKey(node.reference, _programIDs.get(node.program),
+		                                   _materialIDs.get(node.material), _meshIDs.get(node.mesh));
+		_sortItems[i].index = i;
+	}
+
+	sortByKeys();
+}
+
+void RenderQueue::sortByKeys() {
+	radixSort(_sortItems, _sortScratch);
+
+	_sortedArray.resize(_nodeArray.size());
+	for (size_t i = 0; i < _sortItems.size(); i++)
+		_sortedArray[i] = _nodeArray[_sortItems[i].index];
+
+	_nodeArray.swap(_sortedArray);
 }
 
 void RenderQueue::render() {
@@ -100,14 +111,13 @@ void RenderQueue::render() {
 	Shader::ShaderSurface *currentSurface = 0;
 	Mesh::Mesh *currentMesh = 0;
 
-	uint32 i = 0;
-	uint32 limit = _nodeArray.size();
-	while (i < limit) {
-		assert(_nodeArray[i].program);
-		if (currentProgram != _nodeArray[i].program) {
-			currentProgram = _nodeArray[i].program;
+	for (std::vector<RenderQueueNode>::const_iterator n = _nodeArray.begin(); n != _nodeArray.end(); ++n) {
+		assert(n->program);
+		if (currentProgram != n->program) {
+			currentProgram = n->program;
 			glUseProgram(currentProgram->glid);
 
+			// Uniforms need to be uploaded again for the new program
 			if (currentMaterial != 0) {
 				currentMaterial->unbindGLState();
 			}
@@ -115,40 +125,41 @@ void RenderQueue::render() {
 			currentSurface = 0;
 		}
 
-		assert(_nodeArray[i].material);
-		if (currentMaterial != _nodeArray[i].material) {
+		assert(n->material);
+		if (currentMaterial != n->material) {
 			if (currentMaterial != 0) {
 				currentMaterial->unbindGLState();
 			}
-			currentMaterial = _nodeArray[i].material;
+			currentMaterial = n->material;
 			currentMaterial->bindProgram(currentProgram);
 			currentMaterial->bindGLState();
 		}
 
-		assert(_nodeArray[i].surface);
-		assert(_nodeArray[i].mesh);
+		assert(n->mesh);
+		if (currentMesh != n->mesh) {
+			if (currentMesh != 0) {
+				currentMesh->renderUnbind();
+			}
+			currentMesh = n->mesh;
+			currentMesh->renderBind();  // Binds VAO ready for rendering.
+		}
 
-		currentSurface = _nodeArray[i].surface;
-		currentMesh = _nodeArray[i].mesh;
-		currentMesh->renderBind();  // Binds VAO ready for rendering.
+		assert(n->surface);
+		assert(n->transform);
+		if (currentSurface != n->surface) {
+			currentSurface = n->surface;
+			currentSurface->bindProgram(currentProgram, n->transform);
+		} else {
+			// Same surface as before, only the object modelview transform differs.
+			currentSurface->bindObjectModelview(currentProgram, n->transform);
+		}
 
-		// There's at least one mesh to be rendering here.
-		assert(_nodeArray[i].transform);
-		currentSurface->bindProgram(currentProgram, _nodeArray[i].transform);
 		currentMesh->render();
-
-		++i;  // Move to next object.
-		while ((i < limit) && (_nodeArray[i].mesh == currentMesh) && (_nodeArray[i].material == currentMaterial) && (_nodeArray[i].surface == currentSurface)) {
-			// Next object is basically the same, but will have a different object modelview transform. So rebind that, and render again.
-			assert(_nodeArray[i].transform);
-			currentSurface->bindObjectModelview(currentProgram, _nodeArray[i].transform);
-			currentMesh->render();
-			++i;
-		}
-		// Done rendering, unbind the mesh, and onwards into the queue.
-		currentMesh->renderUnbind();
 	}
 
+	// Done rendering, unbind the mesh.
+	currentMesh->renderUnbind();
+
 	// Restore OpenGL state on exit.
 	glDisable(GL_BLEND);
 	glEnable(GL_CULL_FACE);
@@ -158,6 +169,14 @@ void RenderQueue::render() {
 
 void RenderQueue::clear() {
 	_nodeArray.clear();
+
+	/* Start handing out IDs from 0 again. Otherwise, the maps would grow
+	 * with every object ever seen, their IDs would overflow the fields in
+	 * the sort keys, and freed objects would keep their stale IDs. */
+	_programIDs.clear();
+	_materialIDs.clear();
+	_surfaceIDs.clear();
+	_meshIDs.clear();
 }
 
 } // namespace Render
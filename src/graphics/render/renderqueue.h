@@ -30,6 +30,7 @@
 
 #include "src/graphics/graphics.h"
 #include "src/graphics/shader/shaderrenderable.h"
+#include "src/graphics/render/sortkey.h"
 
 #include <vector>
 
@@ -46,14 +47,10 @@ public:
 		Mesh::Mesh *mesh;
 		const glm::mat4 *transform;
 		float reference;  ///< Reference point to the camera location, primarily used for depth sorting.
-		float padding;    ///< Padding for 64bit architectures.
 
 		RenderQueueNode() : program(0), surface(0), material(0), mesh(0), transform(0), reference(0.0f) {}
-		RenderQueueNode(const RenderQueueNode &src) : program(src.program), surface(src.surface), material(src.material), mesh(src.mesh), transform(src.transform), reference(src.reference) {}
 		RenderQueueNode(Shader::ShaderProgram *prog, Shader::ShaderSurface *sur, Shader::ShaderMaterial *mat, Mesh::Mesh *mes, const glm::mat4 *t) : program(prog), surface(sur), material(mat), mesh(mes), transform(t), reference(0.0f) {}
 		RenderQueueNode(Shader::ShaderProgram *prog, Shader::ShaderSurface *sur, Shader::ShaderMaterial *mat, Mesh::Mesh *mes, const glm::mat4 *t, float ref) : program(prog), surface(sur), material(mat), mesh(mes), transform(t), reference(ref) {}
-
-		inline const RenderQueueNode &operator=(const RenderQueueNode &src) { material = src.material; surface = src.surface; mesh = src.mesh; transform = src.transform; reference = src.reference; return *this; }
 	};
 
 	RenderQueue(uint32 precache = 1000);
@@ -69,12 +66,22 @@ public:
 
 	void render();  ///< Render all queued items.
 
-	void clear();  ///< Clear the queue of all items.
+	void clear();  ///< Clear the queue of all items, and forget the IDs of their render state.
 
 private:
 
 	std::vector<RenderQueueNode>_nodeArray;
 	glm::vec3 _cameraReference;
+
+	std::vector<RenderQueueNode> _sortedArray; ///< Scratch space for reordering the nodes.
+	std::vector<SortItem> _sortItems;          ///< The sort keys of all nodes.
+	std::vector<SortItem> _sortScratch;        ///< Scratch space for the radix sort.
+
+	/** Small IDs for the render state objects of this frame, to pack into the sort keys. */
+	SortIDMap _programIDs, _materialIDs, _surfaceIDs, _meshIDs;
+
+	/** Reorder the nodes by their sort keys. */
+	void sortByKeys();
 };
 
 } // namespace Render
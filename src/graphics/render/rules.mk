@@ -25,9 +25,11 @@ src_graphics_render_librender_la_SOURCES =
 src_graphics_render_librender_la_SOURCES += \
     src/graphics/render/renderman.h \
     src/graphics/render/renderqueue.h \
+    src/graphics/render/sortkey.h \
     $(EMPTY)
 
 src_graphics_render_librender_la_SOURCES += \
     src/graphics/render/renderman.cpp \
     src/graphics/render/renderqueue.cpp \
+    src/graphics/render/sortkey.cpp \
     $(EMPTY)
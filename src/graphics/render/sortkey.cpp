@@ -0,0 +1,137 @@
+/* xoreos - A reimplementation of BioWare's Aurora engine
+ *
+ * xoreos is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * xoreos is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * xoreos is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with xoreos. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  Packed sort keys for the render queue, and sorting them.
+ */
+
+#include <cstring>
+
+#include <algorithm>
+
+#include "src/graphics/render/sortkey.h"
+
+namespace Graphics {
+
+namespace Render {
+
+SortIDMap::SortIDMap() : _lastObject(0), _lastID(0) {
+}
+
+SortIDMap::~SortIDMap() {
+}
+
+uint32 SortIDMap::get(const void *object) {
+	if (object == _lastObject)
+		return _lastID;
+
+	std::pair<IDMap::iterator, bool> id = _ids.insert(std::make_pair(object, (uint32) _ids.size()));
+
+	_lastObject = object;
+	_lastID     = id.first->second;
+
+	return _lastID;
+}
+
+void SortIDMap::clear() {
+	_ids.clear();
+
+	_lastObject = 0;
+	_lastID     = 0;
+}
+
+/** Map a float onto an unsigned integer with the same ordering. */
+static uint32 orderedFloatBits(float f) {
+	uint32 bits;
+	std::memcpy(&bits, &f, sizeof(bits));
+
+	// Flip all bits of negative numbers, and only the sign bit of positive ones
+	return (bits & 0x80000000) ? ~bits : (bits | 0x80000000);
+}
+
+uint64 makeStateKey(uint32 program, uint32 material, uint32 surface, uint32 mesh, float depth) {
+	return (((uint64) (program  & 0x000000FF)) << 56) |
+	       (((uint64) (material & 0x00000FFF)) << 44) |
+	       (((uint64) (surface  & 0x000003FF)) << 34) |
+	       (((uint64) (mesh     & 0x0000FFFF)) << 18) |
+	        ((uint64) (orderedFloatBits(depth) >> 14));
+}
+
+uint64 makeDepthKey(float depth, uint32 program, uint32 material, uint32 mesh) {
+	return (((uint64) orderedFloatBits(depth))        << 32) |
+	       (((uint64) (program  & 0x000000FF))        << 24) |
+	       (((uint64) (material & 0x00000FFF))        << 12) |
+	        ((uint64) (mesh     & 0x00000FFF));
+}
+
+void radixSort(std::vector<SortItem> &items, std::vector<SortItem> &scratch) {
+	static const size_t kDigits     = 8;
+	static const size_t kDigitBits  = 8;
+	static const size_t kBucketSize = 1 << kDigitBits;
+
+	const size_t count = items.size();
+	if (count < 2)
+		return;
+
+	// Count the occurrences of all digits in one go
+	uint32 histogram[kDigits][kBucketSize];
+	std::memset(histogram, 0, sizeof(histogram));
+
+	for (size_t i = 0; i < count; i++) {
+		const uint64 key = items[i].key;
+
+		for (size_t d = 0; d < kDigits; d++)
+			histogram[d][(key >> (d * kDigitBits)) & (kBucketSize - 1)]++;
+	}
+
+	scratch.resize(count);
+
+	SortItem *src = &items[0];
+	SortItem *dst = &scratch[0];
+
+	for (size_t d = 0; d < kDigits; d++) {
+		const size_t shift = d * kDigitBits;
+
+		// All items have the same digit here, so this pass wouldn't change anything
+		if (histogram[d][(src[0].key >> shift) & (kBucketSize - 1)] == count)
+			continue;
+
+		uint32 offsets[kBucketSize];
+
+		uint32 offset = 0;
+		for (size_t b = 0; b < kBucketSize; b++) {
+			offsets[b] = offset;
+			offset += histogram[d][b];
+		}
+
+		for (size_t i = 0; i < count; i++)
+			dst[offsets[(src[i].key >> shift) & (kBucketSize - 1)]++] = src[i];
+
+		std::swap(src, dst);
+	}
+
+	// The sorted items ended up in the scratch space
+	if (src != &items[0])
+		items.swap(scratch);
+}
+
+} // End of namespace Render
+
+} // End of namespace Graphics
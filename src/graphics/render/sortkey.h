@@ -0,0 +1,102 @@
+/* xoreos - A reimplementation of BioWare's Aurora engine
+ *
+ * xoreos is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * xoreos is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * xoreos is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with xoreos. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  Packed sort keys for the render queue, and sorting them.
+ */
+
+#ifndef GRAPHICS_RENDER_SORTKEY_H
+#define GRAPHICS_RENDER_SORTKEY_H
+
+#include <vector>
+
+#include <boost/unordered_map.hpp>
+
+#include "src/common/types.h"
+
+namespace Graphics {
+
+namespace Render {
+
+/** An item in the render queue, reduced to its sort key. */
+struct SortItem {
+	uint64 key;   ///< The packed sort key.
+	uint32 index; ///< The index of the item within the queue.
+};
+
+/** Maps render state objects to small, dense IDs to pack into sort keys.
+ *
+ *  IDs are handed out in the order the objects are first seen, and stay
+ *  the same until the map is cleared.
+ */
+class SortIDMap {
+public:
+	SortIDMap();
+	~SortIDMap();
+
+	/** Return the ID of this object, giving it a new one if necessary. */
+	uint32 get(const void *object);
+
+	/** Forget all IDs. */
+	void clear();
+
+private:
+	typedef boost::unordered_map<const void *, uint32> IDMap;
+
+	IDMap _ids;
+
+	// Consecutive queue items often share state, so remember the last lookup
+	const void *_lastObject;
+	uint32 _lastID;
+};
+
+/** Create a key that sorts by render state first, and by depth second.
+ *
+ *  From most to least significant, the key holds 8 bits of the program
+ *  ID, 12 bits of the material ID, 10 bits of the surface ID, 16 bits of
+ *  the mesh ID and the upper 18 bits of the depth. IDs larger than their
+ *  field wrap around. Items with different state might then end up with
+ *  the same key, so the renderer still needs to compare the actual state.
+ */
+uint64 makeStateKey(uint32 program, uint32 material, uint32 surface, uint32 mesh, float depth);
+
+/** Create a key that sorts by depth first, and by render state second.
+ *
+ *  The upper 32 bits hold the depth, the lower 32 bits hold 8 bits of
+ *  the program ID, 12 bits of the material ID and 12 bits of the mesh ID.
+ */
+uint64 makeDepthKey(float depth, uint32 program, uint32 material, uint32 mesh);
+
+/** Sort items by their keys, in ascending order.
+ *
+ *  This is a stable least significant digit radix sort, skipping all
+ *  digits that are the same for every item.
+ *
+ *  @param items   The items to sort.
+ *  @param scratch Temporary storage, resized as needed. Keeping it around
+ *                 between calls avoids reallocations.
+ */
+void radixSort(std::vector<SortItem> &items, std::vector<SortItem> &scratch);
+
+} // End of namespace Render
+
+} // End of namespace Graphics
+
+#endif // GRAPHICS_RENDER_SORTKEY_H
@@ -30,7 +30,7 @@
 
 namespace Graphics {
 
-Renderable::Renderable(RenderableType type) : _clickable(false), _distance(0.0f) {
+Renderable::Renderable(RenderableType type) : _clickable(false), _distance(0.0f), _culled(false) {
 	switch (type) {
 		case kRenderableTypeVideo:
 			_queueExists  = kQueueVideo;
@@ -138,6 +138,10 @@ bool Renderable::isIn(float UNUSED(x1), float UNUSED(y1), float UNUSED(z1),
 	return false;
 }
 
+bool Renderable::getBounds(float UNUSED(min)[3], float UNUSED(max)[3]) const {
+	return false;
+}
+
 void Renderable::lockFrame() {
 	GfxMan.lockFrame();
 }
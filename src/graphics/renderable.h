@@ -81,6 +81,12 @@ public:
 	/** Does the line from x1.y1.z1 to x2.y2.z2 intersect with the object? */
 	virtual bool isIn(float x1, float y1, float z1, float x2, float y2, float z2) const;
 
+	/** Get the object's axis-aligned bounding box in world coordinates.
+	 *
+	 *  Objects without a bounding box return false and are never culled.
+	 */
+	virtual bool getBounds(float min[3], float max[3]) const;
+
 protected:
 	QueueType _queueExists;
 	QueueType _queueVisible;
@@ -92,6 +98,8 @@ protected:
 
 	double _distance; ///< The distance of the object from the viewer.
 
+	bool _culled; ///< Was the object outside the view frustum in the current frame?
+
 	void resort();
 
 	void lockFrame();
@@ -99,6 +107,8 @@ protected:
 
 	void lockFrameIfVisible();
 	void unlockFrameIfVisible();
+
+	friend class GraphicsManager;
 };
 
 } // End of namespace Graphics
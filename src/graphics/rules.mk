@@ -27,6 +27,7 @@ src_graphics_libgraphics_la_SOURCES += \
     src/graphics/windowman.h \
     src/graphics/graphics.h \
     src/graphics/fpscounter.h \
+    src/graphics/gputimer.h \
     src/graphics/icon.h \
     src/graphics/cursor.h \
     src/graphics/queueman.h \
@@ -43,12 +44,15 @@ src_graphics_libgraphics_la_SOURCES += \
     src/graphics/ttf.h \
     src/graphics/indexbuffer.h \
     src/graphics/vertexbuffer.h \
+    src/graphics/frustum.h \
+    src/graphics/bvh.h \
     $(EMPTY)
 
 src_graphics_libgraphics_la_SOURCES += \
     src/graphics/windowman.cpp \
     src/graphics/graphics.cpp \
     src/graphics/fpscounter.cpp \
+    src/graphics/gputimer.cpp \
     src/graphics/icon.cpp \
     src/graphics/cursor.cpp \
     src/graphics/queueman.cpp \
@@ -62,6 +66,8 @@ src_graphics_libgraphics_la_SOURCES += \
     src/graphics/ttf.cpp \
     src/graphics/indexbuffer.cpp \
     src/graphics/vertexbuffer.cpp \
+    src/graphics/frustum.cpp \
+    src/graphics/bvh.cpp \
     $(EMPTY)
 
 src_graphics_libgraphics_la_LIBADD = \
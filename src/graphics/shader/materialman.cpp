@@ -50,18 +50,18 @@ void MaterialManager::init() {
 		color[2] = 1.0f;
 		color[3] = 1.0f;
 	}
-	_resourceMap[material->getName()] = material;
+	_resourceMap[Common::InternedString(material->getName())] = material;
 }
 
 void MaterialManager::deinit() {
-	for (std::map<Common::UString, ShaderMaterial *>::iterator iter = _resourceMap.begin(); iter != _resourceMap.end(); ++iter) {
+	for (MaterialMap::iterator iter = _resourceMap.begin(); iter != _resourceMap.end(); ++iter) {
 		delete iter->second;
 	}
 	_resourceMap.clear();
 }
 
 void MaterialManager::cleanup() {
-	std::map<Common::UString, ShaderMaterial *>::iterator iter = _resourceMap.begin();
+	MaterialMap::iterator iter = _resourceMap.begin();
 	while (iter != _resourceMap.end()) {
 		ShaderMaterial *material = iter->second;
 		if (material->useCount() == 0) {
@@ -77,9 +77,11 @@ void MaterialManager::addMaterial(ShaderMaterial *material) {
 		return;
 	}
 
-	std::map<Common::UString, ShaderMaterial *>::iterator iter = _resourceMap.find(material->getName());
+	const Common::InternedString name(material->getName());
+
+	MaterialMap::iterator iter = _resourceMap.find(name);
 	if (iter == _resourceMap.end()) {
-		_resourceMap[material->getName()] = material;
+		_resourceMap[name] = material;
 	}
 }
 
@@ -88,14 +90,25 @@ void MaterialManager::delMaterial(ShaderMaterial *material) {
 		return;
 	}
 
-	std::map<Common::UString, ShaderMaterial *>::iterator iter = _resourceMap.find(material->getName());
+	Common::InternedString name;
+	if (!Common::InternedString::lookup(material->getName(), name)) {
+		return;
+	}
+
+	MaterialMap::iterator iter = _resourceMap.find(name);
 	if (iter != _resourceMap.end()) {
 		delResource(iter);
 	}
 }
 
 ShaderMaterial *MaterialManager::getMaterial(const Common::UString &name) {
-	std::map<Common::UString, ShaderMaterial *>::iterator iter = _resourceMap.find(name);
+	// A name that was never interned can't be in the map
+	Common::InternedString internedName;
+	if (!Common::InternedString::lookup(name, internedName)) {
+		return 0;
+	}
+
+	MaterialMap::iterator iter = _resourceMap.find(internedName);
 	if (iter != _resourceMap.end()) {
 		return iter->second;
 	} else {
@@ -103,13 +116,10 @@ ShaderMaterial *MaterialManager::getMaterial(const Common::UString &name) {
 	}
 }
 
-std::map<Common::UString, ShaderMaterial *>::iterator MaterialManager::delResource(std::map<Common::UString, ShaderMaterial *>::iterator iter) {
-	std::map<Common::UString, ShaderMaterial *>::iterator inext = iter;
-	inext++;
+MaterialManager::MaterialMap::iterator MaterialManager::delResource(MaterialMap::iterator iter) {
 	delete iter->second;
-	_resourceMap.erase(iter);
 
-	return inext;
+	return _resourceMap.erase(iter);
 }
 
 } // End of namespace Shader
@@ -25,9 +25,10 @@
 #ifndef GRAPHICS_SHADER_MATERIALMAN_H
 #define GRAPHICS_SHADER_MATERIALMAN_H
 
-#include <map>
+#include <boost/unordered_map.hpp>
 
 #include "src/common/ustring.h"
+#include "src/common/internedstring.h"
 #include "src/common/singleton.h"
 #include "src/common/mutex.h"
 
@@ -61,9 +62,11 @@ public:
 	ShaderMaterial *getMaterial(const Common::UString &name);
 
 private:
-	std::map<Common::UString, ShaderMaterial *> _resourceMap;
+	typedef boost::unordered_map<Common::InternedString, ShaderMaterial *, Common::hashInternedString> MaterialMap;
 
-	std::map<Common::UString, ShaderMaterial *>::iterator delResource(std::map<Common::UString, ShaderMaterial *>::iterator iter);
+	MaterialMap _resourceMap;
+
+	MaterialMap::iterator delResource(MaterialMap::iterator iter);
 };
 
 } // End of namespace Shader
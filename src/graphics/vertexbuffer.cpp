@@ -26,6 +26,8 @@
 #include <cstring>
 #include <cassert>
 
+#include "glm/gtc/type_ptr.hpp"
+
 #include "src/graphics/vertexbuffer.h"
 #include "src/graphics/indexbuffer.h"
 
@@ -292,4 +294,23 @@ void VertexBuffer::draw(GLenum mode, const IndexBuffer &indexBuffer) const {
 		d->disable();
 }
 
+void VertexBuffer::draw(GLenum mode, const IndexBuffer &indexBuffer,
+                        const std::vector<glm::mat4> &transforms) const {
+
+	if ((getCount() == 0) || (indexBuffer.getCount() == 0) || transforms.empty())
+		return;
+
+	// Set up the vertex attributes only once for all draws
+	for (VertexDecl::const_iterator d = _decl.begin(); d != _decl.end(); ++d)
+		d->enable();
+
+	for (std::vector<glm::mat4>::const_iterator t = transforms.begin(); t != transforms.end(); ++t) {
+		glLoadMatrixf(glm::value_ptr(*t));
+		glDrawElements(mode, indexBuffer.getCount(), indexBuffer.getType(), indexBuffer.getData());
+	}
+
+	for (VertexDecl::const_iterator d = _decl.begin(); d != _decl.end(); ++d)
+		d->disable();
+}
+
 } // End of namespace Graphics
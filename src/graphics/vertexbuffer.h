@@ -27,6 +27,8 @@
 
 #include <vector>
 
+#include "glm/mat4x4.hpp"
+
 #include "src/graphics/types.h"
 
 namespace Graphics {
@@ -130,6 +132,8 @@ public:
 
 	/** Draw this IndexBuffer/VertexBuffer combination. */
 	void draw(GLenum mode, const IndexBuffer &indexBuffer) const;
+	/** Draw this IndexBuffer/VertexBuffer combination once with each of these modelview matrices. */
+	void draw(GLenum mode, const IndexBuffer &indexBuffer, const std::vector<glm::mat4> &transforms) const;
 
 private:
 	VertexDecl _decl; ///< Vertex declaration.
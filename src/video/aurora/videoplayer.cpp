@@ -28,6 +28,7 @@
 #include "src/common/error.h"
 #include "src/common/ustring.h"
 #include "src/common/readstream.h"
+#include "src/common/readfile.h"
 #include "src/common/debug.h"
 
 #include "src/video/decoder.h"
@@ -47,6 +48,9 @@ namespace Video {
 
 namespace Aurora {
 
+/** Read-ahead for videos streamed directly from a file. */
+static const size_t kVideoFileBufferSize = 256 * 1024;
+
 VideoPlayer::VideoPlayer(const Common::UString &video) {
 	load(video);
 }
@@ -62,6 +66,13 @@ void VideoPlayer::load(const Common::UString &name) {
 	if (!video)
 		throw Common::Exception("No such video resource \"%s\"", name.c_str());
 
+	// Videos are read from start to end, in fairly big chunks
+	Common::ReadFile *videoFile = dynamic_cast<Common::ReadFile *>(video.get());
+	if (videoFile) {
+		videoFile->setBufferSize(kVideoFileBufferSize);
+		videoFile->setAccessHint(Common::ReadFile::kAccessSequential);
+	}
+
 	// Loading the different video formats
 	switch (type) {
 		case ::Aurora::kFileTypeBIK:
@@ -40,6 +40,8 @@
 #include "src/common/threads.h"
 #include "src/common/debugman.h"
 #include "src/common/configman.h"
+#include "src/common/frametimes.h"
+#include "src/common/internedstring.h"
 #include "src/common/xml.h"
 
 #include "src/aurora/resman.h"
@@ -285,6 +287,9 @@ static void init() {
 	// Init threading system
 	Common::initThreads();
 
+	// Create the string interner before any other thread could race to do it
+	Common::StringInterner::instance();
+
 	// Init libxml2
 	Common::initXML();
 
@@ -333,6 +338,9 @@ static void deinit() {
 	Graphics::GraphicsManager::destroy();
 	Graphics::QueueManager::destroy();
 
+	// Common::StringInterner is deliberately leaked, see its documentation
+
+	Common::FrameTimesManager::destroy();
 	Common::DebugManager::destroy();
 	Common::ConfigManager::destroy();
 }
@@ -241,3 +241,31 @@ GTEST_TEST(ActionScript, TestClass2) {
 	delete streama;
 	delete streamb;
 }
+
+GTEST_TEST(ActionScript, TestClassInstances) {
+	Common::MemoryReadStream *stream = new Common::MemoryReadStream(kTestClass);
+	Aurora::ActionScript::ASBuffer asBuffer(stream);
+	delete stream;
+
+	Aurora::ActionScript::AVM avm;
+	asBuffer.run(avm);
+
+	// The member lookups in the methods are cached, make sure they stay per object
+	Aurora::ActionScript::ObjectPtr obj1 = avm.createNewObject("Test").asObject();
+	Aurora::ActionScript::ObjectPtr obj2 = avm.createNewObject("Test").asObject();
+
+	for (int i = 0; i < 3; i++) {
+		obj1->call("inc", avm);
+		obj2->call("dec", avm);
+	}
+
+	EXPECT_EQ(obj1->call("getI", avm).asNumber(), 4);
+	EXPECT_EQ(obj2->call("getI", avm).asNumber(), -2);
+
+	obj1.reset();
+	Aurora::ActionScript::ObjectPtr obj3 = avm.createNewObject("Test").asObject();
+
+	obj3->call("inc", avm);
+	EXPECT_EQ(obj3->call("getI", avm).asNumber(), 2);
+	EXPECT_EQ(obj2->call("getI", avm).asNumber(), -2);
+}
@@ -0,0 +1,179 @@
+/* xoreos - A reimplementation of BioWare's Aurora engine
+ *
+ * xoreos is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * xoreos is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * xoreos is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with xoreos. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  Unit tests for our Lua script manager and its bindings.
+ *
+ *  The "bindings" test case also serves as a headless benchmark of
+ *  the C++ <-> Lua call overhead. Its run time is reported by gtest.
+ */
+
+#include "gtest/gtest.h"
+
+#include "src/common/ustring.h"
+#include "src/common/error.h"
+
+#include "src/aurora/lua/scriptman.h"
+#include "src/aurora/lua/stack.h"
+#include "src/aurora/lua/variable.h"
+#include "src/aurora/lua/util.h"
+
+struct TestVector {
+	float x, y, z;
+};
+
+static const char *kTestVectorType = "TestVector";
+
+static int luaTestVectorNew(lua_State *state) {
+	Aurora::Lua::Stack stack(*state);
+
+	TestVector *v = new TestVector;
+	v->x = stack.getFloatAt(2);
+	v->y = stack.getFloatAt(3);
+	v->z = stack.getFloatAt(4);
+
+	stack.pushUserType<TestVector>(*v, kTestVectorType);
+	stack.registerGCForTopObject();
+	return 1;
+}
+
+static int luaTestVectorLength2(lua_State *state) {
+	Aurora::Lua::Stack stack(*state);
+
+	const TestVector *v = Aurora::Lua::getCppObjectFromStack<TestVector>(stack, 1);
+
+	stack.pushFloat(v->x * v->x + v->y * v->y + v->z * v->z);
+	return 1;
+}
+
+static int luaTestVectorGetX(lua_State *state) {
+	Aurora::Lua::Stack stack(*state);
+
+	stack.pushFloat(stack.getUserTypeAt<TestVector>(1, kTestVectorType)->x);
+	return 1;
+}
+
+static void registerTestVector() {
+	LuaScriptMan.declareClass(kTestVectorType);
+
+	LuaScriptMan.beginRegister();
+
+	LuaScriptMan.beginRegisterClass(kTestVectorType, "", LUA_DEFAULT_DELETER(TestVector));
+	LuaScriptMan.registerFunction("new_local", &luaTestVectorNew);
+	LuaScriptMan.registerFunction("length2", &luaTestVectorLength2);
+	LuaScriptMan.registerVariable("x", &luaTestVectorGetX);
+	LuaScriptMan.endRegisterClass();
+
+	LuaScriptMan.endRegister();
+}
+
+GTEST_TEST(LuaScriptManager, callFunction) {
+	LuaScriptMan.init();
+
+	LuaScriptMan.executeString("function add(a, b) return a + b end");
+	LuaScriptMan.executeString("ns = { inner = { mul = function(a, b) return a * b end } }");
+
+	Aurora::Lua::Variables params;
+	params.push_back(3.0f);
+	params.push_back(4.0f);
+
+	for (int i = 0; i < 2; i++) {
+		const Aurora::Lua::Variables add = LuaScriptMan.callFunction("add", params);
+		ASSERT_EQ(add.size(), 1U);
+		EXPECT_FLOAT_EQ(add[0].getFloat(), 7.0f);
+
+		const Aurora::Lua::Variables mul = LuaScriptMan.callFunction("ns.inner.mul", params);
+		ASSERT_EQ(mul.size(), 1U);
+		EXPECT_FLOAT_EQ(mul[0].getFloat(), 12.0f);
+	}
+
+	LuaScriptMan.deinit();
+}
+
+GTEST_TEST(LuaScriptManager, callFunctionRedefined) {
+	LuaScriptMan.init();
+
+	LuaScriptMan.executeString("function value() return 1 end");
+	EXPECT_FLOAT_EQ(LuaScriptMan.callFunction("value")[0].getFloat(), 1.0f);
+
+	LuaScriptMan.executeString("function value() return 2 end");
+	EXPECT_FLOAT_EQ(LuaScriptMan.callFunction("value")[0].getFloat(), 2.0f);
+
+	EXPECT_THROW(LuaScriptMan.callFunction("nonexistent"), Common::Exception);
+
+	LuaScriptMan.deinit();
+}
+
+GTEST_TEST(LuaScriptManager, callFunctionReassigned) {
+	LuaScriptMan.init();
+
+	LuaScriptMan.executeString("function value() return 1 end");
+	LuaScriptMan.executeString("function setValue() value = function() return 2 end end");
+	LuaScriptMan.executeString("ns = { value = function() return 3 end }");
+	LuaScriptMan.executeString("function setNamespace() ns = { value = function() return 4 end } end");
+	LuaScriptMan.executeString("function removeNamespace() ns = nil end");
+
+	EXPECT_FLOAT_EQ(LuaScriptMan.callFunction("value")[0].getFloat(), 1.0f);
+	EXPECT_FLOAT_EQ(LuaScriptMan.callFunction("ns.value")[0].getFloat(), 3.0f);
+
+	// Functions reassigned by called Lua code, not by executing new code
+	LuaScriptMan.callFunction("setValue");
+	EXPECT_FLOAT_EQ(LuaScriptMan.callFunction("value")[0].getFloat(), 2.0f);
+
+	LuaScriptMan.callFunction("setNamespace");
+	EXPECT_FLOAT_EQ(LuaScriptMan.callFunction("ns.value")[0].getFloat(), 4.0f);
+
+	LuaScriptMan.callFunction("removeNamespace");
+	EXPECT_THROW(LuaScriptMan.callFunction("ns.value"), Common::Exception);
+
+	LuaScriptMan.deinit();
+}
+
+GTEST_TEST(LuaScriptManager, bindings) {
+	static const int kIterations = 10000;
+
+	LuaScriptMan.init();
+	registerTestVector();
+
+	LuaScriptMan.executeString(
+		"function bench(n)"
+		"    local sum = 0"
+		"    for i = 1, n do"
+		"        local v = TestVector:new_local(1, 2, i)"
+		"        sum = sum + v:length2() - v.x"
+		"    end"
+		"    return sum "
+		"end");
+
+	float expected = 0.0f;
+	for (int i = 1; i <= 100; i++)
+		expected += 1.0f + 4.0f + i * i - 1.0f;
+
+	Aurora::Lua::Variables params;
+	params.push_back(100.0f);
+
+	for (int i = 0; i < kIterations / 100; i++) {
+		const Aurora::Lua::Variables result = LuaScriptMan.callFunction("bench", params);
+		ASSERT_EQ(result.size(), 1U);
+		EXPECT_FLOAT_EQ(result[0].getFloat(), expected);
+	}
+
+	LuaScriptMan.deinit();
+}
@@ -0,0 +1,391 @@
+/* xoreos - A reimplementation of BioWare's Aurora engine
+ *
+ * xoreos is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * xoreos is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * xoreos is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with xoreos. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  Unit tests and benchmark for the NWScript virtual machine.
+ *
+ *  The scripts are small, handcrafted NCS files. Engine functions are
+ *  mocked, and every call to them is recorded into a trace, which is
+ *  then compared against the expected one.
+ *
+ *  The benchmark test case records the number of executed instructions
+ *  per second and the number of memory allocations per run as gtest
+ *  properties, which end up in the XML output.
+ */
+
+#include <cstdlib>
+#include <ctime>
+#include <new>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "src/common/ustring.h"
+#include "src/common/memreadstream.h"
+
+#include "src/aurora/nwscript/types.h"
+#include "src/aurora/nwscript/variable.h"
+#include "src/aurora/nwscript/functioncontext.h"
+#include "src/aurora/nwscript/functionman.h"
+#include "src/aurora/nwscript/ncsfile.h"
+
+// --- Counting memory allocations ---
+
+/* Our replacement operator delete hands the memory to free(). Since it comes
+ * from malloc() in our operator new, that's fine, but GCC only sees the
+ * operator new/free() pair when inlining and warns about the mismatch. */
+#if defined(__GNUC__) && !defined(__clang__) && (__GNUC__ >= 11)
+	#define START_IGNORE_MISMATCHED_NEW_DELETE _Pragma("GCC diagnostic push") \
+	                                           _Pragma("GCC diagnostic ignored \"-Wmismatched-new-delete\"")
+	#define STOP_IGNORE_MISMATCHED_NEW_DELETE _Pragma("GCC diagnostic pop")
+#else
+	#define START_IGNORE_MISMATCHED_NEW_DELETE
+	#define STOP_IGNORE_MISMATCHED_NEW_DELETE
+#endif
+
+static size_t allocationCount = 0;
+
+static void *countedAllocate(std::size_t size) {
+	allocationCount++;
+
+	return std::malloc(size ? size : 1);
+}
+
+START_IGNORE_MISMATCHED_NEW_DELETE
+
+#if __cplusplus >= 201103L
+void *operator new(std::size_t size) {
+#else
+void *operator new(std::size_t size) throw(std::bad_alloc) {
+#endif
+	void *ptr = countedAllocate(size);
+	if (!ptr)
+		throw std::bad_alloc();
+
+	return ptr;
+}
+
+#if __cplusplus >= 201103L
+void *operator new[](std::size_t size) {
+#else
+void *operator new[](std::size_t size) throw(std::bad_alloc) {
+#endif
+	void *ptr = countedAllocate(size);
+	if (!ptr)
+		throw std::bad_alloc();
+
+	return ptr;
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) throw() {
+	return countedAllocate(size);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) throw() {
+	return countedAllocate(size);
+}
+
+void operator delete(void *ptr) throw() {
+	std::free(ptr);
+}
+
+void operator delete[](void *ptr) throw() {
+	std::free(ptr);
+}
+
+void operator delete(void *ptr, const std::nothrow_t &) throw() {
+	std::free(ptr);
+}
+
+void operator delete[](void *ptr, const std::nothrow_t &) throw() {
+	std::free(ptr);
+}
+
+#if defined(__cpp_sized_deallocation)
+void operator delete(void *ptr, std::size_t) throw() {
+	std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t) throw() {
+	std::free(ptr);
+}
+#endif
+
+STOP_IGNORE_MISMATCHED_NEW_DELETE
+
+// --- Mocked engine functions ---
+
+static std::vector<Common::UString> engineTrace;
+
+/** void PrintInteger(int nInteger) */
+static void mockPrintInteger(Aurora::NWScript::FunctionContext &ctx) {
+	engineTrace.push_back(Common::UString::format("PrintInteger(%d)", ctx.getParams()[0].getInt()));
+}
+
+/** int GetStringLength(string sString) */
+static void mockGetStringLength(Aurora::NWScript::FunctionContext &ctx) {
+	const Common::UString &string = ctx.getParams()[0].getString();
+
+	engineTrace.push_back(Common::UString::format("GetStringLength(\"%s\")", string.c_str()));
+	ctx.getReturn() = (int32) string.size();
+}
+
+/** void Count(int nInteger), for the benchmark. */
+static void mockCount(Aurora::NWScript::FunctionContext &UNUSED(ctx)) {
+}
+
+static void registerMockFunctions(bool benchmark = false) {
+	using namespace Aurora::NWScript;
+
+	FunctionMan.clear();
+	engineTrace.clear();
+
+	Signature printInteger;
+	printInteger.push_back(kTypeVoid);
+	printInteger.push_back(kTypeInt);
+
+	Signature getStringLength;
+	getStringLength.push_back(kTypeInt);
+	getStringLength.push_back(kTypeString);
+
+	FunctionMan.registerFunction("PrintInteger", 0, benchmark ? &mockCount : &mockPrintInteger, printInteger);
+	FunctionMan.registerFunction("GetStringLength", 1, &mockGetStringLength, getStringLength);
+}
+
+// --- NCS fixtures ---
+
+/*
+ *  int main() {
+ *      return ((2 + 3) * 4 - 6) % 5;
+ *  }
+ */
+static const byte kNCSArithmetic[] = {
+	'N', 'C', 'S', ' ', 'V', '1', '.', '0', 0x42, 0x00, 0x00, 0x00, 0x33,
+	0x04, 0x03, 0x00, 0x00, 0x00, 0x02,       // 13: CONSTI 2
+	0x04, 0x03, 0x00, 0x00, 0x00, 0x03,       // 19: CONSTI 3
+	0x14, 0x20,                               // 25: ADDII
+	0x04, 0x03, 0x00, 0x00, 0x00, 0x04,       // 27: CONSTI 4
+	0x16, 0x20,                               // 33: MULII
+	0x04, 0x03, 0x00, 0x00, 0x00, 0x06,       // 35: CONSTI 6
+	0x15, 0x20,                               // 41: SUBII
+	0x04, 0x03, 0x00, 0x00, 0x00, 0x05,       // 43: CONSTI 5
+	0x18, 0x20                                // 49: MODII
+};
+
+/*
+ *  int main() {
+ *      int i;
+ *      for (i = 0; i < 10; i++)
+ *          PrintInteger(i);
+ *      return i;
+ *  }
+ */
+static const byte kNCSLoop[] = {
+	'N', 'C', 'S', ' ', 'V', '1', '.', '0', 0x42, 0x00, 0x00, 0x00, 0x52,
+	0x02, 0x03,                                     // 13: RSADDI
+	0x04, 0x03, 0x00, 0x00, 0x00, 0x00,             // 15: CONSTI 0
+	0x01, 0x01, 0xFF, 0xFF, 0xFF, 0xF8, 0x00, 0x04, // 21: CPDOWNSP -8, 4
+	0x1B, 0x00, 0xFF, 0xFF, 0xFF, 0xFC,             // 29: MOVSP -4
+	0x03, 0x01, 0xFF, 0xFF, 0xFF, 0xFC, 0x00, 0x04, // 35: CPTOPSP -4, 4
+	0x04, 0x03, 0x00, 0x00, 0x00, 0x0A,             // 43: CONSTI 10
+	0x0F, 0x20,                                     // 49: LTII
+	0x1F, 0x00, 0x00, 0x00, 0x00, 0x1F,             // 51: JZ 82
+	0x03, 0x01, 0xFF, 0xFF, 0xFF, 0xFC, 0x00, 0x04, // 57: CPTOPSP -4, 4
+	0x05, 0x00, 0x00, 0x00, 0x01,                   // 65: ACTION PrintInteger, 1
+	0x24, 0x03, 0xFF, 0xFF, 0xFF, 0xFC,             // 70: INCSPI -4
+	0x1D, 0x00, 0xFF, 0xFF, 0xFF, 0xD7              // 76: JMP 35
+};
+
+/** Offset of the loop count in kNCSLoop. */
+static const size_t kNCSLoopCountOffset = 45;
+
+/*
+ *  int sub() {
+ *      return 42;
+ *  }
+ *
+ *  int main() {
+ *      return sub();
+ *  }
+ */
+static const byte kNCSSubroutine[] = {
+	'N', 'C', 'S', ' ', 'V', '1', '.', '0', 0x42, 0x00, 0x00, 0x00, 0x1D,
+	0x1E, 0x00, 0x00, 0x00, 0x00, 0x08,       // 13: JSR 21
+	0x20, 0x00,                               // 19: RETN
+	0x04, 0x03, 0x00, 0x00, 0x00, 0x2A,       // 21: CONSTI 42
+	0x20, 0x00                                // 27: RETN
+};
+
+/*
+ *  int main() {
+ *      return GetStringLength("hello");
+ *  }
+ */
+static const byte kNCSString[] = {
+	'N', 'C', 'S', ' ', 'V', '1', '.', '0', 0x42, 0x00, 0x00, 0x00, 0x1B,
+	0x04, 0x05, 0x00, 0x05, 'h', 'e', 'l', 'l', 'o', // 13: CONSTS "hello"
+	0x05, 0x00, 0x00, 0x01, 0x01                     // 22: ACTION GetStringLength, 1
+};
+
+static const char * const kTraceLoop[] = {
+	"PrintInteger(0)", "PrintInteger(1)", "PrintInteger(2)", "PrintInteger(3)", "PrintInteger(4)",
+	"PrintInteger(5)", "PrintInteger(6)", "PrintInteger(7)", "PrintInteger(8)", "PrintInteger(9)"
+};
+
+static const char * const kTraceString[] = {
+	"GetStringLength(\"hello\")"
+};
+
+template<size_t N>
+static void expectTrace(const char * const (&trace)[N]) {
+	ASSERT_EQ(engineTrace.size(), N);
+
+	for (size_t i = 0; i < N; i++)
+		EXPECT_STREQ(engineTrace[i].c_str(), trace[i]) << "At index " << i;
+}
+
+static Aurora::NWScript::NCSFile *loadNCS(const byte *data, size_t size) {
+	return new Aurora::NWScript::NCSFile(new Common::MemoryReadStream(data, size));
+}
+
+// --- Tests ---
+
+GTEST_TEST(NWScriptNCSFile, arithmetic) {
+	registerMockFunctions();
+
+	Common::ScopedPtr<Aurora::NWScript::NCSFile> ncs(loadNCS(kNCSArithmetic, sizeof(kNCSArithmetic)));
+
+	const Aurora::NWScript::Variable &ret = ncs->run();
+	ASSERT_EQ(ret.getType(), Aurora::NWScript::kTypeInt);
+	EXPECT_EQ(ret.getInt(), 4);
+
+	EXPECT_EQ(ncs->getInstructionCount(), 9U);
+	EXPECT_TRUE(engineTrace.empty());
+}
+
+GTEST_TEST(NWScriptNCSFile, loop) {
+	registerMockFunctions();
+
+	Common::ScopedPtr<Aurora::NWScript::NCSFile> ncs(loadNCS(kNCSLoop, sizeof(kNCSLoop)));
+
+	const Aurora::NWScript::Variable &ret = ncs->run();
+	ASSERT_EQ(ret.getType(), Aurora::NWScript::kTypeInt);
+	EXPECT_EQ(ret.getInt(), 10);
+
+	expectTrace(kTraceLoop);
+
+	// Running it again has to give the same results
+	engineTrace.clear();
+
+	EXPECT_EQ(ncs->run().getInt(), 10);
+	expectTrace(kTraceLoop);
+}
+
+GTEST_TEST(NWScriptNCSFile, loopTimeSliced) {
+	registerMockFunctions();
+
+	Common::ScopedPtr<Aurora::NWScript::NCSFile> ncs(loadNCS(kNCSLoop, sizeof(kNCSLoop)));
+
+	ncs->start(Aurora::NWScript::NCSFile::getEmptyState());
+
+	size_t slices = 0;
+	while (ncs->isRunning()) {
+		size_t budget = 5;
+		ncs->resume(budget);
+
+		slices++;
+	}
+
+	EXPECT_GT(slices, 1U);
+	EXPECT_EQ(ncs->getReturn().getInt(), 10);
+
+	expectTrace(kTraceLoop);
+}
+
+GTEST_TEST(NWScriptNCSFile, subroutine) {
+	registerMockFunctions();
+
+	Common::ScopedPtr<Aurora::NWScript::NCSFile> ncs(loadNCS(kNCSSubroutine, sizeof(kNCSSubroutine)));
+
+	const Aurora::NWScript::Variable &ret = ncs->run();
+	ASSERT_EQ(ret.getType(), Aurora::NWScript::kTypeInt);
+	EXPECT_EQ(ret.getInt(), 42);
+
+	EXPECT_EQ(ncs->getInstructionCount(), 4U);
+}
+
+GTEST_TEST(NWScriptNCSFile, engineString) {
+	registerMockFunctions();
+
+	Common::ScopedPtr<Aurora::NWScript::NCSFile> ncs(loadNCS(kNCSString, sizeof(kNCSString)));
+
+	const Aurora::NWScript::Variable &ret = ncs->run();
+	ASSERT_EQ(ret.getType(), Aurora::NWScript::kTypeInt);
+	EXPECT_EQ(ret.getInt(), 5);
+
+	expectTrace(kTraceString);
+}
+
+GTEST_TEST(NWScriptNCSFile, illegalInstruction) {
+	static const byte kNCSIllegal[] = {
+		'N', 'C', 'S', ' ', 'V', '1', '.', '0', 0x42, 0x00, 0x00, 0x00, 0x0F,
+		0x2E, 0x00
+	};
+
+	registerMockFunctions();
+
+	Common::ScopedPtr<Aurora::NWScript::NCSFile> ncs(loadNCS(kNCSIllegal, sizeof(kNCSIllegal)));
+
+	EXPECT_THROW(ncs->run(), Common::Exception);
+}
+
+GTEST_TEST(NWScriptNCSFile, benchmark) {
+	static const uint32 kLoopCount = 100000;
+
+	registerMockFunctions(true);
+
+	std::vector<byte> script(kNCSLoop, kNCSLoop + sizeof(kNCSLoop));
+	script[kNCSLoopCountOffset + 0] = (kLoopCount >> 24) & 0xFF;
+	script[kNCSLoopCountOffset + 1] = (kLoopCount >> 16) & 0xFF;
+	script[kNCSLoopCountOffset + 2] = (kLoopCount >>  8) & 0xFF;
+	script[kNCSLoopCountOffset + 3] =  kLoopCount        & 0xFF;
+
+	Common::ScopedPtr<Aurora::NWScript::NCSFile> ncs(loadNCS(&script[0], script.size()));
+
+	// Warm up, to get the stack into its steady state
+	ncs->run();
+
+	const size_t allocationsStart = allocationCount;
+	const std::clock_t timeStart = std::clock();
+
+	EXPECT_EQ(ncs->run().getInt(), (int32) kLoopCount);
+
+	const std::clock_t timeEnd = std::clock();
+	const size_t allocations = allocationCount - allocationsStart;
+
+	const size_t instructions = ncs->getInstructionCount();
+	EXPECT_EQ(instructions, 4 + 8 * kLoopCount + 4);
+
+	const double seconds = (double) (timeEnd - timeStart) / CLOCKS_PER_SEC;
+	if (seconds > 0.0)
+		RecordProperty("InstructionsPerSecond", (int) (instructions / seconds));
+
+	RecordProperty("AllocationsPerRun", (int) allocations);
+}
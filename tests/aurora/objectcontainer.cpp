@@ -0,0 +1,140 @@
+/* xoreos - A reimplementation of BioWare's Aurora engine
+ *
+ * xoreos is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * xoreos is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * xoreos is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with xoreos. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  Unit tests for our NWScript object container.
+ */
+
+#include "gtest/gtest.h"
+
+#include "src/common/ustring.h"
+
+#include "src/aurora/nwscript/object.h"
+#include "src/aurora/nwscript/objectcontainer.h"
+
+class TestObject : public Aurora::NWScript::Object {
+public:
+	TestObject(uint32 id, const Common::UString &tag) {
+		_id  = id;
+		_tag = tag;
+	}
+};
+
+GTEST_TEST(NWScriptObjectContainer, getObjectByID) {
+	TestObject object1(1, "a"), object2(2, "b");
+
+	Aurora::NWScript::ObjectContainer container;
+	container.addObject(object1);
+	container.addObject(object2);
+
+	EXPECT_EQ(container.getObjectByID(1), &object1);
+	EXPECT_EQ(container.getObjectByID(2), &object2);
+	EXPECT_EQ(container.getObjectByID(3), (Aurora::NWScript::Object *) 0);
+}
+
+GTEST_TEST(NWScriptObjectContainer, findObjects) {
+	TestObject object1(1, "a"), object2(2, "b"), object3(3, "a");
+
+	Aurora::NWScript::ObjectContainer container;
+	EXPECT_EQ(container.getFirstObject(), (Aurora::NWScript::Object *) 0);
+	EXPECT_TRUE(container.findObjects().empty());
+
+	container.addObject(object1);
+	container.addObject(object2);
+	container.addObject(object3);
+
+	Aurora::NWScript::ObjectSearch search = container.findObjects();
+	ASSERT_EQ(search.size(), 3);
+
+	EXPECT_EQ(search.get() , &object1);
+	EXPECT_EQ(search.next(), &object1);
+	EXPECT_EQ(search.next(), &object2);
+	EXPECT_EQ(search.next(), &object3);
+	EXPECT_EQ(search.next(), (Aurora::NWScript::Object *) 0);
+	EXPECT_TRUE(search.empty());
+
+	EXPECT_EQ(container.getFirstObject(), &object1);
+}
+
+GTEST_TEST(NWScriptObjectContainer, findObjectsByTag) {
+	TestObject object1(1, "a"), object2(2, "b"), object3(3, "a");
+
+	Aurora::NWScript::ObjectContainer container;
+	container.addObject(object1);
+	container.addObject(object2);
+	container.addObject(object3);
+
+	Aurora::NWScript::ObjectSearch search = container.findObjectsByTag("a");
+	ASSERT_EQ(search.size(), 2);
+
+	EXPECT_EQ(search.next(), &object1);
+	EXPECT_EQ(search.next(), &object3);
+	EXPECT_EQ(search.next(), (Aurora::NWScript::Object *) 0);
+
+	EXPECT_EQ(container.getFirstObjectByTag("b"), &object2);
+	EXPECT_EQ(container.getFirstObjectByTag("c"), (Aurora::NWScript::Object *) 0);
+	EXPECT_TRUE(container.findObjectsByTag("c").empty());
+}
+
+GTEST_TEST(NWScriptObjectContainer, findObjectsByType) {
+	TestObject object1(1, "a"), object2(2, "b"), object3(3, "c");
+
+	Aurora::NWScript::ObjectContainer container;
+	container.addObject(object1, 4);
+	container.addObject(object2, 8);
+	container.addObject(object3, 4);
+
+	Aurora::NWScript::ObjectSearch search = container.findObjectsByType(4);
+	ASSERT_EQ(search.size(), 2);
+
+	EXPECT_EQ(search.next(), &object1);
+	EXPECT_EQ(search.next(), &object3);
+
+	EXPECT_EQ(container.getFirstObjectByType(8), &object2);
+	EXPECT_EQ(container.getFirstObjectByType(16), (Aurora::NWScript::Object *) 0);
+}
+
+GTEST_TEST(NWScriptObjectContainer, removeObject) {
+	TestObject object1(1, "a"), object2(2, "b"), object3(3, "a");
+
+	Aurora::NWScript::ObjectContainer container;
+	container.addObject(object1, 4);
+	container.addObject(object2, 4);
+	container.addObject(object3, 4);
+
+	container.removeObject(object1, 4);
+
+	EXPECT_EQ(container.getObjectByID(1), (Aurora::NWScript::Object *) 0);
+	EXPECT_EQ(container.getFirstObject(), &object2);
+	EXPECT_EQ(container.getFirstObjectByTag("a"), &object3);
+	EXPECT_EQ(container.getFirstObjectByType(4), &object2);
+	EXPECT_EQ(container.findObjects().size(), 2);
+
+	container.removeObject(object3, 4);
+
+	EXPECT_EQ(container.getFirstObjectByTag("a"), (Aurora::NWScript::Object *) 0);
+	EXPECT_EQ(container.findObjectsByType(4).size(), 1);
+
+	container.clearObjects();
+
+	EXPECT_EQ(container.getFirstObject(), (Aurora::NWScript::Object *) 0);
+	EXPECT_EQ(container.getFirstObjectByTag("b"), (Aurora::NWScript::Object *) 0);
+	EXPECT_EQ(container.getFirstObjectByType(4), (Aurora::NWScript::Object *) 0);
+}
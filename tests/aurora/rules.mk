@@ -165,3 +165,27 @@ check_PROGRAMS                      += tests/aurora/test_erfwriter
 tests_aurora_test_erfwriter_SOURCES  = tests/aurora/erfwriter.cpp
 tests_aurora_test_erfwriter_LDADD    = $(aurora_LIBS)
 tests_aurora_test_erfwriter_CXXFLAGS = $(test_CXXFLAGS)
+
+check_PROGRAMS                            += tests/aurora/test_objectcontainer
+tests_aurora_test_objectcontainer_SOURCES  = tests/aurora/objectcontainer.cpp
+tests_aurora_test_objectcontainer_LDADD    = $(aurora_LIBS)
+tests_aurora_test_objectcontainer_CXXFLAGS = $(test_CXXFLAGS)
+
+check_PROGRAMS                         += tests/aurora/test_luascriptman
+tests_aurora_test_luascriptman_SOURCES  = tests/aurora/luascriptman.cpp
+tests_aurora_test_luascriptman_LDADD    = \
+    $(aurora_LIBS) \
+    toluapp/libtoluapp.la \
+    lua/liblua.la \
+    $(EMPTY)
+tests_aurora_test_luascriptman_CXXFLAGS = $(test_CXXFLAGS)
+
+check_PROGRAMS                    += tests/aurora/test_ncsfile
+tests_aurora_test_ncsfile_SOURCES  = tests/aurora/ncsfile.cpp
+tests_aurora_test_ncsfile_LDADD    = $(aurora_LIBS)
+tests_aurora_test_ncsfile_CXXFLAGS = $(test_CXXFLAGS)
+
+check_PROGRAMS                      += tests/aurora/test_scheduler
+tests_aurora_test_scheduler_SOURCES  = tests/aurora/scheduler.cpp
+tests_aurora_test_scheduler_LDADD    = $(aurora_LIBS)
+tests_aurora_test_scheduler_CXXFLAGS = $(test_CXXFLAGS)
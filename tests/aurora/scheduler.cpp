@@ -0,0 +1,333 @@
+/* xoreos - A reimplementation of BioWare's Aurora engine
+ *
+ * xoreos is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * xoreos is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * xoreos is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with xoreos. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  Unit tests for the NWScript script scheduler.
+ *
+ *  The scripts are small, handcrafted NCS files served from memory.
+ *  They print integers through a mocked engine function, which records
+ *  every call into a trace.
+ */
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "src/common/ustring.h"
+#include "src/common/memreadstream.h"
+
+#include "src/aurora/nwscript/types.h"
+#include "src/aurora/nwscript/variable.h"
+#include "src/aurora/nwscript/functioncontext.h"
+#include "src/aurora/nwscript/functionman.h"
+#include "src/aurora/nwscript/ncsfile.h"
+#include "src/aurora/nwscript/object.h"
+#include "src/aurora/nwscript/objectcontainer.h"
+#include "src/aurora/nwscript/scheduler.h"
+
+// --- Mocked engine functions ---
+
+static std::vector<int32> engineTrace;
+
+/** void PrintInteger(int nInteger) */
+static void mockPrintInteger(Aurora::NWScript::FunctionContext &ctx) {
+	engineTrace.push_back(ctx.getParams()[0].getInt());
+}
+
+static void registerMockFunctions() {
+	using namespace Aurora::NWScript;
+
+	FunctionMan.clear();
+	engineTrace.clear();
+
+	Signature printInteger;
+	printInteger.push_back(kTypeVoid);
+	printInteger.push_back(kTypeInt);
+
+	FunctionMan.registerFunction("PrintInteger", 0, &mockPrintInteger, printInteger);
+}
+
+// --- NCS fixtures ---
+
+/*
+ *  int main() {
+ *      int i;
+ *      for (i = 0; i < 10; i++)
+ *          PrintInteger(i);
+ *      return i;
+ *  }
+ */
+static const byte kNCSLoop[] = {
+	'N', 'C', 'S', ' ', 'V', '1', '.', '0', 0x42, 0x00, 0x00, 0x00, 0x52,
+	0x02, 0x03,                                     // 13: RSADDI
+	0x04, 0x03, 0x00, 0x00, 0x00, 0x00,             // 15: CONSTI 0
+	0x01, 0x01, 0xFF, 0xFF, 0xFF, 0xF8, 0x00, 0x04, // 21: CPDOWNSP -8, 4
+	0x1B, 0x00, 0xFF, 0xFF, 0xFF, 0xFC,             // 29: MOVSP -4
+	0x03, 0x01, 0xFF, 0xFF, 0xFF, 0xFC, 0x00, 0x04, // 35: CPTOPSP -4, 4
+	0x04, 0x03, 0x00, 0x00, 0x00, 0x0A,             // 43: CONSTI 10
+	0x0F, 0x20,                                     // 49: LTII
+	0x1F, 0x00, 0x00, 0x00, 0x00, 0x1F,             // 51: JZ 82
+	0x03, 0x01, 0xFF, 0xFF, 0xFF, 0xFC, 0x00, 0x04, // 57: CPTOPSP -4, 4
+	0x05, 0x00, 0x00, 0x00, 0x01,                   // 65: ACTION PrintInteger, 1
+	0x24, 0x03, 0xFF, 0xFF, 0xFF, 0xFC,             // 70: INCSPI -4
+	0x1D, 0x00, 0xFF, 0xFF, 0xFF, 0xD7              // 76: JMP 35
+};
+
+/** Budget kNCSLoop uses up: its instructions, plus the step hitting the end of the script. */
+static const size_t kNCSLoopInstructions = 4 + 8 * 10 + 4 + 1;
+
+/*
+ *  void main() {
+ *      PrintInteger(100);
+ *  }
+ */
+static const byte kNCSPrint[] = {
+	'N', 'C', 'S', ' ', 'V', '1', '.', '0', 0x42, 0x00, 0x00, 0x00, 0x18,
+	0x04, 0x03, 0x00, 0x00, 0x00, 0x64,       // 13: CONSTI 100
+	0x05, 0x00, 0x00, 0x00, 0x01              // 19: ACTION PrintInteger, 1
+};
+
+/** Offset of the lowest byte of the printed value in kNCSPrint. */
+static const size_t kNCSPrintValueOffset = 18;
+
+/** A scheduler loading our fixtures instead of real script resources.
+ *
+ *  "loop" is kNCSLoop, while "printN" is kNCSPrint printing the digit N.
+ */
+class TestScheduler : public Aurora::NWScript::ScriptScheduler {
+public:
+	TestScheduler(Aurora::NWScript::ObjectContainer &objects, size_t budget) :
+		Aurora::NWScript::ScriptScheduler(objects, 0, budget) {
+	}
+
+protected:
+	Aurora::NWScript::NCSFile *loadScript(const Common::UString &script) {
+		if (script == "loop")
+			return loadNCS(kNCSLoop, sizeof(kNCSLoop));
+
+		_print.assign(kNCSPrint, kNCSPrint + sizeof(kNCSPrint));
+		_print[kNCSPrintValueOffset] = *--script.end() - '0';
+
+		return loadNCS(&_print[0], _print.size());
+	}
+
+private:
+	std::vector<byte> _print;
+
+	static Aurora::NWScript::NCSFile *loadNCS(const byte *data, size_t size) {
+		return new Aurora::NWScript::NCSFile(new Common::MemoryReadStream(data, size));
+	}
+};
+
+class TestObject : public Aurora::NWScript::Object {
+public:
+	TestObject(uint32 id) {
+		_id = id;
+	}
+};
+
+// --- Tests ---
+
+GTEST_TEST(NWScriptScheduler, suspendAndResume) {
+	registerMockFunctions();
+
+	Aurora::NWScript::ObjectContainer objects;
+	TestScheduler scheduler(objects, 20);
+
+	scheduler.schedule("loop", 0, 0, 0);
+
+	// The first frame runs out of budget and suspends the script
+	EXPECT_EQ(scheduler.run(0), 20U);
+	EXPECT_FALSE(scheduler.empty());
+	EXPECT_EQ(scheduler.getBacklog(0), 1U);
+
+	const size_t printed = engineTrace.size();
+	EXPECT_GT(printed, 0U);
+	EXPECT_LT(printed, 10U);
+
+	// The next frame continues where the last one stopped
+	size_t frames = 1, executed = 20;
+	while (!scheduler.empty()) {
+		executed += scheduler.run(1);
+		frames++;
+
+		ASSERT_LT(frames, 100U);
+	}
+
+	EXPECT_EQ(executed, kNCSLoopInstructions);
+	EXPECT_EQ(frames, (kNCSLoopInstructions + 19) / 20);
+
+	ASSERT_EQ(engineTrace.size(), 10U);
+	for (size_t i = 0; i < engineTrace.size(); i++)
+		EXPECT_EQ(engineTrace[i], (int32) i) << "At index " << i;
+}
+
+GTEST_TEST(NWScriptScheduler, fifo) {
+	registerMockFunctions();
+
+	Aurora::NWScript::ObjectContainer objects;
+	TestScheduler scheduler(objects, 1000);
+
+	scheduler.schedule("print1", 0, 0, 20);
+	scheduler.schedule("print2", 0, 0, 10);
+	scheduler.schedule("print3", 0, 0, 10);
+	scheduler.schedule("print4", 0, 0, 20);
+	scheduler.schedule("print5", 0, 0, 30);
+
+	// Nothing is due yet
+	EXPECT_EQ(scheduler.run(5), 0U);
+	EXPECT_TRUE(engineTrace.empty());
+
+	// Ordered by timestamp, and in scheduling order within one timestamp
+	scheduler.run(20);
+
+	ASSERT_EQ(engineTrace.size(), 4U);
+	EXPECT_EQ(engineTrace[0], 2);
+	EXPECT_EQ(engineTrace[1], 3);
+	EXPECT_EQ(engineTrace[2], 1);
+	EXPECT_EQ(engineTrace[3], 4);
+
+	EXPECT_FALSE(scheduler.empty());
+	EXPECT_EQ(scheduler.getBacklog(20), 0U);
+	EXPECT_EQ(scheduler.getBacklog(30), 1U);
+}
+
+GTEST_TEST(NWScriptScheduler, fifoBacklog) {
+	registerMockFunctions();
+
+	Aurora::NWScript::ObjectContainer objects;
+	TestScheduler scheduler(objects, 20);
+
+	scheduler.schedule("loop"  , 0, 0, 0);
+	scheduler.schedule("print1", 0, 0, 0);
+	scheduler.schedule("print2", 0, 0, 0);
+
+	// The backlog is worked off in order, over several frames
+	uint32 now = 0;
+	while (!scheduler.empty()) {
+		scheduler.run(now++);
+
+		ASSERT_LT(now, 100U);
+	}
+
+	ASSERT_EQ(engineTrace.size(), 12U);
+	for (size_t i = 0; i < 10; i++)
+		EXPECT_EQ(engineTrace[i], (int32) i) << "At index " << i;
+
+	EXPECT_EQ(engineTrace[10], 1);
+	EXPECT_EQ(engineTrace[11], 2);
+}
+
+GTEST_TEST(NWScriptScheduler, budget) {
+	registerMockFunctions();
+
+	Aurora::NWScript::ObjectContainer objects;
+	TestScheduler scheduler(objects, 30);
+
+	EXPECT_EQ(scheduler.getBudget(), 30U);
+
+	for (size_t i = 0; i < 10; i++)
+		scheduler.schedule("loop", 0, 0, 0);
+
+	size_t executed = 0;
+	while (!scheduler.empty()) {
+		const size_t frame = scheduler.run(0);
+		EXPECT_LE(frame, 30U);
+
+		executed += frame;
+
+		ASSERT_LT(executed, 10 * kNCSLoopInstructions + 30);
+	}
+
+	EXPECT_EQ(executed, 10 * kNCSLoopInstructions);
+	EXPECT_EQ(engineTrace.size(), 100U);
+
+	// A changed budget is used for the next frame
+	scheduler.setBudget(50);
+	scheduler.schedule("loop", 0, 0, 0);
+
+	EXPECT_EQ(scheduler.run(0), 50U);
+	EXPECT_EQ(scheduler.runAll(0), kNCSLoopInstructions - 50);
+}
+
+GTEST_TEST(NWScriptScheduler, defaultBudget) {
+	Aurora::NWScript::ObjectContainer objects;
+	Aurora::NWScript::ScriptScheduler scheduler(objects);
+
+	EXPECT_EQ(scheduler.getBudget(), Aurora::NWScript::ScriptScheduler::kDefaultBudget);
+}
+
+GTEST_TEST(NWScriptScheduler, ownerRemoved) {
+	registerMockFunctions();
+
+	TestObject owner(1), triggerer(2);
+
+	Aurora::NWScript::ObjectContainer objects;
+	objects.addObject(owner);
+	objects.addObject(triggerer);
+
+	TestScheduler scheduler(objects, 1000);
+
+	scheduler.schedule("print1", &owner, &triggerer, 0);
+	scheduler.schedule("print2", &owner, &triggerer, 0);
+	scheduler.schedule("print3", 0    , &triggerer, 0);
+	scheduler.schedule("print4", &owner, 0        , 10);
+
+	scheduler.run(0);
+
+	ASSERT_EQ(engineTrace.size(), 3U);
+	EXPECT_EQ(engineTrace[2], 3);
+
+	// Scripts whose owner is gone are dropped
+	objects.removeObject(owner);
+
+	EXPECT_EQ(scheduler.run(10), 0U);
+	EXPECT_EQ(engineTrace.size(), 3U);
+	EXPECT_TRUE(scheduler.empty());
+}
+
+GTEST_TEST(NWScriptScheduler, triggererRemovedWhileSuspended) {
+	registerMockFunctions();
+
+	TestObject owner(1), triggerer(2);
+
+	Aurora::NWScript::ObjectContainer objects;
+	objects.addObject(owner);
+	objects.addObject(triggerer);
+
+	TestScheduler scheduler(objects, 20);
+
+	scheduler.schedule("loop"  , &owner, &triggerer, 0);
+	scheduler.schedule("print1", &owner, 0         , 0);
+
+	scheduler.run(0);
+
+	const size_t printed = engineTrace.size();
+	ASSERT_LT(printed, 10U);
+
+	// The suspended script is aborted, but the next one still runs
+	objects.removeObject(triggerer);
+
+	scheduler.run(1);
+
+	ASSERT_EQ(engineTrace.size(), printed + 1);
+	EXPECT_EQ(engineTrace.back(), 1);
+	EXPECT_TRUE(scheduler.empty());
+}
@@ -50,6 +50,27 @@ GTEST_TEST(XOREOS_ENCODINGNAME, isValidCodePoint) {
 	EXPECT_FALSE(Common::isValidCodepoint(kEncoding, 0x81));
 }
 
+GTEST_TEST(XOREOS_ENCODINGNAME, readStringUpperHalf) {
+	testSupport(kEncoding);
+
+	static const byte data[] = { 0x80, ' ', 0x9F, ' ', 0xFF };
+
+	const Common::UString string = Common::readString(data, sizeof(data), kEncoding);
+
+	EXPECT_EQ(string.size(), 5);
+	EXPECT_STREQ(string.c_str(), "\xe2\x82\xac"" ""\xc5\xb8"" ""\xc3\xbf");
+}
+
+GTEST_TEST(XOREOS_ENCODINGNAME, readStringUnmapped) {
+	testSupport(kEncoding);
+
+	static const byte data[] = { 'a', 0x81, 'b' };
+
+	const Common::UString string = Common::readString(data, sizeof(data), kEncoding);
+
+	EXPECT_STREQ(string.c_str(), "[!?!]");
+}
+
 // -- Generalized encoding function tests --
 
 // Example string with terminating 0
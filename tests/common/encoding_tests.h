@@ -67,6 +67,45 @@ GTEST_TEST(XOREOS_ENCODINGNAME, readStringBuf) {
 	EXPECT_STREQ(string.c_str(), stringUString.c_str());
 }
 
+/* Decode a long run of the example string, long enough to span several
+ * of the blocks readString() reads at once. The run time of this test
+ * also serves as a simple benchmark of the decoding. */
+GTEST_TEST(XOREOS_ENCODINGNAME, readStringLong) {
+	testSupport(kEncoding);
+
+	static const size_t kRepeat     = 1000;
+	static const size_t kIterations =  100;
+
+	const size_t termSize = sizeof(stringData0) - stringBytes;
+
+	std::vector<byte> data;
+	for (size_t i = 0; i < kRepeat; i++)
+		data.insert(data.end(), stringData0, stringData0 + stringBytes);
+
+	data.insert(data.end(), stringData0 + stringBytes, stringData0 + sizeof(stringData0));
+	data.insert(data.end(), stringData0, stringData0 + sizeof(stringData0));
+
+	Common::UString expected;
+	for (size_t i = 0; i < kRepeat; i++)
+		expected += stringUString;
+
+	for (size_t i = 0; i < kIterations; i++) {
+		Common::MemoryReadStream stream(&data[0], data.size());
+
+		const Common::UString string1 = Common::readString(stream, kEncoding);
+		ASSERT_EQ(string1.size(), stringChars * kRepeat);
+		ASSERT_STREQ(string1.c_str(), expected.c_str());
+
+		ASSERT_EQ(stream.pos(), stringBytes * kRepeat + termSize);
+
+		const Common::UString string2 = Common::readString(stream, kEncoding);
+		ASSERT_STREQ(string2.c_str(), stringUString.c_str());
+
+		const Common::UString string3 = Common::readString(&data[0], data.size(), kEncoding);
+		ASSERT_STREQ(string3.c_str(), expected.c_str());
+	}
+}
+
 static void compareData(Common::SeekableReadStream &stream, const byte *data, size_t n, size_t t) {
 	for (size_t i = 0; i < n; i++)
 		EXPECT_EQ(stream.readByte(), data[i]) << "At case " << t << ", index " << i;
@@ -49,6 +49,27 @@ GTEST_TEST(XOREOS_ENCODINGNAME, isValidCodePoint) {
 	EXPECT_TRUE(Common::isValidCodepoint(kEncoding, 0x20));
 }
 
+GTEST_TEST(XOREOS_ENCODINGNAME, readStringSurrogates) {
+	testSupport(kEncoding);
+
+	static const byte data[] = { 0x61, 0x00, 0x3D, 0xD8, 0x00, 0xDE };
+
+	const Common::UString string = Common::readString(data, sizeof(data), kEncoding);
+
+	EXPECT_EQ(string.size(), 2);
+	EXPECT_STREQ(string.c_str(), "a""\xf0\x9f\x98\x80");
+}
+
+GTEST_TEST(XOREOS_ENCODINGNAME, readStringUnpairedSurrogate) {
+	testSupport(kEncoding);
+
+	static const byte data[] = { 0x61, 0x00, 0x00, 0xDE };
+
+	const Common::UString string = Common::readString(data, sizeof(data), kEncoding);
+
+	EXPECT_STREQ(string.c_str(), "[!?!]");
+}
+
 // -- Generalized encoding function tests --
 
 // Example string with terminating 0
@@ -0,0 +1,258 @@
+/* xoreos - A reimplementation of BioWare's Aurora engine
+ *
+ * xoreos is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * xoreos is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * xoreos is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with xoreos. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  Unit tests for our frame time recording.
+ */
+
+#include "src/common/atomic.h"
+
+#include "gtest/gtest.h"
+
+#include "src/common/frametimes.h"
+#include "src/common/memwritestream.h"
+#include "src/common/thread.h"
+
+/** Keep the CPU busy for this many microseconds. */
+static void burnTime(uint64 time) {
+	const uint64 start = Common::FrameTimes::getMicroseconds();
+	while ((Common::FrameTimes::getMicroseconds() - start) < time)
+		;
+}
+
+GTEST_TEST(FrameTimes, empty) {
+	Common::FrameTimes times;
+
+	EXPECT_EQ(times.getFrameCount(), 0U);
+	EXPECT_EQ(times.getPercentile(50), 0U);
+	EXPECT_EQ(times.getPhaseAverage(Common::kFramePhaseWorld), 0U);
+}
+
+GTEST_TEST(FrameTimes, percentiles) {
+	Common::FrameTimes times;
+
+	// Frame times of 1ms to 100ms, in a scrambled order
+	for (uint32 i = 0; i < 100; i++)
+		times.finishedFrame(((i * 37) % 100 + 1) * 1000);
+
+	EXPECT_EQ(times.getFrameCount(), 100U);
+
+	EXPECT_EQ(times.getPercentile(  0),   1000U);
+	EXPECT_EQ(times.getPercentile( 50),  50000U);
+	EXPECT_EQ(times.getPercentile( 95),  95000U);
+	EXPECT_EQ(times.getPercentile( 99),  99000U);
+	EXPECT_EQ(times.getPercentile(100), 100000U);
+}
+
+GTEST_TEST(FrameTimes, history) {
+	Common::FrameTimes times(10);
+
+	for (uint32 i = 0; i < 10; i++)
+		times.finishedFrame(100000);
+
+	// Only the newest 10 frames are kept, pushing out the slow ones
+	for (uint32 i = 0; i < 10; i++)
+		times.finishedFrame(1000);
+
+	EXPECT_EQ(times.getFrameCount(), 10U);
+	EXPECT_EQ(times.getPercentile(100), 1000U);
+
+	times.reset();
+	EXPECT_EQ(times.getFrameCount(), 0U);
+}
+
+GTEST_TEST(FrameTimes, phases) {
+	Common::FrameTimes times;
+
+	times.addTime(Common::kFramePhaseWorld, 3000);
+	times.addTime(Common::kFramePhaseWorld, 1000);
+	times.addTime(Common::kFramePhaseScripts, 500);
+	times.finishedFrame(16000);
+
+	times.addTime(Common::kFramePhaseWorld, 2000);
+	times.finishedFrame(16000);
+
+	EXPECT_EQ(times.getPhaseAverage(Common::kFramePhaseWorld)  , 3000U);
+	EXPECT_EQ(times.getPhaseAverage(Common::kFramePhaseScripts),  250U);
+	EXPECT_EQ(times.getPhaseAverage(Common::kFramePhaseEvents) ,    0U);
+}
+
+GTEST_TEST(FrameTimes, delayedTimes) {
+	Common::FrameTimes times(4);
+
+	EXPECT_EQ(times.getCurrentFrame(), 0U);
+
+	// Times for the current frame go right into it
+	times.addTime(0, Common::kFramePhaseGPU, 100);
+	times.finishedFrame(16000);
+
+	EXPECT_EQ(times.getCurrentFrame(), 1U);
+
+	times.finishedFrame(16000);
+	times.finishedFrame(16000);
+
+	// Two results for older frames arrive at once, they must not be summed up
+	times.addTime(1, Common::kFramePhaseGPU, 200);
+	times.addTime(2, Common::kFramePhaseGPU, 300);
+	times.finishedFrame(16000);
+
+	Common::MemoryWriteStreamDynamic stream(true);
+	times.write(stream);
+
+	const Common::UString csv(reinterpret_cast<const char *>(stream.getData()), stream.size());
+	EXPECT_STREQ(csv.c_str(),
+	             "frame,time,events,scripts,animation,world,gui,video,gpu\n"
+	             "0,16000,0,0,0,0,0,0,100\n"
+	             "1,16000,0,0,0,0,0,0,200\n"
+	             "2,16000,0,0,0,0,0,0,300\n"
+	             "3,16000,0,0,0,0,0,0,0\n");
+
+	// Frames that left the history drop their times
+	times.finishedFrame(16000);
+	times.addTime(0, Common::kFramePhaseGPU, 4000);
+
+	EXPECT_EQ(times.getPhaseAverage(Common::kFramePhaseGPU), 125U);
+
+	// The numbering continues after a reset, so late times can't land in new frames
+	times.reset();
+	times.addTime(4, Common::kFramePhaseGPU, 4000);
+	times.finishedFrame(16000);
+
+	EXPECT_EQ(times.getCurrentFrame(), 6U);
+	EXPECT_EQ(times.getPhaseAverage(Common::kFramePhaseGPU), 0U);
+}
+
+GTEST_TEST(FrameTimes, histogram) {
+	Common::FrameTimes times;
+
+	times.finishedFrame(1000);
+	times.finishedFrame(4000);
+	times.finishedFrame(4001);
+	times.finishedFrame(16000);
+	times.finishedFrame(1000000);
+
+	Common::FrameTimes::Histogram histogram;
+	times.getHistogram(histogram);
+
+	uint32 total = 0;
+	for (size_t i = 0; i < Common::FrameTimes::kHistogramSize; i++)
+		total += histogram.buckets[i];
+
+	EXPECT_EQ(total, 5U);
+
+	EXPECT_EQ(histogram.buckets[0], 2U);
+	EXPECT_EQ(histogram.buckets[1], 1U);
+	EXPECT_EQ(histogram.buckets[Common::FrameTimes::kHistogramSize - 1], 1U);
+
+	EXPECT_EQ(Common::FrameTimes::getHistogramLimit(Common::FrameTimes::kHistogramSize - 1), 0xFFFFFFFFU);
+}
+
+GTEST_TEST(FrameTimes, timer) {
+	Common::FrameTimes times;
+
+	{
+		Common::FrameTimer outer(times, Common::kFramePhaseScripts);
+
+		// Burn a bit of time, so that the timer has something to measure
+		burnTime(2000);
+
+		// Nested timers of the same phase don't count twice
+		Common::FrameTimer inner(times, Common::kFramePhaseScripts);
+	}
+
+	times.finishedFrame(16000);
+
+	const uint32 scripts = times.getPhaseAverage(Common::kFramePhaseScripts);
+	EXPECT_GE(scripts, 2000U);
+	EXPECT_LT(scripts, 1000000U);
+}
+
+class TimerThread : public Common::Thread {
+public:
+	TimerThread(Common::FrameTimes &times) : _times(&times), _done(false) {
+	}
+
+	bool isDone() const {
+		return _done.load();
+	}
+
+private:
+	Common::FrameTimes *_times;
+	boost::atomic<bool> _done;
+
+	void threadMethod() {
+		{
+			Common::FrameTimer outer(*_times, Common::kFramePhaseScripts);
+
+			burnTime(2000);
+
+			Common::FrameTimer inner(*_times, Common::kFramePhaseScripts);
+		}
+
+		_done.store(true);
+	}
+};
+
+GTEST_TEST(FrameTimes, timerThreads) {
+	Common::FrameTimes times;
+
+	{
+		Common::FrameTimer outer(times, Common::kFramePhaseScripts);
+		Common::FrameTimer inner(times, Common::kFramePhaseScripts);
+
+		burnTime(2000);
+	}
+
+	// Once its timers are done, another thread can time the same phase
+	TimerThread thread(times);
+	ASSERT_TRUE(thread.createThread("FrameTimer"));
+
+	while (!thread.isDone())
+		;
+
+	thread.destroyThread();
+
+	{
+		Common::FrameTimer timer(times, Common::kFramePhaseScripts);
+
+		burnTime(2000);
+	}
+
+	times.finishedFrame(16000);
+
+	const uint32 scripts = times.getPhaseAverage(Common::kFramePhaseScripts);
+	EXPECT_GE(scripts, 6000U);
+	EXPECT_LT(scripts, 1000000U);
+}
+
+GTEST_TEST(FrameTimes, write) {
+	Common::FrameTimes times;
+
+	times.addTime(Common::kFramePhaseGPU, 7);
+	times.finishedFrame(16000);
+
+	Common::MemoryWriteStreamDynamic stream(true);
+	times.write(stream);
+
+	const Common::UString csv(reinterpret_cast<const char *>(stream.getData()), stream.size());
+	EXPECT_STREQ(csv.c_str(),
+	             "frame,time,events,scripts,animation,world,gui,video,gpu\n"
+	             "0,16000,0,0,0,0,0,0,7\n");
+}
@@ -0,0 +1,176 @@
+/* xoreos - A reimplementation of BioWare's Aurora engine
+ *
+ * xoreos is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * xoreos is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * xoreos is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with xoreos. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  Unit tests for our string interner.
+ */
+
+#include "src/common/atomic.h"
+
+#include <boost/unordered_set.hpp>
+
+#include "gtest/gtest.h"
+
+#include "src/common/util.h"
+#include "src/common/ustring.h"
+#include "src/common/internedstring.h"
+#include "src/common/thread.h"
+
+GTEST_TEST(InternedString, empty) {
+	const Common::InternedString str1;
+	const Common::InternedString str2((Common::UString()));
+
+	EXPECT_TRUE(str1.empty());
+	EXPECT_TRUE(str2.empty());
+	EXPECT_EQ(str1, str2);
+
+	EXPECT_STREQ(str1.c_str(), "");
+}
+
+GTEST_TEST(InternedString, equality) {
+	const Common::InternedString str1(Common::UString("Foobar"));
+	const Common::InternedString str2(Common::UString("Foo") + "bar");
+	const Common::InternedString str3(Common::UString("FOOBAR"));
+
+	EXPECT_EQ(str1, str2);
+	EXPECT_NE(str1, str3);
+
+	EXPECT_EQ(str1.hash(), str2.hash());
+	EXPECT_EQ(&str1.str(), &str2.str());
+
+	EXPECT_STREQ(str1.c_str(), "Foobar");
+	EXPECT_STREQ(str3.c_str(), "FOOBAR");
+
+	boost::unordered_set<Common::InternedString, Common::hashInternedString> set;
+	set.insert(str1);
+	set.insert(str2);
+	set.insert(str3);
+
+	EXPECT_EQ(set.size(), 2);
+}
+
+GTEST_TEST(InternedString, lookup) {
+	Common::InternedString str;
+
+	EXPECT_FALSE(Common::InternedString::lookup("InternedStringLookup", str));
+	EXPECT_TRUE(str.empty());
+
+	const Common::InternedString interned(Common::UString("InternedStringLookup"));
+
+	EXPECT_TRUE(Common::InternedString::lookup("InternedStringLookup", str));
+	EXPECT_EQ(str, interned);
+
+	EXPECT_TRUE(Common::InternedString::lookup("", str));
+	EXPECT_TRUE(str.empty());
+}
+
+GTEST_TEST(InternedString, release) {
+	const size_t size = StringInternMan.size();
+
+	{
+		Common::InternedString str1(Common::UString("InternedStringRelease"));
+		EXPECT_EQ(StringInternMan.size(), size + 1);
+
+		Common::InternedString str2(str1);
+		Common::InternedString str3;
+
+		str3 = str2;
+		str1 = Common::InternedString();
+
+		EXPECT_EQ(StringInternMan.size(), size + 1);
+		EXPECT_STREQ(str3.c_str(), "InternedStringRelease");
+	}
+
+	EXPECT_EQ(StringInternMan.size(), size);
+
+	Common::InternedString str;
+	EXPECT_FALSE(Common::InternedString::lookup("InternedStringRelease", str));
+}
+
+class InternThread : public Common::Thread {
+public:
+	InternThread(const Common::InternedString &shared) : _shared(shared), _done(false), _errors(0) {
+		createThread("InternThread");
+	}
+
+	~InternThread() {
+		wait();
+	}
+
+	void wait() {
+		while (!_done.load())
+			;
+
+		destroyThread();
+	}
+
+	size_t getErrors() const {
+		return _errors;
+	}
+
+private:
+	const Common::InternedString _shared;
+
+	boost::atomic<bool> _done;
+	size_t _errors;
+
+	void threadMethod() {
+		for (size_t i = 0; i < 10000; i++) {
+			// Copy and release a shared handle...
+			Common::InternedString copy(_shared);
+
+			// ...and intern and release strings used by the other threads, too
+			const Common::InternedString interned(Common::UString::format("InternedStringThread%u", (uint) (i % 16)));
+			Common::InternedString found;
+
+			if (!Common::InternedString::lookup(interned.str(), found) || (found != interned))
+				_errors++;
+			if (copy != _shared)
+				_errors++;
+		}
+
+		_done.store(true);
+	}
+};
+
+GTEST_TEST(InternedString, threads) {
+	const size_t size = StringInternMan.size();
+
+	{
+		const Common::InternedString shared(Common::UString("InternedStringShared"));
+
+		InternThread thread1(shared), thread2(shared), thread3(shared), thread4(shared);
+
+		for (size_t i = 0; i < 10000; i++)
+			const Common::InternedString interned(Common::UString::format("InternedStringThread%u", (uint) (i % 16)));
+
+		thread1.wait();
+		thread2.wait();
+		thread3.wait();
+		thread4.wait();
+
+		EXPECT_EQ(thread1.getErrors(), 0);
+		EXPECT_EQ(thread2.getErrors(), 0);
+		EXPECT_EQ(thread3.getErrors(), 0);
+		EXPECT_EQ(thread4.getErrors(), 0);
+	}
+
+	EXPECT_EQ(StringInternMan.size(), size);
+}
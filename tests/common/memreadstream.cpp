@@ -26,6 +26,7 @@
 
 #include "src/common/util.h"
 #include "src/common/error.h"
+#include "src/common/scopedptr.h"
 #include "src/common/readstream.h"
 #include "src/common/memreadstream.h"
 
@@ -332,3 +333,99 @@ GTEST_TEST(SeekableSubReadStreamEndian, streamEndianBE) {
 	EXPECT_EQ(subStream.readUint32(), 305419896);
 	EXPECT_THROW(subStream.readUint32(), Common::Exception);
 }
+
+GTEST_TEST(MemoryReadCursor, seek) {
+	static const byte data[4] = { 0 };
+	Common::MemoryReadCursor cursor(data, sizeof(data));
+
+	EXPECT_EQ(cursor.size(), 4);
+	EXPECT_EQ(cursor.pos(), 0);
+
+	cursor.seek(3);
+	EXPECT_EQ(cursor.pos(), 3);
+	EXPECT_EQ(cursor.remaining(), 1);
+
+	cursor.skip(-2);
+	EXPECT_EQ(cursor.pos(), 1);
+
+	cursor.seek(4);
+	EXPECT_EQ(cursor.remaining(), 0);
+
+	EXPECT_THROW(cursor.seek(5), Common::Exception);
+	EXPECT_THROW(cursor.skip(1), Common::Exception);
+	EXPECT_THROW(cursor.skip(-5), Common::Exception);
+}
+
+GTEST_TEST(MemoryReadCursor, read) {
+	static const byte data[] = {
+		0x12, 0x34, 0x56, 0x78, 0x12, 0x34, 0x56, 0x78,
+		0x00, 0x00, 0x80, 0x3F,
+		0xFF, 0xFE
+	};
+	Common::MemoryReadCursor cursor(data, sizeof(data));
+
+	EXPECT_EQ(cursor.readUint16LE(), 0x3412);
+	EXPECT_EQ(cursor.readUint16BE(), 0x5678);
+
+	cursor.seek(0);
+	EXPECT_EQ(cursor.readUint32LE(), 0x78563412);
+	EXPECT_EQ(cursor.readUint32BE(), 0x12345678);
+
+	cursor.seek(0);
+	EXPECT_EQ(cursor.readUint64LE(), UINT64_C(0x7856341278563412));
+
+	cursor.seek(0);
+	EXPECT_EQ(cursor.readUint64BE(), UINT64_C(0x1234567812345678));
+
+	EXPECT_FLOAT_EQ(cursor.readIEEEFloatLE(), 1.0f);
+
+	EXPECT_EQ(cursor.readSByte(), -1);
+	EXPECT_EQ(cursor.readByte(), 0xFE);
+
+	EXPECT_THROW(cursor.readByte(), Common::Exception);
+}
+
+GTEST_TEST(MemoryReadCursor, readPastEnd) {
+	static const byte data[3] = { 0x01, 0x02, 0x03 };
+	Common::MemoryReadCursor cursor(data, sizeof(data));
+
+	EXPECT_THROW(cursor.readUint32LE(), Common::Exception);
+	EXPECT_EQ(cursor.pos(), 0);
+
+	EXPECT_EQ(cursor.readUint16LE(), 0x0201);
+}
+
+GTEST_TEST(MemoryReadCursor, getCursor) {
+	static const byte data[4] = { 0x01, 0x02, 0x03, 0x04 };
+	Common::MemoryReadStream stream(data);
+
+	stream.seek(2);
+
+	Common::MemoryReadCursor cursor = stream.getCursor();
+	EXPECT_EQ(cursor.getData(), data);
+	EXPECT_EQ(cursor.size(), 4);
+	EXPECT_EQ(cursor.pos(), 2);
+
+	EXPECT_EQ(cursor.readUint16LE(), 0x0403);
+
+	// The stream itself is not moved by the cursor
+	EXPECT_EQ(stream.pos(), 2);
+}
+
+GTEST_TEST(MemoryReadCursor, makeMemoryBacked) {
+	static const byte data[4] = { 0x01, 0x02, 0x03, 0x04 };
+	Common::MemoryReadStream stream(data);
+
+	EXPECT_EQ(Common::makeMemoryBacked(&stream), &stream);
+
+	Common::SeekableSubReadStream *subStream = new Common::SeekableSubReadStream(&stream, 1, 4);
+	subStream->seek(1);
+
+	Common::ScopedPtr<Common::MemoryReadStream> memStream(Common::makeMemoryBacked(subStream));
+
+	EXPECT_EQ(memStream->size(), 3);
+	EXPECT_EQ(memStream->pos(), 1);
+
+	EXPECT_EQ(memStream->getData()[0], 0x02);
+	EXPECT_EQ(memStream->getCursor().readUint16LE(), 0x0403);
+}
@@ -0,0 +1,158 @@
+/* xoreos - A reimplementation of BioWare's Aurora engine
+ *
+ * xoreos is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * xoreos is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * xoreos is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with xoreos. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  Unit tests for our parallel for loops.
+ */
+
+#include "src/common/atomic.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "src/common/error.h"
+#include "src/common/threadpool.h"
+#include "src/common/parallelfor.h"
+
+/** Counts how often each index was run. */
+class CountingBody : public Common::ParallelForBody {
+public:
+	CountingBody(size_t count) : _runs(count, 0), _total(0) {
+	}
+
+	void run(size_t index) {
+		// Each index is only ever run once, so no other thread touches this element
+		_runs[index]++;
+
+		_total.fetch_add(1);
+	}
+
+	uint32 getRuns(size_t index) const {
+		return _runs[index];
+	}
+
+	uint32 getTotal() const {
+		return _total.load();
+	}
+
+private:
+	std::vector<uint32> _runs;
+
+	boost::atomic<uint32> _total;
+};
+
+class ThrowingBody : public Common::ParallelForBody {
+public:
+	ThrowingBody() : _runs(0) {
+	}
+
+	void run(size_t index) {
+		_runs.fetch_add(1);
+
+		if (index == 17)
+			throw Common::Exception("Foobar");
+	}
+
+	uint32 getRuns() const {
+		return _runs.load();
+	}
+
+private:
+	boost::atomic<uint32> _runs;
+};
+
+/** Runs a nested parallel for loop in each iteration. */
+class NestedBody : public Common::ParallelForBody {
+public:
+	NestedBody(Common::ThreadPool &pool, size_t count) : _pool(&pool), _count(count), _total(0) {
+	}
+
+	void run(size_t UNUSED(index)) {
+		CountingBody inner(_count);
+		Common::parallelFor(_pool, 0, _count, inner);
+
+		_total.fetch_add(inner.getTotal());
+	}
+
+	uint32 getTotal() const {
+		return _total.load();
+	}
+
+private:
+	Common::ThreadPool *_pool;
+
+	size_t _count;
+
+	boost::atomic<uint32> _total;
+};
+
+static void runCounting(Common::ThreadPool *pool, size_t begin, size_t end, size_t grain) {
+	CountingBody body(end);
+
+	Common::parallelFor(pool, begin, end, body, grain);
+
+	EXPECT_EQ(body.getTotal(), (end > begin) ? (end - begin) : 0U);
+
+	for (size_t i = 0; i < end; i++)
+		EXPECT_EQ(body.getRuns(i), (i >= begin) ? 1U : 0U) << "At index " << i;
+}
+
+GTEST_TEST(ParallelFor, noPool) {
+	runCounting(0, 0,   0, 1);
+	runCounting(0, 0, 100, 1);
+	runCounting(0, 5, 100, 7);
+}
+
+GTEST_TEST(ParallelFor, noWorkers) {
+	Common::ThreadPool pool(0);
+
+	runCounting(&pool, 0, 100, 1);
+}
+
+GTEST_TEST(ParallelFor, run) {
+	Common::ThreadPool pool(4);
+
+	runCounting(&pool,  0,    0,   1);
+	runCounting(&pool,  0,    1,   1);
+	runCounting(&pool,  0,    7,   1);
+	runCounting(&pool,  3, 1000,   1);
+	runCounting(&pool,  0, 1000,  64);
+	runCounting(&pool, 10,  100, 200);
+}
+
+GTEST_TEST(ParallelFor, nested) {
+	Common::ThreadPool pool(2);
+
+	NestedBody body(pool, 50);
+	Common::parallelFor(&pool, 0, 20, body);
+
+	EXPECT_EQ(body.getTotal(), 20U * 50U);
+}
+
+GTEST_TEST(ParallelFor, exception) {
+	Common::ThreadPool pool(2);
+
+	ThrowingBody body;
+	EXPECT_THROW(Common::parallelFor(&pool, 0, 100, body), Common::Exception);
+
+	// The other chunks still ran
+	EXPECT_GT(body.getRuns(), 1U);
+}
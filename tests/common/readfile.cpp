@@ -23,6 +23,7 @@
  */
 
 #include <string>
+#include <vector>
 #include <iostream>
 
 #include <boost/filesystem.hpp>
@@ -31,6 +32,7 @@
 #include "gtest/gtest.h"
 
 #include "src/common/util.h"
+#include "src/common/error.h"
 #include "src/common/platform.h"
 #include "src/common/readfile.h"
 
@@ -53,6 +55,60 @@ protected:
 	}
 };
 
+static byte getPatternByte(size_t i) {
+	return (byte) ((i * 7) ^ (i >> 8));
+}
+
+static void createPatternFile(size_t size) {
+	std::vector<byte> data(size);
+	for (size_t i = 0; i < size; i++)
+		data[i] = getPatternByte(i);
+
+	boost::filesystem::ofstream testFile(kFilePath, std::ofstream::binary);
+
+	testFile.write(reinterpret_cast<const char *>(&data[0]), data.size());
+	testFile.flush();
+	ASSERT_FALSE(testFile.fail());
+
+	testFile.close();
+}
+
+static void readPatternFile(Common::ReadFile &file) {
+	ASSERT_TRUE(file.isOpen());
+
+	file.seek(0);
+
+	// Small reads, crossing block boundaries
+	for (size_t i = 0; i < file.size(); i++)
+		ASSERT_EQ(file.readByte(), getPatternByte(i)) << "At offset " << i;
+
+	// Seek backwards into an old block
+	file.seek(Common::ReadFile::kBlockSize - 2);
+	const uint32 value = file.readUint32LE();
+	EXPECT_EQ(value & 0xFF, getPatternByte(Common::ReadFile::kBlockSize - 2));
+	EXPECT_EQ(value >> 24 , getPatternByte(Common::ReadFile::kBlockSize + 1));
+
+	// A read bigger than the buffer
+	file.seek(1);
+
+	std::vector<byte> readData(file.size());
+	EXPECT_EQ(file.read(&readData[0], readData.size()), file.size() - 1);
+	EXPECT_TRUE(file.eos());
+
+	for (size_t i = 0; i < (file.size() - 1); i++)
+		ASSERT_EQ(readData[i], getPatternByte(i + 1)) << "At index " << i;
+
+	file.seek(0);
+	EXPECT_FALSE(file.eos());
+
+	// Reading exactly up to the end doesn't set eos
+	file.seek(-4, Common::SeekableReadStream::kOriginEnd);
+	EXPECT_EQ(file.read(&readData[0], 4), 4);
+	EXPECT_FALSE(file.eos());
+
+	EXPECT_THROW(file.seek(1, Common::SeekableReadStream::kOriginEnd), Common::Exception);
+}
+
 GTEST_TEST_F(ReadFile, write) {
 	ASSERT_FALSE(kFilePath.empty());
 
@@ -87,3 +143,50 @@ GTEST_TEST_F(ReadFile, write) {
 	for (size_t i = 0; i < ARRAYSIZE(data); i++)
 		EXPECT_EQ(readData[i], data[i]) << "At index " << i;
 }
+
+GTEST_TEST_F(ReadFile, buffered) {
+	ASSERT_FALSE(kFilePath.empty());
+
+	createPatternFile(Common::ReadFile::kDefaultBufferSize * 2 + 123);
+
+	Common::ReadFile file(kFilePath.generic_string());
+	readPatternFile(file);
+
+	file.setBufferSize(1);
+	readPatternFile(file);
+}
+
+GTEST_TEST_F(ReadFile, unbuffered) {
+	ASSERT_FALSE(kFilePath.empty());
+
+	createPatternFile(Common::ReadFile::kBlockSize * 2 + 5);
+
+	Common::ReadFile file(kFilePath.generic_string());
+	file.setBufferSize(0);
+	file.setAccessHint(Common::ReadFile::kAccessRandom);
+
+	readPatternFile(file);
+}
+
+GTEST_TEST_F(ReadFile, readAt) {
+	ASSERT_FALSE(kFilePath.empty());
+
+	createPatternFile(Common::ReadFile::kBlockSize + 10);
+
+	Common::ReadFile file(kFilePath.generic_string());
+	file.seek(5);
+
+	byte readData[16];
+	EXPECT_EQ(file.readAt(Common::ReadFile::kBlockSize - 6, readData, sizeof(readData)), sizeof(readData));
+
+	for (size_t i = 0; i < sizeof(readData); i++)
+		EXPECT_EQ(readData[i], getPatternByte(Common::ReadFile::kBlockSize - 6 + i)) << "At index " << i;
+
+	// Reading at an offset doesn't touch the stream position
+	EXPECT_EQ(file.pos(), 5);
+	EXPECT_EQ(file.readByte(), getPatternByte(5));
+
+	// Reads are clamped to the end of the file
+	EXPECT_EQ(file.readAt(file.size() - 3, readData, sizeof(readData)), 3);
+	EXPECT_EQ(file.readAt(file.size(), readData, sizeof(readData)), 0);
+}
@@ -60,6 +60,21 @@ tests_common_test_ustring_SOURCES  = tests/common/ustring.cpp
 tests_common_test_ustring_LDADD    = $(common_LIBS)
 tests_common_test_ustring_CXXFLAGS = $(test_CXXFLAGS)
 
+check_PROGRAMS                          += tests/common/test_internedstring
+tests_common_test_internedstring_SOURCES  = tests/common/internedstring.cpp
+tests_common_test_internedstring_LDADD    = $(common_LIBS)
+tests_common_test_internedstring_CXXFLAGS = $(test_CXXFLAGS)
+
+check_PROGRAMS                       += tests/common/test_threadpool
+tests_common_test_threadpool_SOURCES  = tests/common/threadpool.cpp
+tests_common_test_threadpool_LDADD    = $(common_LIBS)
+tests_common_test_threadpool_CXXFLAGS = $(test_CXXFLAGS)
+
+check_PROGRAMS                        += tests/common/test_parallelfor
+tests_common_test_parallelfor_SOURCES  = tests/common/parallelfor.cpp
+tests_common_test_parallelfor_LDADD    = $(common_LIBS)
+tests_common_test_parallelfor_CXXFLAGS = $(test_CXXFLAGS)
+
 check_PROGRAMS                    += tests/common/test_strutil
 tests_common_test_strutil_SOURCES  = tests/common/strutil.cpp
 tests_common_test_strutil_LDADD    = $(common_LIBS)
@@ -236,3 +251,13 @@ check_PROGRAMS                        += tests/common/test_boundingbox
 tests_common_test_boundingbox_SOURCES  = tests/common/boundingbox.cpp
 tests_common_test_boundingbox_LDADD    = $(common_LIBS)
 tests_common_test_boundingbox_CXXFLAGS = $(test_CXXFLAGS)
+
+check_PROGRAMS                          += tests/common/test_triplebuffer
+tests_common_test_triplebuffer_SOURCES  = tests/common/triplebuffer.cpp
+tests_common_test_triplebuffer_LDADD    = $(common_LIBS)
+tests_common_test_triplebuffer_CXXFLAGS = $(test_CXXFLAGS)
+
+check_PROGRAMS                        += tests/common/test_frametimes
+tests_common_test_frametimes_SOURCES  = tests/common/frametimes.cpp
+tests_common_test_frametimes_LDADD    = $(common_LIBS)
+tests_common_test_frametimes_CXXFLAGS = $(test_CXXFLAGS)
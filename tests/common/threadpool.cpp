@@ -0,0 +1,218 @@
+/* xoreos - A reimplementation of BioWare's Aurora engine
+ *
+ * xoreos is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * xoreos is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * xoreos is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with xoreos. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  Unit tests for our thread pool.
+ */
+
+#include "src/common/atomic.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "src/common/error.h"
+#include "src/common/ptrvector.h"
+#include "src/common/mutex.h"
+#include "src/common/threadpool.h"
+
+class CountingJob : public Common::ThreadPoolJob {
+public:
+	CountingJob(boost::atomic<uint32> &counter, uint32 work = 0) : _counter(&counter), _work(work), _result(0), _runs(0) {
+	}
+
+	void run() {
+		// Burn some cycles, to give the other threads a chance to steal
+		uint32 x = 1;
+		for (uint32 i = 0; i < _work; i++)
+			x = x * 1664525 + 1013904223;
+
+		_result = x;
+		_runs++;
+
+		_counter->fetch_add(1);
+	}
+
+	uint32 getRuns() const {
+		return _runs;
+	}
+
+private:
+	boost::atomic<uint32> *_counter;
+
+	uint32 _work;
+	uint32 _result;
+	uint32 _runs;
+};
+
+class ThrowingJob : public Common::ThreadPoolJob {
+public:
+	void run() {
+		throw Common::Exception("Foobar");
+	}
+};
+
+class BlockingJob : public Common::ThreadPoolJob {
+public:
+	BlockingJob() : _started(false), _release(0) {
+	}
+
+	void run() {
+		_started.store(true);
+		_release.lock();
+	}
+
+	bool hasStarted() const {
+		return _started.load();
+	}
+
+	void release() {
+		_release.unlock();
+	}
+
+private:
+	boost::atomic<bool> _started;
+	Common::Semaphore _release;
+};
+
+static void runJobs(Common::ThreadPool &pool, size_t count, uint32 work) {
+	boost::atomic<uint32> counter(0);
+
+	Common::PtrVector<CountingJob> jobs;
+	for (size_t i = 0; i < count; i++)
+		jobs.push_back(new CountingJob(counter, work));
+
+	pool.run(std::vector<Common::ThreadPoolJob *>(jobs.begin(), jobs.end()));
+
+	EXPECT_EQ(counter.load(), count);
+
+	for (size_t i = 0; i < count; i++)
+		EXPECT_EQ(jobs[i]->getRuns(), 1) << "At job " << i;
+}
+
+GTEST_TEST(ThreadPool, noWorkers) {
+	Common::ThreadPool pool(0);
+
+	EXPECT_EQ(pool.getThreadCount(), 0);
+
+	runJobs(pool, 0, 0);
+	runJobs(pool, 1, 0);
+	runJobs(pool, 100, 0);
+}
+
+GTEST_TEST(ThreadPool, run) {
+	Common::ThreadPool pool(4);
+
+	EXPECT_EQ(pool.getThreadCount(), 4);
+
+	runJobs(pool,    1, 1000);
+	runJobs(pool,    3, 1000);
+	runJobs(pool, 1000,  100);
+
+	// Uneven amounts of work, so that the workers steal from each other
+	boost::atomic<uint32> counter(0);
+
+	Common::PtrVector<CountingJob> jobs;
+	for (size_t i = 0; i < 100; i++)
+		jobs.push_back(new CountingJob(counter, (i < 10) ? 1000000 : 10));
+
+	pool.run(std::vector<Common::ThreadPoolJob *>(jobs.begin(), jobs.end()));
+
+	EXPECT_EQ(counter.load(), 100);
+}
+
+GTEST_TEST(ThreadPool, exception) {
+	Common::ThreadPool pool(2);
+
+	boost::atomic<uint32> counter(0);
+
+	CountingJob job1(counter), job2(counter);
+	ThrowingJob job3;
+
+	std::vector<Common::ThreadPoolJob *> jobs;
+	jobs.push_back(&job1);
+	jobs.push_back(&job3);
+	jobs.push_back(&job2);
+
+	EXPECT_THROW(pool.run(jobs), Common::Exception);
+
+	// All other jobs still ran
+	EXPECT_EQ(counter.load(), 2);
+}
+
+GTEST_TEST(ThreadPool, queue) {
+	boost::atomic<uint32> counter(0);
+
+	CountingJob job1(counter, 1000), job2(counter, 1000);
+	ThrowingJob job3;
+
+	{
+		Common::ThreadPool pool(2);
+
+		pool.queue(&job1);
+		pool.queue(&job3);
+		pool.queue(&job2);
+
+		// Destroying the pool runs all background jobs that are still queued
+	}
+
+	EXPECT_EQ(counter.load(), 2);
+	EXPECT_EQ(job1.getRuns(), 1);
+	EXPECT_EQ(job2.getRuns(), 1);
+}
+
+GTEST_TEST(ThreadPool, queueNoWorkers) {
+	Common::ThreadPool pool(0);
+
+	boost::atomic<uint32> counter(0);
+
+	CountingJob job(counter);
+	pool.queue(&job);
+
+	// Without workers, the job is run right away
+	EXPECT_EQ(counter.load(), 1);
+}
+
+GTEST_TEST(ThreadPool, runOnlyOwnBatch) {
+	boost::atomic<uint32> background(0);
+
+	BlockingJob blocking;
+	CountingJob job(background);
+
+	{
+		Common::ThreadPool pool(1);
+
+		// Keep the only worker busy, then queue a background job behind it
+		pool.queue(&blocking);
+		while (!blocking.hasStarted())
+			;
+
+		pool.queue(&job);
+
+		// Only the submitting thread can run the batch, and it must leave the background job alone
+		runJobs(pool, 10, 0);
+
+		EXPECT_EQ(background.load(), 0);
+
+		blocking.release();
+	}
+
+	EXPECT_EQ(background.load(), 1);
+}
@@ -0,0 +1,146 @@
+/* xoreos - A reimplementation of BioWare's Aurora engine
+ *
+ * xoreos is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * xoreos is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * xoreos is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with xoreos. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  Unit tests for our lock-free triple buffer.
+ */
+
+#include "src/common/atomic.h"
+
+#include "gtest/gtest.h"
+
+#include "src/common/thread.h"
+#include "src/common/triplebuffer.h"
+
+struct Snapshot {
+	uint32 a;
+	uint32 b;
+
+	Snapshot() : a(0), b(0) {
+	}
+};
+
+GTEST_TEST(TripleBuffer, empty) {
+	Common::TripleBuffer<Snapshot> buffer;
+
+	EXPECT_FALSE(buffer.update());
+	EXPECT_EQ(buffer.getFront().a, 0U);
+}
+
+GTEST_TEST(TripleBuffer, publish) {
+	Common::TripleBuffer<Snapshot> buffer;
+
+	buffer.getBack().a = 23;
+	buffer.publish();
+
+	EXPECT_TRUE(buffer.update());
+	EXPECT_EQ(buffer.getFront().a, 23U);
+
+	EXPECT_FALSE(buffer.update());
+	EXPECT_EQ(buffer.getFront().a, 23U);
+}
+
+GTEST_TEST(TripleBuffer, newest) {
+	Common::TripleBuffer<Snapshot> buffer;
+
+	for (uint32 i = 1; i <= 5; i++) {
+		buffer.getBack().a = i;
+		buffer.publish();
+	}
+
+	EXPECT_TRUE(buffer.update());
+	EXPECT_EQ(buffer.getFront().a, 5U);
+
+	EXPECT_FALSE(buffer.update());
+}
+
+GTEST_TEST(TripleBuffer, separate) {
+	Common::TripleBuffer<Snapshot> buffer;
+
+	buffer.getBack().a = 1;
+	buffer.publish();
+	ASSERT_TRUE(buffer.update());
+
+	// Writing the back buffer must never touch the front buffer
+	for (uint32 i = 2; i <= 10; i++) {
+		buffer.getBack().a = i;
+		EXPECT_EQ(buffer.getFront().a, 1U);
+
+		buffer.publish();
+		EXPECT_EQ(buffer.getFront().a, 1U);
+	}
+}
+
+static const uint32 kProduceCount = 200000;
+
+class Producer : public Common::Thread {
+public:
+	Producer(Common::TripleBuffer<Snapshot> &buffer) : _buffer(&buffer), _done(false) {
+	}
+
+	bool isDone() const {
+		return _done.load();
+	}
+
+private:
+	Common::TripleBuffer<Snapshot> *_buffer;
+	boost::atomic<bool> _done;
+
+	void threadMethod() {
+		for (uint32 i = 1; i <= kProduceCount; i++) {
+			Snapshot &back = _buffer->getBack();
+
+			back.a = i;
+			back.b = i * 3;
+
+			_buffer->publish();
+		}
+
+		_done.store(true);
+	}
+};
+
+GTEST_TEST(TripleBuffer, threaded) {
+	Common::TripleBuffer<Snapshot> buffer;
+	Producer producer(buffer);
+
+	ASSERT_TRUE(producer.createThread("TripleBuffer"));
+
+	uint32 last = 0;
+	bool finished = false;
+	while (!finished) {
+		finished = producer.isDone();
+
+		if (!buffer.update())
+			continue;
+
+		// Each snapshot we get must be complete and newer than the last
+		const Snapshot &front = buffer.getFront();
+		ASSERT_EQ(front.b, front.a * 3);
+		ASSERT_GT(front.a, last);
+
+		last = front.a;
+	}
+
+	buffer.update();
+	EXPECT_EQ(buffer.getFront().a, kProduceCount);
+
+	producer.destroyThread();
+}
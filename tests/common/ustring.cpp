@@ -145,6 +145,68 @@ GTEST_TEST(UString, caseInsensitiveUTF8) {
 	EXPECT_FALSE(str1.equalsIgnoreCase(str2));
 }
 
+GTEST_TEST(UString, caseInsensitiveOrder) {
+	const Common::UString str1("foobar");
+	const Common::UString str2("FOOBAZ");
+	const Common::UString str3(reinterpret_cast<const char *>(kTestStringUTF8));
+
+	EXPECT_TRUE (str1.lessIgnoreCase(str2));
+	EXPECT_FALSE(str2.lessIgnoreCase(str1));
+
+	EXPECT_TRUE (str1.lessIgnoreCase("Foobar1"));
+	EXPECT_FALSE(str1.lessIgnoreCase("FOOBAR"));
+
+	// Mixing ASCII and non-ASCII strings
+	EXPECT_EQ(str3.stricmp("f"), 1);
+	EXPECT_EQ(str3.stricmp("FZ"), 1);
+	EXPECT_EQ(Common::UString("fz").stricmp(str3), -1);
+	EXPECT_EQ(str3.strcmp("F"), 1);
+}
+
+GTEST_TEST(UString, isASCII) {
+	Common::UString str("Foobar");
+	EXPECT_TRUE(str.isASCII());
+
+	str += 0xF6;
+	EXPECT_FALSE(str.isASCII());
+	EXPECT_EQ(str.size(), 7);
+
+	str.clear();
+	EXPECT_TRUE(str.isASCII());
+
+	EXPECT_FALSE(Common::UString(reinterpret_cast<const char *>(kTestStringUTF8)).isASCII());
+}
+
+GTEST_TEST(UString, hashIgnoreCase) {
+	const Common::UString str1(kTestString1);
+	const Common::UString str2(kTestStringUpper1);
+
+	EXPECT_EQ(str1.hashIgnoreCase(), str2.hashIgnoreCase());
+	EXPECT_EQ(str1.hashIgnoreCase(), Common::hashUStringCaseInsensitive()(kTestStringLower1));
+	EXPECT_NE(str1.hashIgnoreCase(), Common::UString(kTestString2).hashIgnoreCase());
+
+	// Building a string piece by piece results in the same hash
+	Common::UString str3;
+	for (const char *s = kTestString1; *s; s++)
+		str3 += (uint32) *s;
+
+	EXPECT_EQ(str3.hashIgnoreCase(), str1.hashIgnoreCase());
+
+	Common::UString str4("Foobar");
+	str4 += Common::UString(" BARFOO");
+
+	EXPECT_EQ(str4.hashIgnoreCase(), str1.hashIgnoreCase());
+
+	// Modifying the string updates the hash
+	Common::UString str5(kTestString1);
+	str5.replaceAll("Foo", "Quux");
+
+	EXPECT_EQ(str5.hashIgnoreCase(), Common::UString("quuxbar Barfoo").hashIgnoreCase());
+
+	const Common::UString str6(reinterpret_cast<const char *>(kTestStringUTF8));
+	EXPECT_EQ(str6.hashIgnoreCase(), str6.toLower().hashIgnoreCase());
+}
+
 GTEST_TEST(UString, clear) {
 	Common::UString str(kTestString1);
 
@@ -356,6 +418,11 @@ GTEST_TEST(UString, replaceAllSubstrings) {
 	str.replaceAll("ar", "ay");
 
 	EXPECT_STREQ(str.c_str(), "Foobay Bayfoo");
+
+	str.replaceAll("oo", "o");
+
+	EXPECT_STREQ(str.c_str(), "Fobay Bayfo");
+	EXPECT_EQ(str.size(), 11);
 }
 
 GTEST_TEST(UString, upper) {
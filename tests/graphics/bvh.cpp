@@ -0,0 +1,306 @@
+/* xoreos - A reimplementation of BioWare's Aurora engine
+ *
+ * xoreos is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * xoreos is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * xoreos is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with xoreos. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  Unit tests for our bounding volume hierarchy.
+ *
+ *  The "benchmark" test case also serves as a CPU-only benchmark of the
+ *  culling and picking of world objects. Its run time is reported by gtest.
+ */
+
+#include <cmath>
+
+#include <vector>
+#include <algorithm>
+
+#include "gtest/gtest.h"
+
+#include "glm/gtc/matrix_transform.hpp"
+
+#include "src/common/maths.h"
+
+#include "src/graphics/bvh.h"
+#include "src/graphics/frustum.h"
+
+/** A simple, deterministic pseudo-random number generator. */
+static float randomFloat(uint32 &seed, float min, float max) {
+	seed = seed * 1103515245 + 12345;
+
+	return min + ((seed >> 8) / 16777216.0f) * (max - min);
+}
+
+/** Create a field of boxes, similar to the objects in a large area. */
+static void createBoxes(std::vector<Graphics::BVH::Box> &boxes, size_t count, uint32 seed) {
+	boxes.resize(count);
+
+	for (size_t i = 0; i < count; i++) {
+		for (int j = 0; j < 3; j++) {
+			const float center = randomFloat(seed, -500.0f, 500.0f);
+			const float size   = randomFloat(seed,    0.5f,  10.0f);
+
+			boxes[i].min[j] = center - size;
+			boxes[i].max[j] = center + size;
+		}
+	}
+}
+
+static Graphics::Frustum createFrustum(float angle) {
+	glm::mat4 modelview;
+	modelview = glm::rotate(modelview, Common::deg2rad(angle), glm::vec3(0.0f, 1.0f, 0.0f));
+
+	return Graphics::Frustum(glm::perspective(Common::deg2rad(60.0f), 4.0f / 3.0f, 1.0f, 300.0f) * modelview);
+}
+
+/** Find the visible boxes by testing each of them. */
+static void findVisible(const Graphics::Frustum &frustum, const std::vector<Graphics::BVH::Box> &boxes,
+                        std::vector<size_t> &items) {
+
+	for (size_t i = 0; i < boxes.size(); i++)
+		if (frustum.isIn(boxes[i].min, boxes[i].max))
+			items.push_back(i);
+}
+
+static void compareVisible(const Graphics::BVH &bvh, const std::vector<Graphics::BVH::Box> &boxes, float angle) {
+	const Graphics::Frustum frustum = createFrustum(angle);
+
+	std::vector<size_t> visible, expected;
+
+	bvh.findVisible(frustum, visible);
+	findVisible(frustum, boxes, expected);
+
+	std::sort(visible.begin(), visible.end());
+
+	ASSERT_EQ(visible.size(), expected.size()) << "At angle " << angle;
+	for (size_t i = 0; i < visible.size(); i++)
+		EXPECT_EQ(visible[i], expected[i]) << "At angle " << angle << ", index " << i;
+}
+
+GTEST_TEST(BVH, empty) {
+	Graphics::BVH bvh;
+
+	EXPECT_TRUE(bvh.empty());
+	EXPECT_EQ(bvh.size(), 0);
+
+	bvh.build(std::vector<Graphics::BVH::Box>());
+
+	EXPECT_TRUE(bvh.empty());
+
+	std::vector<size_t> visible;
+	bvh.findVisible(createFrustum(0.0f), visible);
+
+	EXPECT_TRUE(visible.empty());
+}
+
+GTEST_TEST(BVH, single) {
+	std::vector<Graphics::BVH::Box> boxes(1);
+	for (int j = 0; j < 3; j++) {
+		boxes[0].min[j] = -1.0f;
+		boxes[0].max[j] =  1.0f;
+	}
+
+	boxes[0].min[2] = -11.0f;
+	boxes[0].max[2] =  -9.0f;
+
+	Graphics::BVH bvh;
+	bvh.build(boxes);
+
+	EXPECT_FALSE(bvh.empty());
+	EXPECT_EQ(bvh.size(), 1);
+
+	std::vector<size_t> visible;
+
+	bvh.findVisible(createFrustum(0.0f), visible);
+	ASSERT_EQ(visible.size(), 1);
+	EXPECT_EQ(visible[0], 0);
+
+	visible.clear();
+
+	bvh.findVisible(createFrustum(180.0f), visible);
+	EXPECT_TRUE(visible.empty());
+}
+
+GTEST_TEST(BVH, identical) {
+	// Many boxes in the same spot can't be split
+	std::vector<Graphics::BVH::Box> boxes(100);
+	for (size_t i = 0; i < boxes.size(); i++) {
+		for (int j = 0; j < 3; j++) {
+			boxes[i].min[j] = -1.0f;
+			boxes[i].max[j] =  1.0f;
+		}
+
+		boxes[i].min[2] = -11.0f;
+		boxes[i].max[2] =  -9.0f;
+	}
+
+	Graphics::BVH bvh;
+	bvh.build(boxes);
+
+	EXPECT_EQ(bvh.size(), 100);
+
+	compareVisible(bvh, boxes,   0.0f);
+	compareVisible(bvh, boxes, 180.0f);
+}
+
+GTEST_TEST(BVH, findVisible) {
+	std::vector<Graphics::BVH::Box> boxes;
+	createBoxes(boxes, 1000, 1);
+
+	Graphics::BVH bvh;
+	bvh.build(boxes);
+
+	EXPECT_EQ(bvh.size(), 1000);
+
+	for (float angle = 0.0f; angle < 360.0f; angle += 15.0f)
+		compareVisible(bvh, boxes, angle);
+}
+
+GTEST_TEST(BVH, refit) {
+	std::vector<Graphics::BVH::Box> boxes;
+	createBoxes(boxes, 1000, 1);
+
+	Graphics::BVH bvh;
+	bvh.build(boxes);
+
+	// Move all boxes somewhere else entirely
+	createBoxes(boxes, 1000, 2);
+	bvh.refit(boxes);
+
+	for (float angle = 0.0f; angle < 360.0f; angle += 15.0f)
+		compareVisible(bvh, boxes, angle);
+}
+
+/** Find the boxes intersecting a line segment by testing each of them. */
+static void findIntersecting(const float start[3], const float end[3],
+                             const std::vector<Graphics::BVH::Box> &boxes, std::vector<size_t> &items) {
+
+	// Sample the segment densely, which is good enough for these boxes
+	static const int kSteps = 2000;
+
+	for (size_t i = 0; i < boxes.size(); i++) {
+		for (int s = 0; s <= kSteps; s++) {
+			const float t = s / (float) kSteps;
+
+			bool in = true;
+			for (int j = 0; in && (j < 3); j++) {
+				const float p = start[j] + t * (end[j] - start[j]);
+
+				in = (p >= boxes[i].min[j]) && (p <= boxes[i].max[j]);
+			}
+
+			if (in) {
+				items.push_back(i);
+				break;
+			}
+		}
+	}
+}
+
+GTEST_TEST(BVH, findIntersecting) {
+	std::vector<Graphics::BVH::Box> boxes;
+	createBoxes(boxes, 1000, 1);
+
+	Graphics::BVH bvh;
+	bvh.build(boxes);
+
+	uint32 seed = 3;
+	for (int i = 0; i < 20; i++) {
+		float start[3], end[3];
+		for (int j = 0; j < 3; j++) {
+			start[j] = randomFloat(seed, -600.0f, 600.0f);
+			end  [j] = randomFloat(seed, -600.0f, 600.0f);
+		}
+
+		std::vector<size_t> found, expected;
+
+		bvh.findIntersecting(start, end, found);
+		findIntersecting(start, end, boxes, expected);
+
+		std::sort(found.begin(), found.end());
+
+		// The sampling can miss boxes the segment only grazes, but never finds too many
+		EXPECT_GE(found.size(), expected.size()) << "At case " << i;
+		EXPECT_TRUE(std::includes(found.begin(), found.end(), expected.begin(), expected.end())) << "At case " << i;
+	}
+
+	// Axis-aligned segments, straight through a single box
+	std::vector<Graphics::BVH::Box> single(1);
+	for (int j = 0; j < 3; j++) {
+		single[0].min[j] = -1.0f;
+		single[0].max[j] =  1.0f;
+	}
+
+	bvh.build(single);
+
+	const float start1[3] = { 0.0f, 0.0f, -10.0f }, end1[3] = { 0.0f, 0.0f, 10.0f };
+	const float start2[3] = { 2.0f, 0.0f, -10.0f }, end2[3] = { 2.0f, 0.0f, 10.0f };
+	const float start3[3] = { 0.0f, 0.0f, -10.0f }, end3[3] = { 0.0f, 0.0f, -5.0f };
+
+	std::vector<size_t> found;
+
+	bvh.findIntersecting(start1, end1, found);
+	EXPECT_EQ(found.size(), 1);
+
+	found.clear();
+	bvh.findIntersecting(start2, end2, found);
+	EXPECT_TRUE(found.empty());
+
+	found.clear();
+	bvh.findIntersecting(start3, end3, found);
+	EXPECT_TRUE(found.empty());
+}
+
+GTEST_TEST(BVH, benchmark) {
+	static const size_t kBoxCount   = 10000;
+	static const size_t kIterations =  1000;
+
+	std::vector<Graphics::BVH::Box> boxes;
+	createBoxes(boxes, kBoxCount, 1);
+
+	Graphics::BVH bvh;
+	bvh.build(boxes);
+
+	std::vector<size_t> visible;
+
+	size_t visibleCount = 0;
+	for (size_t i = 0; i < kIterations; i++) {
+		// Nudge a box, like an object moving around every frame
+		boxes[i % kBoxCount].min[0] += 1.0f;
+		boxes[i % kBoxCount].max[0] += 1.0f;
+
+		bvh.refit(boxes);
+
+		visible.clear();
+		bvh.findVisible(createFrustum(i * 0.36f), visible);
+
+		visibleCount += visible.size();
+
+		// Pick along the view direction, like a mouse-over check every frame
+		const float start[3] = { 0.0f, 0.0f, 0.0f };
+		const float end  [3] = { 300.0f * std::sin(Common::deg2rad(i * 0.36f)), 0.0f,
+		                        -300.0f * std::cos(Common::deg2rad(i * 0.36f)) };
+
+		visible.clear();
+		bvh.findIntersecting(start, end, visible);
+	}
+
+	// Only a part of the area should ever be visible
+	EXPECT_GT(visibleCount, 0);
+	EXPECT_LT(visibleCount, kBoxCount * kIterations / 4);
+}
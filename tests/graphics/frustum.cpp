@@ -0,0 +1,103 @@
+/* xoreos - A reimplementation of BioWare's Aurora engine
+ *
+ * xoreos is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * xoreos is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * xoreos is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with xoreos. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  Unit tests for our view frustum.
+ */
+
+#include "gtest/gtest.h"
+
+#include "glm/gtc/matrix_transform.hpp"
+
+#include "src/common/maths.h"
+
+#include "src/graphics/frustum.h"
+
+static Graphics::Frustum createFrustum() {
+	// Looking down the negative Z axis from the origin, seeing 1 to 100 units in front
+	return Graphics::Frustum(glm::perspective(Common::deg2rad(90.0f), 1.0f, 1.0f, 100.0f));
+}
+
+static Graphics::Frustum::Intersection intersect(const Graphics::Frustum &frustum,
+		float x1, float y1, float z1, float x2, float y2, float z2) {
+
+	const float min[3] = { x1, y1, z1 };
+	const float max[3] = { x2, y2, z2 };
+
+	return frustum.intersect(min, max);
+}
+
+GTEST_TEST(Frustum, empty) {
+	const Graphics::Frustum frustum;
+
+	EXPECT_EQ(intersect(frustum,    -1.0f,    -1.0f,    -1.0f,    1.0f,    1.0f,    1.0f), Graphics::Frustum::kInside);
+	EXPECT_EQ(intersect(frustum, -1000.0f, -1000.0f, -1000.0f, 1000.0f, 1000.0f, 1000.0f), Graphics::Frustum::kInside);
+}
+
+GTEST_TEST(Frustum, intersect) {
+	const Graphics::Frustum frustum = createFrustum();
+
+	// In front of the camera
+	EXPECT_EQ(intersect(frustum, -1.0f, -1.0f, -11.0f, 1.0f, 1.0f, -9.0f), Graphics::Frustum::kInside);
+
+	// Behind the camera
+	EXPECT_EQ(intersect(frustum, -1.0f, -1.0f, 9.0f, 1.0f, 1.0f, 11.0f), Graphics::Frustum::kOutside);
+
+	// Beyond the far plane
+	EXPECT_EQ(intersect(frustum, -1.0f, -1.0f, -111.0f, 1.0f, 1.0f, -109.0f), Graphics::Frustum::kOutside);
+
+	// Outside to the left, right, below and above
+	EXPECT_EQ(intersect(frustum, -30.0f, -1.0f, -11.0f, -20.0f, 1.0f, -9.0f), Graphics::Frustum::kOutside);
+	EXPECT_EQ(intersect(frustum,  20.0f, -1.0f, -11.0f,  30.0f, 1.0f, -9.0f), Graphics::Frustum::kOutside);
+	EXPECT_EQ(intersect(frustum, -1.0f, -30.0f, -11.0f, 1.0f, -20.0f, -9.0f), Graphics::Frustum::kOutside);
+	EXPECT_EQ(intersect(frustum, -1.0f,  20.0f, -11.0f, 1.0f,  30.0f, -9.0f), Graphics::Frustum::kOutside);
+
+	// Crossing the near plane and a side plane
+	EXPECT_EQ(intersect(frustum, -1.0f, -1.0f, -2.0f, 1.0f, 1.0f, 2.0f), Graphics::Frustum::kIntersecting);
+	EXPECT_EQ(intersect(frustum, 5.0f, -1.0f, -11.0f, 15.0f, 1.0f, -9.0f), Graphics::Frustum::kIntersecting);
+
+	// Surrounding the whole frustum
+	EXPECT_EQ(intersect(frustum, -500.0f, -500.0f, -500.0f, 500.0f, 500.0f, 500.0f), Graphics::Frustum::kIntersecting);
+}
+
+GTEST_TEST(Frustum, isIn) {
+	const Graphics::Frustum frustum = createFrustum();
+
+	const float min1[3] = { -1.0f, -1.0f, -11.0f }, max1[3] = { 1.0f, 1.0f, -9.0f };
+	const float min2[3] = { -1.0f, -1.0f,   9.0f }, max2[3] = { 1.0f, 1.0f, 11.0f };
+	const float min3[3] = { -1.0f, -1.0f,  -2.0f }, max3[3] = { 1.0f, 1.0f,  2.0f };
+
+	EXPECT_TRUE (frustum.isIn(min1, max1));
+	EXPECT_FALSE(frustum.isIn(min2, max2));
+	EXPECT_TRUE (frustum.isIn(min3, max3));
+}
+
+GTEST_TEST(Frustum, modelview) {
+	// Move the camera to 0.0.50 and turn it around, so it looks down the positive Z axis
+	glm::mat4 modelview;
+	modelview = glm::rotate(modelview, Common::deg2rad(180.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+	modelview = glm::translate(modelview, glm::vec3(0.0f, 0.0f, -50.0f));
+
+	const Graphics::Frustum frustum(glm::perspective(Common::deg2rad(90.0f), 1.0f, 1.0f, 100.0f) * modelview);
+
+	EXPECT_EQ(intersect(frustum, -1.0f, -1.0f, 59.0f, 1.0f, 1.0f,  61.0f), Graphics::Frustum::kInside);
+	EXPECT_EQ(intersect(frustum, -1.0f, -1.0f, 39.0f, 1.0f, 1.0f,  41.0f), Graphics::Frustum::kOutside);
+	EXPECT_EQ(intersect(frustum, -1.0f, -1.0f, 99.0f, 1.0f, 1.0f, 101.0f), Graphics::Frustum::kInside);
+}
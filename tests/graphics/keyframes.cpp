@@ -0,0 +1,131 @@
+/* xoreos - A reimplementation of BioWare's Aurora engine
+ *
+ * xoreos is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * xoreos is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * xoreos is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with xoreos. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  Unit tests for searching animation keyframes.
+ *
+ *  Animations keep a cursor per animated node, pointing to the keyframe
+ *  found in the last update. The tests step through a track the way
+ *  animation playback does and check that the cursor always leads to
+ *  the right keyframe.
+ */
+
+#include "gtest/gtest.h"
+
+#include "src/common/util.h"
+
+#include "src/graphics/aurora/keyframes.h"
+
+static const float kTimes[] = { 0.0f, 0.5f, 1.0f, 1.5f, 2.0f, 3.0f };
+
+/** Find the keyframe for this time by searching the whole track. */
+static uint32 findKeyFrameLinear(const float *times, uint32 count, float time) {
+	uint32 frame = 0;
+	while (((frame + 1) < count) && (times[frame + 1] < time))
+		frame++;
+
+	return frame;
+}
+
+/** Look up a sequence of times with one cursor, comparing against a full search each time. */
+static void expectSequence(const float *times, uint32 count, const float *sequence, size_t length,
+                           uint32 &cursor) {
+
+	for (size_t i = 0; i < length; i++) {
+		const uint32 expected = findKeyFrameLinear(times, count, sequence[i]);
+
+		EXPECT_EQ(Graphics::Aurora::findKeyFrame(times, count, sequence[i], cursor), expected)
+			<< "At time " << sequence[i];
+		EXPECT_EQ(cursor, expected) << "At time " << sequence[i];
+	}
+}
+
+GTEST_TEST(KeyFrames, forward) {
+	uint32 cursor = 0;
+
+	EXPECT_EQ(Graphics::Aurora::findKeyFrame(kTimes, ARRAYSIZE(kTimes), 0.0f , cursor), 0U);
+	EXPECT_EQ(Graphics::Aurora::findKeyFrame(kTimes, ARRAYSIZE(kTimes), 0.25f, cursor), 0U);
+	EXPECT_EQ(Graphics::Aurora::findKeyFrame(kTimes, ARRAYSIZE(kTimes), 0.5f , cursor), 0U);
+	EXPECT_EQ(Graphics::Aurora::findKeyFrame(kTimes, ARRAYSIZE(kTimes), 0.75f, cursor), 1U);
+	EXPECT_EQ(Graphics::Aurora::findKeyFrame(kTimes, ARRAYSIZE(kTimes), 1.75f, cursor), 3U);
+	EXPECT_EQ(Graphics::Aurora::findKeyFrame(kTimes, ARRAYSIZE(kTimes), 2.5f , cursor), 4U);
+	EXPECT_EQ(Graphics::Aurora::findKeyFrame(kTimes, ARRAYSIZE(kTimes), 3.0f , cursor), 4U);
+
+	// Past the last keyframe
+	EXPECT_EQ(Graphics::Aurora::findKeyFrame(kTimes, ARRAYSIZE(kTimes), 5.0f , cursor), 5U);
+	EXPECT_EQ(cursor, 5U);
+}
+
+GTEST_TEST(KeyFrames, loop) {
+	// Several loops of playback in small steps, each ending exactly on the last keyframe
+	static const float kLoop[] = {
+		0.0f, 0.1f, 0.6f, 1.2f, 1.9f, 2.4f, 3.0f,
+		0.0f, 0.3f, 1.0f, 1.6f, 2.2f, 2.9f, 3.0f,
+		0.2f, 0.4f, 1.1f, 2.6f, 3.0f,
+		0.1f
+	};
+
+	uint32 cursor = 0;
+	expectSequence(kTimes, ARRAYSIZE(kTimes), kLoop, ARRAYSIZE(kLoop), cursor);
+}
+
+GTEST_TEST(KeyFrames, seekBackwards) {
+	static const float kSeek[] = {
+		2.5f, 0.75f, 2.0f, 1.5f, 1.25f, 1.0f, 0.5f, 0.0f, 2.75f, 1.6f, 1.4f, 0.6f
+	};
+
+	uint32 cursor = 0;
+	expectSequence(kTimes, ARRAYSIZE(kTimes), kSeek, ARRAYSIZE(kSeek), cursor);
+}
+
+GTEST_TEST(KeyFrames, singleKeyFrame) {
+	static const float kSingle[] = { 1.0f };
+
+	uint32 cursor = 0;
+	for (float time = -1.0f; time < 3.0f; time += 0.5f) {
+		EXPECT_EQ(Graphics::Aurora::findKeyFrame(kSingle, 1, time, cursor), 0U) << "At time " << time;
+		EXPECT_EQ(cursor, 0U);
+	}
+
+	// A cursor left over from a longer track
+	cursor = 4;
+	EXPECT_EQ(Graphics::Aurora::findKeyFrame(kSingle, 1, 2.0f, cursor), 0U);
+	EXPECT_EQ(cursor, 0U);
+}
+
+GTEST_TEST(KeyFrames, rebind) {
+	static const float kShort[] = { 0.0f, 1.0f, 2.0f };
+
+	static const float kSequence[] = { 0.5f, 1.5f, 2.5f, 0.5f };
+
+	// Rebinding an animation after the model's nodes changed resets the cursor
+	uint32 cursor = 0;
+	expectSequence(kTimes, ARRAYSIZE(kTimes), kSequence, 3, cursor);
+
+	cursor = 0;
+	EXPECT_EQ(Graphics::Aurora::findKeyFrame(kTimes, ARRAYSIZE(kTimes), 2.75f, cursor), 4U);
+
+	// But even a cursor from another track has to still find the right keyframe
+	cursor = 5;
+	expectSequence(kShort, ARRAYSIZE(kShort), kSequence, ARRAYSIZE(kSequence), cursor);
+
+	cursor = 2;
+	expectSequence(kTimes, ARRAYSIZE(kTimes), kSequence, ARRAYSIZE(kSequence), cursor);
+}
@@ -0,0 +1,53 @@
+# xoreos - A reimplementation of BioWare's Aurora engine
+#
+# xoreos is the legal property of its developers, whose names
+# can be found in the AUTHORS file distributed with this source
+# distribution.
+#
+# xoreos is free software; you can redistribute it and/or
+# modify it under the terms of the GNU General Public License
+# as published by the Free Software Foundation; either version 3
+# of the License, or (at your option) any later version.
+#
+# xoreos is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with xoreos. If not, see <http://www.gnu.org/licenses/>.
+
+# Unit tests for the Graphics namespace.
+
+graphics_LIBS = \
+    $(test_LIBS) \
+    src/graphics/libgraphics.la \
+    src/aurora/libaurora.la \
+    src/common/libcommon.la \
+    tests/version/libversion.la \
+    $(LDADD)
+
+check_PROGRAMS                      += tests/graphics/test_frustum
+tests_graphics_test_frustum_SOURCES  = tests/graphics/frustum.cpp
+tests_graphics_test_frustum_LDADD    = $(graphics_LIBS)
+tests_graphics_test_frustum_CXXFLAGS = $(test_CXXFLAGS)
+
+check_PROGRAMS                  += tests/graphics/test_bvh
+tests_graphics_test_bvh_SOURCES  = tests/graphics/bvh.cpp
+tests_graphics_test_bvh_LDADD    = $(graphics_LIBS)
+tests_graphics_test_bvh_CXXFLAGS = $(test_CXXFLAGS)
+
+check_PROGRAMS                       += tests/graphics/test_skinning
+tests_graphics_test_skinning_SOURCES  = tests/graphics/skinning.cpp
+tests_graphics_test_skinning_LDADD    = $(graphics_LIBS)
+tests_graphics_test_skinning_CXXFLAGS = $(test_CXXFLAGS)
+
+check_PROGRAMS                      += tests/graphics/test_sortkey
+tests_graphics_test_sortkey_SOURCES  = tests/graphics/sortkey.cpp
+tests_graphics_test_sortkey_LDADD    = $(graphics_LIBS)
+tests_graphics_test_sortkey_CXXFLAGS = $(test_CXXFLAGS)
+
+check_PROGRAMS                        += tests/graphics/test_keyframes
+tests_graphics_test_keyframes_SOURCES  = tests/graphics/keyframes.cpp
+tests_graphics_test_keyframes_LDADD    = $(graphics_LIBS)
+tests_graphics_test_keyframes_CXXFLAGS = $(test_CXXFLAGS)
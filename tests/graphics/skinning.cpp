@@ -0,0 +1,214 @@
+/* xoreos - A reimplementation of BioWare's Aurora engine
+ *
+ * xoreos is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * xoreos is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * xoreos is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with xoreos. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  Unit tests for our vertex skinning.
+ *
+ *  The "benchmark" test case also serves as a CPU-only benchmark of the
+ *  skinning of KotOR-sized creature meshes. Its run time is reported by gtest.
+ */
+
+#include <cstdlib>
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "glm/gtc/type_ptr.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+
+#include "src/common/maths.h"
+
+#include "src/graphics/aurora/skinning.h"
+
+static float randomFloat(float min, float max) {
+	return min + (max - min) * (std::rand() / (float) RAND_MAX);
+}
+
+static glm::mat4 randomTransform() {
+	glm::mat4 m;
+
+	m = glm::translate(m, glm::vec3(randomFloat(-2.0f, 2.0f), randomFloat(-2.0f, 2.0f), randomFloat(-2.0f, 2.0f)));
+	m = glm::rotate(m, Common::deg2rad(randomFloat(-180.0f, 180.0f)),
+	                glm::vec3(randomFloat(0.1f, 1.0f), randomFloat(-1.0f, 1.0f), randomFloat(-1.0f, 1.0f)));
+
+	return m;
+}
+
+/** A skinned mesh, with bones in the same layout as the KotOR models. */
+struct SkinnedMesh {
+	std::vector<glm::mat4> palette;
+
+	std::vector<float> vertices;
+	std::vector<float> boneIDs;
+	std::vector<float> boneWeights;
+
+	SkinnedMesh(size_t vertexCount, size_t boneCount) : palette(boneCount) {
+		for (size_t i = 0; i < boneCount; i++)
+			palette[i] = randomTransform();
+
+		for (size_t i = 0; i < vertexCount; i++) {
+			for (size_t j = 0; j < 3; j++)
+				vertices.push_back(randomFloat(-1.0f, 1.0f));
+
+			// Between one and four bones per vertex, the rest marked as unused
+			const size_t used = 1 + (std::rand() % 4);
+
+			float sum = 0.0f;
+			for (size_t j = 0; j < 4; j++) {
+				const float weight = (j < used) ? randomFloat(0.1f, 1.0f) : 0.0f;
+
+				boneIDs.push_back((j < used) ? (float) (std::rand() % boneCount) : -1.0f);
+				boneWeights.push_back(weight);
+
+				sum += weight;
+			}
+
+			for (size_t j = 0; j < 4; j++)
+				boneWeights[boneWeights.size() - 4 + j] /= sum;
+		}
+	}
+
+	size_t getVertexCount() const {
+		return vertices.size() / 3;
+	}
+};
+
+/** Skin the mesh the straightforward way, transforming each vertex by each bone. */
+static void skinReference(const SkinnedMesh &mesh, std::vector<float> &out) {
+	out.resize(mesh.vertices.size());
+
+	for (size_t i = 0; i < mesh.getVertexCount(); i++) {
+		const glm::vec4 v(mesh.vertices[i * 3 + 0], mesh.vertices[i * 3 + 1], mesh.vertices[i * 3 + 2], 1.0f);
+
+		glm::vec4 result(0.0f);
+		for (size_t j = 0; j < 4; j++) {
+			const int index = (int) mesh.boneIDs[i * 4 + j];
+			if (index != -1)
+				result += (mesh.palette[index] * v) * mesh.boneWeights[i * 4 + j];
+		}
+
+		out[i * 3 + 0] = result.x;
+		out[i * 3 + 1] = result.y;
+		out[i * 3 + 2] = result.z;
+	}
+}
+
+static void skin(const SkinnedMesh &mesh, std::vector<float> &out, bool scalar) {
+	out.resize(mesh.vertices.size());
+
+	if (scalar)
+		Graphics::Aurora::skinVerticesScalar(&out[0], &mesh.vertices[0], &mesh.boneIDs[0], &mesh.boneWeights[0],
+		                                     mesh.getVertexCount(), glm::value_ptr(mesh.palette[0]),
+		                                     mesh.palette.size());
+	else
+		Graphics::Aurora::skinVertices(&out[0], &mesh.vertices[0], &mesh.boneIDs[0], &mesh.boneWeights[0],
+		                               mesh.getVertexCount(), glm::value_ptr(mesh.palette[0]),
+		                               mesh.palette.size());
+}
+
+GTEST_TEST(Skinning, scalar) {
+	std::srand(0);
+
+	const SkinnedMesh mesh(1000, 50);
+
+	std::vector<float> reference, result;
+	skinReference(mesh, reference);
+	skin(mesh, result, true);
+
+	for (size_t i = 0; i < reference.size(); i++)
+		EXPECT_NEAR(result[i], reference[i], 1e-4f) << "At index " << i;
+}
+
+GTEST_TEST(Skinning, simd) {
+	std::srand(1);
+
+	const SkinnedMesh mesh(1001, 50);
+
+	std::vector<float> reference, result;
+	skinReference(mesh, reference);
+	skin(mesh, result, false);
+
+	for (size_t i = 0; i < reference.size(); i++)
+		EXPECT_NEAR(result[i], reference[i], 1e-4f) << "At index " << i;
+}
+
+GTEST_TEST(Skinning, identity) {
+	std::srand(2);
+
+	SkinnedMesh mesh(100, 4);
+	for (size_t i = 0; i < mesh.palette.size(); i++)
+		mesh.palette[i] = glm::mat4();
+
+	std::vector<float> result;
+	skin(mesh, result, false);
+
+	for (size_t i = 0; i < mesh.vertices.size(); i++)
+		EXPECT_NEAR(result[i], mesh.vertices[i], 1e-5f) << "At index " << i;
+}
+
+GTEST_TEST(Skinning, invalidBones) {
+	std::srand(3);
+
+	SkinnedMesh mesh(1, 2);
+	mesh.vertices[0] = 1.0f;
+	mesh.vertices[1] = 2.0f;
+	mesh.vertices[2] = 3.0f;
+
+	mesh.palette[0] = glm::translate(glm::mat4(), glm::vec3(1.0f, 0.0f, 0.0f));
+
+	// Slots referencing unused or nonexistent bones are ignored
+	const float boneIDs[4]     = { 0.0f, -1.0f, 2.0f, 100.0f };
+	const float boneWeights[4] = { 1.0f,  1.0f, 1.0f,   1.0f };
+	for (size_t j = 0; j < 4; j++) {
+		mesh.boneIDs[j]     = boneIDs[j];
+		mesh.boneWeights[j] = boneWeights[j];
+	}
+
+	for (int scalar = 0; scalar < 2; scalar++) {
+		std::vector<float> result;
+		skin(mesh, result, scalar != 0);
+
+		EXPECT_FLOAT_EQ(result[0], 2.0f);
+		EXPECT_FLOAT_EQ(result[1], 2.0f);
+		EXPECT_FLOAT_EQ(result[2], 3.0f);
+	}
+}
+
+GTEST_TEST(Skinning, benchmark) {
+	/* Roughly the size of a KotOR / KotOR 2 creature: a few skinned
+	 * meshes with about 5000 vertices in total, bound to 50 bones. */
+	static const size_t kVertexCount = 5000;
+	static const size_t kBoneCount   = 50;
+	static const size_t kFrames      = 1000;
+
+	std::srand(4);
+
+	const SkinnedMesh mesh(kVertexCount, kBoneCount);
+
+	std::vector<float> reference, result;
+	skinReference(mesh, reference);
+
+	for (size_t i = 0; i < kFrames; i++)
+		skin(mesh, result, false);
+
+	for (size_t i = 0; i < reference.size(); i++)
+		ASSERT_NEAR(result[i], reference[i], 1e-4f) << "At index " << i;
+}
@@ -0,0 +1,241 @@
+/* xoreos - A reimplementation of BioWare's Aurora engine
+ *
+ * xoreos is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * xoreos is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * xoreos is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with xoreos. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  Unit tests for the render queue sort keys.
+ *
+ *  The "benchmark" test cases also serve as CPU-only benchmarks of building
+ *  and sorting a render queue. Their run times are reported by gtest.
+ */
+
+#include <cstdlib>
+
+#include <vector>
+#include <algorithm>
+
+#include "gtest/gtest.h"
+
+#include "src/graphics/render/sortkey.h"
+
+using Graphics::Render::SortItem;
+
+static bool compareItems(const SortItem &a, const SortItem &b) {
+	return a.key < b.key;
+}
+
+static uint64 randomKey() {
+	return (((uint64) std::rand()) << 40) ^ (((uint64) std::rand()) << 20) ^ ((uint64) std::rand());
+}
+
+GTEST_TEST(RenderSortKey, radixSort) {
+	std::srand(0);
+
+	std::vector<SortItem> items(10000);
+	for (size_t i = 0; i < items.size(); i++) {
+		// Few distinct keys, to check that the sort is stable
+		items[i].key   = randomKey() % 100;
+		items[i].index = i;
+	}
+
+	std::vector<SortItem> expected = items;
+	std::stable_sort(expected.begin(), expected.end(), compareItems);
+
+	std::vector<SortItem> scratch;
+	Graphics::Render::radixSort(items, scratch);
+
+	ASSERT_EQ(items.size(), expected.size());
+	for (size_t i = 0; i < items.size(); i++) {
+		EXPECT_EQ(items[i].key  , expected[i].key  ) << "At index " << i;
+		EXPECT_EQ(items[i].index, expected[i].index) << "At index " << i;
+	}
+}
+
+GTEST_TEST(RenderSortKey, radixSortFullKeys) {
+	std::srand(1);
+
+	std::vector<SortItem> items(1001);
+	for (size_t i = 0; i < items.size(); i++) {
+		items[i].key   = randomKey() ^ (((uint64) (i & 0xFF)) << 56);
+		items[i].index = i;
+	}
+
+	std::vector<SortItem> scratch;
+	Graphics::Render::radixSort(items, scratch);
+
+	for (size_t i = 1; i < items.size(); i++)
+		EXPECT_LE(items[i - 1].key, items[i].key) << "At index " << i;
+}
+
+GTEST_TEST(RenderSortKey, radixSortTrivial) {
+	std::vector<SortItem> items, scratch;
+
+	Graphics::Render::radixSort(items, scratch);
+	EXPECT_TRUE(items.empty());
+
+	SortItem item = { 23, 0 };
+	items.push_back(item);
+	items.push_back(item);
+
+	Graphics::Render::radixSort(items, scratch);
+	ASSERT_EQ(items.size(), 2U);
+	EXPECT_EQ(items[0].index, 0U);
+	EXPECT_EQ(items[1].index, 0U);
+}
+
+GTEST_TEST(RenderSortKey, stateKey) {
+	using Graphics::Render::makeStateKey;
+
+	// State takes precedence over depth
+	EXPECT_LT(makeStateKey(1, 5, 5, 5, 1000.0f), makeStateKey(2, 0, 0, 0, 0.0f));
+	EXPECT_LT(makeStateKey(1, 1, 5, 5, 1000.0f), makeStateKey(1, 2, 0, 0, 0.0f));
+	EXPECT_LT(makeStateKey(1, 1, 1, 5, 1000.0f), makeStateKey(1, 1, 2, 0, 0.0f));
+	EXPECT_LT(makeStateKey(1, 1, 1, 1, 1000.0f), makeStateKey(1, 1, 1, 2, 0.0f));
+
+	// Same state, sorted by depth
+	EXPECT_LT(makeStateKey(1, 1, 1, 1, 1.0f), makeStateKey(1, 1, 1, 1, 2.0f));
+	EXPECT_LT(makeStateKey(1, 1, 1, 1, 0.0f), makeStateKey(1, 1, 1, 1, 100.0f));
+}
+
+GTEST_TEST(RenderSortKey, depthKey) {
+	using Graphics::Render::makeDepthKey;
+
+	// Depth takes precedence over state
+	EXPECT_LT(makeDepthKey(1.0f, 9, 9, 9), makeDepthKey(2.0f, 0, 0, 0));
+	EXPECT_LT(makeDepthKey(-2.0f, 9, 9, 9), makeDepthKey(-1.0f, 0, 0, 0));
+	EXPECT_LT(makeDepthKey(-1.0f, 9, 9, 9), makeDepthKey(0.0f, 0, 0, 0));
+	EXPECT_LT(makeDepthKey(0.5f, 9, 9, 9), makeDepthKey(1000.0f, 0, 0, 0));
+
+	// Same depth, sorted by state
+	EXPECT_LT(makeDepthKey(1.0f, 1, 2, 3), makeDepthKey(1.0f, 2, 0, 0));
+	EXPECT_LT(makeDepthKey(1.0f, 1, 2, 3), makeDepthKey(1.0f, 1, 3, 0));
+	EXPECT_LT(makeDepthKey(1.0f, 1, 2, 3), makeDepthKey(1.0f, 1, 2, 4));
+}
+
+GTEST_TEST(RenderSortKey, idMap) {
+	Graphics::Render::SortIDMap ids;
+
+	int objects[3];
+
+	EXPECT_EQ(ids.get(&objects[0]), 0U);
+	EXPECT_EQ(ids.get(&objects[1]), 1U);
+	EXPECT_EQ(ids.get(&objects[0]), 0U);
+	EXPECT_EQ(ids.get(&objects[2]), 2U);
+	EXPECT_EQ(ids.get(&objects[1]), 1U);
+
+	ids.clear();
+	EXPECT_EQ(ids.get(&objects[2]), 0U);
+}
+
+GTEST_TEST(RenderSortKey, idMapPerFrame) {
+	using Graphics::Render::makeStateKey;
+	using Graphics::Render::makeDepthKey;
+
+	/* More programs per frame than the program field of a state key holds
+	 * would collide anyway. But over several frames, the render queue sees
+	 * many more distinct objects than that. With the IDs cleared every frame,
+	 * like the render queue does, they never collide within one frame. */
+	static const size_t kObjectsPerFrame = 200;
+	static const size_t kFrames          =  30;
+
+	std::vector<char> objects(kObjectsPerFrame * kFrames);
+
+	Graphics::Render::SortIDMap programIDs, meshIDs;
+
+	for (size_t f = 0; f < kFrames; f++) {
+		programIDs.clear();
+		meshIDs.clear();
+
+		std::vector<uint64> stateKeys, depthKeys;
+		for (size_t i = 0; i < kObjectsPerFrame; i++) {
+			const void *object = &objects[f * kObjectsPerFrame + i];
+
+			const uint32 programID = programIDs.get(object);
+			const uint32 meshID    = meshIDs.get(object);
+
+			EXPECT_EQ(programID, i) << "At frame " << f;
+
+			stateKeys.push_back(makeStateKey(programID, 0, 0, 0, 1.0f));
+			depthKeys.push_back(makeDepthKey(1.0f, 0, 0, meshID));
+		}
+
+		std::sort(stateKeys.begin(), stateKeys.end());
+		std::sort(depthKeys.begin(), depthKeys.end());
+
+		EXPECT_TRUE(std::adjacent_find(stateKeys.begin(), stateKeys.end()) == stateKeys.end()) << "At frame " << f;
+		EXPECT_TRUE(std::adjacent_find(depthKeys.begin(), depthKeys.end()) == depthKeys.end()) << "At frame " << f;
+	}
+}
+
+/** A fake render queue node for the benchmarks. */
+struct BenchmarkNode {
+	const void *program, *material, *surface, *mesh;
+	float reference;
+};
+
+/** Build a queue of items with random state from a realistic number of
+ *  different programs, materials, surfaces and meshes, and sort it. */
+static void benchmarkQueue(size_t count, size_t frames) {
+	static const size_t kPrograms  =   16;
+	static const size_t kMaterials =  500;
+	static const size_t kSurfaces  =  100;
+	static const size_t kMeshes    = 2000;
+
+	std::srand(2);
+
+	// Fake state objects, we're only interested in their addresses
+	std::vector<char> state(kPrograms + kMaterials + kSurfaces + kMeshes);
+
+	std::vector<BenchmarkNode> nodes(count);
+	for (size_t i = 0; i < count; i++) {
+		nodes[i].program   = &state[std::rand() % kPrograms];
+		nodes[i].material  = &state[kPrograms + std::rand() % kMaterials];
+		nodes[i].surface   = &state[kPrograms + kMaterials + std::rand() % kSurfaces];
+		nodes[i].mesh      = &state[kPrograms + kMaterials + kSurfaces + std::rand() % kMeshes];
+		nodes[i].reference = (std::rand() % 100000) / 10.0f;
+	}
+
+	Graphics::Render::SortIDMap programIDs, materialIDs, surfaceIDs, meshIDs;
+	std::vector<SortItem> items, scratch;
+
+	for (size_t f = 0; f < frames; f++) {
+		items.resize(count);
+		for (size_t i = 0; i < count; i++) {
+			items[i].key   = Graphics::Render::makeStateKey(programIDs.get(nodes[i].program),
+			                                                materialIDs.get(nodes[i].material),
+			                                                surfaceIDs.get(nodes[i].surface),
+			                                                meshIDs.get(nodes[i].mesh),
+			                                                nodes[i].reference);
+			items[i].index = i;
+		}
+
+		Graphics::Render::radixSort(items, scratch);
+	}
+
+	for (size_t i = 1; i < items.size(); i++)
+		ASSERT_LE(items[i - 1].key, items[i].key) << "At index " << i;
+}
+
+GTEST_TEST(RenderSortKey, benchmark10k) {
+	benchmarkQueue(10000, 100);
+}
+
+GTEST_TEST(RenderSortKey, benchmark100k) {
+	benchmarkQueue(100000, 10);
+}
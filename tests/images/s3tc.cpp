@@ -0,0 +1,363 @@
+/* xoreos - A reimplementation of BioWare's Aurora engine
+ *
+ * xoreos is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * xoreos is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * xoreos is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with xoreos. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  Unit tests for our S3TC DXTn decompression.
+ *
+ *  The "benchmark" test cases decompress the same large images with the old
+ *  stream-based decoders and with the current ones. Their run times are
+ *  reported by gtest.
+ */
+
+#include <cstring>
+#include <cstdlib>
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "src/common/error.h"
+#include "src/common/util.h"
+#include "src/common/memreadstream.h"
+#include "src/common/threadpool.h"
+
+#include "src/graphics/images/s3tc.h"
+
+// .--- Reference decoders, reading the blocks through a stream
+static inline uint32 convert565To8888(uint16 color) {
+	return ((color & 0x1F) << 11) | ((color & 0x7E0) << 13) | ((color & 0xF800) << 16) | 0xFF;
+}
+
+static inline uint32 interpolate32(double weight, uint32 color_0, uint32 color_1) {
+	byte r[3], g[3], b[3], a[3];
+	r[0] = color_0 >> 24;
+	r[1] = color_1 >> 24;
+	r[2] = (byte)((1.0f - weight) * (double)r[0] + weight * (double)r[1]);
+	g[0] = (color_0 >> 16) & 0xFF;
+	g[1] = (color_1 >> 16) & 0xFF;
+	g[2] = (byte)((1.0f - weight) * (double)g[0] + weight * (double)g[1]);
+	b[0] = (color_0 >> 8) & 0xFF;
+	b[1] = (color_1 >> 8) & 0xFF;
+	b[2] = (byte)((1.0f - weight) * (double)b[0] + weight * (double)b[1]);
+	a[0] = color_0 & 0xFF;
+	a[1] = color_1 & 0xFF;
+	a[2] = (byte)((1.0f - weight) * (double)a[0] + weight * (double)a[1]);
+	return r[2] << 24 | g[2] << 16 | b[2] << 8 | a[2];
+}
+
+static void referenceDXT1(byte *dest, Common::SeekableReadStream &src, uint32 width, uint32 height, uint32 pitch) {
+	for (int32 ty = height; ty > 0; ty -= 4) {
+		for (uint32 tx = 0; tx < width; tx += 4) {
+			const uint16 color_0 = src.readUint16LE();
+			const uint16 color_1 = src.readUint16LE();
+			uint32 cpx = src.readUint32BE();
+
+			uint32 blended[4];
+
+			blended[0] = convert565To8888(color_0);
+			blended[1] = convert565To8888(color_1);
+
+			if (color_0 > color_1) {
+				blended[2] = interpolate32(0.333333f, blended[0], blended[1]);
+				blended[3] = interpolate32(0.666666f, blended[0], blended[1]);
+			} else {
+				blended[2] = interpolate32(0.5f, blended[0], blended[1]);
+				blended[3] = 0;
+			}
+
+			for (byte y = 0; y < 4; ++y) {
+				for (byte x = 0; x < 4; ++x) {
+					const uint32 destX = tx + x;
+					const uint32 destY = height - 1 - (ty - 4 + y);
+
+					WRITE_BE_UINT32(dest + destY * pitch + destX * 4, blended[cpx & 3]);
+					cpx >>= 2;
+				}
+			}
+		}
+	}
+}
+
+static void referenceDXT5(byte *dest, Common::SeekableReadStream &src, uint32 width, uint32 height, uint32 pitch) {
+	for (int32 ty = height; ty > 0; ty -= 4) {
+		for (uint32 tx = 0; tx < width; tx += 4) {
+			byte alphab[8];
+
+			alphab[0] = src.readByte();
+			alphab[1] = src.readByte();
+
+			uint64 alphabl = src.readUint32LE();
+			alphabl |= ((uint64)src.readUint16LE() << 32);
+
+			const uint16 color_0 = src.readUint16LE();
+			const uint16 color_1 = src.readUint16LE();
+			uint32 cpx = src.readUint32BE();
+
+			if (alphab[0] > alphab[1]) {
+				for (int i = 1; i < 7; i++)
+					alphab[i + 1] = (byte)(((7 - i) * (double)alphab[0] + i * (double)alphab[1] + 3.0f) / 7.0f);
+			} else {
+				for (int i = 1; i < 5; i++)
+					alphab[i + 1] = (byte)(((5 - i) * (double)alphab[0] + i * (double)alphab[1] + 2.0f) / 5.0f);
+
+				alphab[6] = 0;
+				alphab[7] = 255;
+			}
+
+			uint32 blended[4];
+
+			blended[0] = convert565To8888(color_0) & 0xFFFFFF00;
+			blended[1] = convert565To8888(color_1) & 0xFFFFFF00;
+			blended[2] = interpolate32(0.333333f, blended[0], blended[1]);
+			blended[3] = interpolate32(0.666666f, blended[0], blended[1]);
+
+			for (byte y = 0; y < 4; ++y) {
+				for (byte x = 0; x < 4; ++x) {
+					const uint32 destX = tx + x;
+					const uint32 destY = height - 1 - (ty - 4 + y);
+
+					const uint32 alpha = alphab[(alphabl >> (3 * (4 * (3 - y) + x))) & 7];
+
+					WRITE_BE_UINT32(dest + destY * pitch + destX * 4, blended[cpx & 3] | alpha);
+					cpx >>= 2;
+				}
+			}
+		}
+	}
+}
+// '---
+
+static const uint32 kBenchmarkSize       = 1024;
+static const uint32 kBenchmarkIterations = 8;
+
+static void fillRandom(std::vector<byte> &data, size_t size) {
+	data.resize(size);
+
+	uint32 x = 0x12345678;
+	for (size_t i = 0; i < size; i++) {
+		x = x * 1664525 + 1013904223;
+		data[i] = x >> 24;
+	}
+}
+
+static void expectPixel(const byte *image, uint32 pitch, uint32 x, uint32 y,
+                        byte r, byte g, byte b, byte a) {
+
+	const byte *p = image + y * pitch + x * 4;
+
+	EXPECT_EQ(p[0], r) << "At " << x << "x" << y;
+	EXPECT_EQ(p[1], g) << "At " << x << "x" << y;
+	EXPECT_EQ(p[2], b) << "At " << x << "x" << y;
+	EXPECT_EQ(p[3], a) << "At " << x << "x" << y;
+}
+
+GTEST_TEST(S3TC, DXT1FourColors) {
+	// Red and blue end points, each row of indices going 0, 1, 2, 3
+	static const byte kBlock[] = { 0x00, 0xF8, 0x1F, 0x00, 0xE4, 0xE4, 0xE4, 0xE4 };
+
+	byte image[4 * 4 * 4];
+	Graphics::decompressDXT1(image, kBlock, sizeof(kBlock), 4, 4, 4 * 4);
+
+	for (uint32 y = 0; y < 4; y++) {
+		expectPixel(image, 4 * 4, 0, y, 0xFF, 0x00, 0x00, 0xFF);
+		expectPixel(image, 4 * 4, 1, y, 0x00, 0x00, 0xFF, 0xFF);
+		expectPixel(image, 4 * 4, 2, y, 0xAA, 0x00, 0x55, 0xFF);
+		expectPixel(image, 4 * 4, 3, y, 0x55, 0x00, 0xAA, 0xFF);
+	}
+}
+
+GTEST_TEST(S3TC, DXT1ThreeColors) {
+	// Blue and red end points, so that the fourth color is transparent
+	static const byte kBlock[] = { 0x1F, 0x00, 0x00, 0xF8, 0xE4, 0x00, 0xFF, 0xAA };
+
+	byte image[4 * 4 * 4];
+	Graphics::decompressDXT1(image, kBlock, sizeof(kBlock), 4, 4, 4 * 4);
+
+	expectPixel(image, 4 * 4, 0, 0, 0x00, 0x00, 0xFF, 0xFF);
+	expectPixel(image, 4 * 4, 1, 0, 0xFF, 0x00, 0x00, 0xFF);
+	expectPixel(image, 4 * 4, 2, 0, 0x7F, 0x00, 0x7F, 0xFF);
+	expectPixel(image, 4 * 4, 3, 0, 0x00, 0x00, 0x00, 0x00);
+
+	for (uint32 x = 0; x < 4; x++) {
+		expectPixel(image, 4 * 4, x, 1, 0x00, 0x00, 0xFF, 0xFF);
+		expectPixel(image, 4 * 4, x, 2, 0x00, 0x00, 0x00, 0x00);
+		expectPixel(image, 4 * 4, x, 3, 0x7F, 0x00, 0x7F, 0xFF);
+	}
+}
+
+GTEST_TEST(S3TC, DXT3) {
+	// Alpha going 0, 1, 2, ... 15 through the block, on white
+	static const byte kBlock[] = {
+		0x10, 0x32, 0x54, 0x76, 0x98, 0xBA, 0xDC, 0xFE,
+		0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00
+	};
+
+	byte image[4 * 4 * 4];
+	Graphics::decompressDXT3(image, kBlock, sizeof(kBlock), 4, 4, 4 * 4);
+
+	for (uint32 y = 0; y < 4; y++)
+		for (uint32 x = 0; x < 4; x++)
+			expectPixel(image, 4 * 4, x, y, 0xFF, 0xFF, 0xFF, (y * 4 + x) * 0x11);
+}
+
+GTEST_TEST(S3TC, DXT5) {
+	// Eight alpha values from 0xFF to 0x00; the first row going through 0 to 3, the last through 4 to 7
+	static const byte kBlockEight[] = {
+		0xFF, 0x00, 0x88, 0x06, 0x00, 0x00, 0xC0, 0xFA,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+	};
+
+	byte image[4 * 4 * 4];
+	Graphics::decompressDXT5(image, kBlockEight, sizeof(kBlockEight), 4, 4, 4 * 4);
+
+	static const byte kAlphaEight[8] = { 0xFF, 0x00, 0xDB, 0xB6, 0x92, 0x6D, 0x49, 0x24 };
+	for (uint32 x = 0; x < 4; x++) {
+		expectPixel(image, 4 * 4, x, 0, 0x00, 0x00, 0x00, kAlphaEight[x]);
+		expectPixel(image, 4 * 4, x, 1, 0x00, 0x00, 0x00, kAlphaEight[0]);
+		expectPixel(image, 4 * 4, x, 3, 0x00, 0x00, 0x00, kAlphaEight[4 + x]);
+	}
+
+	// Six alpha values from 0x00 to 0xFF, plus fully transparent and fully opaque
+	static const byte kBlockSix[] = {
+		0x00, 0xFF, 0x88, 0x06, 0x00, 0x00, 0xC0, 0xFA,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+	};
+
+	Graphics::decompressDXT5(image, kBlockSix, sizeof(kBlockSix), 4, 4, 4 * 4);
+
+	static const byte kAlphaSix[8] = { 0x00, 0xFF, 0x33, 0x66, 0x99, 0xCC, 0x00, 0xFF };
+	for (uint32 x = 0; x < 4; x++) {
+		expectPixel(image, 4 * 4, x, 0, 0x00, 0x00, 0x00, kAlphaSix[x]);
+		expectPixel(image, 4 * 4, x, 3, 0x00, 0x00, 0x00, kAlphaSix[4 + x]);
+	}
+}
+
+GTEST_TEST(S3TC, smallImage) {
+	// A 2x2 image only takes the top left corner of the block
+	static const byte kBlock[] = { 0x00, 0xF8, 0x1F, 0x00, 0x04, 0x01, 0xFF, 0xFF };
+
+	byte image[2 * 3 * 4];
+	std::memset(image, 0x42, sizeof(image));
+
+	// With a pitch of 3 pixels, to see that nothing is written outside of the image
+	Graphics::decompressDXT1(image, kBlock, sizeof(kBlock), 2, 2, 3 * 4);
+
+	expectPixel(image, 3 * 4, 0, 0, 0xFF, 0x00, 0x00, 0xFF);
+	expectPixel(image, 3 * 4, 1, 0, 0x00, 0x00, 0xFF, 0xFF);
+	expectPixel(image, 3 * 4, 0, 1, 0x00, 0x00, 0xFF, 0xFF);
+	expectPixel(image, 3 * 4, 1, 1, 0xFF, 0x00, 0x00, 0xFF);
+
+	expectPixel(image, 3 * 4, 2, 0, 0x42, 0x42, 0x42, 0x42);
+	expectPixel(image, 3 * 4, 2, 1, 0x42, 0x42, 0x42, 0x42);
+}
+
+GTEST_TEST(S3TC, notEnoughData) {
+	static const byte kBlock[] = { 0x00, 0xF8, 0x1F, 0x00, 0xE4, 0xE4, 0xE4, 0xE4 };
+
+	byte image[8 * 4 * 4];
+
+	EXPECT_THROW(Graphics::decompressDXT1(image, kBlock, sizeof(kBlock), 8, 4, 8 * 4), Common::Exception);
+	EXPECT_THROW(Graphics::decompressDXT5(image, kBlock, sizeof(kBlock), 4, 4, 4 * 4), Common::Exception);
+}
+
+GTEST_TEST(S3TC, threaded) {
+	static const uint32 kSize = 256;
+
+	std::vector<byte> data;
+	fillRandom(data, (kSize / 4) * (kSize / 4) * 16);
+
+	std::vector<byte> serial(kSize * kSize * 4), threaded(kSize * kSize * 4);
+
+	Common::ThreadPool pool(3);
+
+	Graphics::decompressDXT1(&serial[0], &data[0], data.size(), kSize, kSize, kSize * 4);
+	Graphics::decompressDXT1(&threaded[0], &data[0], data.size(), kSize, kSize, kSize * 4, &pool);
+	EXPECT_TRUE(serial == threaded);
+
+	Graphics::decompressDXT5(&serial[0], &data[0], data.size(), kSize, kSize, kSize * 4);
+	Graphics::decompressDXT5(&threaded[0], &data[0], data.size(), kSize, kSize, kSize * 4, &pool);
+	EXPECT_TRUE(serial == threaded);
+}
+
+GTEST_TEST(S3TC, matchesReference) {
+	/* The reference decoders don't replicate the high bits of the 565 colors
+	 * into the low bits, and their interpolation can be off by one. The
+	 * alpha values need to match exactly. */
+
+	static const uint32 kSize = 64;
+
+	std::vector<byte> data;
+	fillRandom(data, (kSize / 4) * (kSize / 4) * 16);
+
+	std::vector<byte> reference(kSize * kSize * 4), current(kSize * kSize * 4);
+
+	Common::MemoryReadStream stream1(&data[0], data.size());
+	referenceDXT1(&reference[0], stream1, kSize, kSize, kSize * 4);
+	Graphics::decompressDXT1(&current[0], &data[0], data.size(), kSize, kSize, kSize * 4);
+
+	for (size_t i = 0; i < current.size(); i++) {
+		const int tolerance = ((i % 4) == 3) ? 0 : 8;
+		ASSERT_LE(std::abs((int) current[i] - (int) reference[i]), tolerance) << "At DXT1 byte " << i;
+	}
+
+	Common::MemoryReadStream stream5(&data[0], data.size());
+	referenceDXT5(&reference[0], stream5, kSize, kSize, kSize * 4);
+	Graphics::decompressDXT5(&current[0], &data[0], data.size(), kSize, kSize, kSize * 4);
+
+	for (size_t i = 0; i < current.size(); i++) {
+		const int tolerance = ((i % 4) == 3) ? 0 : 8;
+		ASSERT_LE(std::abs((int) current[i] - (int) reference[i]), tolerance) << "At DXT5 byte " << i;
+	}
+}
+
+GTEST_TEST(S3TC, benchmarkReference) {
+	std::vector<byte> data;
+	fillRandom(data, (kBenchmarkSize / 4) * (kBenchmarkSize / 4) * 16);
+
+	std::vector<byte> image(kBenchmarkSize * kBenchmarkSize * 4);
+
+	for (uint32 i = 0; i < kBenchmarkIterations; i++) {
+		Common::MemoryReadStream stream(&data[0], data.size());
+		referenceDXT5(&image[0], stream, kBenchmarkSize, kBenchmarkSize, kBenchmarkSize * 4);
+	}
+}
+
+GTEST_TEST(S3TC, benchmark) {
+	std::vector<byte> data;
+	fillRandom(data, (kBenchmarkSize / 4) * (kBenchmarkSize / 4) * 16);
+
+	std::vector<byte> image(kBenchmarkSize * kBenchmarkSize * 4);
+
+	for (uint32 i = 0; i < kBenchmarkIterations; i++)
+		Graphics::decompressDXT5(&image[0], &data[0], data.size(), kBenchmarkSize, kBenchmarkSize, kBenchmarkSize * 4);
+}
+
+GTEST_TEST(S3TC, benchmarkThreaded) {
+	std::vector<byte> data;
+	fillRandom(data, (kBenchmarkSize / 4) * (kBenchmarkSize / 4) * 16);
+
+	std::vector<byte> image(kBenchmarkSize * kBenchmarkSize * 4);
+
+	Common::ThreadPool pool(Common::ThreadPool::getDefaultThreadCount());
+
+	for (uint32 i = 0; i < kBenchmarkIterations; i++)
+		Graphics::decompressDXT5(&image[0], &data[0], data.size(), kBenchmarkSize, kBenchmarkSize,
+		                         kBenchmarkSize * 4, &pool);
+}
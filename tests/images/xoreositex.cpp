@@ -138,6 +138,41 @@ GTEST_TEST(XEOSITEX_3, getMipMap) {
 	}
 }
 
+GTEST_TEST(XEOSITEX_3, unloadMipMaps) {
+	Common::MemoryReadStream stream(kXEOSITEX_3);
+	Graphics::XEOSITEX image(stream);
+
+	image.unloadMipMaps(2);
+
+	EXPECT_FALSE(image.getMipMap(0).data);
+	EXPECT_FALSE(image.getMipMap(1).data);
+	EXPECT_TRUE (image.getMipMap(2).data);
+
+	EXPECT_EQ(image.getMipMap(0).width, 4);
+	EXPECT_EQ(image.getMipMap(0).size , 4 * 4 * 3);
+
+	EXPECT_FALSE(image.dumpTGA("xoreositex.tga"));
+}
+
+GTEST_TEST(XEOSITEX_3, reloadMipMaps) {
+	Common::MemoryReadStream stream(kXEOSITEX_3);
+	Graphics::XEOSITEX image(stream);
+
+	image.unloadMipMaps(2);
+
+	stream.seek(0);
+	Graphics::XEOSITEX reloaded(stream);
+
+	ASSERT_TRUE(image.reloadMipMaps(reloaded, 2));
+
+	ASSERT_TRUE(image.getMipMap(0).data);
+	ASSERT_TRUE(image.getMipMap(1).data);
+
+	expectData(image.getMipMap(0).data.get(), 4 * 4 * 3, 0);
+	expectData(image.getMipMap(1).data.get(), 2 * 2 * 3, 1);
+	expectData(image.getMipMap(2).data.get(), 1 * 1 * 3, 2);
+}
+
 // --- 4 bytes per pixel ---
 
 static const byte kXEOSITEX_4[] = {
@@ -245,6 +280,19 @@ GTEST_TEST(XEOSITEX_4, getMipMap) {
 	}
 }
 
+GTEST_TEST(XEOSITEX_4, reloadMipMapsMismatch) {
+	Common::MemoryReadStream stream4(kXEOSITEX_4);
+	Graphics::XEOSITEX image(stream4);
+
+	Common::MemoryReadStream stream3(kXEOSITEX_3);
+	Graphics::XEOSITEX other(stream3);
+
+	image.unloadMipMaps(1);
+
+	EXPECT_FALSE(image.reloadMipMaps(other, 1));
+	EXPECT_FALSE(image.getMipMap(0).data);
+}
+
 // --- Variations ---
 
 GTEST_TEST(XEOSITEX, broken) {